@@ -307,9 +307,12 @@ function(ADD_SHOGUN_BENCHMARK REL_BENCHMARK_NAME)
 		set_target_properties (${BENCHMARK_NAME} PROPERTIES RUNTIME_OUTPUT_DIRECTORY_RELEASE ${CMAKE_BINARY_DIR}/bin)
 		target_link_libraries(${BENCHMARK_NAME} ${SHOGUN_BENCHMARK_LINK_LIBS})
 		set(NO_COLOR "--color_print=false")
+		# machine readable results, to track regressions across releases
+		set(JSON_OUTPUT "--benchmark_out=${BENCHMARK_OUTPUT_DIR}/${BENCHMARK_NAME}.json"
+			"--benchmark_out_format=json")
 	endif()
 
-	add_test(${BENCHMARK_NAME} ${CMAKE_BINARY_DIR}/bin/${BENCHMARK_NAME} ${NO_COLOR})
+	add_test(${BENCHMARK_NAME} ${CMAKE_BINARY_DIR}/bin/${BENCHMARK_NAME} ${NO_COLOR} ${JSON_OUTPUT})
 	set_tests_properties(${BENCHMARK_NAME} PROPERTIES LABELS "benchmark")
 	if(ARGN)
 		set_tests_properties(${BENCHMARK_NAME} PROPERTIES ${ARGN})
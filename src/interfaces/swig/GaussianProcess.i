@@ -20,6 +20,7 @@
 %rename(FITCInferenceMethod) CFITCInferenceMethod;
 %rename(SingleFITCLaplaceInferenceMethod) CSingleFITCLaplaceInferenceMethod;
 %rename(VarDTCInferenceMethod) CVarDTCInferenceMethod;
+%rename(SVGPInferenceMethod) CSVGPInferenceMethod;
 %rename(EPInferenceMethod) CEPInferenceMethod;
 
 %rename(LikelihoodModel) CLikelihoodModel;
@@ -89,6 +90,7 @@
 %include <shogun/machine/gp/SingleFITCLaplaceInferenceMethod.h>
 %include <shogun/machine/gp/FITCInferenceMethod.h>
 %include <shogun/machine/gp/VarDTCInferenceMethod.h>
+%include <shogun/machine/gp/SVGPInferenceMethod.h>
 %include <shogun/machine/gp/EPInferenceMethod.h>
 
 %include <shogun/machine/gp/KLInference.h>
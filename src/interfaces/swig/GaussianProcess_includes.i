@@ -32,6 +32,7 @@
  #include <shogun/machine/gp/ExactInferenceMethod.h>
  #include <shogun/machine/gp/FITCInferenceMethod.h>
  #include <shogun/machine/gp/VarDTCInferenceMethod.h>
+ #include <shogun/machine/gp/SVGPInferenceMethod.h>
  #include <shogun/machine/gp/SingleFITCLaplaceInferenceMethod.h>
  #include <shogun/machine/gp/EPInferenceMethod.h>
 
@@ -15,6 +15,7 @@
 #include <shogun/io/HDF5File.h>
 #include <shogun/io/SerializableFile.h>
 #include <shogun/io/SerializableAsciiFile.h>
+#include <shogun/io/SerializableBinaryFile.h>
 #include <shogun/io/SerializableHdf5File.h>
 #include <shogun/io/SerializableJsonFile.h>
 #include <shogun/io/SerializableXmlFile.h>
@@ -2304,14 +2304,20 @@ TParameter::save_stype(CSerializableFile* file, const void* param,
 		}
 		if (!file->write_string_begin(
 				&m_datatype, m_name, prefix, len_real)) return false;
-		for (index_t i=0; i<len_real; i++) {
-			if (!file->write_stringentry_begin(
-					&m_datatype, m_name, prefix, i)) return false;
-			if (!save_ptype(file, (char*) str_ptr->string
-							+ i *m_datatype.sizeof_ptype(), prefix))
-				return false;
-			if (!file->write_stringentry_end(
-					&m_datatype, m_name, prefix, i)) return false;
+		if (file->supports_blocks()) {
+			if (!file->write_block(
+					&m_datatype, m_name, prefix, str_ptr->string,
+					len_real*m_datatype.sizeof_ptype())) return false;
+		} else {
+			for (index_t i=0; i<len_real; i++) {
+				if (!file->write_stringentry_begin(
+						&m_datatype, m_name, prefix, i)) return false;
+				if (!save_ptype(file, (char*) str_ptr->string
+								+ i *m_datatype.sizeof_ptype(), prefix))
+					return false;
+				if (!file->write_stringentry_end(
+						&m_datatype, m_name, prefix, i)) return false;
+			}
 		}
 		if (!file->write_string_end(
 				&m_datatype, m_name, prefix, len_real)) return false;
@@ -2327,19 +2333,26 @@ TParameter::save_stype(CSerializableFile* file, const void* param,
 		}
 		if (!file->write_sparse_begin(
 				&m_datatype, m_name, prefix, len_real)) return false;
-		for (index_t i=0; i<len_real; i++) {
-			SGSparseVectorEntry<char>* cur = (SGSparseVectorEntry<char>*)
-				((char*) spr_ptr->features + i *TSGDataType
-				 ::sizeof_sparseentry(m_datatype.m_ptype));
-			if (!file->write_sparseentry_begin(
-					&m_datatype, m_name, prefix, spr_ptr->features,
-					cur->feat_index, i)) return false;
-			if (!save_ptype(file, (char*) cur + TSGDataType
-							::offset_sparseentry(m_datatype.m_ptype),
-							prefix)) return false;
-			if (!file->write_sparseentry_end(
+		if (file->supports_blocks()) {
+			if (!file->write_block(
 					&m_datatype, m_name, prefix, spr_ptr->features,
-					cur->feat_index, i)) return false;
+					len_real*TSGDataType::sizeof_sparseentry(
+						m_datatype.m_ptype))) return false;
+		} else {
+			for (index_t i=0; i<len_real; i++) {
+				SGSparseVectorEntry<char>* cur = (SGSparseVectorEntry<char>*)
+					((char*) spr_ptr->features + i *TSGDataType
+					 ::sizeof_sparseentry(m_datatype.m_ptype));
+				if (!file->write_sparseentry_begin(
+						&m_datatype, m_name, prefix, spr_ptr->features,
+						cur->feat_index, i)) return false;
+				if (!save_ptype(file, (char*) cur + TSGDataType
+								::offset_sparseentry(m_datatype.m_ptype),
+								prefix)) return false;
+				if (!file->write_sparseentry_end(
+						&m_datatype, m_name, prefix, spr_ptr->features,
+						cur->feat_index, i)) return false;
+			}
 		}
 		if (!file->write_sparse_end(
 				&m_datatype, m_name, prefix, len_real)) return false;
@@ -2370,14 +2383,20 @@ TParameter::load_stype(CSerializableFile* file, void* param,
 			return false;
 		str_ptr->string = len_real > 0
 			? SG_MALLOC(char, len_real*m_datatype.sizeof_ptype()): NULL;
-		for (index_t i=0; i<len_real; i++) {
-			if (!file->read_stringentry_begin(
-					&m_datatype, m_name, prefix, i)) return false;
-			if (!load_ptype(file, (char*) str_ptr->string
-							+ i *m_datatype.sizeof_ptype(), prefix))
-				return false;
-			if (!file->read_stringentry_end(
-					&m_datatype, m_name, prefix, i)) return false;
+		if (file->supports_blocks()) {
+			if (!file->read_block(
+					&m_datatype, m_name, prefix, str_ptr->string,
+					len_real*m_datatype.sizeof_ptype())) return false;
+		} else {
+			for (index_t i=0; i<len_real; i++) {
+				if (!file->read_stringentry_begin(
+						&m_datatype, m_name, prefix, i)) return false;
+				if (!load_ptype(file, (char*) str_ptr->string
+								+ i *m_datatype.sizeof_ptype(), prefix))
+					return false;
+				if (!file->read_stringentry_end(
+						&m_datatype, m_name, prefix, i)) return false;
+			}
 		}
 		if (!file->read_string_end(
 				&m_datatype, m_name, prefix, len_real))
@@ -2390,19 +2409,26 @@ TParameter::load_stype(CSerializableFile* file, void* param,
 		spr_ptr->features = len_real > 0? (SGSparseVectorEntry<char>*)
 			SG_MALLOC(char, len_real *TSGDataType::sizeof_sparseentry(
 				m_datatype.m_ptype)): NULL;
-		for (index_t i=0; i<len_real; i++) {
-			SGSparseVectorEntry<char>* cur = (SGSparseVectorEntry<char>*)
-				((char*) spr_ptr->features + i *TSGDataType
-				 ::sizeof_sparseentry(m_datatype.m_ptype));
-			if (!file->read_sparseentry_begin(
-					&m_datatype, m_name, prefix, spr_ptr->features,
-					&cur->feat_index, i)) return false;
-			if (!load_ptype(file, (char*) cur + TSGDataType
-							::offset_sparseentry(m_datatype.m_ptype),
-							prefix)) return false;
-			if (!file->read_sparseentry_end(
+		if (file->supports_blocks()) {
+			if (!file->read_block(
 					&m_datatype, m_name, prefix, spr_ptr->features,
-					&cur->feat_index, i)) return false;
+					len_real*TSGDataType::sizeof_sparseentry(
+						m_datatype.m_ptype))) return false;
+		} else {
+			for (index_t i=0; i<len_real; i++) {
+				SGSparseVectorEntry<char>* cur = (SGSparseVectorEntry<char>*)
+					((char*) spr_ptr->features + i *TSGDataType
+					 ::sizeof_sparseentry(m_datatype.m_ptype));
+				if (!file->read_sparseentry_begin(
+						&m_datatype, m_name, prefix, spr_ptr->features,
+						&cur->feat_index, i)) return false;
+				if (!load_ptype(file, (char*) cur + TSGDataType
+								::offset_sparseentry(m_datatype.m_ptype),
+								prefix)) return false;
+				if (!file->read_sparseentry_end(
+						&m_datatype, m_name, prefix, spr_ptr->features,
+						&cur->feat_index, i)) return false;
+			}
 		}
 
 		if (!file->read_sparse_end(&m_datatype, m_name, prefix, len_real))
@@ -2572,20 +2598,29 @@ TParameter::save(CSerializableFile* file, const char* prefix)
 
 		/* ******************************************************** */
 
-		for (index_t x=0; x<len_real_x; x++)
-			for (index_t y=0; y<len_real_y; y++) {
-				if (!file->write_item_begin(
-						&m_datatype, m_name, prefix, y, x))
-					return false;
+		if (m_datatype.m_stype == ST_NONE
+			&& m_datatype.m_ptype != PT_SGOBJECT
+			&& file->supports_blocks()) {
+			if (!file->write_block(
+					&m_datatype, m_name, prefix, *(char**) m_parameter,
+					size_t(len_real_x)*len_real_y*m_datatype.sizeof_stype()))
+				return false;
+		} else {
+			for (index_t x=0; x<len_real_x; x++)
+				for (index_t y=0; y<len_real_y; y++) {
+					if (!file->write_item_begin(
+							&m_datatype, m_name, prefix, y, x))
+						return false;
 
-				if (!save_stype(
-						file, (*(char**) m_parameter)
-						+ (x*len_real_y + y)*m_datatype.sizeof_stype(),
-						prefix)) return false;
-				if (!file->write_item_end(
-						&m_datatype, m_name, prefix, y, x))
-					return false;
-			}
+					if (!save_stype(
+							file, (*(char**) m_parameter)
+							+ (x*len_real_y + y)*m_datatype.sizeof_stype(),
+							prefix)) return false;
+					if (!file->write_item_end(
+							&m_datatype, m_name, prefix, y, x))
+						return false;
+				}
+		}
 
 		/* ******************************************************** */
 
@@ -2658,21 +2693,33 @@ TParameter::load(CSerializableFile* file, const char* prefix)
 					break;
 			}
 
-			for (index_t x=0; x<dims[0]; x++)
+			if (m_datatype.m_stype == ST_NONE
+				&& m_datatype.m_ptype != PT_SGOBJECT
+				&& file->supports_blocks())
+			{
+				if (!file->read_block(
+							&m_datatype, m_name, prefix, *(char**) m_parameter,
+							size_t(dims[0])*dims[1]*m_datatype.sizeof_stype()))
+					return false;
+			}
+			else
 			{
-				for (index_t y=0; y<dims[1]; y++)
+				for (index_t x=0; x<dims[0]; x++)
 				{
-					if (!file->read_item_begin(
-								&m_datatype, m_name, prefix, y, x))
-						return false;
-
-					if (!load_stype(
-								file, (*(char**) m_parameter)
-								+ (x*dims[1] + y)*m_datatype.sizeof_stype(),
-								prefix)) return false;
-					if (!file->read_item_end(
-								&m_datatype, m_name, prefix, y, x))
-						return false;
+					for (index_t y=0; y<dims[1]; y++)
+					{
+						if (!file->read_item_begin(
+									&m_datatype, m_name, prefix, y, x))
+							return false;
+
+						if (!load_stype(
+									file, (*(char**) m_parameter)
+									+ (x*dims[1] + y)*m_datatype.sizeof_stype(),
+									prefix)) return false;
+						if (!file->read_item_end(
+									&m_datatype, m_name, prefix, y, x))
+							return false;
+					}
 				}
 			}
 
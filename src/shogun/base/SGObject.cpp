@@ -679,6 +679,16 @@ void CSGObject::build_gradient_parameter_dictionary(CMap<TParameter*, CSGObject*
 }
 
 CSGObject* CSGObject::clone()
+{
+	return clone_parameters(false);
+}
+
+CSGObject* CSGObject::shallow_clone()
+{
+	return clone_parameters(true);
+}
+
+CSGObject* CSGObject::clone_parameters(bool share)
 {
 	SG_DEBUG("Starting to clone %s at %p.\n", get_name(), this);
 	SG_DEBUG("Constructing an empty instance of %s.\n", get_name());
@@ -707,10 +717,13 @@ CSGObject* CSGObject::clone()
 		}
 
 		SG_SDEBUG(
-			"Cloning parameter %s::%s of type %s.\n", this->get_name(),
-			tag.name().c_str(), own.type().c_str());
+			"%s parameter %s::%s of type %s.\n", share ? "Sharing" : "Cloning",
+			this->get_name(), tag.name().c_str(), own.type().c_str());
 
-		clone->get_parameter(tag).get_value().clone_from(own);
+		if (share)
+			clone->get_parameter(tag).get_value().share_from(own);
+		else
+			clone->get_parameter(tag).get_value().clone_from(own);
 	}
 
 	SG_DEBUG("Done cloning %s at %p, new object at %p.\n", get_name(), this, clone);
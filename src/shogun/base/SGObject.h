@@ -763,6 +763,21 @@ public:
 	 */
 	virtual CSGObject* clone();
 
+	/** Creates a shallow clone of the current object. Parameters are copied
+	 * like in clone(), except that reference counted data (SGVector,
+	 * SGMatrix, ...) shares its memory with this object and parameter
+	 * objects are shallow cloned themselves. Shared data is copy-on-write:
+	 * classes that modify such data in place detach it first, so changes
+	 * of either object are not visible in the other.
+	 *
+	 * This is meant for cheaply handing independent copies of large objects
+	 * to concurrent workers, e.g. one per cross-validation fold.
+	 *
+	 * @return a copy of the given object that shares its data.
+	 * NULL if the clone fails. Note that the returned object is SG_REF'ed
+	 */
+	virtual CSGObject* shallow_clone();
+
 protected:
 	/** Returns an empty instance of own type.
 	 *
@@ -780,6 +795,13 @@ private:
 	void unset_global_objects();
 	void init();
 
+	/** Implementation of clone() and shallow_clone()
+	 *
+	 * @param share whether to share reference counted data
+	 * @return cloned object
+	 */
+	CSGObject* clone_parameters(bool share);
+
 	/** Overloaded helper to increase reference counter */
 	static void ref_value(CSGObject* value)
 	{
@@ -114,6 +114,7 @@ namespace shogun
 	{
 #ifdef TRACE_MEMORY_ALLOCS
 		list_memory_allocs();
+		list_memory_alloc_sites();
 		shogun::CMap<void*, shogun::MemoryBlock>* mallocs=sg_mallocs;
 		sg_mallocs=NULL;
 		SG_UNREF(mallocs);
@@ -44,6 +44,14 @@ void CPerceptron::init_model(CFeatures* data)
 		SG_UNREF(m_continue_features);
 		m_continue_features = data->as<CDotFeatures>();
 	}
+	else if (features)
+	{
+		// continue on the features that were set before, e.g. by a
+		// multiclass machine
+		SG_REF(features);
+		SG_UNREF(m_continue_features);
+		m_continue_features = features;
+	}
 
 	int32_t num_feat = features->get_dim_feature_space();
 
@@ -293,7 +293,16 @@ void CMKL::register_params()
 
 CSGObject* CMKL::clone()
 {
-	CMKL* cloned = (CMKL*) CSGObject::clone();
+	return copy_solver_state((CMKL*) CSGObject::clone());
+}
+
+CSGObject* CMKL::shallow_clone()
+{
+	return copy_solver_state((CMKL*) CSGObject::shallow_clone());
+}
+
+CMKL* CMKL::copy_solver_state(CMKL* cloned) const
+{
 #ifdef USE_GLPK
 	// GLPK params
 	if (self->lp_glpk_parm != nullptr)
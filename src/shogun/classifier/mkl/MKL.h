@@ -93,6 +93,8 @@ class CMKL : public CSVM
 
 		virtual CSGObject* clone();
 
+		virtual CSGObject* shallow_clone();
+
 		/** SVM to use as constraint generator in MKL SIP
 		 *
 		 * @param s svm
@@ -400,6 +402,14 @@ class CMKL : public CSVM
 	private:
 		void register_params();
 
+		/** copy the third party solver state, which is not registered as a
+		 * parameter, to a clone of this object
+		 *
+		 * @param cloned clone of this object
+		 * @return cloned
+		 */
+		CMKL* copy_solver_state(CMKL* cloned) const;
+
 	protected:
 		/** wrapper SVM */
 		CSVM* svm;
@@ -8,6 +8,7 @@
 #include <shogun/classifier/svm/LibSVM.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/labels/BinaryLabels.h>
+#include <shogun/lib/Profiler.h>
 
 using namespace shogun;
 
@@ -41,6 +42,7 @@ void CLibSVM::register_params()
 
 bool CLibSVM::train_machine(CFeatures* data)
 {
+	SG_PROFILE_SCOPE("svm/libsvm/train");
 	svm_problem problem;
 	svm_parameter param;
 	struct svm_model* model = nullptr;
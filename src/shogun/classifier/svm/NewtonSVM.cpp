@@ -14,6 +14,7 @@
 #include <shogun/labels/Labels.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/linalg/LinalgExpression.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 //#define DEBUG_NEWTON
@@ -59,6 +60,14 @@ void CNewtonSVM::init_model(CFeatures* data)
 		SG_UNREF(m_continue_features);
 		m_continue_features = data->as<CDotFeatures>();
 	}
+	else if (features)
+	{
+		// continue on the features that were set before, e.g. by a
+		// multiclass machine
+		SG_REF(features);
+		SG_UNREF(m_continue_features);
+		m_continue_features = features;
+	}
 
 	ASSERT(features)
 
@@ -152,7 +161,6 @@ void CNewtonSVM::line_search_linear(const SGVector<float64_t> d)
 	SGVector<float64_t> Y = binary_labels(m_labels)->get_labels();
 	SGVector<float64_t> outz(x_n);
 	SGVector<float64_t> temp1(x_n);
-	SGVector<float64_t> temp1forout(x_n);
 	SGVector<float64_t> outzsv(x_n);
 	SGVector<float64_t> Ysv(x_n);
 	SGVector<float64_t> Xsv(x_n);
@@ -173,10 +181,8 @@ void CNewtonSVM::line_search_linear(const SGVector<float64_t> d)
 
 	while (1)
 	{
-		temp1 = linalg::element_prod(Y, Xd);
-		temp1forout = temp1.clone();
-		linalg::scale(temp1forout, temp1forout, t);
-		outz = linalg::add(out, temp1forout, 1.0, -1.0);
+		linalg::evaluate(
+		    linalg::lazy(out) - t * linalg::lazy(Y) * linalg::lazy(Xd), outz);
 
 		// Calculation of sv
 		sv_len=0;
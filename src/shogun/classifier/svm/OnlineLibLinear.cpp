@@ -48,6 +48,8 @@ COnlineLibLinear::COnlineLibLinear(COnlineLibLinear *mch)
 	C1 = mch->C1;
 	C2 = mch->C2;
 	use_bias = mch->use_bias;
+	use_hogwild = mch->use_hogwild;
+	chunk_size = mch->chunk_size;
 
 	set_features(mch->features);
 	m_w = mch->m_w.clone();
@@ -62,11 +64,17 @@ void COnlineLibLinear::init()
 	Cp=1;
 	Cn=1;
 	use_bias=false;
+	use_hogwild=false;
+	chunk_size=1024;
 
 	SG_ADD(&C1, "C1", "C Cost constant 1.", ParameterProperties::HYPER);
 	SG_ADD(&C2, "C2", "C Cost constant 2.", ParameterProperties::HYPER);
 	SG_ADD(
 	    &use_bias, "use_bias", "Indicates if bias is used.");
+	SG_ADD(
+	    &use_hogwild, "use_hogwild",
+	    "Indicates if weights are updated by several threads without locks.");
+	SG_ADD(&chunk_size, "chunk_size", "Examples trained on in parallel.");
 
 	PG = 0;
 	PGmax_old = CMath::INFTY;
@@ -92,6 +100,119 @@ COnlineLibLinear::~COnlineLibLinear()
 {
 }
 
+void COnlineLibLinear::set_chunk_size(int32_t size)
+{
+	REQUIRE(size > 0, "Chunk size (%d) must be positive.\n", size)
+	chunk_size = size;
+}
+
+bool COnlineLibLinear::train_machine(CFeatures* data)
+{
+	if (!use_hogwild)
+		return COnlineLinearMachine::train_machine(data);
+
+	if (data)
+	{
+		if (!data->has_property(FP_STREAMING_DOT))
+			SG_ERROR("Specified features are not of type CStreamingDotFeatures\n")
+		set_features((CStreamingDotFeatures*) data);
+	}
+	start_train();
+	features->start_parser();
+
+	// the parser can only be used by one thread, so the examples are read
+	// serially into a chunk and then trained on in parallel
+	std::vector<SGSparseVector<float32_t> > examples;
+	std::vector<float64_t> labels;
+	bool end_of_stream = false;
+	while (!end_of_stream)
+	{
+		examples.clear();
+		labels.clear();
+		while (index_t(examples.size()) < chunk_size)
+		{
+			if (!features->get_next_example())
+			{
+				end_of_stream = true;
+				break;
+			}
+			features->expand_if_required(m_w.vector, m_w.vlen);
+			examples.push_back(features->get_sparse_example());
+			labels.push_back(features->get_label());
+			features->release_example();
+		}
+
+		if (!examples.empty())
+			train_chunk(examples, labels);
+	}
+
+	features->end_parser();
+	stop_train();
+
+	return true;
+}
+
+void COnlineLibLinear::train_chunk(
+	const std::vector<SGSparseVector<float32_t> >& examples,
+	const std::vector<float64_t>& labels)
+{
+	index_t num_examples = examples.size();
+	std::vector<float64_t> alphas(num_examples, 0);
+	std::vector<float64_t> PGs(num_examples, 0);
+	std::vector<char> skipped(num_examples, false);
+
+	// the threads read and write m_w and bias without synchronization,
+	// every example is seen once, so its alpha starts at 0
+#pragma omp parallel for num_threads(parallel->get_num_threads()) schedule(static)
+	for (index_t i = 0; i < num_examples; i++)
+	{
+		const SGSparseVector<float32_t>& ex = examples[i];
+		int32_t y_i = labels[i] > 0 ? +1 : -1;
+
+		float64_t QD_i = diag[y_i + 1]
+			+ SGSparseVector<float32_t>::sparse_dot(ex, ex);
+		float64_t G_i = 0;
+		for (int32_t j=0; j < ex.num_feat_entries; j++)
+			G_i += m_w[ex.features[j].feat_index]*ex.features[j].entry;
+		if (use_bias)
+			G_i += bias;
+		G_i = G_i*y_i - 1;
+
+		if (G_i > PGmax_old)
+		{
+			skipped[i] = true;
+			continue;
+		}
+		PGs[i] = G_i < 0 ? G_i : 0;
+
+		if (fabs(PGs[i]) > 1.0e-12)
+		{
+			alphas[i] = CMath::min(
+				CMath::max(-G_i/QD_i, 0.0), upper_bound[y_i + 1]);
+			float64_t d_i = alphas[i]*y_i;
+
+			for (int32_t j=0; j < ex.num_feat_entries; j++)
+				m_w[ex.features[j].feat_index] += d_i*ex.features[j].entry;
+
+			if (use_bias)
+				bias += d_i;
+		}
+	}
+
+	for (index_t i = 0; i < num_examples; i++)
+	{
+		if (skipped[i])
+			continue;
+
+		int32_t y_i = labels[i] > 0 ? +1 : -1;
+		PGmax_new = CMath::max(PGmax_new, PGs[i]);
+		PGmin_new = CMath::min(PGmin_new, PGs[i]);
+		v += alphas[i]*(alphas[i]*diag[y_i + 1] - 2);
+		if (alphas[i] > 0)
+			nSV++;
+	}
+}
+
 void COnlineLibLinear::start_train()
 {
 	Cp = C1;
@@ -16,6 +16,8 @@
 #include <shogun/base/Parameter.h>
 #include <shogun/machine/OnlineLinearMachine.h>
 
+#include <vector>
+
 namespace shogun
 {
 /** @brief Class implementing a purely online version of CLibLinear,
@@ -101,6 +103,33 @@ public:
 		 */
 		virtual bool get_bias_enabled() { return use_bias; }
 
+		/**
+		 * Set whether the weights shall be updated by several threads
+		 * without locks
+		 * @param enable_hogwild if lock-free parallel updates shall be enabled
+		 */
+		void set_hogwild_enabled(bool enable_hogwild) { use_hogwild=enable_hogwild; }
+
+		/**
+		 * Check if lock-free parallel updates are enabled
+		 * @return if lock-free parallel updates are enabled
+		 */
+		bool get_hogwild_enabled() { return use_hogwild; }
+
+		/**
+		 * Set the number of examples read before they are trained on in
+		 * parallel
+		 * @param size chunk size
+		 */
+		void set_chunk_size(int32_t size);
+
+		/**
+		 * Get the number of examples read before they are trained on in
+		 * parallel
+		 * @return chunk size
+		 */
+		int32_t get_chunk_size() { return chunk_size; }
+
 		/** @return Object name */
 		virtual const char* get_name() const { return "OnlineLibLinear"; }
 
@@ -121,10 +150,26 @@ public:
 		 */
 		virtual void train_example(CStreamingDotFeatures *feature, float64_t label);
 
+protected:
+		/** train on the streaming features, in parallel chunks if
+		 * lock-free parallel updates are enabled
+		 * @param data training features
+		 * @return whether training was successful
+		 */
+		virtual bool train_machine(CFeatures* data=NULL);
+
 private:
 		/** Set up parameters */
 		void init();
 
+		/** train on a chunk of examples, sharded across the threads
+		 * @param examples the examples being trained
+		 * @param labels labels of the examples
+		 */
+		void train_chunk(
+			const std::vector<SGSparseVector<float32_t> >& examples,
+			const std::vector<float64_t>& labels);
+
 		/** train on one vector
 		 * @param ex the example being trained
 		 * @param label label of this example
@@ -145,6 +190,10 @@ private:
 		float64_t C1;
 		/// C2 value
 		float64_t C2;
+		/// update the weights by several threads without locks
+		bool use_hogwild;
+		/// number of examples trained on in parallel
+		int32_t chunk_size;
 
 private:
 		//========================================
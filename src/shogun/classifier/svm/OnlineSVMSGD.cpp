@@ -8,13 +8,71 @@
 #include <shogun/base/Parameter.h>
 #include <shogun/base/progress.h>
 #include <shogun/classifier/svm/OnlineSVMSGD.h>
+#include <shogun/labels/BinaryLabels.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/loss/HingeLoss.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <vector>
+
 using namespace shogun;
 
+namespace
+{
+	/** chunk of examples read from streaming features */
+	struct StreamedExamples
+	{
+		float64_t get_label(index_t i) const
+		{
+			return labels[i];
+		}
+
+		float64_t dense_dot(index_t i, const float64_t* w) const
+		{
+			const SGSparseVector<float32_t>& x = vectors[i];
+			float64_t result = 0;
+			for (int32_t j = 0; j < x.num_feat_entries; j++)
+				result += w[x.features[j].feat_index] * x.features[j].entry;
+			return result;
+		}
+
+		void add_to_dense_vec(float64_t alpha, index_t i, float64_t* w) const
+		{
+			const SGSparseVector<float32_t>& x = vectors[i];
+			for (int32_t j = 0; j < x.num_feat_entries; j++)
+				w[x.features[j].feat_index] += alpha * x.features[j].entry;
+		}
+
+		std::vector<SGSparseVector<float32_t>> vectors;
+		std::vector<float64_t> labels;
+	};
+
+	/** chunk of examples of dot features in memory */
+	struct DotFeaturesExamples
+	{
+		float64_t get_label(index_t i) const
+		{
+			return labels->get_label(first + i);
+		}
+
+		float64_t dense_dot(index_t i, const float64_t* w) const
+		{
+			return features->dense_dot(first + i, w, dim);
+		}
+
+		void add_to_dense_vec(float64_t alpha, index_t i, float64_t* w) const
+		{
+			features->add_to_dense_vec(alpha, first + i, w, dim);
+		}
+
+		CDotFeatures* features;
+		CBinaryLabels* labels;
+		int32_t dim;
+		index_t first;
+	};
+}
+
 COnlineSVMSGD::COnlineSVMSGD()
 : COnlineLinearMachine()
 {
@@ -52,12 +110,23 @@ void COnlineSVMSGD::set_loss_function(CLossFunction* loss_func)
 	loss=loss_func;
 }
 
+void COnlineSVMSGD::set_chunk_size(int32_t size)
+{
+	REQUIRE(size > 0, "Chunk size (%d) must be positive.\n", size)
+	chunk_size = size;
+}
+
 bool COnlineSVMSGD::train(CFeatures* data)
 {
 	if (data)
 	{
 		if (!data->has_property(FP_STREAMING_DOT))
-			SG_ERROR("Specified features are not of type CStreamingDotFeatures\n")
+		{
+			if (data->has_property(FP_DOT))
+				return train_dot_features((CDotFeatures*) data);
+
+			SG_ERROR("Specified features are not of type CStreamingDotFeatures or CDotFeatures\n")
+		}
 		set_features((CStreamingDotFeatures*) data);
 	}
 
@@ -89,6 +158,14 @@ bool COnlineSVMSGD::train(CFeatures* data)
 	if ((loss_type == L_LOGLOSS) || (loss_type == L_LOGLOSSMARGIN))
 		is_log_loss = true;
 
+	if (use_hogwild)
+	{
+		train_hogwild(is_log_loss);
+		features->end_parser();
+		SG_INFO("Norm: %.6f, Bias: %.6f\n", linalg::dot(m_w, m_w), bias)
+		return true;
+	}
+
 	int32_t vec_count;
 	for (auto e : SG_PROGRESS(range(epochs)))
 	{
@@ -147,6 +224,179 @@ bool COnlineSVMSGD::train(CFeatures* data)
 	return true;
 }
 
+void COnlineSVMSGD::train_hogwild(bool is_log_loss)
+{
+	int32_t dim = 1;
+	float64_t* w = SG_CALLOC(float64_t, dim);
+	float64_t* w_avg = SG_CALLOC(float64_t, dim);
+	bias_avg = 0;
+	num_averaged = 0;
+
+	StreamedExamples examples;
+	for (auto e : SG_PROGRESS(range(epochs)))
+	{
+		COMPUTATION_CONTROLLERS
+		bool end_of_stream = false;
+		while (!end_of_stream)
+		{
+			// read the next chunk, the parser can only be used by one thread
+			examples.vectors.clear();
+			examples.labels.clear();
+			while (index_t(examples.vectors.size()) < chunk_size)
+			{
+				if (!features->get_next_example())
+				{
+					end_of_stream = true;
+					break;
+				}
+				examples.vectors.push_back(features->get_sparse_example());
+				examples.labels.push_back(features->get_label());
+				features->release_example();
+			}
+			if (examples.vectors.empty())
+				break;
+
+			// expand w if more features were seen in this chunk
+			int32_t old_dim = dim;
+			features->expand_if_required(w, dim);
+			if (dim > old_dim)
+			{
+				w_avg = SG_REALLOC(float64_t, w_avg, old_dim, dim);
+				memset(&w_avg[old_dim], 0, (dim - old_dim) * sizeof(float64_t));
+			}
+
+			update_chunk(
+			    w, w_avg, dim, examples, examples.vectors.size(), is_log_loss);
+		}
+
+		// If the stream is seekable, reset the stream to the first
+		// example (for epochs > 1)
+		if (features->is_seekable() && e < epochs-1)
+			features->reset_stream();
+		else
+			break;
+	}
+
+	float64_t* result = use_averaging ? w_avg : w;
+	m_w = SGVector<float32_t>(dim);
+	for (int32_t i = 0; i < dim; i++)
+		m_w[i] = result[i];
+	if (use_averaging)
+		bias = bias_avg;
+
+	SG_FREE(w);
+	SG_FREE(w_avg);
+}
+
+bool COnlineSVMSGD::train_dot_features(CDotFeatures* data)
+{
+	REQUIRE(m_labels, "No labels set.\n")
+	REQUIRE(m_labels->get_label_type() == LT_BINARY, "Binary labels expected.\n")
+	index_t num_vec = data->get_num_vectors();
+	REQUIRE(num_vec == m_labels->get_num_labels(),
+		"Number of vectors (%d) does not match number of labels (%d).\n",
+		num_vec, m_labels->get_num_labels())
+
+	DotFeaturesExamples examples;
+	examples.features = data;
+	examples.labels = (CBinaryLabels*) m_labels;
+	examples.dim = data->get_dim_feature_space();
+
+	SGVector<float64_t> w(examples.dim), w_avg(examples.dim);
+	w.zero();
+	w_avg.zero();
+	bias = 0;
+	bias_avg = 0;
+	num_averaged = 0;
+
+	// Shift t in order to have a
+	// reasonable initial learning rate.
+	// This assumes |x| \approx 1.
+	float64_t maxw = 1.0 / sqrt(lambda);
+	float64_t typw = sqrt(maxw);
+	float64_t eta0 = typw / CMath::max(1.0,-loss->first_derivative(-typw,1));
+	t = 1 / (eta0 * lambda);
+
+	SG_INFO("lambda=%f, epochs=%d, eta0=%f\n", lambda, epochs, eta0)
+
+	calibrate(data);
+
+	ELossType loss_type = loss->get_loss_type();
+	bool is_log_loss = false;
+	if ((loss_type == L_LOGLOSS) || (loss_type == L_LOGLOSSMARGIN))
+		is_log_loss = true;
+
+	for (auto e : SG_PROGRESS(range(epochs)))
+	{
+		COMPUTATION_CONTROLLERS
+		for (examples.first = 0; examples.first < num_vec; examples.first += chunk_size)
+		{
+			update_chunk(
+			    w.vector, w_avg.vector, examples.dim, examples,
+			    CMath::min(chunk_size, num_vec - examples.first), is_log_loss);
+		}
+	}
+
+	const SGVector<float64_t>& result = use_averaging ? w_avg : w;
+	m_w = SGVector<float32_t>(examples.dim);
+	for (int32_t i = 0; i < examples.dim; i++)
+		m_w[i] = result[i];
+	if (use_averaging)
+		bias = bias_avg;
+
+	SG_INFO("Norm: %.6f, Bias: %.6f\n", linalg::dot(m_w, m_w), bias)
+
+	return true;
+}
+
+template <class Examples>
+void COnlineSVMSGD::update_chunk(
+    float64_t* w, float64_t* w_avg, int32_t dim, const Examples& examples,
+    index_t num_examples, bool is_log_loss)
+{
+	float64_t t0 = t;
+	int32_t num_threads = use_hogwild ? parallel->get_num_threads() : 1;
+
+	// the threads read and write w and bias without synchronization
+#pragma omp parallel for num_threads(num_threads) schedule(static)
+	for (index_t i = 0; i < num_examples; i++)
+	{
+		float64_t eta = 1.0 / (lambda * (t0 + i));
+		float64_t y = examples.get_label(i);
+		float64_t z = y * (examples.dense_dot(i, w) + bias);
+
+		if (z < 1 || is_log_loss)
+		{
+			float64_t etd = -eta * loss->first_derivative(z,1);
+			examples.add_to_dense_vec(etd * y / wscale, i, w);
+
+			if (use_bias)
+			{
+				if (use_regularized_bias)
+					bias *= 1 - eta * lambda * bscale;
+				bias += etd * y * bscale;
+			}
+		}
+	}
+	t += num_examples;
+
+	// weight decay of the chunk, the product of 1-eta*lambda = 1-1/t
+	// over all its examples
+	float64_t r = CMath::max(0.0, (t0 - 1) / (t - 1));
+	SGVector<float64_t> weights(w, dim, false);
+	linalg::scale(weights, weights, r);
+
+	if (use_averaging)
+	{
+		num_averaged++;
+		SGVector<float64_t> averaged(w_avg, dim, false);
+		linalg::add(
+		    averaged, weights, averaged, 1.0 - 1.0 / num_averaged,
+		    1.0 / num_averaged);
+		bias_avg += (bias - bias_avg) / num_averaged;
+	}
+}
+
 void COnlineSVMSGD::calibrate(int32_t max_vec_num)
 {
 	int32_t c_dim=1;
@@ -188,6 +438,33 @@ void COnlineSVMSGD::calibrate(int32_t max_vec_num)
 	SG_FREE(c);
 }
 
+void COnlineSVMSGD::calibrate(CDotFeatures* data, int32_t max_vec_num)
+{
+	int32_t c_dim = data->get_dim_feature_space();
+	SGVector<float64_t> c(c_dim);
+	c.zero();
+
+	// compute average gradient size
+	int32_t n = 0;
+	float64_t m = 0;
+	float64_t r = 0;
+
+	for (; n < data->get_num_vectors() && n < max_vec_num && m <= 1000; n++)
+	{
+		r += data->get_nnz_features_for_vector(n);
+		data->add_to_dense_vec(1, n, c.vector, c_dim, true);
+		m = CMath::max(c.vector, c_dim);
+	}
+
+	// bias update scaling
+	bscale = 0.5*m/n;
+
+	// compute weight decay skip
+	skip = (int32_t) ((16 * n * c_dim) / r);
+
+	SG_INFO("using %d examples. skip=%d  bscale=%.6f\n", n, skip, bscale)
+}
+
 void COnlineSVMSGD::init()
 {
 	t=1;
@@ -202,6 +479,11 @@ void COnlineSVMSGD::init()
 	use_bias=true;
 
 	use_regularized_bias=false;
+	use_hogwild=false;
+	chunk_size=1024;
+	use_averaging=false;
+	bias_avg=0;
+	num_averaged=0;
 
 	loss=new CHingeLoss();
 	SG_REF(loss);
@@ -219,4 +501,11 @@ void COnlineSVMSGD::init()
 	SG_ADD(
 	    &use_regularized_bias, "use_regularized_bias",
 	    "Indicates if bias is regularized.");
+	SG_ADD(
+	    &use_hogwild, "use_hogwild",
+	    "Indicates if weights are updated by several threads without locks.");
+	SG_ADD(&chunk_size, "chunk_size", "Examples between weight decays.");
+	SG_ADD(
+	    &use_averaging, "use_averaging",
+	    "Indicates if weights at the end of chunks are averaged.");
 }
@@ -12,12 +12,25 @@
 #include <shogun/lib/common.h>
 #include <shogun/labels/Labels.h>
 #include <shogun/machine/OnlineLinearMachine.h>
+#include <shogun/features/DotFeatures.h>
 #include <shogun/features/streaming/StreamingDotFeatures.h>
 #include <shogun/loss/LossFunction.h>
 
 namespace shogun
 {
-/** @brief class OnlineSVMSGD */
+/** @brief class OnlineSVMSGD
+ *
+ * Trains a linear SVM with stochastic gradient descent on streaming features,
+ * or on dot features in memory with the labels set by set_labels().
+ *
+ * With set_hogwild(), the examples are processed in chunks whose examples are
+ * sharded across the threads, which update the shared weights without locks
+ * as in Hogwild (Niu et al., Hogwild!: A Lock-Free Approach to Parallelizing
+ * Stochastic Gradient Descent, NIPS 2011). This pays off for sparse, high
+ * dimensional examples, which rarely touch the same weights. The weight
+ * decay is applied at the end of every chunk, where the weights can also be
+ * averaged (set_averaging()) to smooth out the noise of the updates.
+ */
 class COnlineSVMSGD : public COnlineLinearMachine
 {
 	public:
@@ -126,6 +139,47 @@ class COnlineSVMSGD : public COnlineLinearMachine
 		 */
 		inline bool get_regularized_bias_enabled() { return use_regularized_bias; }
 
+		/** set if the weights shall be updated by several threads
+		 * without locks
+		 *
+		 * @param enable_hogwild if lock-free parallel updates shall be enabled
+		 */
+		inline void set_hogwild_enabled(bool enable_hogwild) { use_hogwild=enable_hogwild; }
+
+		/** check if lock-free parallel updates are enabled
+		 *
+		 * @return if lock-free parallel updates are enabled
+		 */
+		inline bool get_hogwild_enabled() { return use_hogwild; }
+
+		/** set chunk size
+		 *
+		 * @param size number of examples processed in parallel between
+		 * weight decays
+		 */
+		void set_chunk_size(int32_t size);
+
+		/** get chunk size
+		 *
+		 * @return number of examples processed in parallel between
+		 * weight decays
+		 */
+		inline int32_t get_chunk_size() { return chunk_size; }
+
+		/** set if the weights at the end of the chunks shall be averaged,
+		 * used with lock-free parallel updates and with features in memory,
+		 * which are always trained in chunks
+		 *
+		 * @param enable_averaging if averaging shall be enabled
+		 */
+		inline void set_averaging_enabled(bool enable_averaging) { use_averaging=enable_averaging; }
+
+		/** check if averaging is enabled
+		 *
+		 * @return if averaging is enabled
+		 */
+		inline bool get_averaging_enabled() { return use_averaging; }
+
 		/** Set the loss function to use
 		 *
 		 * @param loss_func object derived from CLossFunction
@@ -149,9 +203,38 @@ class COnlineSVMSGD : public COnlineLinearMachine
 		 * */
 		void calibrate(int32_t max_vec_num=1000);
 
+		/** calibrate on features in memory
+		 *
+		 * @param data features to calibrate on
+		 * @param max_vec_num maximum number of vectors to calibrate using
+		 */
+		void calibrate(CDotFeatures* data, int32_t max_vec_num=1000);
+
 	private:
 		void init();
 
+		/** train with lock-free parallel updates on streaming features */
+		void train_hogwild(bool is_log_loss);
+
+		/** train on features in memory, in chunks */
+		bool train_dot_features(CDotFeatures* data);
+
+		/** update the weights with a chunk of examples, sharded across the
+		 * threads, followed by the weight decay and the averaging
+		 *
+		 * @param w weights
+		 * @param w_avg averaged weights
+		 * @param dim dimension of the weights
+		 * @param examples chunk of examples
+		 * @param num_examples number of examples in the chunk
+		 * @param is_log_loss whether every example updates the weights
+		 */
+		template <class Examples>
+		void update_chunk(
+		    float64_t* w, float64_t* w_avg, int32_t dim,
+		    const Examples& examples, index_t num_examples,
+		    bool is_log_loss);
+
 	private:
 		float64_t t;
 		float64_t lambda;
@@ -166,6 +249,14 @@ class COnlineSVMSGD : public COnlineLinearMachine
 		bool use_bias;
 		bool use_regularized_bias;
 
+		bool use_hogwild;
+		int32_t chunk_size;
+		bool use_averaging;
+
+		/** averaged bias and number of averaged chunks */
+		float64_t bias_avg;
+		int32_t num_averaged;
+
 		CLossFunction* loss;
 };
 }
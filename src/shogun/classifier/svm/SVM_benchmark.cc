@@ -0,0 +1,107 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "shogun/classifier/svm/LibLinear.h"
+#include "shogun/classifier/svm/LibSVM.h"
+#include "shogun/classifier/svm/SVMLight.h"
+#include "shogun/features/DenseFeatures.h"
+#include "shogun/kernel/GaussianKernel.h"
+#include "shogun/labels/BinaryLabels.h"
+#include "shogun/util/benchmark_data.h"
+
+namespace shogun
+{
+
+class SVMFixture : public benchmark::Fixture
+{
+public:
+	void SetUp(const ::benchmark::State& st)
+	{
+		SGVector<float64_t> lab;
+		auto data = benchmark_data::binary_blobs(st.range(1), st.range(0), lab);
+		feats = new CDenseFeatures<float64_t>(data);
+		labels = new CBinaryLabels(lab);
+		SG_REF(feats);
+		SG_REF(labels);
+	}
+
+	void TearDown(const ::benchmark::State&)
+	{
+		SG_UNREF(feats);
+		SG_UNREF(labels);
+	}
+
+	/** trains a kernel SVM with a Gaussian kernel */
+	void train_kernel_svm(benchmark::State& state, CSVM* svm)
+	{
+		SG_REF(svm);
+		svm->set_kernel(new CGaussianKernel(feats, feats, state.range(1)));
+		svm->set_labels(labels);
+		for (auto _ : state)
+			svm->train();
+		SG_UNREF(svm);
+	}
+
+	/** trains a linear SVM with the given liblinear solver */
+	void train_liblinear(benchmark::State& state, LIBLINEAR_SOLVER_TYPE type)
+	{
+		auto svm = new CLibLinear(type);
+		SG_REF(svm);
+		svm->set_features(feats);
+		svm->set_labels(labels);
+		for (auto _ : state)
+			svm->train();
+		SG_UNREF(svm);
+	}
+
+	CDenseFeatures<float64_t>* feats;
+	CBinaryLabels* labels;
+};
+
+BENCHMARK_DEFINE_F(SVMFixture, LibSVM)(benchmark::State& state)
+{
+	train_kernel_svm(state, new CLibSVM());
+}
+
+#ifdef USE_SVMLIGHT
+BENCHMARK_DEFINE_F(SVMFixture, SVMLight)(benchmark::State& state)
+{
+	train_kernel_svm(state, new CSVMLight());
+}
+#endif // USE_SVMLIGHT
+
+BENCHMARK_DEFINE_F(SVMFixture, LibLinear_L2R_L2LOSS_SVC_DUAL)
+(benchmark::State& state)
+{
+	train_liblinear(state, L2R_L2LOSS_SVC_DUAL);
+}
+
+BENCHMARK_DEFINE_F(SVMFixture, LibLinear_L2R_LR)(benchmark::State& state)
+{
+	train_liblinear(state, L2R_LR);
+}
+
+// number of vectors x dimension
+#define ADD_KERNEL_SVM_ARGS(WHAT)                                              \
+	BENCHMARK_REGISTER_F(SVMFixture, WHAT)                                     \
+	    ->RangeMultiplier(4)                                                   \
+	    ->Ranges({{256, 4096}, {10, 10}})                                      \
+	    ->Unit(benchmark::kMillisecond);
+
+#define ADD_LINEAR_SVM_ARGS(WHAT)                                              \
+	BENCHMARK_REGISTER_F(SVMFixture, WHAT)                                     \
+	    ->RangeMultiplier(4)                                                   \
+	    ->Ranges({{4096, 65536}, {64, 64}})                                    \
+	    ->Unit(benchmark::kMillisecond);
+
+ADD_KERNEL_SVM_ARGS(LibSVM)
+#ifdef USE_SVMLIGHT
+ADD_KERNEL_SVM_ARGS(SVMLight)
+#endif // USE_SVMLIGHT
+ADD_LINEAR_SVM_ARGS(LibLinear_L2R_L2LOSS_SVC_DUAL)
+ADD_LINEAR_SVM_ARGS(LibLinear_L2R_LR)
+
+}
@@ -19,6 +19,7 @@ CEmbeddingConverter::CEmbeddingConverter()
 	m_target_dim = 1;
 	m_distance = new CEuclideanDistance();
 	m_kernel = new CLinearKernel();
+	m_neighbors_method = NEIGHBORS_COVER_TREE;
 
 	init();
 }
@@ -66,6 +67,16 @@ CKernel* CEmbeddingConverter::get_kernel() const
 	return m_kernel;
 }
 
+void CEmbeddingConverter::set_neighbors_method(ENeighborsMethod method)
+{
+	m_neighbors_method = method;
+}
+
+ENeighborsMethod CEmbeddingConverter::get_neighbors_method() const
+{
+	return m_neighbors_method;
+}
+
 void CEmbeddingConverter::init()
 {
 	SG_ADD(&m_target_dim, "target_dim",
@@ -75,5 +86,8 @@ void CEmbeddingConverter::init()
 		ParameterProperties::HYPER);
 	SG_ADD(
 		&m_kernel, "kernel", "kernel to be used for embedding", ParameterProperties::HYPER);
+	SG_ADD(
+		(machine_int_t*)&m_neighbors_method, "neighbors_method",
+		"method to find nearest neighbors");
 }
 }
@@ -22,6 +22,21 @@ class CFeatures;
 class CDistance;
 class CKernel;
 
+/** method to find the nearest neighbors of the converters that build a
+ * neighborhood graph */
+enum ENeighborsMethod
+{
+	/** exact, cover tree */
+	NEIGHBORS_COVER_TREE,
+	/** exact, vantage point tree */
+	NEIGHBORS_VP_TREE,
+	/** exact, brute force in parallel */
+	NEIGHBORS_BRUTE_FORCE,
+	/** approximate, NN-descent in parallel, for large datasets of high
+	 * dimension */
+	NEIGHBORS_NN_DESCENT
+};
+
 /** @brief class EmbeddingConverter (part of the Efficient Dimensionality
  * Reduction Toolkit) used to construct embeddings of
  * features, e.g. construct dense numeric embedding of string features
@@ -73,6 +88,17 @@ public:
 	 */
 	CKernel* get_kernel() const;
 
+	/** setter for the method to find nearest neighbors, only used by
+	 * converters that build a neighborhood graph
+	 * @param method neighbors method
+	 */
+	void set_neighbors_method(ENeighborsMethod method);
+
+	/** getter for the method to find nearest neighbors
+	 * @return neighbors method
+	 */
+	ENeighborsMethod get_neighbors_method() const;
+
 	virtual const char* get_name() const { return "EmbeddingConverter"; };
 
 protected:
@@ -90,6 +116,9 @@ protected:
 
 	/** kernel to be used */
 	CKernel* m_kernel;
+
+	/** method to find nearest neighbors */
+	ENeighborsMethod m_neighbors_method;
 };
 }
 
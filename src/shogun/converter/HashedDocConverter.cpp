@@ -7,11 +7,12 @@
 #include <shogun/converter/HashedDocConverter.h>
 #include <shogun/lib/DelimiterTokenizer.h>
 #include <shogun/lib/Hash.h>
-#include <shogun/lib/DynamicArray.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/features/hashed/HashedDocDotFeatures.h>
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
+
 using namespace shogun;
 
 namespace shogun
@@ -80,26 +81,48 @@ CFeatures* CHashedDocConverter::transform(CFeatures* features, bool inplace)
 	CStringFeatures<char>* s_features = (CStringFeatures<char>*) features;
 
 	int32_t dim = CMath::pow(2, num_bits);
-	SGSparseMatrix<float64_t> matrix(dim,features->get_num_vectors());
-	for (index_t vec_idx=0; vec_idx<s_features->get_num_vectors(); vec_idx++)
+	int32_t num_vectors = s_features->get_num_vectors();
+	SGSparseMatrix<float64_t> matrix(dim, num_vectors);
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
 	{
-		SGVector<char> doc = s_features->get_feature_vector(vec_idx);
-		matrix[vec_idx] = apply(doc);
-		s_features->free_feature_vector(doc, vec_idx);
+		/** tokenizers keep the state of the current document */
+		CTokenizer* local_tzer = tokenizer->get_copy();
+		std::vector<uint32_t> hashed_indices;
+
+		#pragma omp for schedule(dynamic, 64)
+		for (index_t vec_idx=0; vec_idx<num_vectors; vec_idx++)
+		{
+			int32_t len;
+			bool do_free;
+			char* doc = s_features->get_feature_vector(vec_idx, len, do_free);
+			matrix[vec_idx] = apply(SGVector<char>(doc, len, false),
+					local_tzer, hashed_indices);
+			s_features->free_feature_vector(doc, vec_idx, do_free);
+		}
+
+		SG_UNREF(local_tzer);
 	}
 
 	return (CFeatures*) new CSparseFeatures<float64_t>(matrix);
 }
 
 SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document)
+{
+	std::vector<uint32_t> hashed_indices;
+	return apply(document, tokenizer, hashed_indices);
+}
+
+SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document,
+	CTokenizer* tzer, std::vector<uint32_t>& hashed_indices)
 {
 	ASSERT(document.size()>0)
-	const int32_t array_size = 1024*1024;
-	/** the array will contain all the hashes generated from the tokens */
-	CDynamicArray<uint32_t> hashed_indices(array_size);
+	/** the vector will contain all the hashes generated from the tokens */
+	hashed_indices.clear();
 
 	/** this vector will maintain the current n+k active tokens
-	 * in a circular manner */
+	 * in a circular manner, every token is hashed only once and the
+	 * n-gram hashes are combined from these */
 	SGVector<uint32_t> cached_hashes(ngrams+tokens_to_skip);
 	index_t hashes_start = 0;
 	index_t hashes_end = 0;
@@ -111,20 +134,20 @@ SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document)
 
 	/** Reading n+s-1 tokens */
 	const int32_t seed = 0xdeadbeaf;
-	tokenizer->set_text(document);
+	tzer->set_text(document);
 	index_t token_start = 0;
-	while (hashes_end<ngrams-1+tokens_to_skip && tokenizer->has_next())
+	while (hashes_end<ngrams-1+tokens_to_skip && tzer->has_next())
 	{
-		index_t end = tokenizer->next_token_idx(token_start);
+		index_t end = tzer->next_token_idx(token_start);
 		uint32_t token_hash = CHash::MurmurHash3((uint8_t* ) &document.vector[token_start],
 				end-token_start, seed);
 		cached_hashes[hashes_end++] = token_hash;
 	}
 
 	/** Reading token and storing index to hashed_indices */
-	while (tokenizer->has_next())
+	while (tzer->has_next())
 	{
-		index_t end = tokenizer->next_token_idx(token_start);
+		index_t end = tzer->next_token_idx(token_start);
 		uint32_t token_hash = CHash::MurmurHash3((uint8_t* ) &document.vector[token_start],
 				end-token_start, seed);
 		cached_hashes[hashes_end] = token_hash;
@@ -133,7 +156,7 @@ SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document)
 				ngram_indices, num_bits, ngrams, tokens_to_skip);
 
 		for (index_t i=0; i<ngram_indices.vlen; i++)
-			hashed_indices.append_element(ngram_indices[i]);
+			hashed_indices.push_back(ngram_indices[i]);
 
 		hashes_start++;
 		hashes_end++;
@@ -153,7 +176,7 @@ SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document)
 					len, ngram_indices, num_bits, ngrams, tokens_to_skip);
 
 			for (index_t i=0; i<max_idx; i++)
-				hashed_indices.append_element(ngram_indices[i]);
+				hashed_indices.push_back(ngram_indices[i]);
 
 			hashes_start++;
 			if (hashes_start==cached_hashes.vlen)
@@ -174,17 +197,18 @@ SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document)
 	return sparse_doc_rep;
 }
 
-SGSparseVector<float64_t> CHashedDocConverter::create_hashed_representation(CDynamicArray<uint32_t>& hashed_indices)
+SGSparseVector<float64_t> CHashedDocConverter::create_hashed_representation(std::vector<uint32_t>& hashed_indices)
 {
 	int32_t num_nnz_features = count_distinct_indices(hashed_indices);
 
 	SGSparseVector<float64_t> sparse_doc_rep(num_nnz_features);
 	index_t sparse_idx = 0;
-	for (index_t i=0; i<hashed_indices.get_num_elements(); i++)
+	const index_t num_indices = hashed_indices.size();
+	for (index_t i=0; i<num_indices; i++)
 	{
 		sparse_doc_rep.features[sparse_idx].feat_index = hashed_indices[i];
 		sparse_doc_rep.features[sparse_idx].entry = 1;
-		while ( (i+1<hashed_indices.get_num_elements()) &&
+		while ( (i+1<num_indices) &&
 				(hashed_indices[i+1]==hashed_indices[i]) )
 		{
 			sparse_doc_rep.features[sparse_idx].entry++;
@@ -218,16 +242,17 @@ index_t CHashedDocConverter::generate_ngram_hashes(SGVector<uint32_t>& hashes, i
 	return h_idx;
 }
 
-int32_t CHashedDocConverter::count_distinct_indices(CDynamicArray<uint32_t>& hashed_indices)
+int32_t CHashedDocConverter::count_distinct_indices(std::vector<uint32_t>& hashed_indices)
 {
-	CMath::qsort(hashed_indices.get_array(), hashed_indices.get_num_elements());
+	std::sort(hashed_indices.begin(), hashed_indices.end());
 
 	/** Counting nnz features */
 	int32_t num_nnz_features = 0;
-	for (index_t i=0; i<hashed_indices.get_num_elements(); i++)
+	const index_t num_indices = hashed_indices.size();
+	for (index_t i=0; i<num_indices; i++)
 	{
 		num_nnz_features++;
-		while ( (i+1<hashed_indices.get_num_elements()) &&
+		while ( (i+1<num_indices) &&
 				(hashed_indices[i+1]==hashed_indices[i]) )
 		{
 			i++;
@@ -15,6 +15,8 @@
 #include <shogun/lib/Tokenizer.h>
 #include <shogun/features/SparseFeatures.h>
 
+#include <vector>
+
 namespace shogun
 {
 class CFeatures;
@@ -63,7 +65,8 @@ public:
 	/** Destructor */
 	virtual ~CHashedDocConverter();
 
-	/** Hashes each string contained in features
+	/** Hashes each string contained in features. Documents are hashed in
+	 * parallel, each thread working with its own copy of the tokenizer.
 	 *
 	 * @param features the strings to be hashed. Must be an instance of CStringFeatures.
 	 * @return a CSparseFeatures object containing the hashes of the strings.
@@ -77,6 +80,18 @@ public:
 	 */
 	SGSparseVector<float64_t> apply(SGVector<char> document);
 
+	/** Hashes the tokens contained in document using the given tokenizer
+	 * and buffer, which allows to hash several documents concurrently.
+	 *
+	 * @param document the char vector to tokenize and hash
+	 * @param tzer the tokenizer to use, e.g. a copy of the converter's
+	 * @param hashed_indices buffer for the indices of the document, reused
+	 * between calls to avoid reallocation
+	 * @return a SGSparseVector with the hashed representation of the document
+	 */
+	SGSparseVector<float64_t> apply(SGVector<char> document, CTokenizer* tzer,
+		std::vector<uint32_t>& hashed_indices);
+
 	/** Generates all the k-skip n-grams combinations for the pre-hashed tokens in hashes,
 	 * starting from hashes[hashes_start] and going up to hashes[1+len] in a circular manner.
 	 * The generated tokens (maximun (n-1)(k+1)+1) are stored in ngram_hashes. The number of
@@ -120,21 +135,21 @@ protected:
 	/** init */
 	void init(CTokenizer* tzer, int32_t d, bool normalize, int32_t n_grams, int32_t skips);
 
-	/** This method takes a dynamic array as an argument, sorts it and returns the number
-	 * of the distinct elements(indices here) in the array.
+	/** This method takes a vector as an argument, sorts it and returns the number
+	 * of the distinct elements(indices here) in the vector.
 	 *
 	 * @param hashed_indices the array to sort and count elements
 	 * @return the number of distinct elements
 	 */
-	int32_t count_distinct_indices(CDynamicArray<uint32_t>& hashed_indices);
+	int32_t count_distinct_indices(std::vector<uint32_t>& hashed_indices);
 
-	/** This method takes the dynamic array containing all the hashed indices of a document and returns a compact
+	/** This method takes the sorted vector containing all the hashed indices of a document and returns a compact
 	 * sparse representation with each index found and with the count of such index
 	 *
 	 * @param hashed_indices the array containing the hashed indices
 	 * @return the compact hashed document representation
 	 */
-	SGSparseVector<float64_t> create_hashed_representation(CDynamicArray<uint32_t>& hashed_indices);
+	SGSparseVector<float64_t> create_hashed_representation(std::vector<uint32_t>& hashed_indices);
 
 protected:
 
@@ -39,6 +39,11 @@ class CDistance;
  *   dividing each eigenvector by the square root of its corresponding eigenvalue. Form the final embedding with eigenvectors as rows and projected
  *   feature vectors as columns.
 
+ * For large datasets, only the geodesic distances to a random subset of
+ * landmarks can be computed (see set_landmark and set_landmark_number), and
+ * the neighbourhood graph can be approximated by NN-descent (see
+ * set_neighbors_method), which avoids the quadratic neighbours search.
+ *
  * It is possible to apply preprocessor to specified distance using
  * apply_to_distance.
  *
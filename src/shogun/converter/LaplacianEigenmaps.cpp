@@ -80,6 +80,7 @@ CDenseFeatures<float64_t>* CLaplacianEigenmaps::embed_distance(CDistance* distan
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
 	parameters.n_neighbors = m_k;
+	parameters.neighbors_method = m_neighbors_method;
 	parameters.gaussian_kernel_width = m_tau;
 	parameters.method = SHOGUN_LAPLACIAN_EIGENMAPS;
 	parameters.target_dimension = m_target_dim;
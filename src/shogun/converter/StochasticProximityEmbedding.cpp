@@ -135,6 +135,7 @@ CDenseFeatures< float64_t >* CStochasticProximityEmbedding::embed_distance(CDist
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
 	parameters.n_neighbors = m_k;
+	parameters.neighbors_method = m_neighbors_method;
 	parameters.method = SHOGUN_STOCHASTIC_PROXIMITY_EMBEDDING;
 	parameters.target_dimension = m_target_dim;
 	parameters.spe_num_updates = m_nupdates;
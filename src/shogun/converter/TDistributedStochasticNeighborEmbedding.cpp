@@ -16,13 +16,32 @@ CTDistributedStochasticNeighborEmbedding::CTDistributedStochasticNeighborEmbeddi
 	// Default values
 	m_perplexity = 30.0;
 	m_theta = 0.5;
+	m_max_iteration = 1000;
+	m_early_exaggeration = 12.0;
+	m_exaggeration_iterations = 250;
+	m_momentum = 0.5;
+	m_final_momentum = 0.8;
+	m_momentum_switch_iteration = 250;
+	m_learning_rate = 200.0;
+	m_interpolation = false;
 	init();
 }
 
 void CTDistributedStochasticNeighborEmbedding::init()
 {
 	SG_ADD(&m_perplexity, "perplexity", "perplexity");
-	SG_ADD(&m_theta, "theta", "learning rate");
+	SG_ADD(&m_theta, "theta", "accuracy of the Barnes-Hut approximation");
+	SG_ADD(&m_max_iteration, "max_iteration", "number of iterations");
+	SG_ADD(&m_early_exaggeration, "early_exaggeration", "early exaggeration");
+	SG_ADD(&m_exaggeration_iterations, "exaggeration_iterations",
+	       "number of iterations with early exaggeration");
+	SG_ADD(&m_momentum, "momentum", "momentum of the first iterations");
+	SG_ADD(&m_final_momentum, "final_momentum", "final momentum");
+	SG_ADD(&m_momentum_switch_iteration, "momentum_switch_iteration",
+	       "iteration to switch to the final momentum at");
+	SG_ADD(&m_learning_rate, "learning_rate", "learning rate");
+	SG_ADD(&m_interpolation, "interpolation",
+	       "whether to compute the repulsive forces by interpolation");
 }
 
 CTDistributedStochasticNeighborEmbedding::~CTDistributedStochasticNeighborEmbedding()
@@ -55,12 +74,100 @@ float64_t CTDistributedStochasticNeighborEmbedding::get_perplexity() const
 	return m_perplexity;
 }
 
+void CTDistributedStochasticNeighborEmbedding::set_max_iteration(const int32_t max_iteration)
+{
+	m_max_iteration = max_iteration;
+}
+
+int32_t CTDistributedStochasticNeighborEmbedding::get_max_iteration() const
+{
+	return m_max_iteration;
+}
+
+void CTDistributedStochasticNeighborEmbedding::set_early_exaggeration(const float64_t early_exaggeration)
+{
+	m_early_exaggeration = early_exaggeration;
+}
+
+float64_t CTDistributedStochasticNeighborEmbedding::get_early_exaggeration() const
+{
+	return m_early_exaggeration;
+}
+
+void CTDistributedStochasticNeighborEmbedding::set_exaggeration_iterations(const int32_t exaggeration_iterations)
+{
+	m_exaggeration_iterations = exaggeration_iterations;
+}
+
+int32_t CTDistributedStochasticNeighborEmbedding::get_exaggeration_iterations() const
+{
+	return m_exaggeration_iterations;
+}
+
+void CTDistributedStochasticNeighborEmbedding::set_momentum(const float64_t momentum)
+{
+	m_momentum = momentum;
+}
+
+float64_t CTDistributedStochasticNeighborEmbedding::get_momentum() const
+{
+	return m_momentum;
+}
+
+void CTDistributedStochasticNeighborEmbedding::set_final_momentum(const float64_t final_momentum)
+{
+	m_final_momentum = final_momentum;
+}
+
+float64_t CTDistributedStochasticNeighborEmbedding::get_final_momentum() const
+{
+	return m_final_momentum;
+}
+
+void CTDistributedStochasticNeighborEmbedding::set_momentum_switch_iteration(const int32_t momentum_switch_iteration)
+{
+	m_momentum_switch_iteration = momentum_switch_iteration;
+}
+
+int32_t CTDistributedStochasticNeighborEmbedding::get_momentum_switch_iteration() const
+{
+	return m_momentum_switch_iteration;
+}
+
+void CTDistributedStochasticNeighborEmbedding::set_learning_rate(const float64_t learning_rate)
+{
+	m_learning_rate = learning_rate;
+}
+
+float64_t CTDistributedStochasticNeighborEmbedding::get_learning_rate() const
+{
+	return m_learning_rate;
+}
+
+void CTDistributedStochasticNeighborEmbedding::set_interpolation(const bool interpolation)
+{
+	m_interpolation = interpolation;
+}
+
+bool CTDistributedStochasticNeighborEmbedding::get_interpolation() const
+{
+	return m_interpolation;
+}
+
 CFeatures* CTDistributedStochasticNeighborEmbedding::transform(
     CFeatures* features, bool inplace)
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
 	parameters.sne_theta = m_theta;
 	parameters.sne_perplexity = m_perplexity;
+	parameters.sne_max_iteration = m_max_iteration;
+	parameters.sne_early_exaggeration = m_early_exaggeration;
+	parameters.sne_exaggeration_iterations = m_exaggeration_iterations;
+	parameters.sne_momentum = m_momentum;
+	parameters.sne_final_momentum = m_final_momentum;
+	parameters.sne_momentum_switch_iteration = m_momentum_switch_iteration;
+	parameters.sne_learning_rate = m_learning_rate;
+	parameters.sne_interpolation = m_interpolation;
 	parameters.features = (CDotFeatures*)features;
 
 	parameters.method = SHOGUN_TDISTRIBUTED_STOCHASTIC_NEIGHBOR_EMBEDDING;
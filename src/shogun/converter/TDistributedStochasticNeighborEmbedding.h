@@ -18,8 +18,17 @@ namespace shogun
  * data using t-distributed stochastic neighbor embedding algorithm:
  * http://jmlr.csail.mit.edu/papers/volume9/vandermaaten08a/vandermaaten08a.pdf.
  *
- * Uses implementation from the Tapkee library.
+ * Uses implementation from the Tapkee library. Input similarities are
+ * calibrated and the repulsive forces of the gradient are computed in
+ * parallel, either with a Barnes-Hut tree whose accuracy is controlled by
+ * theta (theta = 0 gives the exact gradient) or, for 2D embeddings, by
+ * interpolation on a grid with FFT as in FIt-SNE
+ * (https://doi.org/10.1038/s41592-018-0308-4), which scales better to
+ * millions of points.
  *
+ * The gradient descent multiplies the input similarities by the early
+ * exaggeration for the first iterations and switches from the momentum to
+ * the final momentum after a number of iterations.
  */
 class CTDistributedStochasticNeighborEmbedding : public CEmbeddingConverter
 {
@@ -40,15 +49,15 @@ public:
 	 */
 	virtual CFeatures* transform(CFeatures* features, bool inplace = true);
 
-	/** setter for the learning rate
+	/** setter for theta, the accuracy of the Barnes-Hut approximation
 	 *
-	 * @param theta the learning rate
+	 * @param theta theta, 0 for the exact gradient
 	 */
 	void set_theta(const float64_t theta);
 
-	/** getter for the learning rate
+	/** getter for theta
 	 *
-	 * @return the learning rate theta
+	 * @return theta
 	 */
 	float64_t get_theta() const;
 
@@ -64,6 +73,104 @@ public:
 	 */
 	float64_t get_perplexity() const;
 
+	/** setter for the number of iterations
+	 *
+	 * @param max_iteration number of gradient descent iterations
+	 */
+	void set_max_iteration(const int32_t max_iteration);
+
+	/** getter for the number of iterations
+	 *
+	 * @return number of gradient descent iterations
+	 */
+	int32_t get_max_iteration() const;
+
+	/** setter for the early exaggeration
+	 *
+	 * @param early_exaggeration factor of the input similarities in the
+	 * first iterations
+	 */
+	void set_early_exaggeration(const float64_t early_exaggeration);
+
+	/** getter for the early exaggeration
+	 *
+	 * @return factor of the input similarities in the first iterations
+	 */
+	float64_t get_early_exaggeration() const;
+
+	/** setter for the number of iterations with early exaggeration
+	 *
+	 * @param exaggeration_iterations number of iterations
+	 */
+	void set_exaggeration_iterations(const int32_t exaggeration_iterations);
+
+	/** getter for the number of iterations with early exaggeration
+	 *
+	 * @return number of iterations
+	 */
+	int32_t get_exaggeration_iterations() const;
+
+	/** setter for the momentum of the first iterations
+	 *
+	 * @param momentum momentum in [0,1]
+	 */
+	void set_momentum(const float64_t momentum);
+
+	/** getter for the momentum of the first iterations
+	 *
+	 * @return momentum
+	 */
+	float64_t get_momentum() const;
+
+	/** setter for the final momentum
+	 *
+	 * @param final_momentum momentum in [0,1]
+	 */
+	void set_final_momentum(const float64_t final_momentum);
+
+	/** getter for the final momentum
+	 *
+	 * @return final momentum
+	 */
+	float64_t get_final_momentum() const;
+
+	/** setter for the iteration to switch to the final momentum at
+	 *
+	 * @param momentum_switch_iteration iteration
+	 */
+	void set_momentum_switch_iteration(const int32_t momentum_switch_iteration);
+
+	/** getter for the iteration to switch to the final momentum at
+	 *
+	 * @return iteration
+	 */
+	int32_t get_momentum_switch_iteration() const;
+
+	/** setter for the learning rate
+	 *
+	 * @param learning_rate learning rate
+	 */
+	void set_learning_rate(const float64_t learning_rate);
+
+	/** getter for the learning rate
+	 *
+	 * @return learning rate
+	 */
+	float64_t get_learning_rate() const;
+
+	/** setter for whether to compute the repulsive forces by
+	 * interpolation instead of the Barnes-Hut tree, only for 2D embeddings
+	 *
+	 * @param interpolation whether to use interpolation
+	 */
+	void set_interpolation(const bool interpolation);
+
+	/** getter for whether to compute the repulsive forces by interpolation
+	 *
+	 * @return whether to use interpolation
+	 */
+	bool get_interpolation() const;
+
 private:
 
 	/** default init */
@@ -71,12 +178,36 @@ private:
 
 private:
 
-	/** theta - learning rate */
+	/** theta - accuracy of the Barnes-Hut approximation */
 	float64_t m_theta;
 
 	/** perplexity */
 	float64_t m_perplexity;
 
+	/** number of iterations */
+	int32_t m_max_iteration;
+
+	/** early exaggeration */
+	float64_t m_early_exaggeration;
+
+	/** number of iterations with early exaggeration */
+	int32_t m_exaggeration_iterations;
+
+	/** momentum of the first iterations */
+	float64_t m_momentum;
+
+	/** final momentum */
+	float64_t m_final_momentum;
+
+	/** iteration to switch to the final momentum at */
+	int32_t m_momentum_switch_iteration;
+
+	/** learning rate */
+	float64_t m_learning_rate;
+
+	/** whether to use interpolation */
+	bool m_interpolation;
+
 }; /* class CTDistributedStochasticNeighborEmbedding */
 
 } /* namespace shogun */
@@ -12,6 +12,8 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
 
+#include <algorithm>
+
 using namespace shogun;
 using namespace Eigen;
 
@@ -71,24 +73,28 @@ void CFastICA::fit_dense(CDenseFeatures<float64_t>* features)
 	auto X = features->get_feature_matrix();
 	REQUIRE(X.data(), "Features have not been provided.\n");
 	int n = X.num_rows;
-	int p = X.num_cols;
+	index_t p = X.num_cols;
 	int m = n;
 
-	Map<MatrixXd> EX(X.matrix,n,p);
-
-	// Whiten
+	// Whiten, WX = S * (X - mean) is never formed, the iterations
+	// below transform one block of samples at a time
+	SGVector<float64_t> mean(n);
 	MatrixXd K;
-	MatrixXd WX;
+	MatrixXd S;
 	if (whiten)
 	{
-		VectorXd mean = (EX.rowwise().sum() / (float64_t)p);
-		MatrixXd SPX = EX.colwise() - mean;
+		mean = compute_mean(X);
+		SGVector<float64_t> taus(1);
+		taus[0] = 0;
+		SGNDArray<float64_t> cov = compute_lagged_covariances(X, mean, taus);
 
-		Eigen::JacobiSVD<MatrixXd> svd;
-		svd.compute(SPX, Eigen::ComputeThinU);
+		// the eigenvectors of the covariance are the left singular vectors
+		// of the centered data, ordered by decreasing singular value
+		SelfAdjointEigenSolver<MatrixXd> eig;
+		eig.compute(Map<MatrixXd>(cov.get_matrix(0), n, n));
 
-		MatrixXd u = svd.matrixU();
-		MatrixXd d = svd.singularValues();
+		MatrixXd u = eig.eigenvectors().rowwise().reverse();
+		VectorXd d = (eig.eigenvalues().reverse() * (float64_t)p).cwiseSqrt();
 
 		// for matching numpy/scikit-learn
 		//u.rightCols(u.cols() - 1) *= -1;
@@ -100,12 +106,12 @@ void CFastICA::fit_dense(CDenseFeatures<float64_t>* features)
 
 		// see Hyvarinen (13.6) p.267 Here WX is white and data
 		// in X has been projected onto a subspace by PCA
-		WX = K * SPX;
-		WX *= std::sqrt((float64_t)p);
+		S = K * std::sqrt((float64_t)p);
 	}
 	else
 	{
-		WX = EX;
+		mean.zero();
+		S = MatrixXd::Identity(n, n);
 	}
 
 	// Initial mixing matrix estimate
@@ -121,18 +127,55 @@ void CFastICA::fit_dense(CDenseFeatures<float64_t>* features)
 	}
 
 	Map<MatrixXd> W(m_mixing_matrix.matrix, m, m);
+	Map<VectorXd> EMean(mean.vector, n);
+	index_t num_blocks = (p + block_size - 1) / block_size;
 
 	W = sym_decorrelation(W);
 
 	float64_t lim = tol+1;
 	for (auto i : SG_PROGRESS(range(0, max_iter), [&] { return lim > tol; }))
 	{
-		MatrixXd wtx = W * WX;
+		// wtx = W * WX = WS * X - WS * mean
+		MatrixXd WS = W * S;
+		VectorXd offset = WS * EMean;
 
-		MatrixXd gwtx = wtx.unaryExpr(std::ptr_fun(&gx));
-		MatrixXd g_wtx = wtx.unaryExpr(std::ptr_fun(&g_x));
+		// gwtx * X^T and the row sums of gwtx and g_wtx
+		MatrixXd GX = MatrixXd::Zero(m, n);
+		VectorXd gwtx_sum = VectorXd::Zero(m);
+		VectorXd g_wtx_sum = VectorXd::Zero(m);
+
+		#pragma omp parallel num_threads(parallel->get_num_threads())
+		{
+			MatrixXd local_GX = MatrixXd::Zero(m, n);
+			VectorXd local_gwtx_sum = VectorXd::Zero(m);
+			VectorXd local_g_wtx_sum = VectorXd::Zero(m);
+
+			#pragma omp for
+			for (index_t b = 0; b < num_blocks; b++)
+			{
+				index_t begin = b * block_size;
+				index_t len = std::min(block_size, p - begin);
+				Map<MatrixXd> block(X.get_column_vector(begin), n, len);
+
+				MatrixXd wtx = (WS * block).colwise() - offset;
+				MatrixXd gwtx = wtx.unaryExpr(std::ptr_fun(&gx));
+
+				local_GX.noalias() += gwtx * block.transpose();
+				local_gwtx_sum += gwtx.rowwise().sum();
+				local_g_wtx_sum += wtx.unaryExpr(std::ptr_fun(&g_x)).rowwise().sum();
+			}
+
+			#pragma omp critical
+			{
+				GX += local_GX;
+				gwtx_sum += local_gwtx_sum;
+				g_wtx_sum += local_g_wtx_sum;
+			}
+		}
 
-		MatrixXd W1 = (gwtx * WX.transpose()) / (float64_t)p - (g_wtx.rowwise().sum()/(float64_t)p).asDiagonal() * W;
+		// gwtx * WX^T = (gwtx * X^T - gwtx * 1 * mean^T) * S^T
+		MatrixXd gwtx_WX = (GX - gwtx_sum * EMean.transpose()) * S.transpose();
+		MatrixXd W1 = gwtx_WX / (float64_t)p - (g_wtx_sum/(float64_t)p).asDiagonal() * W;
 
 		W1 = sym_decorrelation(W1);
 
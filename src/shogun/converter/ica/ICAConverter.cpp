@@ -9,6 +9,9 @@
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <algorithm>
+#include <vector>
+
 using namespace shogun;
 using namespace Eigen;
 
@@ -22,10 +25,12 @@ void CICAConverter::init()
 	m_mixing_matrix = SGMatrix<float64_t>();
 	max_iter = 200;
 	tol = 1e-6;
+	block_size = 16384;
 
 	SG_ADD(&m_mixing_matrix, "mixing_matrix", "the mixing matrix");
 	SG_ADD(&max_iter, "max_iter", "maximum number of iterations");
 	SG_ADD(&tol, "tol", "the convergence tolerance");
+	SG_ADD(&block_size, "block_size", "number of samples processed at once");
 }
 
 CICAConverter::~CICAConverter()
@@ -62,6 +67,118 @@ float64_t CICAConverter::get_tol() const
 	return tol;
 }
 
+void CICAConverter::set_block_size(index_t _block_size)
+{
+	REQUIRE(_block_size > 0, "Block size must be positive, got %d\n", _block_size);
+	block_size = _block_size;
+}
+
+index_t CICAConverter::get_block_size() const
+{
+	return block_size;
+}
+
+SGVector<float64_t> CICAConverter::compute_mean(SGMatrix<float64_t> X) const
+{
+	int n = X.num_rows;
+	index_t T = X.num_cols;
+	index_t num_blocks = (T + block_size - 1) / block_size;
+
+	VectorXd sum = VectorXd::Zero(n);
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		VectorXd local_sum = VectorXd::Zero(n);
+
+		#pragma omp for
+		for (index_t b = 0; b < num_blocks; b++)
+		{
+			index_t begin = b * block_size;
+			index_t len = std::min(block_size, T - begin);
+			Map<MatrixXd> block(X.get_column_vector(begin), n, len);
+			local_sum += block.rowwise().sum();
+		}
+
+		#pragma omp critical
+		sum += local_sum;
+	}
+
+	SGVector<float64_t> mean(n);
+	Map<VectorXd>(mean.vector, n) = sum / (float64_t)T;
+	return mean;
+}
+
+SGNDArray<float64_t> CICAConverter::compute_lagged_covariances(
+    SGMatrix<float64_t> X, SGVector<float64_t> mean,
+    SGVector<float64_t> taus) const
+{
+	int n = X.num_rows;
+	index_t T = X.num_cols;
+	int N = taus.vlen;
+	REQUIRE(mean.vlen == n, "Mean has %d entries, data has %d rows\n", mean.vlen, n);
+
+	int max_tau = 0;
+	for (int t = 0; t < N; t++)
+	{
+		REQUIRE(
+		    taus[t] >= 0 && taus[t] < T,
+		    "Lag %f must be non-negative and less than the number of "
+		    "samples (%d)\n", taus[t], T);
+		max_tau = std::max(max_tau, int(taus[t]));
+	}
+
+	Map<VectorXd> EMean(mean.vector, n);
+	index_t num_blocks = (T + block_size - 1) / block_size;
+
+	std::vector<MatrixXd> sums(N, MatrixXd::Zero(n, n));
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		std::vector<MatrixXd> local_sums(N, MatrixXd::Zero(n, n));
+		MatrixXd centered;
+
+		#pragma omp for schedule(dynamic)
+		for (index_t b = 0; b < num_blocks; b++)
+		{
+			index_t begin = b * block_size;
+			index_t len = std::min(block_size, T - begin);
+
+			// the block and the samples it is paired with at the largest lag
+			index_t width = std::min(len + max_tau, T - begin);
+			centered = Map<MatrixXd>(X.get_column_vector(begin), n, width)
+			               .colwise() - EMean;
+
+			for (int t = 0; t < N; t++)
+			{
+				int tau = int(taus[t]);
+				index_t count = std::min(len, T - tau - begin);
+				if (count <= 0)
+					continue;
+
+				local_sums[t].noalias() += centered.leftCols(count) *
+				                           centered.middleCols(tau, count).transpose();
+			}
+		}
+
+		#pragma omp critical
+		for (int t = 0; t < N; t++)
+			sums[t] += local_sums[t];
+	}
+
+	index_t* dims = SG_MALLOC(index_t, 3);
+	dims[0] = n;
+	dims[1] = n;
+	dims[2] = N;
+	SGNDArray<float64_t> covs(dims, 3);
+
+	for (int t = 0; t < N; t++)
+	{
+		Map<MatrixXd> EC(covs.get_matrix(t), n, n);
+		MatrixXd K = sums[t] / (float64_t)(T - int(taus[t]));
+		EC = (K + K.transpose()) / 2.0;
+	}
+
+	return covs;
+}
+
 void CICAConverter::fit(CFeatures* features)
 {
 	REQUIRE(features, "Features are not provided\n");
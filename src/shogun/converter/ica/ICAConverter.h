@@ -11,6 +11,8 @@
 #include <shogun/converter/Converter.h>
 #include <shogun/features/Features.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGNDArray.h>
+#include <shogun/lib/SGVector.h>
 
 namespace shogun
 {
@@ -91,6 +93,17 @@ namespace shogun
 		 */
 		float64_t get_tol() const;
 
+		/** setter for block_size, the number of samples that are processed
+		 * at once when estimating covariance matrices and other statistics
+		 * @param block_size the number of samples per block
+		 */
+		void set_block_size(index_t block_size);
+
+		/** getter for block_size
+		 * @return block_size the number of samples per block
+		 */
+		index_t get_block_size() const;
+
 		/** @return object name */
 		virtual const char* get_name() const { return "ICAConverter"; };
 
@@ -100,6 +113,30 @@ namespace shogun
 
 		virtual void fit_dense(CDenseFeatures<float64_t>* features) = 0;
 
+		/** compute the mean of the samples, blocks of samples are summed in
+		 * parallel
+		 * @param X data, one sample per column
+		 * @return mean of the samples
+		 */
+		SGVector<float64_t> compute_mean(SGMatrix<float64_t> X) const;
+
+		/** compute the symmetrised time-lagged covariance matrices
+		 * \f[
+		 * C_\tau = \frac{1}{T-\tau}\sum_{t=1}^{T-\tau}(x_t-\mu)(x_{t+\tau}-\mu)^\top
+		 * \f]
+		 * for all lags in a single pass over the data. Blocks of samples are
+		 * centered and processed in parallel, so the centered data is never
+		 * stored as a whole.
+		 *
+		 * @param X data, one sample per column
+		 * @param mean mean of the samples
+		 * @param taus lags, a lag of 0 gives the covariance matrix
+		 * @return covariance matrices, one per lag
+		 */
+		SGNDArray<float64_t> compute_lagged_covariances(
+		    SGMatrix<float64_t> X, SGVector<float64_t> mean,
+		    SGVector<float64_t> taus) const;
+
 		/** mixing_matrix */
 		SGMatrix<float64_t> m_mixing_matrix;
 
@@ -108,6 +145,9 @@ namespace shogun
 
 		/** tol */
 		float64_t tol;
+
+		/** block_size */
+		index_t block_size;
 };
 }
 #endif // ICACONVERTER
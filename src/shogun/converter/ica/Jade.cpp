@@ -13,6 +13,8 @@
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/ajd/JADiagOrth.h>
 
+#include <algorithm>
+
 #ifdef DEBUG_JADE
 #include <iostream>
 #endif
@@ -51,13 +53,14 @@ void CJade::fit_dense(CDenseFeatures<float64_t>* features)
 	int T = X.num_cols;
 	int m = n;
 
-	Map<MatrixXd> EX(X.matrix,n,T);
-
 	// Mean center X
-	VectorXd mean = (EX.rowwise().sum() / (float64_t)T);
-	MatrixXd SPX = EX.colwise() - mean;
+	SGVector<float64_t> mean = compute_mean(X);
+	Map<VectorXd> EMean(mean.vector,n);
 
-	MatrixXd cov = (SPX * SPX.transpose()) / (float64_t)T;
+	SGVector<float64_t> taus(1);
+	taus[0] = 0;
+	SGNDArray<float64_t> covs = compute_lagged_covariances(X, mean, taus);
+	Map<MatrixXd> cov(covs.get_matrix(0),n,n);
 
 	#ifdef DEBUG_JADE
 	std::cout << "cov" << std::endl;
@@ -85,34 +88,43 @@ void CJade::fit_dense(CDenseFeatures<float64_t>* features)
 	std::cout << B << std::endl;
 	#endif
 
-	// Sphering
-	SPX = B * SPX;
-
 	// Estimation of the cumulant matrices
 	int dimsymm = (m * ( m + 1)) / 2; // Dim. of the space of real symm matrices
 	int nbcm = dimsymm; //  number of cumulant matrices
 	m_cumulant_matrix = SGMatrix<float64_t>(m,m*nbcm);	// Storage for cumulant matrices
 	Map<MatrixXd> CM(m_cumulant_matrix.matrix,m,m*nbcm);
 	MatrixXd R(m,m); R.setIdentity();
-	MatrixXd Qij = MatrixXd::Zero(m,m); // Temp for a cum. matrix
-	VectorXd Xim = VectorXd::Zero(m); // Temp
-	VectorXd Xjm = VectorXd::Zero(m); // Temp
-	VectorXd Xijm = VectorXd::Zero(m); // Temp
-	int Range = 0;
+	index_t num_blocks = (T + block_size - 1) / block_size;
 
+	// The matrices of each im are estimated independently, sphering
+	// the data block by block so that it never has to be stored
+	#pragma omp parallel for schedule(dynamic) num_threads(parallel->get_num_threads())
 	for (int im = 0; im < m; im++)
 	{
-		Xim = SPX.row(im);
-		Xijm = Xim.cwiseProduct(Xim);
-		Qij = SPX.cwiseProduct(Xijm.replicate(1,m).transpose()) * SPX.transpose() / (float)T - R - 2*R.col(im)*R.col(im).transpose();
-		CM.block(0,Range,m,m) = Qij;
+		// Qii followed by Qij for all jm < im
+		MatrixXd Q = MatrixXd::Zero(m,m*(im+1));
+		for (index_t b = 0; b < num_blocks; b++)
+		{
+			index_t begin = b * block_size;
+			index_t len = std::min(block_size, T - begin);
+			MatrixXd SPX = B * (Map<MatrixXd>(X.get_column_vector(begin),n,len).colwise() - EMean);
+
+			VectorXd Xim = SPX.row(im);
+			Q.leftCols(m).noalias() += SPX * Xim.cwiseProduct(Xim).asDiagonal() * SPX.transpose();
+			for (int jm = 0; jm < im; jm++)
+			{
+				VectorXd Xijm = Xim.cwiseProduct(SPX.row(jm).transpose());
+				Q.middleCols((jm+1)*m,m).noalias() += SPX * Xijm.asDiagonal() * SPX.transpose();
+			}
+		}
+		Q /= (float64_t)T;
+
+		int Range = m*(im*(im+1))/2;
+		CM.block(0,Range,m,m) = Q.leftCols(m) - R - 2*R.col(im)*R.col(im).transpose();
 		Range = Range + m;
 		for (int jm = 0; jm < im; jm++)
 		{
-			Xjm = SPX.row(jm);
-			Xijm = Xim.cwiseProduct(Xjm);
-			Qij = SPX.cwiseProduct(Xijm.replicate(1,m).transpose()) * SPX.transpose() / (float)T - R.col(im)*R.col(jm).transpose() - R.col(jm)*R.col(im).transpose();
-			CM.block(0,Range,m,m) =  sqrt(2)*Qij;
+			CM.block(0,Range,m,m) = sqrt(2)*(Q.middleCols((jm+1)*m,m) - R.col(im)*R.col(jm).transpose() - R.col(jm)*R.col(im).transpose());
 			Range = Range + m;
 		}
 	}
@@ -16,8 +16,6 @@
 using namespace shogun;
 using namespace Eigen;
 
-namespace { MatrixXd cor(MatrixXd x, int tau = 0, bool mean_flag = true); };
-
 CJediSep::CJediSep() : CICAConverter()
 {
 	init();
@@ -57,23 +55,10 @@ void CJediSep::fit_dense(CDenseFeatures<float64_t>* features)
 	auto X = features->get_feature_matrix();
 
 	int n = X.num_rows;
-	int m = X.num_cols;
-	int N = m_tau.vlen;
-
-	Map<MatrixXd> EX(X.matrix,n,m);
 
 	// Compute Correlation Matrices
-	index_t * M_dims = SG_MALLOC(index_t, 3);
-	M_dims[0] = n;
-	M_dims[1] = n;
-	M_dims[2] = N;
-	m_covs = SGNDArray< float64_t >(M_dims, 3);
-
-	for (int t = 0; t < N; t++)
-	{
-		Map<MatrixXd> EM(m_covs.get_matrix(t),n,n);
-		EM = cor(EX,m_tau[t]);
-	}
+	SGVector<float64_t> mean = compute_mean(X);
+	m_covs = compute_lagged_covariances(X, mean, m_tau);
 
 	// Diagonalize
 	SGMatrix<float64_t> Q = CJediDiag::diagonalize(m_covs, m_mixing_matrix, tol, max_iter);
@@ -88,35 +73,3 @@ void CJediSep::fit_dense(CDenseFeatures<float64_t>* features)
 	for (int t = 0; t < C.cols(); t++)
 		C.col(t) /= C.col(t).maxCoeff();
 }
-
-// Computing time delayed correlation matrix
-namespace
-{
-	MatrixXd cor(MatrixXd x, int tau, bool mean_flag)
-	{
-		int m = x.rows();
-		int n = x.cols();
-
-		// Center the data
-		if ( mean_flag )
-		{
-			VectorXd mean = x.rowwise().sum();
-			mean /= n;
-			x = x.colwise() - mean;
-		}
-
-		// Time-delayed Signal Matrix
-		MatrixXd L = x.leftCols(n-tau);
-		MatrixXd R = x.rightCols(n-tau);
-
-		// Compute Correlations
-		MatrixXd K(m,m);
-		K = (L * R.transpose()) / (n-tau);
-
-		// Symmetrize
-		K = (K + K.transpose()) / 2.0;
-
-		return K;
-	}
-};
-
@@ -16,8 +16,6 @@
 using namespace shogun;
 using namespace Eigen;
 
-namespace { MatrixXd cor(MatrixXd x, int tau = 0, bool mean_flag = true); };
-
 CSOBI::CSOBI() : CICAConverter()
 {
 	init();
@@ -57,29 +55,24 @@ void CSOBI::fit_dense(CDenseFeatures<float64_t>* features)
 	auto X = features->get_feature_matrix();
 
 	int n = X.num_rows;
-	int m = X.num_cols;
 	int N = m_tau.vlen;
 
-	Map<MatrixXd> EX(X.matrix,n,m);
+	// Correlation matrices of the data, those of the sphered data follow
+	// from them so it never has to be formed
+	SGVector<float64_t> mean = compute_mean(X);
+	m_covs = compute_lagged_covariances(X, mean, m_tau);
 
 	// Whitening or Sphering
-	MatrixXd M0 = cor(EX,int(m_tau[0]));
+	Map<MatrixXd> M0(m_covs.get_matrix(0),n,n);
 	EigenSolver<MatrixXd> eig;
 	eig.compute(M0);
 	MatrixXd SPH = (eig.pseudoEigenvectors() * eig.pseudoEigenvalueMatrix().cwiseSqrt() * eig.pseudoEigenvectors ().transpose()).inverse();
-	MatrixXd spx = SPH*EX;
-
-	// Compute Correlation Matrices
-	index_t * M_dims = SG_MALLOC(index_t, 3);
-	M_dims[0] = n;
-	M_dims[1] = n;
-	M_dims[2] = N;
-	m_covs = SGNDArray< float64_t >(M_dims, 3);
 
+	// Compute Correlation Matrices of the sphered data
 	for(int t = 0; t < N; t++)
 	{
 		Map<MatrixXd> EM(m_covs.get_matrix(t),n,n);
-		EM = cor(spx,m_tau[t]);
+		EM = SPH * EM * SPH.transpose();
 	}
 
 	// Diagonalize
@@ -97,34 +90,3 @@ void CSOBI::fit_dense(CDenseFeatures<float64_t>* features)
 		C.col(t) /= C.col(t).maxCoeff();
 	}
 }
-
-// Computing time delayed correlation matrix
-namespace
-{
-	MatrixXd cor(MatrixXd x, int tau, bool mean_flag)
-	{
-		int m = x.rows();
-		int n = x.cols();
-
-		// Center the data
-		if ( mean_flag )
-		{
-			VectorXd mean = x.rowwise().sum();
-			mean /= n;
-			x = x.colwise() - mean;
-		}
-
-		// Time-delayed Signal Matrix
-		MatrixXd L = x.leftCols(n-tau);
-		MatrixXd R = x.rightCols(n-tau);
-
-		// Compute Correlations
-		MatrixXd K(m,m);
-		K = (L * R.transpose()) / (n-tau);
-
-		// Symmetrize
-		K = (K + K.transpose()) / 2.0;
-
-		return K;
-	}
-};
@@ -0,0 +1,79 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "shogun/distance/ChiSquareDistance.h"
+#include "shogun/distance/CosineDistance.h"
+#include "shogun/distance/EuclideanDistance.h"
+#include "shogun/distance/ManhattanMetric.h"
+#include "shogun/features/DenseFeatures.h"
+#include "shogun/util/benchmark_data.h"
+
+namespace shogun
+{
+
+class DistanceFixture : public benchmark::Fixture
+{
+public:
+	void SetUp(const ::benchmark::State& st)
+	{
+		auto data = benchmark_data::uniform_matrix(st.range(1), st.range(0));
+		f = new CDenseFeatures<float64_t>(data);
+		SG_REF(f);
+	}
+
+	void TearDown(const ::benchmark::State&)
+	{
+		SG_UNREF(f);
+	}
+
+	/** computes the full distance matrix of the features with themselves */
+	void compute(benchmark::State& state, CDistance* distance)
+	{
+		SG_REF(distance);
+		distance->init(f, f);
+		for (auto _ : state)
+			benchmark::DoNotOptimize(distance->get_distance_matrix().matrix);
+		state.SetItemsProcessed(
+		    int64_t(state.iterations()) * state.range(0) * state.range(0));
+		SG_UNREF(distance);
+	}
+
+	CDenseFeatures<float64_t>* f;
+};
+
+BENCHMARK_DEFINE_F(DistanceFixture, EuclideanDistance)(benchmark::State& state)
+{
+	compute(state, new CEuclideanDistance());
+}
+
+BENCHMARK_DEFINE_F(DistanceFixture, ManhattanMetric)(benchmark::State& state)
+{
+	compute(state, new CManhattanMetric());
+}
+
+BENCHMARK_DEFINE_F(DistanceFixture, CosineDistance)(benchmark::State& state)
+{
+	compute(state, new CCosineDistance());
+}
+
+BENCHMARK_DEFINE_F(DistanceFixture, ChiSquareDistance)(benchmark::State& state)
+{
+	compute(state, new CChiSquareDistance());
+}
+
+// number of vectors x dimension
+#define ADD_DISTANCE_ARGS(WHAT)                                                \
+	BENCHMARK_REGISTER_F(DistanceFixture, WHAT)                                \
+	    ->RangeMultiplier(4)                                                   \
+	    ->Ranges({{256, 4096}, {16, 256}})                                     \
+	    ->Unit(benchmark::kMillisecond);
+
+ADD_DISTANCE_ARGS(EuclideanDistance)
+ADD_DISTANCE_ARGS(ManhattanMetric)
+ADD_DISTANCE_ARGS(CosineDistance)
+ADD_DISTANCE_ARGS(ChiSquareDistance)
+
+}
@@ -8,6 +8,7 @@
 
 #include <shogun/base/Parameter.h>
 #include <shogun/distributions/Gaussian.h>
+#include <shogun/lib/MemoryArena.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/lapack.h>
@@ -232,15 +233,18 @@ float64_t CGaussian::compute_log_PDF(SGVector<float64_t> point)
 {
 	ASSERT(m_mean.vector && m_d.vector)
 	ASSERT(point.vlen == m_mean.vlen)
-	SGVector<float64_t> difference = point.clone();
 
-	linalg::add(difference, m_mean, difference, -1.0, 1.0);
+	// temporaries are taken from the arena of this thread, since this is
+	// called for every vector
+	ArenaScope scope;
+	SGVector<float64_t> difference = scope.vector<float64_t>(point.vlen);
+	linalg::add(point, m_mean, difference, -1.0, 1.0);
 
 	float64_t answer=m_constant;
 
 	if (m_cov_type==FULL)
 	{
-		SGVector<float64_t> temp_holder(m_d.vlen);
+		SGVector<float64_t> temp_holder = scope.vector<float64_t>(m_d.vlen);
 		temp_holder.zero();
 #ifdef HAVE_LAPACK
 		cblas_dgemv(
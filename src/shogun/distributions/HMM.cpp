@@ -13,6 +13,9 @@
 #include <shogun/base/Parallel.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/features/Alphabet.h>
+#include <shogun/mathematics/eigen3.h>
+
+#include <vector>
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -1693,6 +1696,284 @@ void CHMM::estimate_model_baum_welch_old(CHMM* estimate)
 }
 #endif // USE_HMMPARALLEL
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+	/** HMM parameters in probability space, as used by the scaled
+	 * forward/backward algorithms */
+	struct ScaledHMM
+	{
+		ScaledHMM(const CHMM* hmm)
+		{
+			int32_t N=hmm->get_N();
+			int32_t M=hmm->get_M();
+
+			p.resize(N);
+			q.resize(N);
+			A.resize(N, N);
+			B.resize(N, M);
+			for (int32_t i=0; i<N; i++)
+			{
+				p[i]=exp(hmm->get_p(i));
+				q[i]=exp(hmm->get_q(i));
+				for (int32_t j=0; j<N; j++)
+					A(i,j)=exp(hmm->get_a(i,j));
+				for (int32_t j=0; j<M; j++)
+					B(i,j)=exp(hmm->get_b(i,j));
+			}
+		}
+
+		/** initial state distribution */
+		Eigen::VectorXd p;
+		/** end state distribution */
+		Eigen::VectorXd q;
+		/** transitions, A(i,j) is the probability of going from i to j */
+		Eigen::MatrixXd A;
+		/** observations, B(i,o) is the probability of emitting o in i */
+		Eigen::MatrixXd B;
+	};
+
+	/** expected counts (sufficient statistics) for baum welch */
+	struct BaumWelchStats
+	{
+		BaumWelchStats(int32_t N, int32_t M)
+		: p(Eigen::VectorXd::Zero(N)), q(Eigen::VectorXd::Zero(N)),
+			xi(Eigen::MatrixXd::Zero(N, N)), b(Eigen::MatrixXd::Zero(N, M)),
+			log_likelihood(0)
+		{
+		}
+
+		Eigen::VectorXd p;
+		Eigen::VectorXd q;
+		/** transition counts not yet multiplied with the transitions */
+		Eigen::MatrixXd xi;
+		Eigen::MatrixXd b;
+		float64_t log_likelihood;
+	};
+
+	/** scaled forward algorithm, every column of alpha is normalised to
+	 * one and scale holds the normalisation constants
+	 *
+	 * @return log-likelihood of the sequence
+	 */
+	float64_t scaled_forward(
+		const ScaledHMM& hmm, const uint16_t* obs, int32_t len,
+		Eigen::MatrixXd& alpha, Eigen::VectorXd& scale)
+	{
+		if (len<=0)
+			return -CMath::INFTY;
+
+		alpha.resize(hmm.p.size(), len);
+		scale.resize(len);
+
+		float64_t log_likelihood=0;
+		for (int32_t t=0; t<len; t++)
+		{
+			if (t==0)
+				alpha.col(0)=hmm.p.cwiseProduct(hmm.B.col(obs[0]));
+			else
+			{
+				alpha.col(t).noalias()=hmm.A.transpose()*alpha.col(t-1);
+				alpha.col(t).array()*=hmm.B.col(obs[t]).array();
+			}
+
+			scale[t]=alpha.col(t).sum();
+			if (scale[t]<=0)
+				return -CMath::INFTY;
+
+			alpha.col(t)/=scale[t];
+			log_likelihood+=log(scale[t]);
+		}
+
+		return log_likelihood+log(alpha.col(len-1).dot(hmm.q));
+	}
+
+	/** scaled backward algorithm, adds the expected counts of the sequence
+	 * to stats (alpha and scale have to be computed by scaled_forward) */
+	void scaled_backward(
+		const ScaledHMM& hmm, const uint16_t* obs, int32_t len,
+		const Eigen::MatrixXd& alpha, const Eigen::VectorXd& scale,
+		Eigen::MatrixXd& beta, BaumWelchStats& stats)
+	{
+		beta.resize(hmm.p.size(), len);
+		beta.col(len-1)=hmm.q/alpha.col(len-1).dot(hmm.q);
+		for (int32_t t=len-2; t>=0; t--)
+		{
+			beta.col(t).noalias()=hmm.A*
+				(hmm.B.col(obs[t+1]).cwiseProduct(beta.col(t+1))/scale[t+1]);
+		}
+
+		// state posteriors are alpha.*beta
+		stats.p+=alpha.col(0).cwiseProduct(beta.col(0));
+		stats.q+=alpha.col(len-1).cwiseProduct(beta.col(len-1));
+		for (int32_t t=0; t<len; t++)
+			stats.b.col(obs[t])+=alpha.col(t).cwiseProduct(beta.col(t));
+
+		// transition posteriors summed over time as a single product
+		if (len>1)
+		{
+			for (int32_t t=1; t<len; t++)
+				beta.col(t)=hmm.B.col(obs[t]).cwiseProduct(beta.col(t))/scale[t];
+
+			stats.xi.noalias()+=alpha.leftCols(len-1)*
+				beta.rightCols(len-1).transpose();
+		}
+	}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+float64_t CHMM::model_probability_scaled()
+{
+	ASSERT(p_observations)
+
+	ScaledHMM hmm(this);
+	int32_t num_vectors=p_observations->get_num_vectors();
+	SGVector<float64_t> log_likelihood(num_vectors);
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t dim=0; dim<num_vectors; dim++)
+	{
+		Eigen::MatrixXd alpha;
+		Eigen::VectorXd scale;
+		int32_t len=0;
+		bool free_vec;
+		uint16_t* obs=p_observations->get_feature_vector(dim, len, free_vec);
+		log_likelihood[dim]=scaled_forward(hmm, obs, len, alpha, scale);
+		p_observations->free_feature_vector(obs, dim, free_vec);
+	}
+
+	mod_prob=0;
+	for (int32_t dim=0; dim<num_vectors; dim++)
+		mod_prob+=log_likelihood[dim];
+
+	mod_prob_updated=true;
+	return mod_prob;
+}
+
+SGVector<float64_t> CHMM::best_path_batch()
+{
+	ASSERT(p_observations)
+
+	Eigen::Map<const Eigen::MatrixXd> a(transition_matrix_a, N, N);
+	// observation_matrix_b is stored row-major, i.e. as b^T
+	Eigen::Map<const Eigen::MatrixXd> b_t(observation_matrix_b, M, N);
+	Eigen::Map<const Eigen::VectorXd> p(initial_state_distribution_p, N);
+	Eigen::Map<const Eigen::VectorXd> q(end_state_distribution_q, N);
+
+	int32_t num_vectors=p_observations->get_num_vectors();
+	SGVector<float64_t> path_prob(num_vectors);
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t dim=0; dim<num_vectors; dim++)
+	{
+		int32_t len=0;
+		bool free_vec;
+		uint16_t* obs=p_observations->get_feature_vector(dim, len, free_vec);
+
+		if (len<=0)
+		{
+			path_prob[dim]=-CMath::INFTY;
+			p_observations->free_feature_vector(obs, dim, free_vec);
+			continue;
+		}
+
+		Eigen::VectorXd delta=p+b_t.row(obs[0]).transpose();
+		for (int32_t t=1; t<len; t++)
+		{
+			delta=(a.colwise()+delta).colwise().maxCoeff().transpose()+
+				b_t.row(obs[t]).transpose();
+		}
+
+		path_prob[dim]=(delta+q).maxCoeff();
+		p_observations->free_feature_vector(obs, dim, free_vec);
+	}
+
+	return path_prob;
+}
+
+//estimates new model lambda out of lambda_estimate using baum welch algorithm
+//with scaled forward/backward variables and sequences spread across threads
+void CHMM::estimate_model_baum_welch_scaled(CHMM* estimate)
+{
+	ASSERT(p_observations)
+
+	ScaledHMM hmm(estimate);
+	int32_t num_vectors=p_observations->get_num_vectors();
+	int32_t num_threads=CMath::max(1,
+			CMath::min(parallel->get_num_threads(), num_vectors));
+
+	// every thread sums up the statistics of a contiguous block of
+	// sequences, which are reduced in a fixed order afterwards
+	std::vector<BaumWelchStats> stats(num_threads, BaumWelchStats(N, M));
+
+	#pragma omp parallel for num_threads(num_threads)
+	for (int32_t cpu=0; cpu<num_threads; cpu++)
+	{
+		int32_t start=int64_t(num_vectors)*cpu/num_threads;
+		int32_t stop=int64_t(num_vectors)*(cpu+1)/num_threads;
+		Eigen::MatrixXd alpha;
+		Eigen::MatrixXd beta;
+		Eigen::VectorXd scale;
+
+		for (int32_t dim=start; dim<stop; dim++)
+		{
+			int32_t len=0;
+			bool free_vec;
+			uint16_t* obs=p_observations->get_feature_vector(dim, len, free_vec);
+
+			if (len>0)
+			{
+				float64_t dimmodprob=scaled_forward(hmm, obs, len, alpha, scale);
+				stats[cpu].log_likelihood+=dimmodprob;
+
+				if (dimmodprob>-CMath::INFTY)
+					scaled_backward(hmm, obs, len, alpha, scale, beta, stats[cpu]);
+			}
+			p_observations->free_feature_vector(obs, dim, free_vec);
+		}
+	}
+
+	for (int32_t cpu=1; cpu<num_threads; cpu++)
+	{
+		stats[0].p+=stats[cpu].p;
+		stats[0].q+=stats[cpu].q;
+		stats[0].xi+=stats[cpu].xi;
+		stats[0].b+=stats[cpu].b;
+		stats[0].log_likelihood+=stats[cpu].log_likelihood;
+	}
+	BaumWelchStats& total=stats[0];
+
+	//numerators start from PSEUDO for allowed, and the (tiny) estimated
+	//value for disallowed parameters
+	for (int32_t i=0; i<N; i++)
+	{
+		float64_t pseudo_p=(estimate->get_p(i)>CMath::ALMOST_NEG_INFTY) ? PSEUDO : hmm.p[i];
+		float64_t pseudo_q=(estimate->get_q(i)>CMath::ALMOST_NEG_INFTY) ? PSEUDO : hmm.q[i];
+		set_p(i, log(pseudo_p+total.p[i]));
+		set_q(i, log(pseudo_q+total.q[i]));
+
+		for (int32_t j=0; j<N; j++)
+		{
+			float64_t pseudo_a=(estimate->get_a(i,j)>CMath::ALMOST_NEG_INFTY) ? PSEUDO : hmm.A(i,j);
+			set_a(i,j, log(pseudo_a+total.xi(i,j)*hmm.A(i,j)));
+		}
+
+		for (int32_t j=0; j<M; j++)
+		{
+			float64_t pseudo_b=(estimate->get_b(i,j)>CMath::ALMOST_NEG_INFTY) ? PSEUDO : hmm.B(i,j);
+			set_b(i,j, log(pseudo_b+total.b(i,j)));
+		}
+	}
+
+	//cache estimate model probability
+	estimate->mod_prob=total.log_likelihood;
+	estimate->mod_prob_updated=true;
+
+	//new model probability is unknown
+	normalize();
+	invalidate_model();
+}
+
 //estimates new model lambda out of lambda_estimate using baum welch algorithm
 // optimize only p, q, a but not b
 void CHMM::estimate_model_baum_welch_trans(CHMM* estimate)
@@ -5601,6 +5882,8 @@ bool CHMM::baum_welch_viterbi_train(BaumWelchViterbiType type)
 				working->estimate_model_viterbi(estimate); break;
 			case VIT_DEFINED:
 				working->estimate_model_viterbi_defined(estimate); break;
+			case BW_SCALED:
+				working->estimate_model_baum_welch_scaled(estimate); break;
 		}
 		prob_train=estimate->model_probability();
 
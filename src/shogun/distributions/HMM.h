@@ -73,7 +73,9 @@ enum BaumWelchViterbiType
 	/// standard viterbi
 	VIT_NORMAL,
 	/// viterbi only for defined transitions/observations
-	VIT_DEFINED
+	VIT_DEFINED,
+	/// standard baum welch using scaled forward/backward variables
+	BW_SCALED
 };
 
 
@@ -566,6 +568,24 @@ class CHMM : public CDistribution
 		/// by the model using forward algorithm.
 		float64_t model_probability_comp() ;
 
+		/** calculates probability that observations were generated by the
+		 * model using the scaled forward algorithm, i.e. in probability
+		 * rather than log space with the transitions as matrix-vector
+		 * products. Sequences are distributed across threads. The result
+		 * is cached as model probability.
+		 *
+		 * @return sum of log-likelihoods of all observation sequences
+		 */
+		float64_t model_probability_scaled();
+
+		/** calculates the probability of the best state sequence for all
+		 * observation sequences in parallel, like best_path() but without
+		 * storing the paths
+		 *
+		 * @return log-probability of the best path for every sequence
+		 */
+		SGVector<float64_t> best_path_batch();
+
 		/// inline proxy for model probability.
 		inline float64_t model_probability(int32_t dimension=-1)
 		{
@@ -637,6 +657,14 @@ class CHMM : public CDistribution
 		void estimate_model_baum_welch(CHMM* train);
 		void estimate_model_baum_welch_trans(CHMM* train);
 
+		/** uses baum-welch-algorithm to train a fully connected HMM, with
+		 * scaled forward/backward variables instead of log-sums. The
+		 * expected counts of the sequences are computed in parallel and
+		 * reduced afterwards.
+		 * @param train model from which the new model is estimated
+		 */
+		void estimate_model_baum_welch_scaled(CHMM* train);
+
 #ifdef USE_HMMPARALLEL_STRUCTURES
 		void ab_buf_comp(
 			float64_t* p_buf, float64_t* q_buf, float64_t* a_buf,
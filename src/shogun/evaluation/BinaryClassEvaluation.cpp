@@ -0,0 +1,265 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/base/Parallel.h>
+#include <shogun/evaluation/BinaryClassEvaluation.h>
+#include <shogun/mathematics/Math.h>
+
+#include <algorithm>
+
+using namespace shogun;
+
+/** minimum number of scores per thread to sort in parallel */
+static const index_t PARALLEL_SORT_MIN_SIZE = 65536;
+
+/** sorts scores in decreasing order by sorting one chunk per thread and
+ * merging the chunks pairwise
+ */
+static void sort_scores(
+    std::vector<std::pair<float64_t, bool>>& scores, int32_t num_threads)
+{
+	auto greater = [](const std::pair<float64_t, bool>& a,
+	                  const std::pair<float64_t, bool>& b) {
+		return a.first > b.first;
+	};
+
+	index_t size = scores.size();
+	num_threads =
+	    std::max(std::min<index_t>(num_threads, size / PARALLEL_SORT_MIN_SIZE), 1);
+	if (num_threads == 1)
+	{
+		std::sort(scores.begin(), scores.end(), greater);
+		return;
+	}
+
+	std::vector<index_t> bounds(num_threads + 1);
+	for (int32_t i = 0; i <= num_threads; i++)
+		bounds[i] = int64_t(size) * i / num_threads;
+
+	auto begin = scores.begin();
+	#pragma omp parallel for num_threads(num_threads)
+	for (int32_t i = 0; i < num_threads; i++)
+		std::sort(begin + bounds[i], begin + bounds[i + 1], greater);
+
+	for (int32_t width = 1; width < num_threads; width *= 2)
+	{
+		#pragma omp parallel for num_threads(num_threads)
+		for (int32_t i = 0; i < num_threads - width; i += 2 * width)
+		{
+			std::inplace_merge(
+			    begin + bounds[i], begin + bounds[i + width],
+			    begin + bounds[std::min(i + 2 * width, num_threads)], greater);
+		}
+	}
+}
+
+CBinaryClassEvaluation::CBinaryClassEvaluation() : CEvaluation()
+{
+	init();
+}
+
+CBinaryClassEvaluation::~CBinaryClassEvaluation()
+{
+}
+
+void CBinaryClassEvaluation::init()
+{
+	m_num_bins = 0;
+	m_min_score = -1.0;
+	m_max_score = 1.0;
+
+	SG_ADD(
+	    &m_num_bins, "num_bins",
+	    "Number of bins of the score histogram, 0 if exact");
+	SG_ADD(&m_min_score, "min_score", "Lower end of the score histogram");
+	SG_ADD(&m_max_score, "max_score", "Upper end of the score histogram");
+}
+
+void CBinaryClassEvaluation::set_num_bins(
+    int32_t num_bins, float64_t min_score, float64_t max_score)
+{
+	REQUIRE(num_bins >= 0, "Number of bins (%d) must be non-negative\n", num_bins);
+	REQUIRE(
+	    num_bins == 0 || min_score < max_score,
+	    "Minimum score (%f) must be smaller than maximum score (%f)\n",
+	    min_score, max_score);
+
+	m_num_bins = num_bins;
+	m_min_score = min_score;
+	m_max_score = max_score;
+	reset_scores();
+}
+
+int32_t CBinaryClassEvaluation::get_num_bins() const
+{
+	return m_num_bins;
+}
+
+void CBinaryClassEvaluation::reset_scores()
+{
+	std::vector<std::pair<float64_t, bool>>().swap(m_scores);
+	m_pos_histogram = SGVector<float64_t>();
+	m_neg_histogram = SGVector<float64_t>();
+}
+
+void CBinaryClassEvaluation::add_scores(CLabels* predicted, CLabels* ground_truth)
+{
+	REQUIRE(predicted, "No predicted labels provided.\n");
+	REQUIRE(ground_truth, "No ground truth labels provided.\n");
+	REQUIRE(
+	    predicted->get_label_type() == LT_BINARY,
+	    "Given predicted labels (%d) must be binary (%d).\n",
+	    predicted->get_label_type(), LT_BINARY);
+	REQUIRE(
+	    ground_truth->get_label_type() == LT_BINARY,
+	    "Given ground truth labels (%d) must be binary (%d).\n",
+	    ground_truth->get_label_type(), LT_BINARY);
+	REQUIRE(
+	    predicted->get_num_labels() == ground_truth->get_num_labels(),
+	    "Number of predicted labels (%d) must match number of ground truth "
+	    "labels (%d).\n",
+	    predicted->get_num_labels(), ground_truth->get_num_labels());
+	ground_truth->ensure_valid();
+
+	SGVector<float64_t> labels = ((CBinaryLabels*)ground_truth)->get_labels();
+	index_t length = labels.vlen;
+
+	if (m_num_bins == 0)
+	{
+		index_t offset = m_scores.size();
+		m_scores.resize(offset + length);
+		#pragma omp parallel for num_threads(parallel->get_num_threads())
+		for (index_t i = 0; i < length; i++)
+			m_scores[offset + i] = std::make_pair(predicted->get_value(i), labels[i] > 0);
+		return;
+	}
+
+	if (!m_pos_histogram.vlen)
+	{
+		m_pos_histogram = SGVector<float64_t>(m_num_bins);
+		m_neg_histogram = SGVector<float64_t>(m_num_bins);
+		m_pos_histogram.zero();
+		m_neg_histogram.zero();
+	}
+
+	float64_t bin_width = (m_max_score - m_min_score) / m_num_bins;
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		SGVector<float64_t> pos_histogram(m_num_bins);
+		SGVector<float64_t> neg_histogram(m_num_bins);
+		pos_histogram.zero();
+		neg_histogram.zero();
+
+		#pragma omp for
+		for (index_t i = 0; i < length; i++)
+		{
+			float64_t bin = std::floor((predicted->get_value(i) - m_min_score) / bin_width);
+			index_t idx = CMath::clamp<float64_t>(bin, 0, m_num_bins - 1);
+			if (labels[i] > 0)
+				pos_histogram[idx] += 1;
+			else
+				neg_histogram[idx] += 1;
+		}
+
+		#pragma omp critical
+		{
+			for (index_t i = 0; i < m_num_bins; i++)
+			{
+				m_pos_histogram[i] += pos_histogram[i];
+				m_neg_histogram[i] += neg_histogram[i];
+			}
+		}
+	}
+}
+
+float64_t CBinaryClassEvaluation::evaluate_scores()
+{
+	std::vector<float64_t> thresholds;
+	std::vector<float64_t> pos_counts;
+	std::vector<float64_t> neg_counts;
+
+	if (m_num_bins == 0)
+	{
+		sort_scores(m_scores, parallel->get_num_threads());
+		for (const auto& score : m_scores)
+		{
+			if (thresholds.empty() || score.first != thresholds.back())
+			{
+				thresholds.push_back(score.first);
+				pos_counts.push_back(0);
+				neg_counts.push_back(0);
+			}
+
+			if (score.second)
+				pos_counts.back() += 1;
+			else
+				neg_counts.back() += 1;
+		}
+	}
+	else
+	{
+		// every bin is represented by its lower end
+		float64_t bin_width = (m_max_score - m_min_score) / m_num_bins;
+		for (index_t i = m_pos_histogram.vlen - 1; i >= 0; i--)
+		{
+			if (m_pos_histogram[i] + m_neg_histogram[i] == 0)
+				continue;
+
+			thresholds.push_back(m_min_score + i * bin_width);
+			pos_counts.push_back(m_pos_histogram[i]);
+			neg_counts.push_back(m_neg_histogram[i]);
+		}
+	}
+
+	auto to_sgvector = [](const std::vector<float64_t>& v) {
+		SGVector<float64_t> result(v.size());
+		std::copy(v.begin(), v.end(), result.vector);
+		return result;
+	};
+
+	return evaluate_counts(
+	    to_sgvector(thresholds), to_sgvector(pos_counts),
+	    to_sgvector(neg_counts));
+}
+
+float64_t CBinaryClassEvaluation::evaluate_batch(
+    CLabels* predicted, CLabels* ground_truth)
+{
+	// set the accumulated scores aside while the batch is evaluated
+	std::vector<std::pair<float64_t, bool>> scores;
+	SGVector<float64_t> pos_histogram;
+	SGVector<float64_t> neg_histogram;
+	std::swap(scores, m_scores);
+	std::swap(pos_histogram, m_pos_histogram);
+	std::swap(neg_histogram, m_neg_histogram);
+
+	auto restore = [&]() {
+		std::swap(scores, m_scores);
+		std::swap(pos_histogram, m_pos_histogram);
+		std::swap(neg_histogram, m_neg_histogram);
+	};
+
+	float64_t result;
+	try
+	{
+		add_scores(predicted, ground_truth);
+		result = evaluate_scores();
+	}
+	catch (...)
+	{
+		restore();
+		throw;
+	}
+	restore();
+
+	return result;
+}
+
+float64_t CBinaryClassEvaluation::evaluate_counts(
+    SGVector<float64_t> thresholds, SGVector<float64_t> pos_counts,
+    SGVector<float64_t> neg_counts)
+{
+	SG_NOTIMPLEMENTED
+	return 0;
+}
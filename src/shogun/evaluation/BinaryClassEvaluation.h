@@ -12,6 +12,9 @@
 #include <shogun/evaluation/Evaluation.h>
 #include <shogun/labels/BinaryLabels.h>
 
+#include <utility>
+#include <vector>
+
 namespace shogun
 {
 
@@ -21,6 +24,16 @@ class CLabels;
  * a base class used to evaluate binary classification
  * labels.
  *
+ * Evaluations based on the ranking of the predicted scores (like ROC and
+ * PRC) reduce the scores to the number of positive and negative examples
+ * per distinct score, see evaluate_counts(). Scores are either sorted
+ * exactly, using a parallel sort and merge, or, if a number of bins is set
+ * with set_num_bins(), counted in a fixed size histogram over a given score
+ * range, which bounds the memory independently of the number of scores.
+ *
+ * Besides evaluate(), scores can be fed batch by batch with add_scores(),
+ * e.g. predictions on streaming features, and evaluated with
+ * evaluate_scores(). evaluate() leaves the scores added so far untouched.
  */
 class CBinaryClassEvaluation: public CEvaluation
 {
@@ -28,10 +41,10 @@ class CBinaryClassEvaluation: public CEvaluation
 public:
 
 	/** constructor */
-	CBinaryClassEvaluation() : CEvaluation() {};
+	CBinaryClassEvaluation();
 
 	/** destructor */
-	virtual ~CBinaryClassEvaluation() {};
+	virtual ~CBinaryClassEvaluation();
 
 	/** evaluate labels
 	 * @param predicted labels for evaluating
@@ -39,6 +52,83 @@ public:
 	 * @return evaluation result
 	 */
 	virtual float64_t evaluate(CLabels* predicted, CLabels* ground_truth) = 0;
+
+	/** set number of bins of the score histogram, scores outside of the
+	 * given range are counted in the first or last bin. Discards the
+	 * scores added so far.
+	 *
+	 * @param num_bins number of bins, 0 to sort the scores exactly
+	 * @param min_score lower end of the histogram
+	 * @param max_score upper end of the histogram
+	 */
+	void set_num_bins(
+	    int32_t num_bins, float64_t min_score = -1.0, float64_t max_score = 1.0);
+
+	/** @return number of bins of the score histogram, 0 if exact */
+	int32_t get_num_bins() const;
+
+	/** add a batch of scores to be evaluated by evaluate_scores()
+	 * @param predicted labels for evaluating
+	 * @param ground_truth labels assumed to be correct
+	 */
+	void add_scores(CLabels* predicted, CLabels* ground_truth);
+
+	/** evaluate all scores added with add_scores() so far
+	 * @return evaluation result
+	 */
+	float64_t evaluate_scores();
+
+	/** discard the scores added so far */
+	void reset_scores();
+
+protected:
+
+	/** evaluate the given labels on their own, without discarding the
+	 * scores added with add_scores()
+	 *
+	 * @param predicted labels for evaluating
+	 * @param ground_truth labels assumed to be correct
+	 * @return evaluation result
+	 */
+	float64_t evaluate_batch(CLabels* predicted, CLabels* ground_truth);
+
+	/** evaluate counts of examples per distinct score, has to be
+	 * implemented by evaluations that support evaluate_scores()
+	 *
+	 * @param thresholds distinct scores in decreasing order
+	 * @param pos_counts number of positive examples with each score
+	 * @param neg_counts number of negative examples with each score
+	 * @return evaluation result
+	 */
+	virtual float64_t evaluate_counts(
+	    SGVector<float64_t> thresholds, SGVector<float64_t> pos_counts,
+	    SGVector<float64_t> neg_counts);
+
+private:
+
+	void init();
+
+protected:
+
+	/** number of bins of the score histogram, 0 if exact */
+	int32_t m_num_bins;
+
+	/** lower end of the score histogram */
+	float64_t m_min_score;
+
+	/** upper end of the score histogram */
+	float64_t m_max_score;
+
+private:
+
+	/** scores and whether they are positive, in exact mode */
+	std::vector<std::pair<float64_t, bool>> m_scores;
+
+	/** number of positive examples per bin */
+	SGVector<float64_t> m_pos_histogram;
+
+	/** number of negative examples per bin */
+	SGVector<float64_t> m_neg_histogram;
 };
 
 }
@@ -243,10 +243,10 @@ float64_t CCrossValidation::evaluate_one_run(
 
 			auto machine = (CMachine*)m_machine->clone();
 
-			// TODO while these are not used through const interfaces,
-			// we unfortunately have to clone, even though these could be shared
-			auto features = (CFeatures*)m_features->clone();
-			auto labels = (CLabels*)m_labels->clone();
+			// features and labels share their data with the originals, only
+			// the subset stacks are per fold
+			auto features = (CFeatures*)m_features->shallow_clone();
+			auto labels = (CLabels*)m_labels->shallow_clone();
 			auto evaluation_criterion =
 			    (CEvaluation*)m_evaluation_criterion->clone();
 
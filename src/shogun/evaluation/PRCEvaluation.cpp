@@ -6,7 +6,6 @@
  */
 
 #include <shogun/evaluation/PRCEvaluation.h>
-#include <shogun/labels/RegressionLabels.h>
 #include <shogun/labels/BinaryLabels.h>
 #include <shogun/mathematics/Math.h>
 
@@ -20,59 +19,43 @@ float64_t CPRCEvaluation::evaluate(CLabels* predicted, CLabels* ground_truth)
 {
 	ASSERT(predicted && ground_truth)
 	ASSERT(predicted->get_num_labels()==ground_truth->get_num_labels())
-	ASSERT(predicted->get_label_type()==LT_BINARY)
-	ASSERT(ground_truth->get_label_type()==LT_BINARY)
-	ground_truth->ensure_valid();
 
-	// number of true positive examples
-	float64_t tp = 0.0;
-	int32_t i;
-
-	// total number of positive labels in predicted
-	int32_t pos_count=0;
+	return evaluate_batch(predicted, ground_truth);
+}
 
-	// initialize number of labels and labels
-	SGVector<float64_t> orig_labels = predicted->get_values();
-	int32_t length = orig_labels.vlen;
-	float64_t* labels = SGVector<float64_t>::clone_vector(orig_labels.vector, length);
+float64_t CPRCEvaluation::evaluate_counts(
+    SGVector<float64_t> thresholds, SGVector<float64_t> pos_counts,
+    SGVector<float64_t> neg_counts)
+{
+	int32_t length = thresholds.vlen;
 
-	// get indexes for sort
-	int32_t* idxs = SG_MALLOC(int32_t, length);
-	for(i=0; i<length; i++)
-		idxs[i] = i;
+	// total number of positive labels
+	float64_t pos_count = SGVector<float64_t>::sum(pos_counts);
 
-	// sort indexes by labels ascending
-	CMath::qsort_backward_index(labels,idxs,length);
+	// assure number of positive examples is >0
+	ASSERT(pos_count>0)
 
-	// clean and initialize graph and auPRC
-	SG_FREE(labels);
+	// initialize graph and auPRC
 	m_PRC_graph = SGMatrix<float64_t>(2,length);
 	m_thresholds = SGVector<float64_t>(length);
 	m_auPRC = 0.0;
 
-	// get total numbers of positive and negative labels
-	for (i=0; i<length; i++)
-	{
-		if (ground_truth->get_value(i) > 0)
-			pos_count++;
-	}
-
-	// assure number of positive examples is >0
-	ASSERT(pos_count>0)
+	// number of true and false positive examples
+	float64_t tp = 0.0;
+	float64_t fp = 0.0;
 
-	// create PRC curve
-	for (i=0; i<length; i++)
+	// create PRC curve, examples with tied scores are added at once
+	for (int32_t i=0; i<length; i++)
 	{
-		// update number of true positive examples
-		if (ground_truth->get_value(idxs[i]) > 0)
-			tp += 1.0;
+		tp += pos_counts[i];
+		fp += neg_counts[i];
 
 		// precision (x)
-		m_PRC_graph[2*i] = tp/float64_t(i+1);
+		m_PRC_graph[2*i] = tp/(tp+fp);
 		// recall (y)
-		m_PRC_graph[2*i+1] = tp/float64_t(pos_count);
+		m_PRC_graph[2*i+1] = tp/pos_count;
 
-		m_thresholds[i]= predicted->get_value(idxs[i]);
+		m_thresholds[i] = thresholds[i];
 	}
 
 	// calc auRPC using area under curve
@@ -81,7 +64,6 @@ float64_t CPRCEvaluation::evaluate(CLabels* predicted, CLabels* ground_truth)
 	// set computed indicator
 	m_computed = true;
 
-	SG_FREE(idxs);
 	return m_auPRC;
 }
 
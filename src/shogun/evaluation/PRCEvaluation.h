@@ -20,6 +20,10 @@ class CLabels;
 /** @brief Class PRCEvaluation used to evaluate PRC
  * (Precision Recall Curve) and an area under PRC curve (auPRC).
  *
+ * The curve has one point per distinct score, examples with tied scores
+ * are added at once. For large numbers of scores see
+ * CBinaryClassEvaluation::set_num_bins() and
+ * CBinaryClassEvaluation::add_scores().
  */
 class CPRCEvaluation: public CBinaryClassEvaluation
 {
@@ -68,6 +72,18 @@ public:
 	 */
 	SGVector<float64_t> get_thresholds();
 
+protected:
+
+	/** compute PRC and auPRC from counts of examples per distinct score
+	 * @param thresholds distinct scores in decreasing order
+	 * @param pos_counts number of positive examples with each score
+	 * @param neg_counts number of negative examples with each score
+	 * @return auPRC
+	 */
+	virtual float64_t evaluate_counts(
+	    SGVector<float64_t> thresholds, SGVector<float64_t> pos_counts,
+	    SGVector<float64_t> neg_counts);
+
 protected:
 
 	/** 2-d array used to store PRC graph */
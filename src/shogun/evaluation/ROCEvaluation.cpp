@@ -34,59 +34,20 @@ float64_t CROCEvaluation::evaluate_roc(CBinaryLabels* predicted, CBinaryLabels*
 {
 	ASSERT(predicted && ground_truth)
 	ASSERT(predicted->get_num_labels()==ground_truth->get_num_labels())
-	ground_truth->ensure_valid();
 
-	// assume threshold as negative infinity
-	float64_t threshold = CMath::ALMOST_NEG_INFTY;
-	// false positive rate
-	float64_t fp = 0.0;
-	// true positive rate
-	float64_t tp=0.0;
-
-	int32_t i;
-	// total number of positive labels in predicted
-	int32_t pos_count=0;
-	int32_t neg_count=0;
-
-	// initialize number of labels and labels
-	SGVector<float64_t> orig_labels(predicted->get_num_labels());
-	int32_t length = orig_labels.vlen;
-	for (i=0; i<length; i++)
-		orig_labels[i] = predicted->get_value(i);
-	float64_t* labels = SGVector<float64_t>::clone_vector(orig_labels.vector, length);
-
-	// get sorted indexes
-	SGVector<int32_t> idxs(length);
-	for(i=0; i<length; i++)
-		idxs[i] = i;
-
-	CMath::qsort_backward_index(labels,idxs.vector,idxs.vlen);
+	return evaluate_batch(predicted, ground_truth);
+}
 
+float64_t CROCEvaluation::evaluate_counts(
+    SGVector<float64_t> thresholds, SGVector<float64_t> pos_counts,
+    SGVector<float64_t> neg_counts)
+{
 	// number of different predicted labels
-	int32_t diff_count=1;
-
-	// get number of different labels
-	for (i=0; i<length-1; i++)
-	{
-		if (labels[i] != labels[i+1])
-			diff_count++;
-	}
-
-	SG_FREE(labels);
-
-	// initialize graph and auROC
-	m_ROC_graph = SGMatrix<float64_t>(2,diff_count+1);
-	m_thresholds = SGVector<float64_t>(length);
-	m_auROC = 0.0;
+	int32_t diff_count = thresholds.vlen;
 
 	// get total numbers of positive and negative labels
-	for(i=0; i<length; i++)
-	{
-		if (ground_truth->get_label(i) >= 0)
-			pos_count++;
-		else
-			neg_count++;
-	}
+	float64_t pos_count = SGVector<float64_t>::sum(pos_counts);
+	float64_t neg_count = SGVector<float64_t>::sum(neg_counts);
 
 	// assure both number of positive and negative examples is >0
 	REQUIRE(pos_count>0, "%s::evaluate_roc(): Number of positive labels is "
@@ -94,33 +55,28 @@ float64_t CROCEvaluation::evaluate_roc(CBinaryLabels* predicted, CBinaryLabels*
 	REQUIRE(neg_count>0, "%s::evaluate_roc(): Number of negative labels is "
 			"zero, ROC fails!\n", get_name());
 
-	int32_t j = 0;
-	float64_t label;
+	// initialize graph, every point gives the rates of examples with
+	// scores greater than its threshold, so that tied scores produce a
+	// single (diagonal) segment
+	m_ROC_graph = SGMatrix<float64_t>(2,diff_count+1);
+	m_thresholds = SGVector<float64_t>(diff_count+1);
 
-	// create ROC curve and calculate auROC
-	for(i=0; i<length; i++)
+	float64_t fp = 0.0;
+	float64_t tp = 0.0;
+	for (int32_t i=0; i<diff_count; i++)
 	{
-		label = predicted->get_value(idxs[i]);
-
-		if (label != threshold)
-		{
-			threshold = label;
-			m_ROC_graph[2*j] = fp/neg_count;
-			m_ROC_graph[2*j+1] = tp/pos_count;
-			j++;
-		}
-
-		m_thresholds[i]=threshold;
-
-		if (ground_truth->get_label(idxs[i]) > 0)
-			tp+=1.0;
-		else
-			fp+=1.0;
+		m_ROC_graph[2*i] = fp/neg_count;
+		m_ROC_graph[2*i+1] = tp/pos_count;
+		m_thresholds[i] = thresholds[i];
+
+		tp += pos_counts[i];
+		fp += neg_counts[i];
 	}
 
 	// add (1,1) to ROC curve
 	m_ROC_graph[2*diff_count] = 1.0;
 	m_ROC_graph[2*diff_count+1] = 1.0;
+	m_thresholds[diff_count] = CMath::ALMOST_NEG_INFTY;
 
 	// calc auROC using area under curve
 	m_auROC = CMath::area_under_curve(m_ROC_graph.matrix,diff_count+1,false);
@@ -25,6 +25,11 @@ class CLabels;
  *
  * Fawcett, Tom (2004) ROC Graphs:
  * Notes and Practical Considerations for Researchers; Machine Learning, 2004
+ *
+ * The graph has one point per distinct score (plus the point (1,1)), tied
+ * scores are handled by a single segment. For large numbers of scores see
+ * CBinaryClassEvaluation::set_num_bins() and
+ * CBinaryClassEvaluation::add_scores().
  */
 class CROCEvaluation: public CBinaryClassEvaluation
 {
@@ -65,7 +70,8 @@ public:
 	 */
 	SGMatrix<float64_t> get_ROC();
 
-	/** get thresholds corresponding to points on the ROC graph
+	/** get thresholds corresponding to points on the ROC graph, each point
+	 * gives the rates of examples with scores greater than its threshold
 	 * @return thresholds
 	 */
 	SGVector<float64_t> get_thresholds();
@@ -79,6 +85,16 @@ protected:
 	 */
 	float64_t evaluate_roc(CBinaryLabels* predicted, CBinaryLabels* ground_truth);
 
+	/** compute ROC and auROC from counts of examples per distinct score
+	 * @param thresholds distinct scores in decreasing order
+	 * @param pos_counts number of positive examples with each score
+	 * @param neg_counts number of negative examples with each score
+	 * @return auROC
+	 */
+	virtual float64_t evaluate_counts(
+	    SGVector<float64_t> thresholds, SGVector<float64_t> pos_counts,
+	    SGVector<float64_t> neg_counts);
+
 protected:
 
 	/** 2-d array used to store ROC graph */
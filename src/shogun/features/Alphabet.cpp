@@ -611,6 +611,14 @@ SGVector<int64_t> CAlphabet::get_histogram()
 	return SGVector<int64_t>(&histogram[0], 1 << (sizeof(uint8_t)*8), false);
 }
 
+void CAlphabet::set_histogram(SGVector<int64_t> hist)
+{
+	REQUIRE(hist.vlen == 1 << (sizeof(uint8_t)*8),
+		"Histogram must have %d entries, not %d.\n",
+		1 << (sizeof(uint8_t)*8), hist.vlen)
+	sg_memcpy(histogram, hist.vector, sizeof(histogram));
+}
+
 bool CAlphabet::check_alphabet(bool print_error)
 {
 	bool result = true;
@@ -200,6 +200,12 @@ class CAlphabet : public CSGObject
 		 */
 		SGVector<int64_t> get_histogram();
 
+		/** set histogram, e.g. to restore a saved one
+		 *
+		 * @param hist histogram with an entry for every byte
+		 */
+		void set_histogram(SGVector<int64_t> hist);
+
 		/** check whether symbols in histogram are valid in alphabet
 		 * e.g. for DNA if only letters ACGT appear
 		 *
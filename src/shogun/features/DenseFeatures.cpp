@@ -120,7 +120,7 @@ template<class ST> void CDenseFeatures<ST>::free_feature_matrix()
 	num_features = 0;
 }
 
-template<class ST> ST* CDenseFeatures<ST>::get_feature_vector(int32_t num, int32_t& len, bool& dofree)
+template<class ST> ST* CDenseFeatures<ST>::get_raw_feature_vector(int32_t num, int32_t& len, bool& dofree)
 {
 	/* index conversion for subset, only for array access */
 	int32_t real_num=m_subset_stack->subset_idx_conversion(num);
@@ -151,31 +151,258 @@ template<class ST> ST* CDenseFeatures<ST>::get_feature_vector(int32_t num, int32
 		}
 	}
 
-	if (get_num_preprocessors())
-	{
-		SGVector<ST> feat_vec(feat, len, false);
+	return feat;
+}
 
-		for (auto i = 0; i < get_num_preprocessors(); i++)
+template<class ST> ST* CDenseFeatures<ST>::get_feature_vector(int32_t num, int32_t& len, bool& dofree)
+{
+	ST* feat = get_raw_feature_vector(num, len, dofree);
+
+	if (!get_num_preprocessors())
+		return feat;
+
+	if (preprocessors_support_inplace())
+	{
+		/* the whole chain runs on a single buffer, which is the computed
+		 * vector if we own it and one copy of the stored vector otherwise */
+		if (!dofree)
 		{
-			auto preprocessor =
-				get_preprocessor(i)->template as<CDensePreprocessor<ST>>();
-			// temporary hack
-			SGVector<ST> applied =
-				preprocessor->apply_to_feature_vector(feat_vec);
-
-			if (i == 0)
-				free_feature_vector(feat_vec.vector, num, dofree);
-			feat_vec = applied;
+			ST* copy = SG_MALLOC(ST, len);
+			sg_memcpy(copy, feat, len * sizeof(ST));
+			free_feature_vector(feat, num, false);
+			feat = copy;
+			dofree = true;
 		}
 
-		feat = SG_MALLOC(ST, feat_vec.vlen);
-		sg_memcpy(feat, feat_vec.vector, feat_vec.vlen * sizeof(ST));
-		dofree = true;
-		len = feat_vec.vlen;
+		len = apply_preprocessors_inplace(feat, len, 1);
+		return feat;
 	}
+
+	SGVector<ST> feat_vec(feat, len, false);
+
+	for (auto i = 0; i < get_num_preprocessors(); i++)
+	{
+		auto preprocessor =
+			get_preprocessor(i)->template as<CDensePreprocessor<ST>>();
+		// temporary hack
+		SGVector<ST> applied =
+			preprocessor->apply_to_feature_vector(feat_vec);
+		SG_UNREF(preprocessor);
+
+		if (i == 0)
+			free_feature_vector(feat_vec.vector, num, dofree);
+		feat_vec = applied;
+	}
+
+	feat = SG_MALLOC(ST, feat_vec.vlen);
+	sg_memcpy(feat, feat_vec.vector, feat_vec.vlen * sizeof(ST));
+	dofree = true;
+	len = feat_vec.vlen;
+
 	return feat;
 }
 
+template<class ST> bool CDenseFeatures<ST>::preprocessors_support_inplace()
+{
+	for (auto i = 0; i < get_num_preprocessors(); i++)
+	{
+		auto preprocessor =
+			get_preprocessor(i)->template as<CDensePreprocessor<ST>>();
+		bool inplace = preprocessor->supports_inplace();
+		SG_UNREF(preprocessor);
+
+		if (!inplace)
+			return false;
+	}
+
+	return true;
+}
+
+/* applies y_j = scale_j * x_{idx_j} + shift_j to all columns of the block,
+ * writing the (possibly shorter) output columns contiguously in place */
+template<class ST> static int32_t apply_affine_inplace(ST* block,
+	int32_t dim, int32_t num_vectors, SGVector<int32_t> idx,
+	SGVector<ST> scale, SGVector<ST> shift, int32_t num_threads)
+{
+	REQUIRE(idx.vlen<=dim && (!idx.vlen || idx[idx.vlen-1]<dim),
+		"Affine preprocessor expects at most %d features\n", dim);
+
+	const int32_t out_dim = idx.vlen;
+
+	/* when the dimension shrinks, output columns overlap input columns
+	 * of the previous vectors, so they have to be written in order */
+	if (out_dim == dim)
+	{
+		#pragma omp parallel for num_threads(num_threads)
+		for (int32_t i = 0; i < num_vectors; i++)
+		{
+			ST* vec = block + int64_t(i) * dim;
+			for (int32_t j = 0; j < out_dim; j++)
+				vec[j] = scale[j] * vec[idx[j]] + shift[j];
+		}
+	}
+	else
+	{
+		for (int32_t i = 0; i < num_vectors; i++)
+		{
+			const ST* src = block + int64_t(i) * dim;
+			ST* dst = block + int64_t(i) * out_dim;
+			for (int32_t j = 0; j < out_dim; j++)
+				dst[j] = scale[j] * src[idx[j]] + shift[j];
+		}
+	}
+
+	return out_dim;
+}
+
+/* replaces the affine map (idx, scale, shift) by its composition with the
+ * affine map (p_idx, p_scale, p_shift) applied after it */
+template<class ST> static void compose_affine(SGVector<int32_t>& idx,
+	SGVector<ST>& scale, SGVector<ST>& shift, SGVector<int32_t> p_idx,
+	SGVector<ST> p_scale, SGVector<ST> p_shift)
+{
+	SGVector<int32_t> c_idx(p_idx.vlen);
+	SGVector<ST> c_scale(p_idx.vlen);
+	SGVector<ST> c_shift(p_idx.vlen);
+	for (auto j = 0; j < p_idx.vlen; j++)
+	{
+		c_idx[j] = idx[p_idx[j]];
+		c_scale[j] = p_scale[j] * scale[p_idx[j]];
+		c_shift[j] = p_scale[j] * shift[p_idx[j]] + p_shift[j];
+	}
+	idx = c_idx;
+	scale = c_scale;
+	shift = c_shift;
+}
+
+/* on booleans, apply_affine_inplace() computes (scale && x) || shift */
+template<> void compose_affine<bool>(SGVector<int32_t>& idx,
+	SGVector<bool>& scale, SGVector<bool>& shift, SGVector<int32_t> p_idx,
+	SGVector<bool> p_scale, SGVector<bool> p_shift)
+{
+	SGVector<int32_t> c_idx(p_idx.vlen);
+	SGVector<bool> c_scale(p_idx.vlen);
+	SGVector<bool> c_shift(p_idx.vlen);
+	for (auto j = 0; j < p_idx.vlen; j++)
+	{
+		c_idx[j] = idx[p_idx[j]];
+		c_scale[j] = p_scale[j] && scale[p_idx[j]];
+		c_shift[j] = (p_scale[j] && shift[p_idx[j]]) || p_shift[j];
+	}
+	idx = c_idx;
+	scale = c_scale;
+	shift = c_shift;
+}
+
+template<class ST> int32_t CDenseFeatures<ST>::apply_preprocessors_inplace(
+	ST* block, int32_t dim, int32_t num_vec)
+{
+	SGVector<int32_t> idx;
+	SGVector<ST> scale;
+	SGVector<ST> shift;
+	bool affine = false;
+
+	for (auto i = 0; i < get_num_preprocessors(); i++)
+	{
+		auto preprocessor =
+			get_preprocessor(i)->template as<CDensePreprocessor<ST>>();
+
+		SGVector<int32_t> p_idx;
+		SGVector<ST> p_scale;
+		SGVector<ST> p_shift;
+
+		/* consecutive affine maps are composed and applied in a single pass,
+		 * which only pays off for more than one vector */
+		if (num_vec > 1 &&
+			preprocessor->get_affine_form(p_idx, p_scale, p_shift))
+		{
+			if (!affine)
+			{
+				idx = p_idx;
+				scale = p_scale;
+				shift = p_shift;
+				affine = true;
+			}
+			else
+			{
+				REQUIRE(p_idx.vlen<=idx.vlen &&
+					(!p_idx.vlen || p_idx[p_idx.vlen-1]<idx.vlen),
+					"%s expects at most %d features\n",
+					preprocessor->get_name(), idx.vlen);
+
+				compose_affine(idx, scale, shift, p_idx, p_scale, p_shift);
+			}
+		}
+		else
+		{
+			if (affine)
+			{
+				dim = apply_affine_inplace(block, dim, num_vec, idx, scale,
+					shift, parallel->get_num_threads());
+				affine = false;
+			}
+
+			SGMatrix<ST> result = preprocessor->apply_to_matrix(
+				SGMatrix<ST>(block, dim, num_vec, false));
+			ASSERT(result.matrix == block)
+			dim = result.num_rows;
+		}
+
+		SG_UNREF(preprocessor);
+	}
+
+	if (affine)
+		dim = apply_affine_inplace(block, dim, num_vec, idx, scale, shift,
+			parallel->get_num_threads());
+
+	return dim;
+}
+
+template<class ST> SGMatrix<ST> CDenseFeatures<ST>::get_preprocessed_feature_vectors(
+	SGVector<index_t> indices)
+{
+	if (get_num_preprocessors() && !preprocessors_support_inplace())
+	{
+		SGMatrix<ST> result;
+		for (auto i = 0; i < indices.vlen; i++)
+		{
+			SGVector<ST> vec = get_feature_vector(indices[i]);
+			if (!result.matrix)
+				result = SGMatrix<ST>(vec.vlen, indices.vlen);
+
+			ASSERT(vec.vlen == result.num_rows)
+			sg_memcpy(result.get_column_vector(i), vec.vector,
+				vec.vlen * sizeof(ST));
+			free_feature_vector(vec, indices[i]);
+		}
+
+		return result;
+	}
+
+	const int32_t dim = get_num_features();
+	SGMatrix<ST> block(dim, indices.vlen);
+
+	for (auto i = 0; i < indices.vlen; i++)
+	{
+		REQUIRE(indices[i]>=0 && indices[i]<get_num_vectors(),
+			"Index out of bounds (number of vectors %d, you requested %d)\n",
+			get_num_vectors(), indices[i]);
+
+		int32_t len;
+		bool dofree;
+		ST* vec = get_raw_feature_vector(indices[i], len, dofree);
+		ASSERT(len == dim)
+		sg_memcpy(block.get_column_vector(i), vec, len * sizeof(ST));
+		free_feature_vector(vec, indices[i], dofree);
+	}
+
+	if (get_num_preprocessors())
+		block.num_rows = apply_preprocessors_inplace(block.matrix, dim,
+			indices.vlen);
+
+	return block;
+}
+
 template<class ST> SGVector<ST> CDenseFeatures<ST>::get_feature_vector(int32_t num)
 {
 	/* index conversion for subset, only for array access */
@@ -215,6 +442,7 @@ template<class ST> void CDenseFeatures<ST>::vector_subset(int32_t* idx, int32_t
 
 	ASSERT(feature_matrix.matrix)
 	ASSERT(idx_len<=num_vectors)
+	feature_matrix.make_unique();
 
 	int32_t num_vec = num_vectors;
 	num_vectors = idx_len;
@@ -246,6 +474,7 @@ template<class ST> void CDenseFeatures<ST>::feature_subset(int32_t* idx, int32_t
 
 	ASSERT(feature_matrix.matrix)
 	ASSERT(idx_len<=num_features)
+	feature_matrix.make_unique();
 	int32_t num_feat = num_features;
 	num_features = idx_len;
 
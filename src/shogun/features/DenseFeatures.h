@@ -134,6 +134,23 @@ public:
 	 */
 	SGVector<ST> get_feature_vector(int32_t num);
 
+	/** get a block of preprocessed feature vectors
+	 *
+	 * If all attached preprocessors support in place application (see
+	 * CDensePreprocessor::supports_inplace()), the raw vectors are copied
+	 * into one matrix and the preprocessor chain is applied to the whole
+	 * block at once, with consecutive affine preprocessors fused into a
+	 * single pass. Otherwise every vector is obtained via
+	 * get_feature_vector(). Keep the returned matrix to reuse the
+	 * transformed block.
+	 *
+	 * possible with subset
+	 *
+	 * @param indices indices of the vectors
+	 * @return preprocessed vectors, one per column
+	 */
+	SGMatrix<ST> get_preprocessed_feature_vectors(SGVector<index_t> indices);
+
 	/** free feature vector
 	 *
 	 * possible with subset
@@ -504,6 +521,31 @@ protected:
 	virtual ST* compute_feature_vector(int32_t num, int32_t& len,
 			ST* target = NULL);
 
+	/** get feature vector num without applying preprocessors
+	 *
+	 * @param num index of feature vector
+	 * @param len length is returned by reference
+	 * @param dofree whether returned vector must be freed by
+	 * caller via free_feature_vector
+	 * @return feature vector
+	 */
+	ST* get_raw_feature_vector(int32_t num, int32_t& len, bool& dofree);
+
+	/** @return whether all attached preprocessors can be applied in place */
+	bool preprocessors_support_inplace();
+
+	/** apply all attached preprocessors in place to a block of vectors,
+	 * which must all support in place application
+	 *
+	 * @param block column-major vectors, the transformed vectors are
+	 * stored contiguously at the beginning of the block
+	 * @param dim number of features of the input vectors
+	 * @param num_vec number of vectors in the block
+	 * @return number of features of the transformed vectors
+	 */
+	int32_t apply_preprocessors_inplace(ST* block, int32_t dim,
+		int32_t num_vec);
+
 	/** free feature matrix and cache
 	 *
 	 * Any subset is removed
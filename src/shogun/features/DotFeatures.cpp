@@ -11,6 +11,7 @@
 #include <shogun/base/progress.h>
 #include <shogun/features/DotFeatures.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/lib/Profiler.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/Time.h>
 #include <shogun/mathematics/Math.h>
@@ -50,6 +51,7 @@ float64_t CDotFeatures::dense_dot_sgvec(int32_t vec_idx1, SGVector<float64_t> ve
 
 void CDotFeatures::dense_dot_range(float64_t* output, int32_t start, int32_t stop, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b)
 {
+	SG_PROFILE_SCOPE("features/dense_dot_range");
 	ASSERT(output)
 	// write access is internally between output[start..stop] so the following
 	// line is necessary to write to output[0...(stop-start-1)]
@@ -3,6 +3,7 @@
 #include <shogun/features/StringFeatures.h>
 #include <shogun/io/MemoryMappedFile.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/lib/Hash.h>
 #include <shogun/lib/SGStringList.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/preprocessor/Preprocessor.h>
@@ -22,9 +23,104 @@
 
 #endif
 
+#include <limits>
+#include <vector>
+
 namespace shogun
 {
 
+namespace
+{
+	/** buffers for decoding packed strings, reused by the thread that
+	 * released them; every buffer is preceded by its capacity
+	 */
+	template <class ST>
+	class PackedStringBuffers
+	{
+	public:
+		~PackedStringBuffers()
+		{
+			for (auto buffer : free_buffers)
+				SG_FREE(get_header(buffer));
+		}
+
+		/** @return buffers of the calling thread */
+		static PackedStringBuffers& instance()
+		{
+			static thread_local PackedStringBuffers buffers;
+			return buffers;
+		}
+
+		/** @return buffer for at least len symbols */
+		ST* acquire(int32_t len)
+		{
+			for (size_t i=0; i<free_buffers.size(); i++)
+			{
+				ST* buffer=free_buffers[i];
+				if (*(int64_t*) get_header(buffer)>=len)
+				{
+					free_buffers[i]=free_buffers.back();
+					free_buffers.pop_back();
+					return buffer;
+				}
+			}
+
+			char* header=SG_MALLOC(char, HEADER_SIZE+sizeof(ST)*CMath::max(len, 1));
+			*(int64_t*) header=len;
+			return (ST*) (header+HEADER_SIZE);
+		}
+
+		/** return a buffer obtained from acquire() */
+		void release(ST* buffer)
+		{
+			if (free_buffers.size()<MAX_FREE_BUFFERS)
+				free_buffers.push_back(buffer);
+			else
+				SG_FREE(get_header(buffer));
+		}
+
+	private:
+		static char* get_header(ST* buffer)
+		{
+			return ((char*) buffer)-HEADER_SIZE;
+		}
+
+		/** keeps the buffers aligned for all symbol types */
+		static const int32_t HEADER_SIZE=16;
+		static const size_t MAX_FREE_BUFFERS=16;
+
+		std::vector<ST*> free_buffers;
+	};
+
+	/** identifies files written by save_packed() */
+	const char PACKED_MAGIC[8]={'S', 'G', 'P', 'A', 'C', 'K', '0', '1'};
+
+	/** header of files written by save_packed(), followed by the histogram
+	 * of the alphabet, the offsets and lengths of the strings and, aligned
+	 * to 8 bytes, the packed words
+	 */
+	struct PackedFileHeader
+	{
+		char magic[8];
+		int32_t alphabet;
+		int32_t packed_bits;
+		int32_t num_vectors;
+		int32_t max_string_length;
+		int64_t num_words;
+	};
+
+	/** number of histogram entries in files written by save_packed() */
+	const int32_t PACKED_HISTOGRAM_SIZE=1 << (sizeof(uint8_t)*8);
+
+	int64_t packed_words_start(int32_t num_vectors)
+	{
+		int64_t start=sizeof(PackedFileHeader)
+			+PACKED_HISTOGRAM_SIZE*sizeof(int64_t)
+			+num_vectors*(sizeof(int64_t)+sizeof(int32_t));
+		return (start+7)/8*8;
+	}
+}
+
 template<class ST> CStringFeatures<ST>::CStringFeatures() : CFeatures(0)
 {
 	init();
@@ -94,6 +190,26 @@ template<class ST> CStringFeatures<ST>::CStringFeatures(const CStringFeatures &
 	alphabet=orig.alphabet;
 	SG_REF(alphabet);
 
+	if (orig.is_packed())
+	{
+		packed_bits=orig.packed_bits;
+		packed_offsets=orig.packed_offsets.clone();
+		packed_lengths=orig.packed_lengths.clone();
+		num_packed_words=orig.num_packed_words;
+		packed_words_capacity=orig.num_packed_words;
+
+		// mapped words are read-only and can be shared
+		packed_file=orig.packed_file;
+		SG_REF(packed_file);
+		if (packed_file)
+			packed_words=orig.packed_words;
+		else
+		{
+			packed_words=SG_MALLOC(uint64_t, num_packed_words);
+			sg_memcpy(packed_words, orig.packed_words, num_packed_words*sizeof(uint64_t));
+		}
+	}
+
 	if (orig.features)
 	{
 		features=SG_MALLOC(SGString<ST>, orig.num_vectors);
@@ -168,6 +284,7 @@ template<class ST> void CStringFeatures<ST>::cleanup()
 	SG_FREE(symbol_mask_table);
 	features=NULL;
 	symbol_mask_table=NULL;
+	cleanup_packed();
 
 	/* start with a fresh alphabet, but instead of emptying the histogram
 	 * create a new object (to leave the alphabet object alone if it is used
@@ -227,9 +344,95 @@ template<class ST> CFeatures* CStringFeatures<ST>::duplicate() const
 	return new CStringFeatures<ST>(*this);
 }
 
+template<class ST> CSGObject* CStringFeatures<ST>::clone()
+{
+	if (is_packed())
+		return clone_unpacked(false);
+
+	return CFeatures::clone();
+}
+
+template<class ST> CSGObject* CStringFeatures<ST>::shallow_clone()
+{
+	if (is_packed())
+		return clone_unpacked(true);
+
+	return CFeatures::shallow_clone();
+}
+
+template<class ST> bool CStringFeatures<ST>::equals(const CSGObject* other) const
+{
+	const CStringFeatures<ST>* other_strings=
+		dynamic_cast<const CStringFeatures<ST>*>(other);
+
+	if (!is_packed() && !(other_strings && other_strings->is_packed()))
+		return CFeatures::equals(other);
+
+	if (!other_strings)
+	{
+		SG_DEBUG("Provided object is no string features of the same type.\n");
+		return false;
+	}
+
+	// packed strings are no parameters, so their unpacked clones are compared
+	CSGObject* own=const_cast<CStringFeatures<ST>*>(this)->clone();
+	CSGObject* given=const_cast<CStringFeatures<ST>*>(other_strings)->clone();
+	bool result=own->equals(given);
+	SG_UNREF(own);
+	SG_UNREF(given);
+
+	return result;
+}
+
+template<class ST> CSGObject* CStringFeatures<ST>::clone_unpacked(bool share)
+{
+	// the features parameter holds the decoded strings while cloning
+	features=decode_packed_strings();
+
+	CSGObject* result=NULL;
+	try
+	{
+		result=share ? CFeatures::shallow_clone() : CFeatures::clone();
+	}
+	catch (...)
+	{
+		free_decoded_strings();
+		throw;
+	}
+	free_decoded_strings();
+
+	return result;
+}
+
+template<class ST> void CStringFeatures<ST>::save_serializable_pre() throw (ShogunException)
+{
+	CFeatures::save_serializable_pre();
+
+	// packed strings are saved as unpacked strings
+	if (is_packed())
+		features=decode_packed_strings();
+}
+
+template<class ST> void CStringFeatures<ST>::save_serializable_post() throw (ShogunException)
+{
+	CFeatures::save_serializable_post();
+
+	if (is_packed())
+		free_decoded_strings();
+}
+
+template<class ST> void CStringFeatures<ST>::load_serializable_pre() throw (ShogunException)
+{
+	CFeatures::load_serializable_pre();
+
+	// the loaded strings replace any packed strings
+	if (is_packed())
+		cleanup_packed();
+}
+
 template<class ST> SGVector<ST> CStringFeatures<ST>::get_feature_vector(int32_t num)
 {
-	ASSERT(features)
+	ASSERT(features || is_packed())
 	if (num>=get_num_vectors())
 	{
 		SG_ERROR("Index out of bounds (number of strings %d, you "
@@ -247,6 +450,7 @@ template<class ST> SGVector<ST> CStringFeatures<ST>::get_feature_vector(int32_t
 
 template<class ST> void CStringFeatures<ST>::set_feature_vector(SGVector<ST> vector, int32_t num)
 {
+	REQUIRE(!is_packed(), "Cannot set feature vector of packed strings, unpack them first.\n")
 	ASSERT(features)
 
 	if (m_subset_stack->has_subsets())
@@ -281,13 +485,22 @@ template<class ST> void CStringFeatures<ST>::disable_on_the_fly_preprocessing()
 
 template<class ST> ST* CStringFeatures<ST>::get_feature_vector(int32_t num, int32_t& len, bool& dofree)
 {
-	ASSERT(features)
+	ASSERT(features || is_packed())
 	if (num>=get_num_vectors())
 		SG_ERROR("Requested feature vector with index %d while total num is", num, get_num_vectors())
 
 	int32_t real_num=m_subset_stack->subset_idx_conversion(num);
 
-	if (!preprocess_on_get)
+	if (!preprocess_on_get && is_packed())
+	{
+		// decode into a buffer of this thread, returned by free_feature_vector()
+		len=packed_lengths[real_num];
+		ST* feat=PackedStringBuffers<ST>::instance().acquire(len);
+		decode_packed_vector(num, feat);
+		dofree=true;
+		return feat;
+	}
+	else if (!preprocess_on_get)
 	{
 		dofree=false;
 		len=features[real_num].slen;
@@ -376,7 +589,12 @@ template<class ST> void CStringFeatures<ST>::free_feature_vector(ST* feat_vec, i
 		feature_cache->unlock_entry(real_num);
 
 	if (dofree)
-		SG_FREE(feat_vec);
+	{
+		if (!preprocess_on_get && is_packed())
+			PackedStringBuffers<ST>::instance().release(feat_vec);
+		else
+			SG_FREE(feat_vec);
+	}
 }
 
 template<class ST> void CStringFeatures<ST>::free_feature_vector(SGVector<ST> feat_vec, int32_t num)
@@ -412,6 +630,9 @@ template<class ST> int32_t CStringFeatures<ST>::get_vector_length(int32_t vec_nu
 {
 	ASSERT(vec_num<get_num_vectors())
 
+	if (is_packed() && !preprocess_on_get)
+		return packed_lengths[m_subset_stack->subset_idx_conversion(vec_num)];
+
 	int32_t len;
 	bool free_vec;
 	ST* vec=get_feature_vector(vec_num, len, free_vec);
@@ -603,9 +824,11 @@ template<class ST> void CStringFeatures<ST>::load_ascii_file(char* fname, bool r
 	num_symbols=alphabet->get_num_symbols();
 }
 
-template<class ST> bool CStringFeatures<ST>::load_fasta_file(const char* fname, bool ignore_invalid)
+template<class ST> bool CStringFeatures<ST>::load_fasta_file(const char* fname, bool ignore_invalid,
+		bool packed)
 {
 	remove_all_subsets();
+	REQUIRE(!packed || sizeof(ST)==1, "Only strings of bytes can be packed.\n")
 
 	int32_t i=0;
 	uint64_t len=0;
@@ -631,11 +854,19 @@ template<class ST> bool CStringFeatures<ST>::load_fasta_file(const char* fname,
 	cleanup();
 	SG_UNREF(alphabet);
 	alphabet=new CAlphabet(DNA);
+	SG_REF(alphabet);
 	num_symbols=alphabet->get_num_symbols();
 
 	SGString<ST>* strings=SG_MALLOC(SGString<ST>, num);
 	offs=0;
 
+	if (packed)
+	{
+		packed_bits=alphabet->get_num_bits();
+		packed_offsets=SGVector<int64_t>(num);
+		packed_lengths=SGVector<int32_t>(num);
+	}
+
 	for (i=0;i<num; i++)
 	{
 		uint64_t id_len=0;
@@ -684,6 +915,22 @@ template<class ST> bool CStringFeatures<ST>::load_fasta_file(const char* fname,
 				}
 				max_len=CMath::max(max_len, strings[i].slen);
 
+				if (packed)
+				{
+					alphabet->add_string_to_histogram(str, len);
+					if (!append_packed_string(i, str, len))
+					{
+						SG_FREE(str);
+						for (int32_t k=0; k<i; k++)
+							SG_FREE(strings[k].string);
+						SG_FREE(strings);
+						cleanup_packed();
+						SG_ERROR("Invalid symbol in fasta entry %d, set ignore_invalid"
+								" to convert invalid symbols to 'A'.\n", i)
+					}
+					SG_FREE(str);
+					strings[i].string=NULL;
+				}
 
 				break;
 			}
@@ -693,6 +940,15 @@ template<class ST> bool CStringFeatures<ST>::load_fasta_file(const char* fname,
 			s=f.get_line(len, offs);
 		}
 	}
+
+	if (packed)
+	{
+		SG_FREE(strings);
+		num_vectors=num;
+		max_string_length=max_len;
+		return true;
+	}
+
 	return set_features(strings, num, max_len);
 }
 
@@ -951,6 +1207,9 @@ template<class ST> bool CStringFeatures<ST>::append_features(CStringFeatures<ST>
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("Cannot call set_features() with subset.\n")
 
+	REQUIRE(!is_packed() && !sf->is_packed(),
+			"Cannot append packed strings, unpack them first.\n")
+
 	SGString<ST>* new_features=SG_MALLOC(SGString<ST>, sf->get_num_vectors());
 
 	index_t sf_num_str=sf->get_num_vectors();
@@ -968,6 +1227,8 @@ template<class ST> bool CStringFeatures<ST>::append_features(CStringFeatures<ST>
 
 template<class ST> bool CStringFeatures<ST>::append_features(SGString<ST>* p_features, int32_t p_num_vectors, int32_t p_max_string_length)
 {
+	REQUIRE(!is_packed(), "Cannot append to packed strings, unpack them first.\n")
+
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("Cannot call set_features() with subset.\n")
 
@@ -1032,6 +1293,9 @@ template<class ST> SGString<ST>* CStringFeatures<ST>::get_features(int32_t& num_
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("get features() is not possible on subset")
 
+	REQUIRE(!is_packed(), "get_features() is not possible on packed strings,"
+			" use copy_features() or unpack them first.\n")
+
 	num_str=num_vectors;
 	max_str_len=max_string_length;
 	return features;
@@ -1222,8 +1486,308 @@ template<class ST> bool CStringFeatures<ST>::save_compressed(char* dest, E_COMPR
 	return true;
 }
 
+template<class ST> bool CStringFeatures<ST>::pack()
+{
+	if (m_subset_stack->has_subsets())
+		SG_ERROR("pack() is not possible on subset")
+
+	if (is_packed())
+		return true;
+
+	int32_t bits=alphabet->get_num_bits();
+	if (sizeof(ST)!=1 || single_string || !features || bits<=0 || bits>=8)
+		return false;
+
+	packed_bits=bits;
+	packed_offsets=SGVector<int64_t>(num_vectors);
+	packed_lengths=SGVector<int32_t>(num_vectors);
+
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		if (!append_packed_string(i, features[i].string, features[i].slen))
+		{
+			SG_DEBUG("Invalid symbol in string %d, not packing\n", i)
+			cleanup_packed();
+			return false;
+		}
+	}
+
+	for (int32_t i=0; i<num_vectors; i++)
+		SG_FREE(features[i].string);
+	SG_FREE(features);
+	features=NULL;
+
+	SG_DEBUG("Packed %d strings into %ld words\n", num_vectors, num_packed_words)
+	return true;
+}
+
+template<class ST> void CStringFeatures<ST>::unpack()
+{
+	if (!is_packed())
+		return;
+
+	if (m_subset_stack->has_subsets())
+		SG_ERROR("unpack() is not possible on subset")
+
+	SGString<ST>* strings=decode_packed_strings();
+	cleanup_packed();
+	features=strings;
+}
+
+template<class ST> SGString<ST>* CStringFeatures<ST>::decode_packed_strings() const
+{
+	SGString<ST>* strings=SG_MALLOC(SGString<ST>, num_vectors);
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		strings[i].slen=packed_lengths[i];
+		strings[i].string=SG_MALLOC(ST, strings[i].slen);
+		decode_packed_string(i, strings[i].string, true);
+	}
+
+	return strings;
+}
+
+template<class ST> void CStringFeatures<ST>::free_decoded_strings()
+{
+	ASSERT(is_packed())
+
+	if (features)
+	{
+		for (int32_t i=0; i<num_vectors; i++)
+			SG_FREE(features[i].string);
+		SG_FREE(features);
+		features=NULL;
+	}
+}
+
+template<class ST> const uint64_t* CStringFeatures<ST>::get_packed_vector(int32_t num, int32_t& len) const
+{
+	REQUIRE(is_packed(), "Strings are not packed.\n")
+	ASSERT(num<get_num_vectors())
+
+	int32_t real_num=m_subset_stack->subset_idx_conversion(num);
+	len=packed_lengths[real_num];
+	return packed_words+packed_offsets[real_num];
+}
+
+template<class ST> void CStringFeatures<ST>::decode_packed_vector(int32_t num, ST* target, bool to_char) const
+{
+	REQUIRE(is_packed(), "Strings are not packed.\n")
+	ASSERT(num<get_num_vectors())
+
+	decode_packed_string(m_subset_stack->subset_idx_conversion(num), target, to_char);
+}
+
+template<class ST> void CStringFeatures<ST>::decode_packed_string(int32_t real_num, ST* target, bool to_char) const
+{
+	int32_t len=packed_lengths[real_num];
+	const uint64_t* words=packed_words+packed_offsets[real_num];
+	const int32_t symbols_per_word=get_symbols_per_packed_word();
+	const uint64_t mask=(((uint64_t) 1) << packed_bits)-1;
+
+	for (int32_t i=0; i<len; i+=symbols_per_word)
+	{
+		uint64_t word=words[i/symbols_per_word];
+		int32_t end=CMath::min(len, i+symbols_per_word);
+
+		for (int32_t j=i; j<end; j++, word>>=packed_bits)
+		{
+			uint8_t code=(uint8_t) (word & mask);
+			target[j]=to_char ? (ST) alphabet->remap_to_char(code) : (ST) code;
+		}
+	}
+}
+
+template<class ST> bool CStringFeatures<ST>::append_packed_string(int32_t num, const ST* string, int32_t len)
+{
+	ASSERT(!packed_file)
+
+	const int32_t symbols_per_word=get_symbols_per_packed_word();
+	int64_t len_words=(len+symbols_per_word-1)/symbols_per_word;
+
+	if (num_packed_words+len_words>packed_words_capacity)
+	{
+		int64_t capacity=CMath::max(2*packed_words_capacity,
+				num_packed_words+len_words);
+		packed_words=SG_REALLOC(uint64_t, packed_words, packed_words_capacity, capacity);
+		packed_words_capacity=capacity;
+	}
+
+	uint64_t* words=packed_words+num_packed_words;
+	memset(words, 0, len_words*sizeof(uint64_t));
+
+	for (int32_t i=0; i<len; i++)
+	{
+		uint8_t c=(uint8_t) string[i];
+		if (!alphabet->is_valid(c))
+			return false;
+
+		words[i/symbols_per_word]|=((uint64_t) alphabet->remap_to_bin(c))
+			<< ((i%symbols_per_word)*packed_bits);
+	}
+
+	packed_offsets[num]=num_packed_words;
+	packed_lengths[num]=len;
+	num_packed_words+=len_words;
+
+	return true;
+}
+
+template<class ST> void CStringFeatures<ST>::cleanup_packed()
+{
+	if (packed_file)
+	{
+		SG_UNREF(packed_file);
+	}
+	else
+		SG_FREE(packed_words);
+
+	packed_bits=0;
+	packed_words=NULL;
+	num_packed_words=0;
+	packed_words_capacity=0;
+	packed_offsets=SGVector<int64_t>();
+	packed_lengths=SGVector<int32_t>();
+}
+
+template<class ST> bool CStringFeatures<ST>::save_packed(const char* fname)
+{
+	if (m_subset_stack->has_subsets())
+		SG_ERROR("save_packed() is not possible on subset")
+
+	REQUIRE(is_packed(), "Strings are not packed, call pack() first.\n")
+
+	FILE* file=NULL;
+
+	if (!(file=fopen(fname, "wb")))
+		return false;
+
+	PackedFileHeader header;
+	sg_memcpy(header.magic, PACKED_MAGIC, sizeof(PACKED_MAGIC));
+	header.alphabet=alphabet->get_alphabet();
+	header.packed_bits=packed_bits;
+	header.num_vectors=num_vectors;
+	header.max_string_length=max_string_length;
+	header.num_words=num_packed_words;
+
+	SGVector<int64_t> histogram=alphabet->get_histogram();
+	ASSERT(histogram.vlen==PACKED_HISTOGRAM_SIZE)
+
+	// pad to the words, so that they are aligned when mapped
+	const uint8_t padding[8]={0};
+	size_t padding_len=packed_words_start(num_vectors)-sizeof(header)
+		-PACKED_HISTOGRAM_SIZE*sizeof(int64_t)
+		-num_vectors*(sizeof(int64_t)+sizeof(int32_t));
+
+	bool success=
+		fwrite(&header, sizeof(header), 1, file)==1 &&
+		fwrite(histogram.vector, sizeof(int64_t), histogram.vlen, file)==size_t(histogram.vlen) &&
+		fwrite(packed_offsets.vector, sizeof(int64_t), num_vectors, file)==size_t(num_vectors) &&
+		fwrite(packed_lengths.vector, sizeof(int32_t), num_vectors, file)==size_t(num_vectors) &&
+		fwrite(padding, sizeof(uint8_t), padding_len, file)==padding_len &&
+		fwrite(packed_words, sizeof(uint64_t), num_packed_words, file)==size_t(num_packed_words);
+
+	fclose(file);
+	return success;
+}
+
+template<class ST> bool CStringFeatures<ST>::load_packed(const char* fname)
+{
+	remove_all_subsets();
+
+	CMemoryMappedFile<char>* file=new CMemoryMappedFile<char>(fname);
+	SG_REF(file);
+
+	char* map=file->get_map();
+	PackedFileHeader header;
+
+	if (file->get_size()<sizeof(header))
+	{
+		SG_UNREF(file);
+		SG_ERROR("File %s is too small to hold packed strings\n", fname)
+	}
+
+	sg_memcpy(&header, map, sizeof(header));
+	if (memcmp(header.magic, PACKED_MAGIC, sizeof(PACKED_MAGIC)) ||
+			header.num_vectors<0 || header.num_words<0 ||
+			header.max_string_length<0 ||
+			header.packed_bits<=0 || header.packed_bits>64)
+	{
+		SG_UNREF(file);
+		SG_ERROR("File %s does not contain packed strings\n", fname)
+	}
+
+	int64_t words_start=packed_words_start(header.num_vectors);
+	if (file->get_size()<uint64_t(words_start) ||
+			uint64_t(header.num_words)>(file->get_size()-words_start)/sizeof(uint64_t))
+	{
+		SG_UNREF(file);
+		SG_ERROR("File %s is truncated\n", fname)
+	}
+
+	CAlphabet* packed_alphabet=new CAlphabet((EAlphabet) header.alphabet);
+	SG_REF(packed_alphabet);
+
+	if (packed_alphabet->get_num_bits()!=header.packed_bits)
+	{
+		int32_t num_bits=packed_alphabet->get_num_bits();
+		SG_UNREF(packed_alphabet);
+		SG_UNREF(file);
+		SG_ERROR("File %s has %d bits per symbol, but the alphabet needs %d\n",
+				fname, header.packed_bits, num_bits)
+	}
+
+	// offsets and lengths are used in place, so every string has to lie
+	// within the mapped words
+	char* histogram=map+sizeof(header);
+	char* offsets=histogram+PACKED_HISTOGRAM_SIZE*sizeof(int64_t);
+	char* lengths=offsets+header.num_vectors*sizeof(int64_t);
+	const int64_t* string_offsets=(const int64_t*) offsets;
+	const int32_t* string_lengths=(const int32_t*) lengths;
+	const int32_t symbols_per_word=64/header.packed_bits;
+	for (int32_t i=0; i<header.num_vectors; i++)
+	{
+		int32_t len=string_lengths[i];
+		int64_t offset=string_offsets[i];
+		if (len<0 || len>header.max_string_length || offset<0 ||
+				offset>header.num_words-(int64_t(len)+symbols_per_word-1)/symbols_per_word)
+		{
+			SG_UNREF(packed_alphabet);
+			SG_UNREF(file);
+			SG_ERROR("File %s has an invalid offset (%ld) or length (%d) for "
+					"string %d of %ld words\n", fname, offset, len, i,
+					header.num_words)
+		}
+	}
+
+	cleanup();
+	SG_UNREF(alphabet);
+	alphabet=packed_alphabet;
+
+	// the histogram is needed by obtain_from_char()
+	SGVector<int64_t> hist(PACKED_HISTOGRAM_SIZE);
+	sg_memcpy(hist.vector, histogram, PACKED_HISTOGRAM_SIZE*sizeof(int64_t));
+	alphabet->set_histogram(hist);
+	num_symbols=alphabet->get_num_symbols();
+
+	packed_offsets=SGVector<int64_t>((int64_t*) offsets, header.num_vectors, false);
+	packed_lengths=SGVector<int32_t>((int32_t*) lengths, header.num_vectors, false);
+	packed_words=(uint64_t*) (map+words_start);
+	num_packed_words=header.num_words;
+	packed_words_capacity=header.num_words;
+	packed_file=file;
+	packed_bits=header.packed_bits;
+
+	num_vectors=header.num_vectors;
+	max_string_length=header.max_string_length;
+
+	return true;
+}
+
 template<class ST> int32_t CStringFeatures<ST>::obtain_by_sliding_window(int32_t window_size, int32_t step_size, int32_t skip)
 {
+	REQUIRE(!is_packed(), "Cannot slide a window over packed strings, unpack them first.\n")
+
 	if (m_subset_stack->has_subsets())
 		SG_NOTIMPLEMENTED
 
@@ -1262,6 +1826,8 @@ template<class ST> int32_t CStringFeatures<ST>::obtain_by_sliding_window(int32_t
 template<class ST> int32_t CStringFeatures<ST>::obtain_by_position_list(int32_t window_size, CDynamicArray<int32_t>* positions,
 		int32_t skip)
 {
+	REQUIRE(!is_packed(), "Cannot obtain windows from packed strings, unpack them first.\n")
+
 	if (m_subset_stack->has_subsets())
 		SG_NOTIMPLEMENTED
 
@@ -1322,6 +1888,69 @@ template<class ST> bool CStringFeatures<ST>::obtain_from_char(CStringFeatures<ch
 	return obtain_from_char_features(sf, start, p_order, gap, rev);
 }
 
+template<class ST> bool CStringFeatures<ST>::obtain_hashed_from_char(CStringFeatures<char>* sf, int32_t p_order)
+{
+	REQUIRE(std::numeric_limits<ST>::is_integer && sizeof(ST)>1,
+			"Hashed k-mers need integer words of at least 16 bits.\n")
+	REQUIRE(p_order>0, "Order (%d) must be positive.\n", p_order)
+	remove_all_subsets();
+	ASSERT(sf)
+
+	CAlphabet* alpha=sf->get_alphabet();
+	ASSERT(alpha->get_num_symbols_in_histogram() > 0)
+
+	order=p_order;
+	cleanup();
+
+	num_vectors=sf->get_num_vectors();
+	ASSERT(num_vectors>0)
+	features=SG_MALLOC(SGString<ST>, num_vectors);
+
+	/* two independent 32 bit hashes for 64 bit words */
+	const uint32_t seed=0xdeadbeaf;
+	const uint64_t mask=sizeof(ST)>=sizeof(uint64_t) ?
+		~((uint64_t) 0) : (((uint64_t) 1) << (sizeof(ST)*8))-1;
+
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		int32_t len=sf->get_vector_length(i);
+		SGVector<uint8_t> codes(CMath::max(len, 1));
+		if (sf->is_packed())
+		{
+			SGVector<char> packed_codes(CMath::max(len, 1));
+			sf->decode_packed_vector(i, packed_codes.vector, false);
+			for (int32_t j=0; j<len; j++)
+				codes[j]=(uint8_t) packed_codes[j];
+		}
+		else
+		{
+			SGVector<char> vec=sf->get_feature_vector(i);
+			for (int32_t j=0; j<len; j++)
+				codes[j]=alpha->remap_to_bin((uint8_t) vec[j]);
+		}
+
+		int32_t num_kmers=CMath::max(len-p_order+1, 0);
+		features[i].string=SG_MALLOC(ST, num_kmers);
+		features[i].slen=num_kmers;
+
+		for (int32_t j=0; j<num_kmers; j++)
+		{
+			uint64_t hash=CHash::MurmurHash3(&codes[j], p_order, seed);
+			if (sizeof(ST)>sizeof(uint32_t))
+				hash|=((uint64_t) CHash::MurmurHash3(&codes[j], p_order, ~seed)) << 32;
+			features[i].string[j]=(ST) (hash & mask);
+		}
+	}
+
+	determine_maximum_string_length();
+	original_num_symbols=alpha->get_num_symbols();
+	num_symbols=CMath::powl((floatmax_t) 2, (floatmax_t) sizeof(ST)*8);
+	SG_UNREF(alpha);
+
+	return true;
+}
+
 template<class ST> bool CStringFeatures<ST>::have_same_length(int32_t len)
 {
 	if (len!=-1)
@@ -1343,6 +1972,8 @@ template<class ST> bool CStringFeatures<ST>::have_same_length(int32_t len)
 
 template<class ST> void CStringFeatures<ST>::embed_features(int32_t p_order)
 {
+	REQUIRE(!is_packed(), "Cannot embed packed strings, unpack them first.\n")
+
 	if (m_subset_stack->has_subsets())
 		SG_NOTIMPLEMENTED
 
@@ -1457,6 +2088,16 @@ template<class ST> void CStringFeatures<ST>::determine_maximum_string_length()
 	max_string_length=0;
 	index_t num_str=get_num_vectors();
 
+	if (is_packed())
+	{
+		for (int32_t i=0; i<num_str; i++)
+		{
+			max_string_length=CMath::max(max_string_length,
+				packed_lengths[m_subset_stack->subset_idx_conversion(i)]);
+		}
+		return;
+	}
+
 	for (int32_t i=0; i<num_str; i++)
 	{
 		max_string_length=CMath::max(max_string_length,
@@ -1475,6 +2116,7 @@ template<class ST> ST* CStringFeatures<ST>::get_zero_terminated_string_copy(SGSt
 
 template<class ST> void CStringFeatures<ST>::set_feature_vector(int32_t num, ST* string, int32_t len)
 {
+	REQUIRE(!is_packed(), "Cannot set feature vector of packed strings, unpack them first.\n")
 	ASSERT(features)
 	ASSERT(num<get_num_vectors())
 
@@ -1644,6 +2286,14 @@ template<class ST> CFeatures* CStringFeatures<ST>::copy_subset(
 		index_t real_idx=m_subset_stack->subset_idx_conversion(indices.vector[i]);
 
 		/* copy string */
+		if (is_packed())
+		{
+			SGString<ST> string_copy(packed_lengths[real_idx]);
+			decode_packed_vector(indices.vector[i], string_copy.string);
+			list_copy.strings[i]=string_copy;
+			continue;
+		}
+
 		SGString<ST> current_string=features[real_idx];
 		SGString<ST> string_copy(current_string.slen);
 		sg_memcpy(string_copy.string, current_string.string,
@@ -1654,6 +2304,10 @@ template<class ST> CFeatures* CStringFeatures<ST>::copy_subset(
 	/* create copy instance */
 	CStringFeatures* result=new CStringFeatures(list_copy, alphabet);
 
+	/* the copy is packed as well, symbols were valid before */
+	if (is_packed())
+		result->pack();
+
 	/* max string length may have changed */
 	result->determine_maximum_string_length();
 
@@ -1674,10 +2328,21 @@ template<class ST> void CStringFeatures<ST>::subset_changed_post()
 
 template<class ST> ST* CStringFeatures<ST>::compute_feature_vector(int32_t num, int32_t& len)
 {
-	ASSERT(features && num<get_num_vectors())
+	ASSERT((features || is_packed()) && num<get_num_vectors())
 
 	int32_t real_num=m_subset_stack->subset_idx_conversion(num);
 
+	if (is_packed())
+	{
+		len=packed_lengths[real_num];
+		if (len<=0)
+			return NULL;
+
+		ST* target=SG_MALLOC(ST, len);
+		decode_packed_vector(num, target);
+		return target;
+	}
+
 	len=features[real_num].slen;
 	if (len<=0)
 		return NULL;
@@ -1704,6 +2369,11 @@ template<class ST> void CStringFeatures<ST>::init()
 	symbol_mask_table_len=0;
 	num_symbols=0.0;
 	original_num_symbols=0;
+	packed_bits=0;
+	packed_words=NULL;
+	num_packed_words=0;
+	packed_words_capacity=0;
+	packed_file=NULL;
 
 	SG_ADD(&alphabet, "alphabet", "Alphabet used.");
 
@@ -1983,6 +2653,8 @@ template<> void CStringFeatures<sg_type>::save(CFile* writer)		\
 {																			\
 	if (m_subset_stack->has_subsets())															\
 		SG_ERROR("save() is not possible on subset")						\
+	REQUIRE(!is_packed(), "save() is not possible on packed strings,"		\
+			" use save_packed() or unpack them first.\n")						\
 	SG_SET_LOCALE_C;													\
 	ASSERT(writer)															\
 	writer->f_write(features, num_vectors);									\
@@ -2025,12 +2697,31 @@ bool CStringFeatures<ST>::obtain_from_char_features(CStringFeatures<CT>* sf, int
 	SG_DEBUG("%1.0llf symbols in StringFeatures<*> %d symbols in histogram\n", sf->get_num_symbols(),
 			alpha->get_num_symbols_in_histogram());
 
+	// strings are mapped independently, decoding packed strings uses
+	// buffers of the calling thread
+	bool preprocessed=false;
+	#pragma omp parallel for schedule(dynamic, 64) reduction(||:preprocessed) \
+		num_threads(parallel->get_num_threads())
 	for (int32_t i=0; i<num_vectors; i++)
 	{
+		if (sf->is_packed())
+		{
+			// packed strings already hold the codes of the symbols
+			int32_t len=sf->get_vector_length(i);
+			features[i].string=SG_MALLOC(ST, len);
+			features[i].slen=len;
+
+			CT* codes=SG_MALLOC(CT, len);
+			sf->decode_packed_vector(i, codes, false);
+			for (int32_t j=0; j<len; j++)
+				features[i].string[j]=(ST) codes[j];
+			SG_FREE(codes);
+			continue;
+		}
+
 		int32_t len=-1;
 		bool vfree;
 		CT* c=sf->get_feature_vector(i, len, vfree);
-		ASSERT(!vfree) // won't work when preprocessors are attached
 
 		features[i].string=SG_MALLOC(ST, len);
 		features[i].slen=len;
@@ -2038,7 +2729,14 @@ bool CStringFeatures<ST>::obtain_from_char_features(CStringFeatures<CT>* sf, int
 		ST* str=features[i].string;
 		for (int32_t j=0; j<len; j++)
 			str[j]=(ST) alpha->remap_to_bin(c[j]);
+
+		if (vfree)
+		{
+			preprocessed=true;
+			sf->free_feature_vector(c, i, vfree);
+		}
 	}
+	ASSERT(!preprocessed) // won't work when preprocessors are attached
 
 	original_num_symbols=alpha->get_num_symbols();
 	int32_t max_val=alpha->get_num_bits();
@@ -2058,12 +2756,11 @@ bool CStringFeatures<ST>::obtain_from_char_features(CStringFeatures<CT>* sf, int
 	}
 
 	SG_DEBUG("translate: start=%i order=%i gap=%i(size:%i)\n", start, p_order, gap, sizeof(ST))
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(parallel->get_num_threads())
 	for (int32_t line=0; line<num_vectors; line++)
 	{
-		int32_t len=0;
-		bool vfree;
-		ST* fv=get_feature_vector(line, len, vfree);
-		ASSERT(!vfree) // won't work when preprocessors are attached
+		int32_t len=features[line].slen;
+		ST* fv=features[line].string;
 
 		if (rev)
 			CAlphabet::translate_from_single_order_reversed(fv, len, start+gap, p_order+gap, max_val, gap);
@@ -16,6 +16,7 @@
 #include <shogun/lib/DynamicArray.h>
 #include <shogun/lib/Compressor.h>
 #include <shogun/io/File.h>
+#include <shogun/io/MemoryMappedFile.h>
 
 #include <shogun/features/Features.h>
 #include <shogun/features/Alphabet.h>
@@ -165,6 +166,28 @@ template <class ST> class CStringFeatures : public CFeatures
 		 */
 		virtual CFeatures* duplicate() const;
 
+		/** clone string features, packed strings are cloned as unpacked
+		 * strings
+		 *
+		 * @return cloned features
+		 */
+		virtual CSGObject* clone();
+
+		/** shallow clone string features, packed strings are cloned as
+		 * unpacked strings
+		 *
+		 * @return cloned features
+		 */
+		virtual CSGObject* shallow_clone();
+
+		/** compare with another object, packed strings are equal to the
+		 * unpacked strings they encode
+		 *
+		 * @param other object to compare with
+		 * @return whether the objects are equal
+		 */
+		virtual bool equals(const CSGObject* other) const;
+
 		/** get string for selected example num
 		 *
 		 * possible with subset
@@ -356,9 +379,13 @@ template <class ST> class CStringFeatures : public CFeatures
 		 *
 		 * @param fname filename to load from
 		 * @param ignore_invalid if set to true, characters other than A,C,G,T are converted to A
+		 * @param packed if set to true, every sequence is packed right after
+		 * it was read, so that the unpacked sequences never need to fit
+		 * into memory at once, see pack()
 		 * @return if loading was successful
 		 */
-		bool load_fasta_file(const char* fname, bool ignore_invalid=false);
+		bool load_fasta_file(const char* fname, bool ignore_invalid=false,
+				bool packed=false);
 
 		/** load fastq file as string features
 		 *
@@ -488,6 +515,81 @@ template <class ST> class CStringFeatures : public CFeatures
 		 */
 		virtual bool save_compressed(char* dest, E_COMPRESSION_TYPE compression, int level);
 
+		/** pack the strings in memory, with as many bits per symbol as the
+		 * alphabet needs, e.g. 2 bits for DNA and 5 bits for PROTEIN
+		 *
+		 * The symbols of every string are mapped to their codes in the
+		 * alphabet (see CAlphabet::remap_to_bin) and stored in 64 bit words,
+		 * starting with the lowest bits; every string starts with a new word.
+		 * get_feature_vector() decodes the strings on the fly into buffers
+		 * that are reused by the calling thread, while kernels and
+		 * obtain_from_char() can read the packed words directly.
+		 *
+		 * Packed strings are read-only, methods that modify strings in place
+		 * require them to be unpacked first. Not possible with subset.
+		 *
+		 * @return if packing was successful, i.e. the alphabet needs less
+		 * than 8 bits and all symbols are valid
+		 */
+		bool pack();
+
+		/** unpack packed strings */
+		void unpack();
+
+		/** @return whether the strings are packed */
+		bool is_packed() const { return packed_bits>0; }
+
+		/** @return bits per symbol of the packed strings, 0 if not packed */
+		int32_t get_packed_bits() const { return packed_bits; }
+
+		/** get the packed words of a string
+		 *
+		 * possible with subset
+		 *
+		 * @param num index of the string
+		 * @param len length of the string in symbols (returned via reference)
+		 * @return words of the string, get_symbols_per_packed_word() symbols
+		 * per word
+		 */
+		const uint64_t* get_packed_vector(int32_t num, int32_t& len) const;
+
+		/** @return number of symbols per packed word */
+		int32_t get_symbols_per_packed_word() const
+		{
+			return packed_bits>0 ? 64/packed_bits : 0;
+		}
+
+		/** decode a packed string
+		 *
+		 * possible with subset
+		 *
+		 * @param num index of the string
+		 * @param target buffer for at least get_vector_length(num) symbols
+		 * @param to_char whether to map the codes back to symbols of the
+		 * alphabet, or to keep the codes
+		 */
+		void decode_packed_vector(int32_t num, ST* target, bool to_char=true) const;
+
+		/** save the packed strings to a file that load_packed() can map
+		 * into memory
+		 *
+		 * not possible with subset
+		 *
+		 * @param fname filename to save to
+		 * @return if saving was successful
+		 */
+		bool save_packed(const char* fname);
+
+		/** load packed strings saved by save_packed(), the words are mapped
+		 * into memory instead of being read
+		 *
+		 * any subset is removed before
+		 *
+		 * @param fname filename to load from
+		 * @return if loading was successful
+		 */
+		bool load_packed(const char* fname);
+
 		/** slides a window of size window_size over the current single string
 		 * step_size is the amount by which the window is shifted.
 		 * creates (string_len-window_size)/step_size many feature obj
@@ -531,6 +633,23 @@ template <class ST> class CStringFeatures : public CFeatures
 		bool obtain_from_char(CStringFeatures<char>* sf, int32_t start,
 				int32_t p_order, int32_t gap, bool rev);
 
+		/** obtain hashed k-mers from char features
+		 *
+		 * for k-mers that are too long to be embedded with
+		 * obtain_from_char(), e.g. more than 8 DNA symbols in uint16_t or
+		 * more than 12 protein symbols in uint64_t. Every k-mer is hashed
+		 * with MurmurHash3 to all bits of ST, so that different k-mers only
+		 * rarely share a word. Like for obtain_from_char(), the words need
+		 * to be sorted before they are used in spectrum kernels.
+		 *
+		 * any subset is removed before, subset of parameter sf is possible
+		 *
+		 * @param sf string features
+		 * @param p_order length of the k-mers
+		 * @return if obtaining was successful
+		 */
+		bool obtain_hashed_from_char(CStringFeatures<char>* sf, int32_t p_order);
+
 		/** template obtain from char features
 		 *
 		 * any subset is removed before, subset of parameter sf is possible
@@ -655,9 +774,70 @@ template <class ST> class CStringFeatures : public CFeatures
 		 */
 		virtual ST* compute_feature_vector(int32_t num, int32_t& len);
 
+		/** pack a string and append it to the packed words
+		 *
+		 * @param num index of the string
+		 * @param string string to pack
+		 * @param len length of the string
+		 * @return if all symbols are valid
+		 */
+		bool append_packed_string(int32_t num, const ST* string, int32_t len);
+
+		/** free the packed strings */
+		void cleanup_packed();
+
+		/** decode all packed strings, ignoring any subset
+		 *
+		 * @return decoded strings, num_vectors many
+		 */
+		SGString<ST>* decode_packed_strings() const;
+
+		/** free the strings that were decoded into features while the
+		 * strings are packed
+		 */
+		void free_decoded_strings();
+
+		/** clone with the packed strings decoded into the features
+		 * parameter, which only holds unpacked strings
+		 *
+		 * @param share whether to shallow clone
+		 * @return cloned features
+		 */
+		CSGObject* clone_unpacked(bool share);
+
+		/** decode packed strings into the features parameter, so that
+		 * they are saved as unpacked strings
+		 *
+		 * @exception ShogunException Will be thrown if an error
+		 *                            occurres.
+		 */
+		virtual void save_serializable_pre() throw (ShogunException);
+
+		/** free the strings decoded by save_serializable_pre()
+		 *
+		 * @exception ShogunException Will be thrown if an error
+		 *                            occurres.
+		 */
+		virtual void save_serializable_post() throw (ShogunException);
+
+		/** free packed strings, which the loaded strings replace
+		 *
+		 * @exception ShogunException Will be thrown if an error
+		 *                            occurres.
+		 */
+		virtual void load_serializable_pre() throw (ShogunException);
+
 	private:
 		void init();
 
+		/** decode a packed string
+		 *
+		 * @param real_num index of the string, without subset
+		 * @param target buffer for the symbols of the string
+		 * @param to_char whether to map the codes back to symbols
+		 */
+		void decode_packed_string(int32_t real_num, ST* target, bool to_char) const;
+
 	protected:
 		/** alphabet */
 		CAlphabet* alphabet;
@@ -697,6 +877,27 @@ template <class ST> class CStringFeatures : public CFeatures
 
 		/** feature cache */
 		CCache<ST>* feature_cache;
+
+		/** bits per symbol of the packed strings, 0 if not packed */
+		int32_t packed_bits;
+
+		/** packed words of all strings, allocated or mapped from packed_file */
+		uint64_t* packed_words;
+
+		/** number of packed words in use */
+		int64_t num_packed_words;
+
+		/** number of allocated packed words */
+		int64_t packed_words_capacity;
+
+		/** index of the first packed word of every string */
+		SGVector<int64_t> packed_offsets;
+
+		/** length of every packed string */
+		SGVector<int32_t> packed_lengths;
+
+		/** file the packed strings are mapped from, NULL if in memory */
+		CMemoryMappedFile<char>* packed_file;
 };
 }
 #endif // _CSTRINGFEATURES__H__
@@ -28,6 +28,7 @@ CHashedDocDotFeatures::CHashedDocDotFeatures(const CHashedDocDotFeatures& orig)
 {
 	init(orig.num_bits, orig.doc_collection, orig.tokenizer, orig.should_normalize,
 			orig.ngrams, orig.tokens_to_skip);
+	hashed_cache_size = orig.hashed_cache_size;
 }
 
 CHashedDocDotFeatures::CHashedDocDotFeatures(CFile* loader)
@@ -44,6 +45,8 @@ void CHashedDocDotFeatures::init(int32_t hash_bits, CStringFeatures<char>* docs,
 	doc_collection = docs;
 	tokenizer = tzer;
 	should_normalize = normalize;
+	hashed_cache_size = 0;
+	converter = NULL;
 
 	if (!tokenizer)
 	{
@@ -57,6 +60,7 @@ void CHashedDocDotFeatures::init(int32_t hash_bits, CStringFeatures<char>* docs,
 	SG_ADD((CSGObject**) &doc_collection, "doc_collection", "Document collection");
 	SG_ADD((CSGObject**) &tokenizer, "tokenizer", "Document tokenizer");
 	SG_ADD(&should_normalize, "should_normalize", "Normalize or not the dot products");
+	SG_ADD(&hashed_cache_size, "hashed_cache_size", "Number of hashed documents to cache");
 
 	SG_REF(doc_collection);
 	SG_REF(tokenizer);
@@ -66,6 +70,7 @@ CHashedDocDotFeatures::~CHashedDocDotFeatures()
 {
 	SG_UNREF(doc_collection);
 	SG_UNREF(tokenizer);
+	SG_UNREF(converter);
 }
 
 int32_t CHashedDocDotFeatures::get_dim_feature_space() const
@@ -80,20 +85,9 @@ float64_t CHashedDocDotFeatures::dot(int32_t vec_idx1, CDotFeatures* df, int32_t
 
 	CHashedDocDotFeatures* hddf = (CHashedDocDotFeatures*) df;
 
-	SGVector<char> sv1 = doc_collection->get_feature_vector(vec_idx1);
-	SGVector<char> sv2 = hddf->doc_collection->get_feature_vector(vec_idx2);
-
-	CHashedDocConverter* converter = new CHashedDocConverter(tokenizer, num_bits,
-			should_normalize, ngrams, tokens_to_skip);
-	SGSparseVector<float64_t> cv1 = converter->apply(sv1);
-	SGSparseVector<float64_t> cv2 = converter->apply(sv2);
-	float64_t result = SGSparseVector<float64_t>::sparse_dot(cv1,cv2);
-
-	doc_collection->free_feature_vector(sv1, vec_idx1);
-	hddf->doc_collection->free_feature_vector(sv2, vec_idx2);
-	SG_UNREF(converter);
-
-	return result;
+	SGSparseVector<float64_t> cv1 = get_hashed_vector(vec_idx1);
+	SGSparseVector<float64_t> cv2 = hddf->get_hashed_vector(vec_idx2);
+	return SGSparseVector<float64_t>::sparse_dot(cv1,cv2);
 }
 
 float64_t CHashedDocDotFeatures::dense_dot_sgvec(int32_t vec_idx1, const SGVector<float64_t> vec2)
@@ -105,6 +99,12 @@ float64_t CHashedDocDotFeatures::dense_dot(int32_t vec_idx1, const float64_t* ve
 {
 	ASSERT(vec2_len == CMath::pow(2,num_bits))
 
+	if (hashed_cache_size>0)
+	{
+		SGSparseVector<float64_t> cv = get_hashed_vector(vec_idx1);
+		return cv.dense_dot(1.0, const_cast<float64_t*>(vec2), vec2_len, 0.0);
+	}
+
 	SGVector<char> sv = doc_collection->get_feature_vector(vec_idx1);
 
 	/** this vector will maintain the current n+k active tokens
@@ -182,6 +182,13 @@ void CHashedDocDotFeatures::add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
 	if (abs_val)
 		alpha = CMath::abs(alpha);
 
+	if (hashed_cache_size>0)
+	{
+		SGSparseVector<float64_t> cv = get_hashed_vector(vec_idx1);
+		cv.add_to_dense(alpha, vec2, vec2_len);
+		return;
+	}
+
 	SGVector<char> sv = doc_collection->get_feature_vector(vec_idx1);
 	const float64_t value =
 		should_normalize ? alpha / std::sqrt((float64_t)sv.size()) : alpha;
@@ -262,6 +269,88 @@ void CHashedDocDotFeatures::set_doc_collection(CStringFeatures<char>* docs)
 {
 	SG_UNREF(doc_collection);
 	doc_collection = docs;
+	clear_hashed_cache();
+}
+
+void CHashedDocDotFeatures::set_hashed_cache_size(int32_t num_docs)
+{
+	REQUIRE(num_docs>=0, "Cache size (%d) must not be negative\n", num_docs);
+	hashed_cache_size = num_docs;
+	clear_hashed_cache();
+}
+
+int32_t CHashedDocDotFeatures::get_hashed_cache_size() const
+{
+	return hashed_cache_size;
+}
+
+void CHashedDocDotFeatures::clear_hashed_cache()
+{
+	std::lock_guard<std::mutex> lock(hashed_cache_lock);
+	hashed_cache.clear();
+	hashed_cache_index.clear();
+}
+
+SGSparseVector<float64_t> CHashedDocDotFeatures::get_hashed_vector(int32_t vec_idx)
+{
+	if (hashed_cache_size<=0)
+		return compute_hashed_vector(vec_idx);
+
+	{
+		std::lock_guard<std::mutex> lock(hashed_cache_lock);
+		auto it = hashed_cache_index.find(vec_idx);
+		if (it!=hashed_cache_index.end())
+		{
+			hashed_cache.splice(hashed_cache.begin(), hashed_cache, it->second);
+			return it->second->second;
+		}
+	}
+
+	/** hashing is done without holding the lock, so another thread may
+	 * have inserted the same document in the meantime */
+	SGSparseVector<float64_t> hashed = compute_hashed_vector(vec_idx);
+
+	std::lock_guard<std::mutex> lock(hashed_cache_lock);
+	if (hashed_cache_index.find(vec_idx)==hashed_cache_index.end())
+	{
+		hashed_cache.emplace_front(vec_idx, hashed);
+		hashed_cache_index[vec_idx] = hashed_cache.begin();
+
+		if ((int32_t) hashed_cache.size()>hashed_cache_size)
+		{
+			hashed_cache_index.erase(hashed_cache.back().first);
+			hashed_cache.pop_back();
+		}
+	}
+
+	return hashed;
+}
+
+SGSparseVector<float64_t> CHashedDocDotFeatures::compute_hashed_vector(int32_t vec_idx)
+{
+	{
+		/** created lazily so that it picks up parameters set after init */
+		std::lock_guard<std::mutex> lock(hashed_cache_lock);
+		if (!converter)
+		{
+			converter = new CHashedDocConverter(tokenizer, num_bits,
+					should_normalize, ngrams, tokens_to_skip);
+			SG_REF(converter);
+		}
+	}
+
+	int32_t len;
+	bool do_free;
+	char* doc = doc_collection->get_feature_vector(vec_idx, len, do_free);
+
+	CTokenizer* local_tzer = tokenizer->get_copy();
+	std::vector<uint32_t> hashed_indices;
+	SGSparseVector<float64_t> hashed = converter->apply(
+			SGVector<char>(doc, len, false), local_tzer, hashed_indices);
+	SG_UNREF(local_tzer);
+
+	doc_collection->free_feature_vector(doc, vec_idx, do_free);
+	return hashed;
 }
 
 int32_t CHashedDocDotFeatures::get_nnz_features_for_vector(int32_t num)
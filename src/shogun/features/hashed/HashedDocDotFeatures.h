@@ -14,6 +14,10 @@
 #include <shogun/converter/HashedDocConverter.h>
 #include <shogun/lib/Tokenizer.h>
 
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
 namespace shogun {
 template<class ST> class CStringFeatures;
 template<class ST> class SGMatrix;
@@ -30,6 +34,11 @@ class CTokenizer;
  * The latter implements a k-skip n-grams approach, meaning that you can combine up to n tokens, while skipping up to k.
  * Eg. for the tokens ["a", "b", "c", "d"], with n_grams = 2 and skips = 2, one would get the following combinations :
  * ["a", "ab", "ac" (skipped 1), "ad" (skipped 2), "b", "bc", "bd" (skipped 1), "c", "cd", "d"].
+ *
+ * Documents are tokenized and hashed again every time they are used. When
+ * iterating over the collection several times, e.g. in the epochs of SGD,
+ * set_hashed_cache_size() allows to keep the hashed representation of the
+ * most recently used documents in memory instead.
  */
 class CHashedDocDotFeatures: public CDotFeatures
 {
@@ -151,6 +160,24 @@ public:
 	 */
 	void set_doc_collection(CStringFeatures<char>* docs);
 
+	/** set the number of hashed documents to keep in a least recently used
+	 * cache, which is shared by all threads
+	 *
+	 * @param num_docs number of documents to cache, 0 disables caching
+	 */
+	void set_hashed_cache_size(int32_t num_docs);
+
+	/** @return number of hashed documents that are cached */
+	int32_t get_hashed_cache_size() const;
+
+	/** get the hashed representation of a document, from the cache if
+	 * enabled
+	 *
+	 * @param vec_idx index of the document
+	 * @return hashed document, normalized if should_normalize is set
+	 */
+	SGSparseVector<float64_t> get_hashed_vector(int32_t vec_idx);
+
 	virtual const char* get_name() const;
 
 	/** duplicate feature object
@@ -192,6 +219,12 @@ private:
 	void init(int32_t hash_bits, CStringFeatures<char>* docs, CTokenizer* tzer,
 		bool normalize, int32_t n_grams, int32_t skips);
 
+	/** tokenize and hash a document */
+	SGSparseVector<float64_t> compute_hashed_vector(int32_t vec_idx);
+
+	/** drop all cached documents */
+	void clear_hashed_cache();
+
 protected:
 	/** the document collection*/
 	CStringFeatures<char>* doc_collection;
@@ -210,6 +243,23 @@ protected:
 
 	/** tokens to skip when combining tokens */
 	int32_t tokens_to_skip;
+
+	/** converter used to hash documents, see compute_hashed_vector() */
+	CHashedDocConverter* converter;
+
+	/** max number of cached hashed documents */
+	int32_t hashed_cache_size;
+
+	/** cached documents, most recently used first */
+	std::list<std::pair<int32_t, SGSparseVector<float64_t>>> hashed_cache;
+
+	/** position of the cached documents in hashed_cache */
+	std::unordered_map<int32_t,
+		std::list<std::pair<int32_t, SGSparseVector<float64_t>>>::iterator>
+		hashed_cache_index;
+
+	/** guards hashed_cache and hashed_cache_index */
+	std::mutex hashed_cache_lock;
 };
 }
 
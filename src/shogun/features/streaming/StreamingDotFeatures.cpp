@@ -91,3 +91,32 @@ void CStreamingDotFeatures::free_feature_iterator(void* iterator)
 	SG_NOTIMPLEMENTED
 	return;
 }
+
+SGSparseVector<float32_t> CStreamingDotFeatures::get_sparse_example()
+{
+	int32_t dim = get_dim_feature_space();
+	SGVector<float32_t> dense(dim);
+	dense.zero();
+	add_to_dense_vec(1, dense.vector, dim);
+
+	int32_t num_nonzero = 0;
+	for (int32_t i = 0; i < dim; i++)
+	{
+		if (dense[i] != 0)
+			num_nonzero++;
+	}
+
+	SGSparseVector<float32_t> example(num_nonzero);
+	int32_t j = 0;
+	for (int32_t i = 0; i < dim; i++)
+	{
+		if (dense[i] != 0)
+		{
+			example.features[j].feat_index = i;
+			example.features[j].entry = dense[i];
+			j++;
+		}
+	}
+
+	return example;
+}
@@ -184,6 +184,34 @@ public:
 	 */
 	virtual void free_feature_iterator(void* iterator);
 
+	/** copy the current example to a sparse vector that remains valid
+	 * after release_example(), e.g. to process buffered examples in parallel
+	 *
+	 * The default implementation adds the example to a dense vector of
+	 * get_dim_feature_space() entries and keeps the non-zero entries.
+	 *
+	 * @return copy of the current example
+	 */
+	virtual SGSparseVector<float32_t> get_sparse_example();
+
+protected:
+	/** copy a sparse vector to a sparse vector of float32_t entries
+	 *
+	 * @param vector sparse vector to copy
+	 * @return copy of vector
+	 */
+	template <class T>
+	static SGSparseVector<float32_t> copy_sparse_example(const SGSparseVector<T>& vector)
+	{
+		SGSparseVector<float32_t> example(vector.num_feat_entries);
+		for (int32_t i = 0; i < vector.num_feat_entries; i++)
+		{
+			example.features[i].feat_index = vector.features[i].feat_index;
+			example.features[i].entry = vector.features[i].entry;
+		}
+		return example;
+	}
+
 };
 }
 #endif // _STREAMING_DOTFEATURES__H__
@@ -190,6 +190,11 @@ SGSparseVector<float64_t> CStreamingHashedDocDotFeatures::get_vector()
 	return current_vector;
 }
 
+SGSparseVector<float32_t> CStreamingHashedDocDotFeatures::get_sparse_example()
+{
+	return copy_sparse_example(current_vector);
+}
+
 void CStreamingHashedDocDotFeatures::set_normalization(bool normalize)
 {
 	converter->set_normalization(normalize);
@@ -208,6 +208,12 @@ public:
 	 */
 	SGSparseVector<float64_t> get_vector();
 
+	/** copy the current example to a sparse vector
+	 *
+	 * @return copy of the current example
+	 */
+	virtual SGSparseVector<float32_t> get_sparse_example();
+
 	/** specify whether hashed vector should be normalized or not
 	 *
 	 * @param normalize  whether to normalize
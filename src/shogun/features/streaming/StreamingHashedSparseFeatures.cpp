@@ -209,6 +209,12 @@ SGSparseVector<ST> CStreamingHashedSparseFeatures<ST>::get_vector()
 	return current_vector;
 }
 
+template <class ST>
+SGSparseVector<float32_t> CStreamingHashedSparseFeatures<ST>::get_sparse_example()
+{
+	return copy_sparse_example(current_vector);
+}
+
 template class CStreamingHashedSparseFeatures<bool>;
 template class CStreamingHashedSparseFeatures<char>;
 template class CStreamingHashedSparseFeatures<int8_t>;
@@ -196,6 +196,12 @@ public:
 	 */
 	SGSparseVector<ST> get_vector();
 
+	/** copy the current example to a sparse vector
+	 *
+	 * @return copy of the current example
+	 */
+	virtual SGSparseVector<float32_t> get_sparse_example();
+
 private:
 	void init(CStreamingFile* file, bool is_labelled, int32_t size,
 		int32_t d, bool use_quadr, bool keep_lin_terms);
@@ -323,6 +323,12 @@ SGSparseVector<T> CStreamingSparseFeatures<T>::get_vector()
 	return current_sgvector;
 }
 
+template <class T>
+SGSparseVector<float32_t> CStreamingSparseFeatures<T>::get_sparse_example()
+{
+	return copy_sparse_example(current_sgvector);
+}
+
 template <class T>
 float64_t CStreamingSparseFeatures<T>::get_label()
 {
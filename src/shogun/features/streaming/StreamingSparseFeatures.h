@@ -134,6 +134,12 @@ public:
 	 */
 	SGSparseVector<T> get_vector();
 
+	/** copy the current example to a sparse vector
+	 *
+	 * @return copy of the current example
+	 */
+	virtual SGSparseVector<float32_t> get_sparse_example();
+
 	/**
 	 * Return the label of the current example as a float.
 	 *
@@ -12,6 +12,7 @@
 #include <shogun/io/LineReader.h>
 #include <shogun/io/Parser.h>
 #include <shogun/lib/DelimiterTokenizer.h>
+#include <shogun/lib/Profiler.h>
 
 using namespace shogun;
 
@@ -180,6 +181,7 @@ GET_VECTOR(read_ulong, uint64_t)
 #define GET_MATRIX(read_func, sg_type) \
 void CCSVFile::get_matrix(sg_type*& matrix, int32_t& num_feat, int32_t& num_vec) \
 { \
+	SG_PROFILE_SCOPE("io/csv/get_matrix"); \
 	int32_t num_lines=0; \
 	int32_t num_tokens=-1; \
 	int32_t current_line_idx=0; \
@@ -0,0 +1,108 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "shogun/io/CSVFile.h"
+#include "shogun/io/LibSVMFile.h"
+#include "shogun/lib/config.h"
+#include "shogun/util/benchmark_data.h"
+#ifdef HAVE_HDF5
+#include "shogun/io/HDF5File.h"
+#endif // HAVE_HDF5
+
+#include <stdio.h>
+
+namespace shogun
+{
+
+static const char* CSV_FILENAME = "File_benchmark.csv";
+static const char* LIBSVM_FILENAME = "File_benchmark.libsvm";
+#ifdef HAVE_HDF5
+static const char* HDF5_FILENAME = "File_benchmark.h5";
+#endif // HAVE_HDF5
+
+static void BM_CSVFile_load(benchmark::State& state)
+{
+	auto data = benchmark_data::uniform_matrix(64, state.range(0));
+	auto writer = new CCSVFile(CSV_FILENAME, 'w');
+	data.save(writer);
+	SG_UNREF(writer);
+
+	for (auto _ : state)
+	{
+		auto reader = new CCSVFile(CSV_FILENAME, 'r');
+		SGMatrix<float64_t> loaded;
+		loaded.load(reader);
+		SG_UNREF(reader);
+	}
+	state.SetBytesProcessed(
+	    int64_t(state.iterations()) * data.num_rows * data.num_cols *
+	    sizeof(float64_t));
+
+	remove(CSV_FILENAME);
+}
+
+static void BM_LibSVMFile_load(benchmark::State& state)
+{
+	SGVector<float64_t> labels;
+	benchmark_data::binary_blobs(1, state.range(0), labels);
+	auto data = benchmark_data::sparse_matrix(10000, state.range(0), 50);
+	auto writer = new CLibSVMFile(LIBSVM_FILENAME, 'w', NULL);
+	data.save_with_labels(writer, labels);
+	SG_UNREF(writer);
+
+	for (auto _ : state)
+	{
+		auto reader = new CLibSVMFile(LIBSVM_FILENAME, 'r', NULL);
+		SGSparseMatrix<float64_t> loaded;
+		loaded.load_with_labels(reader, false);
+		SG_UNREF(reader);
+	}
+
+	remove(LIBSVM_FILENAME);
+}
+
+#ifdef HAVE_HDF5
+static void BM_HDF5File_load(benchmark::State& state)
+{
+	auto data = benchmark_data::uniform_matrix(64, state.range(0));
+	auto writer =
+	    new CHDF5File(const_cast<char*>(HDF5_FILENAME), 'w', "/data");
+	data.save(writer);
+	SG_UNREF(writer);
+
+	for (auto _ : state)
+	{
+		auto reader =
+		    new CHDF5File(const_cast<char*>(HDF5_FILENAME), 'r', "/data");
+		SGMatrix<float64_t> loaded;
+		loaded.load(reader);
+		SG_UNREF(reader);
+	}
+	state.SetBytesProcessed(
+	    int64_t(state.iterations()) * data.num_rows * data.num_cols *
+	    sizeof(float64_t));
+
+	remove(HDF5_FILENAME);
+}
+#endif // HAVE_HDF5
+
+// number of vectors
+BENCHMARK(BM_CSVFile_load)
+    ->RangeMultiplier(4)
+    ->Range(1024, 16384)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LibSVMFile_load)
+    ->RangeMultiplier(4)
+    ->Range(1024, 16384)
+    ->Unit(benchmark::kMillisecond);
+#ifdef HAVE_HDF5
+BENCHMARK(BM_HDF5File_load)
+    ->RangeMultiplier(4)
+    ->Range(1024, 16384)
+    ->Unit(benchmark::kMillisecond);
+#endif // HAVE_HDF5
+
+}
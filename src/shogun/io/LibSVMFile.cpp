@@ -12,6 +12,7 @@
 #include <shogun/io/LineReader.h>
 #include <shogun/io/Parser.h>
 #include <shogun/lib/DelimiterTokenizer.h>
+#include <shogun/lib/Profiler.h>
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/SGVector.h>
 
@@ -148,6 +149,7 @@ GET_LABELED_SPARSE_MATRIX(read_ulong, uint64_t)
 	    int32_t& num_vec, SGVector<float64_t>*& multilabel,                    \
 	    int32_t& num_classes, bool load_labels)                                \
 	{                                                                          \
+		SG_PROFILE_SCOPE("io/libsvm/get_sparse_matrix");                       \
 		num_feat = 0;                                                          \
                                                                                \
 		SG_INFO("counting line numbers in file %s.\n", filename)               \
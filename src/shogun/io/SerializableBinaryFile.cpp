@@ -0,0 +1,448 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/io/SerializableBinaryFile.h>
+#include <shogun/io/SerializableBinaryReader00.h>
+
+#define STR_HEADER_00                 \
+	"<<_SHOGUN_SERIALIZABLE_BINARY_FILE_V_00_>>"
+
+/** written after the header to detect files of a different byte order */
+#define BYTE_ORDER_MARK 0x01020304U
+
+using namespace shogun;
+
+/* 64 bit file positions, so that files larger than 2GB work everywhere */
+static int64_t tell64(FILE* fstream)
+{
+#ifdef _MSC_VER
+	return _ftelli64(fstream);
+#else
+	return ftello(fstream);
+#endif
+}
+
+static bool seek64(FILE* fstream, int64_t fpos)
+{
+#ifdef _MSC_VER
+	return _fseeki64(fstream, fpos, SEEK_SET) == 0;
+#else
+	return fseeko(fstream, (off_t) fpos, SEEK_SET) == 0;
+#endif
+}
+
+CSerializableBinaryFile::CSerializableBinaryFile()
+	:CSerializableFile() { init(); }
+
+CSerializableBinaryFile::CSerializableBinaryFile(FILE* fstream, char rw)
+	:CSerializableFile(fstream, rw) { init(); }
+
+CSerializableBinaryFile::CSerializableBinaryFile(
+	const char* fname, char rw)
+	:CSerializableFile(fname, rw) { init(); }
+
+CSerializableBinaryFile::~CSerializableBinaryFile()
+{
+	close();
+}
+
+void
+CSerializableBinaryFile::close()
+{
+	if (is_opened() && m_task == 'w' && !write_index())
+		SG_WARNING("Could not write the record index of `%s'!\n",
+				   m_filename);
+
+	CSerializableFile::close();
+}
+
+CSerializableFile::TSerializableReader*
+CSerializableBinaryFile::new_reader(char* dest_version, size_t n)
+{
+	REQUIRE(m_fstream != NULL, "Provided fstream should be != NULL\n");
+
+	string_t buf;
+	if (fgets(buf, STRING_LEN, m_fstream) == NULL)
+		return NULL;
+
+	char* newline = strchr(buf, '\n');
+	if (newline == NULL)
+		return NULL;
+	*newline = '\0';
+
+	strncpy(dest_version, buf, n < STRING_LEN? n: STRING_LEN);
+
+	if (strcmp(STR_HEADER_00, dest_version) == 0) {
+		uint32_t bom = 0;
+		int64_t index_fpos = 0;
+		if (fread(&bom, sizeof(bom), 1, m_fstream) != 1)
+			return NULL;
+
+		if (bom != BYTE_ORDER_MARK) {
+			SG_WARNING("`%s' was written on a machine with different "
+					   "byte order!\n", m_filename);
+			return NULL;
+		}
+
+		if (fread(&index_fpos, sizeof(index_fpos), 1, m_fstream) != 1)
+			return NULL;
+
+		SerializableBinaryReader00* reader
+			= new SerializableBinaryReader00(this);
+		if (!reader->map(tell64(m_fstream), index_fpos)) {
+			SG_WARNING("`%s' is truncated or has no valid record "
+					   "index!\n", m_filename);
+			delete reader;
+			return NULL;
+		}
+
+		return reader;
+	}
+
+	return NULL;
+}
+
+void
+CSerializableBinaryFile::init()
+{
+	m_index_fpos = 0;
+
+	if (m_fstream == NULL) return;
+
+	switch (m_task) {
+	case 'w':
+	{
+		const uint32_t bom = BYTE_ORDER_MARK;
+		const int64_t index_fpos = 0;
+		if (fprintf(m_fstream, STR_HEADER_00"\n") <= 0
+			|| fwrite(&bom, sizeof(bom), 1, m_fstream) != 1) {
+			CSerializableFile::close(); return;
+		}
+
+		m_index_fpos = tell64(m_fstream);
+		if (fwrite(&index_fpos, sizeof(index_fpos), 1, m_fstream) != 1) {
+			CSerializableFile::close(); return;
+		}
+
+		/* the outermost object spans all top level records */
+		m_stack_scope.push_back(tell64(m_fstream));
+		break;
+	}
+	case 'r': break;
+	default:
+		SG_WARNING("Could not open file `%s', unknown mode!\n",
+				   m_filename);
+		CSerializableFile::close(); return;
+	}
+}
+
+bool
+CSerializableBinaryFile::write_index()
+{
+	const int64_t index_fpos = tell64(m_fstream);
+	const uint64_t num_records = m_index.size();
+
+	if (index_fpos < 0 || m_stack_record.get_num_elements() > 0) return false;
+	if (fwrite(&num_records, sizeof(num_records), 1, m_fstream) != 1)
+		return false;
+
+	for (size_t i=0; i<m_index.size(); i++) {
+		const TRecordIndex& record = m_index[i];
+		if (fwrite(&record.scope, sizeof(record.scope), 1, m_fstream) != 1
+			|| fwrite(&record.offset, sizeof(record.offset), 1, m_fstream)
+			!= 1 || fwrite(&record.size, sizeof(record.size), 1, m_fstream)
+			!= 1) return false;
+		if (!write_string(record.name.c_str())) return false;
+		if (!write_string(record.type.c_str())) return false;
+	}
+
+	if (!seek64(m_fstream, m_index_fpos)) return false;
+	if (fwrite(&index_fpos, sizeof(index_fpos), 1, m_fstream) != 1)
+		return false;
+
+	m_index.clear();
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_size_begin()
+{
+	const uint64_t size = 0;
+	const int64_t fpos = tell64(m_fstream);
+
+	if (fpos < 0) return false;
+	m_stack_fpos.push_back(fpos);
+	if (fwrite(&size, sizeof(size), 1, m_fstream) != 1) return false;
+
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_size_end()
+{
+	const int64_t fpos_size = m_stack_fpos.back();
+	const int64_t fpos_end = tell64(m_fstream);
+	m_stack_fpos.pop_back();
+
+	if (fpos_end < 0) return false;
+
+	const uint64_t size = fpos_end - fpos_size - sizeof(uint64_t);
+	if (!seek64(m_fstream, fpos_size)) return false;
+	if (fwrite(&size, sizeof(size), 1, m_fstream) != 1) return false;
+	if (!seek64(m_fstream, fpos_end)) return false;
+
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_string(const char* str)
+{
+	const uint32_t len = strlen(str);
+
+	if (fwrite(&len, sizeof(len), 1, m_fstream) != 1) return false;
+	if (len > 0 && fwrite(str, 1, len, m_fstream) != len) return false;
+
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_scalar_wrapped(
+	const TSGDataType* type, const void* param)
+{
+	switch (type->m_ptype) {
+	case PT_UNDEFINED:
+	case PT_SGOBJECT:
+		SG_ERROR("write_scalar_wrapped(): Implementation error during"
+				 " writing BinaryFile!");
+		return false;
+	default:
+		if (fwrite(param, type->sizeof_ptype(), 1, m_fstream) != 1)
+			return false;
+		break;
+	}
+
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_cont_begin_wrapped(
+	const TSGDataType* type, index_t len_real_y, index_t len_real_x)
+{
+	switch (type->m_ctype) {
+	case CT_NDARRAY:
+		SG_NOTIMPLEMENTED
+		break;
+	case CT_VECTOR: case CT_SGVECTOR:
+	case CT_MATRIX: case CT_SGMATRIX:
+		if (fwrite(&len_real_y, sizeof(index_t), 1, m_fstream) != 1
+			|| fwrite(&len_real_x, sizeof(index_t), 1, m_fstream) != 1)
+			return false;
+		break;
+	case CT_UNDEFINED:
+	case CT_SCALAR:
+		SG_ERROR("write_cont_begin_wrapped(): Implementation error "
+				 "during writing BinaryFile!");
+		return false;
+	}
+
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_cont_end_wrapped(
+	const TSGDataType* type, index_t len_real_y, index_t len_real_x)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_string_begin_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	if (fwrite(&length, sizeof(index_t), 1, m_fstream) != 1)
+		return false;
+
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_string_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_stringentry_begin_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_stringentry_end_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_sparse_begin_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	if (fwrite(&length, sizeof(index_t), 1, m_fstream) != 1)
+		return false;
+
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_sparse_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_sparseentry_begin_wrapped(
+	const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+	index_t feat_index, index_t y)
+{
+	if (fwrite(&feat_index, sizeof(index_t), 1, m_fstream) != 1)
+		return false;
+
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_sparseentry_end_wrapped(
+	const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+	index_t feat_index, index_t y)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_item_begin_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_item_end_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_sgserializable_begin_wrapped(
+	const TSGDataType* type, const char* sgserializable_name,
+	EPrimitiveType generic)
+{
+	const int32_t generic_type = generic;
+
+	if (!write_string(sgserializable_name)) return false;
+	if (fwrite(&generic_type, sizeof(generic_type), 1, m_fstream) != 1)
+		return false;
+
+	if (*sgserializable_name != '\0') {
+		if (!write_size_begin()) return false;
+		m_stack_scope.push_back(tell64(m_fstream));
+	}
+
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_sgserializable_end_wrapped(
+	const TSGDataType* type, const char* sgserializable_name,
+	EPrimitiveType generic)
+{
+	if (*sgserializable_name != '\0') {
+		m_stack_scope.pop_back();
+		return write_size_end();
+	}
+
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_type_begin_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	string_t buf;
+	type->to_string(buf, STRING_LEN);
+
+	if (!write_string(name)) return false;
+	if (!write_string(buf)) return false;
+	if (!write_size_begin()) return false;
+
+	TRecordIndex record;
+	record.scope = m_stack_scope.back();
+	record.offset = tell64(m_fstream);
+	record.size = 0;
+	record.name = name;
+	record.type = buf;
+	m_stack_record.push_back(m_index.size());
+	m_index.push_back(record);
+
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_type_end_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	TRecordIndex& record = m_index[m_stack_record.back()];
+	m_stack_record.pop_back();
+
+	const int64_t fpos = tell64(m_fstream);
+	if (fpos < record.offset) return false;
+	record.size = fpos - record.offset;
+
+	return write_size_end();
+}
+
+bool
+CSerializableBinaryFile::write_block_wrapped(
+	const TSGDataType* type, const void* data, size_t nbytes)
+{
+	const char zeros[SERIALIZABLE_BINARY_ALIGNMENT] = {0};
+	const int64_t fpos = tell64(m_fstream);
+	if (fpos < 0) return false;
+
+	const size_t padding = (SERIALIZABLE_BINARY_ALIGNMENT
+		- fpos % SERIALIZABLE_BINARY_ALIGNMENT) % SERIALIZABLE_BINARY_ALIGNMENT;
+
+	if (padding > 0 && fwrite(zeros, 1, padding, m_fstream) != padding)
+		return false;
+	if (nbytes == 0) return true;
+
+	if (type->m_stype != ST_SPARSE)
+		return fwrite(data, 1, nbytes, m_fstream) == nbytes;
+
+	/* sparse entries keep their in-memory layout, but are copied field by
+	 * field into zeroed memory first, so that their padding is not written
+	 */
+	const size_t entry_size = TSGDataType::sizeof_sparseentry(type->m_ptype);
+	const size_t value_offset
+		= TSGDataType::offset_sparseentry(type->m_ptype);
+	const size_t value_size = type->sizeof_ptype();
+	const size_t num_entries = nbytes/entry_size;
+	char* buf = SG_CALLOC(char, nbytes);
+
+	for (size_t i=0; i<num_entries; i++) {
+		const char* src = (const char*) data + i*entry_size;
+		char* dst = buf + i*entry_size;
+		memcpy(dst, src, sizeof(index_t));
+		memcpy(dst + value_offset, src + value_offset, value_size);
+	}
+
+	const bool success = fwrite(buf, 1, nbytes, m_fstream) == nbytes;
+	SG_FREE(buf);
+
+	return success;
+}
@@ -0,0 +1,184 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+#ifndef __SERIALIZABLE_BINARY_FILE_H__
+#define __SERIALIZABLE_BINARY_FILE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/io/SerializableFile.h>
+#include <shogun/base/DynArray.h>
+#include <shogun/lib/DataType.h>
+#include <shogun/lib/common.h>
+
+#include <string>
+#include <vector>
+
+/** alignment (in bytes, relative to the start of the file) of raw blocks */
+#define SERIALIZABLE_BINARY_ALIGNMENT 64
+
+namespace shogun
+{
+template <class T> struct SGSparseVectorEntry;
+
+/** @brief serializable binary file
+ *
+ * Compact binary container for CSGObject::save_serializable() and
+ * CSGObject::load_serializable(). The file starts with a version header, a
+ * byte order mark and the 64 bit offset of the record index, followed by
+ * one record per parameter. Every record holds the name and type of the
+ * parameter and the size of its payload, and the same holds for every
+ * serialised object. The index is written when the file is closed and maps
+ * the object scope, name and type of every record to its payload, so that
+ * the reader maps the file into memory and locates parameters without
+ * scanning the records in front of them.
+ *
+ * Vectors and matrices of primitive types, strings and sparse vectors are
+ * stored as raw blocks (see CSerializableFile::supports_blocks()) aligned
+ * to SERIALIZABLE_BINARY_ALIGNMENT bytes, so they are written and read with
+ * a single call each instead of one call per element.
+ *
+ * The format is native: files are only portable between machines with the
+ * same byte order and type sizes, which is checked when reading.
+ */
+class CSerializableBinaryFile :public CSerializableFile
+{
+	friend class SerializableBinaryReader00;
+
+	/** index entry of a record */
+	struct TRecordIndex
+	{
+		/** offset of the first record of the enclosing object */
+		int64_t scope;
+		/** offset of the payload */
+		int64_t offset;
+		/** size of the payload */
+		uint64_t size;
+		/** parameter name */
+		std::string name;
+		/** parameter type */
+		std::string type;
+	};
+
+	/** positions of the size fields of records not finished yet */
+	DynArray<int64_t> m_stack_fpos;
+	/** first record of the objects being written */
+	DynArray<int64_t> m_stack_scope;
+	/** index entries of the records not finished yet */
+	DynArray<index_t> m_stack_record;
+	/** index of all records written so far */
+	std::vector<TRecordIndex> m_index;
+	/** position of the index offset in the header */
+	int64_t m_index_fpos;
+
+	void init();
+
+	/** write the record index and its offset into the header */
+	bool write_index();
+
+	/** write a placeholder for the payload size of a new record */
+	bool write_size_begin();
+	/** fill in the payload size of the last unfinished record */
+	bool write_size_end();
+	/** write a length prefixed string */
+	bool write_string(const char* str);
+
+protected:
+
+	/** new reader
+	 * @param dest_version
+	 * @param n
+	 */
+	virtual TSerializableReader* new_reader(
+		char* dest_version, size_t n);
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+	virtual bool write_scalar_wrapped(
+		const TSGDataType* type, const void* param);
+
+	virtual bool write_cont_begin_wrapped(
+		const TSGDataType* type, index_t len_real_y,
+		index_t len_real_x);
+	virtual bool write_cont_end_wrapped(
+		const TSGDataType* type, index_t len_real_y,
+		index_t len_real_x);
+
+	virtual bool write_string_begin_wrapped(
+		const TSGDataType* type, index_t length);
+	virtual bool write_string_end_wrapped(
+		const TSGDataType* type, index_t length);
+
+	virtual bool write_stringentry_begin_wrapped(
+		const TSGDataType* type, index_t y);
+	virtual bool write_stringentry_end_wrapped(
+		const TSGDataType* type, index_t y);
+
+	virtual bool write_sparse_begin_wrapped(
+		const TSGDataType* type, index_t length);
+	virtual bool write_sparse_end_wrapped(
+		const TSGDataType* type, index_t length);
+
+	virtual bool write_sparseentry_begin_wrapped(
+		const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+		index_t feat_index, index_t y);
+	virtual bool write_sparseentry_end_wrapped(
+		const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+		index_t feat_index, index_t y);
+
+	virtual bool write_item_begin_wrapped(
+		const TSGDataType* type, index_t y, index_t x);
+	virtual bool write_item_end_wrapped(
+		const TSGDataType* type, index_t y, index_t x);
+
+	virtual bool write_sgserializable_begin_wrapped(
+		const TSGDataType* type, const char* sgserializable_name,
+		EPrimitiveType generic);
+	virtual bool write_sgserializable_end_wrapped(
+		const TSGDataType* type, const char* sgserializable_name,
+		EPrimitiveType generic);
+
+	virtual bool write_type_begin_wrapped(
+		const TSGDataType* type, const char* name,
+		const char* prefix);
+	virtual bool write_type_end_wrapped(
+		const TSGDataType* type, const char* name,
+		const char* prefix);
+
+	virtual bool write_block_wrapped(
+		const TSGDataType* type, const void* data, size_t nbytes);
+#endif
+public:
+	/** default constructor */
+	explicit CSerializableBinaryFile();
+
+	/** constructor
+	 *
+	 * @param fstream already opened file
+	 * @param rw
+	 */
+	explicit CSerializableBinaryFile(FILE* fstream, char rw);
+
+	/** constructor
+	 *
+	 * @param fname filename to open
+	 * @param rw mode, 'r' or 'w'
+	 */
+	explicit CSerializableBinaryFile(const char* fname, char rw='r');
+
+	/** default destructor */
+	virtual ~CSerializableBinaryFile();
+
+	/** close, writes the record index first when writing */
+	virtual void close();
+
+	/** @return true, arrays are stored as raw blocks */
+	virtual bool supports_blocks() const { return true; }
+
+	/** @return object name */
+	virtual const char* get_name() const {
+		return "SerializableBinaryFile";
+	}
+};
+}
+
+#endif /* __SERIALIZABLE_BINARY_FILE_H__  */
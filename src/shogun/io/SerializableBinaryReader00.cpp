@@ -0,0 +1,367 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/io/SerializableBinaryReader00.h>
+#include <shogun/io/SerializableBinaryFile.h>
+#include <shogun/lib/common.h>
+
+#ifndef _MSC_VER
+#include <sys/mman.h>
+#endif
+#include <sys/stat.h>
+
+using namespace shogun;
+
+SerializableBinaryReader00::SerializableBinaryReader00(
+	CSerializableBinaryFile* file)
+{
+	m_file = file;
+	m_data = NULL;
+	m_size = 0;
+	m_pos = 0;
+}
+
+SerializableBinaryReader00::~SerializableBinaryReader00()
+{
+	if (m_data == NULL) return;
+
+#ifdef _MSC_VER
+	SG_FREE((char*) m_data);
+#else
+	munmap((void*) m_data, m_size);
+#endif
+}
+
+std::string
+SerializableBinaryReader00::index_key(
+	int64_t scope, const char* name, const char* type)
+{
+	std::string key((const char*) &scope, sizeof(scope));
+	key.append(name).push_back('\0');
+	key.append(type);
+
+	return key;
+}
+
+bool
+SerializableBinaryReader00::map(int64_t begin, int64_t index_fpos)
+{
+	struct stat sb;
+	if (fstat(fileno(m_file->m_fstream), &sb) != 0 || sb.st_size <= 0)
+		return false;
+	m_size = sb.st_size;
+
+#ifdef _MSC_VER
+	char* data = SG_MALLOC(char, m_size);
+	if (_fseeki64(m_file->m_fstream, 0, SEEK_SET) != 0
+		|| fread(data, 1, m_size, m_file->m_fstream) != (size_t) m_size) {
+		SG_FREE(data);
+		return false;
+	}
+	m_data = data;
+#else
+	void* data = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE,
+		fileno(m_file->m_fstream), 0);
+	if (data == MAP_FAILED) return false;
+	m_data = (const char*) data;
+#endif
+
+	if (begin <= 0 || begin > index_fpos || index_fpos >= m_size)
+		return false;
+
+	m_pos = index_fpos;
+	uint64_t num_records = 0;
+	if (!read_raw(&num_records, sizeof(num_records))) return false;
+
+	string_t name, type;
+	for (uint64_t i=0; i<num_records; i++) {
+		int64_t scope = 0;
+		TRecord record;
+		if (!read_raw(&scope, sizeof(scope))
+			|| !read_raw(&record.offset, sizeof(record.offset))
+			|| !read_raw(&record.size, sizeof(record.size)))
+			return false;
+		if (!read_string(name, STRING_LEN)) return false;
+		if (!read_string(type, STRING_LEN)) return false;
+
+		if (record.offset < begin || record.offset > index_fpos
+			|| record.size > (uint64_t) (index_fpos - record.offset))
+			return false;
+
+		m_index[index_key(scope, name, type)] = record;
+	}
+
+	/* the outermost object spans all top level records */
+	m_pos = begin;
+	m_stack_scope_begin.push_back(begin);
+	m_stack_scope_end.push_back(index_fpos);
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_raw(void* dest, size_t n)
+{
+	if (m_pos < 0 || (uint64_t) (m_size - m_pos) < n) return false;
+
+	memcpy(dest, m_data + m_pos, n);
+	m_pos += n;
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_string(char* str, size_t n)
+{
+	uint32_t len = 0;
+
+	if (!read_raw(&len, sizeof(len))) return false;
+	if (len >= n) return false;
+	if (!read_raw(str, len)) return false;
+	str[len] = '\0';
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::check_length(uint64_t count, size_t nbytes) const
+{
+	const int64_t end = m_stack_record_end.get_num_elements() > 0
+		? m_stack_record_end.back() : m_size;
+
+	if (m_pos < 0 || m_pos > end || nbytes == 0) return false;
+
+	return count <= (uint64_t) (end - m_pos) / nbytes;
+}
+
+bool
+SerializableBinaryReader00::read_scalar_wrapped(
+	const TSGDataType* type, void* param)
+{
+	switch (type->m_ptype) {
+	case PT_UNDEFINED:
+	case PT_SGOBJECT:
+		SG_ERROR("read_scalar_wrapped(): Implementation error during"
+				 " reading BinaryFile!");
+		return false;
+	default:
+		if (!read_raw(param, type->sizeof_ptype()))
+			return false;
+		break;
+	}
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_cont_begin_wrapped(
+	const TSGDataType* type, index_t* len_read_y, index_t* len_read_x)
+{
+	switch (type->m_ctype) {
+	case CT_NDARRAY:
+		SG_NOTIMPLEMENTED
+		break;
+	case CT_VECTOR: case CT_SGVECTOR:
+	case CT_MATRIX: case CT_SGMATRIX:
+	{
+		if (!read_raw(len_read_y, sizeof(index_t))
+			|| !read_raw(len_read_x, sizeof(index_t)))
+			return false;
+		if (*len_read_y < 0 || *len_read_x < 0) return false;
+
+		/* primitive items are one block, every other item starts with
+		 * at least a length prefix */
+		size_t nbytes = sizeof(index_t);
+		if (type->m_stype == ST_NONE && type->m_ptype != PT_SGOBJECT)
+			nbytes = type->sizeof_stype();
+		else if (type->m_stype == ST_NONE)
+			nbytes = sizeof(uint32_t) + sizeof(int32_t);
+
+		if (!check_length((uint64_t) *len_read_y * *len_read_x, nbytes))
+			return false;
+		break;
+	}
+	case CT_UNDEFINED:
+	case CT_SCALAR:
+		SG_ERROR("read_cont_begin_wrapped(): Implementation error "
+				 "during reading BinaryFile!");
+		return false;
+	}
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_cont_end_wrapped(
+	const TSGDataType* type, index_t len_read_y, index_t len_read_x)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_string_begin_wrapped(
+	const TSGDataType* type, index_t* length)
+{
+	if (!read_raw(length, sizeof(index_t)))
+		return false;
+	if (*length < 0 || !check_length(*length, type->sizeof_ptype()))
+		return false;
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_string_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_stringentry_begin_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_stringentry_end_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sparse_begin_wrapped(
+	const TSGDataType* type, index_t* length)
+{
+	if (!read_raw(length, sizeof(index_t)))
+		return false;
+	if (*length < 0 || !check_length(
+			*length, TSGDataType::sizeof_sparseentry(type->m_ptype)))
+		return false;
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sparse_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sparseentry_begin_wrapped(
+	const TSGDataType* type, SGSparseVectorEntry<char>* first_entry,
+	index_t* feat_index, index_t y)
+{
+	if (!read_raw(feat_index, sizeof(index_t)))
+		return false;
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sparseentry_end_wrapped(
+	const TSGDataType* type, SGSparseVectorEntry<char>* first_entry,
+	index_t* feat_index, index_t y)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_item_begin_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_item_end_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sgserializable_begin_wrapped(
+	const TSGDataType* type, char* sgserializable_name,
+	EPrimitiveType* generic)
+{
+	int32_t generic_type = PT_NOT_GENERIC;
+
+	if (!read_string(sgserializable_name, STRING_LEN)) return false;
+	if (!read_raw(&generic_type, sizeof(generic_type))) return false;
+	*generic = (EPrimitiveType) generic_type;
+
+	if (*sgserializable_name != '\0') {
+		uint64_t size = 0;
+		if (!read_raw(&size, sizeof(size))) return false;
+		if (size > (uint64_t) (m_stack_scope_end.back() - m_pos))
+			return false;
+
+		m_stack_scope_begin.push_back(m_pos);
+		m_stack_scope_end.push_back(m_pos + size);
+	}
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sgserializable_end_wrapped(
+	const TSGDataType* type, const char* sgserializable_name,
+	EPrimitiveType generic)
+{
+	if (*sgserializable_name != '\0') {
+		m_pos = m_stack_scope_end.back();
+
+		m_stack_scope_begin.pop_back();
+		m_stack_scope_end.pop_back();
+	}
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_type_begin_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	string_t type_str;
+	type->to_string(type_str, STRING_LEN);
+
+	std::unordered_map<std::string, TRecord>::const_iterator it
+		= m_index.find(index_key(m_stack_scope_begin.back(), name, type_str));
+	if (it == m_index.end()) return false;
+
+	m_pos = it->second.offset;
+	m_stack_record_end.push_back(it->second.offset + it->second.size);
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_type_end_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	const int64_t record_end = m_stack_record_end.back();
+	m_stack_record_end.pop_back();
+
+	if (m_pos != record_end) return false;
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_block_wrapped(
+	const TSGDataType* type, void* data, size_t nbytes)
+{
+	const size_t padding = (SERIALIZABLE_BINARY_ALIGNMENT
+		- m_pos % SERIALIZABLE_BINARY_ALIGNMENT) % SERIALIZABLE_BINARY_ALIGNMENT;
+
+	if ((uint64_t) (m_size - m_pos) < padding) return false;
+	m_pos += padding;
+
+	return read_raw(data, nbytes);
+}
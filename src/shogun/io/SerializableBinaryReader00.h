@@ -0,0 +1,160 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+#ifndef __SERIALIZABLE_BINARY_READER_00_H__
+#define __SERIALIZABLE_BINARY_READER_00_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/io/SerializableFile.h>
+#include <shogun/base/DynArray.h>
+
+#include <string>
+#include <unordered_map>
+
+namespace shogun
+{
+class CSerializableBinaryFile;
+template <class T> struct SGSparseVectorEntry;
+
+/** @brief Serializable binary reader
+ *
+ * Maps the whole file into memory and looks records up in the index written
+ * by CSerializableBinaryFile, so that all reads are bounds checked copies
+ * out of the mapping and no record is scanned to find another one.
+ */
+class SerializableBinaryReader00
+	: public CSerializableFile::TSerializableReader {
+
+	/** payload of a record */
+	struct TRecord
+	{
+		/** offset of the payload */
+		int64_t offset;
+		/** size of the payload */
+		uint64_t size;
+	};
+
+	CSerializableBinaryFile* m_file;
+
+	/** start of the mapped file */
+	const char* m_data;
+	/** size of the mapped file */
+	int64_t m_size;
+	/** current read position */
+	int64_t m_pos;
+
+	/** records by object scope, name and type */
+	std::unordered_map<std::string, TRecord> m_index;
+
+	/** first record of the objects being read */
+	DynArray<int64_t> m_stack_scope_begin;
+	/** end of the objects being read */
+	DynArray<int64_t> m_stack_scope_end;
+	/** end of the records being read */
+	DynArray<int64_t> m_stack_record_end;
+
+	/** @return key of a record in the index */
+	static std::string index_key(
+		int64_t scope, const char* name, const char* type);
+
+	/** copy n bytes at the current position and advance past them */
+	bool read_raw(void* dest, size_t n);
+
+	/** read a length prefixed string
+	 *
+	 * @param str destination of at least n characters
+	 * @param n size of destination
+	 */
+	bool read_string(char* str, size_t n);
+
+	/** check a length read from the file before anything is allocated
+	 * for it
+	 *
+	 * @param count number of elements
+	 * @param nbytes least number of bytes each element takes in the file
+	 * @return whether count elements fit into the rest of the record
+	 */
+	bool check_length(uint64_t count, size_t nbytes) const;
+
+public:
+	/** constructor
+	 * @param file
+	 */
+	explicit SerializableBinaryReader00(CSerializableBinaryFile* file);
+
+	/** destructor */
+	virtual ~SerializableBinaryReader00();
+
+	/** map the file and read its record index
+	 *
+	 * @param begin offset of the first top level record
+	 * @param index_fpos offset of the record index
+	 * @return whether the file was mapped and its index is consistent
+	 */
+	bool map(int64_t begin, int64_t index_fpos);
+
+	/** @return object name */
+	virtual const char* get_name() const {
+		return "SerializableBinaryReader00";
+	}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+	virtual bool read_scalar_wrapped(
+		const TSGDataType* type, void* param);
+
+	virtual bool read_cont_begin_wrapped(
+		const TSGDataType* type, index_t* len_read_y,
+		index_t* len_read_x);
+	virtual bool read_cont_end_wrapped(
+		const TSGDataType* type, index_t len_read_y,
+		index_t len_read_x);
+
+	virtual bool read_string_begin_wrapped(
+		const TSGDataType* type, index_t* length);
+	virtual bool read_string_end_wrapped(
+		const TSGDataType* type, index_t length);
+
+	virtual bool read_stringentry_begin_wrapped(
+		const TSGDataType* type, index_t y);
+	virtual bool read_stringentry_end_wrapped(
+		const TSGDataType* type, index_t y);
+
+	virtual bool read_sparse_begin_wrapped(
+		const TSGDataType* type, index_t* length);
+	virtual bool read_sparse_end_wrapped(
+		const TSGDataType* type, index_t length);
+
+	virtual bool read_sparseentry_begin_wrapped(
+		const TSGDataType* type, SGSparseVectorEntry<char>* first_entry,
+		index_t* feat_index, index_t y);
+	virtual bool read_sparseentry_end_wrapped(
+		const TSGDataType* type, SGSparseVectorEntry<char>* first_entry,
+		index_t* feat_index, index_t y);
+
+	virtual bool read_item_begin_wrapped(
+		const TSGDataType* type, index_t y, index_t x);
+	virtual bool read_item_end_wrapped(
+		const TSGDataType* type, index_t y, index_t x);
+
+	virtual bool read_sgserializable_begin_wrapped(
+		const TSGDataType* type, char* sgserializable_name,
+		EPrimitiveType* generic);
+	virtual bool read_sgserializable_end_wrapped(
+		const TSGDataType* type, const char* sgserializable_name,
+		EPrimitiveType generic);
+
+	virtual bool read_type_begin_wrapped(
+		const TSGDataType* type, const char* name,
+		const char* prefix);
+	virtual bool read_type_end_wrapped(
+		const TSGDataType* type, const char* name,
+		const char* prefix);
+
+	virtual bool read_block_wrapped(
+		const TSGDataType* type, void* data, size_t nbytes);
+#endif
+};
+}
+
+#endif /* __SERIALIZABLE_BINARY_READER_00_H__  */
@@ -571,3 +571,29 @@ CSerializableFile::read_type_end(
 
 	return true;
 }
+
+bool
+CSerializableFile::write_block(
+	const TSGDataType* type, const char* name, const char* prefix,
+	const void* data, size_t nbytes)
+{
+	if (!is_task_warn('w', name, prefix)) return false;
+
+	if (!write_block_wrapped(type, data, nbytes))
+		return false_warn(prefix, name);
+
+	return true;
+}
+
+bool
+CSerializableFile::read_block(
+	const TSGDataType* type, const char* name, const char* prefix,
+	void* data, size_t nbytes)
+{
+	if (!is_task_warn('r', name, prefix)) return false;
+
+	if (!m_reader->read_block_wrapped(type, data, nbytes))
+		return false_warn(prefix, name);
+
+	return true;
+}
@@ -79,6 +79,12 @@ public:
 			const TSGDataType* type, const char* name,
 			const char* prefix) = 0;
 
+		virtual bool read_block_wrapped(
+			const TSGDataType* type, void* data, size_t nbytes)
+		{
+			return false;
+		}
+
 #endif
 		/* End of abstract write methods  */
 		/* ******************************************************** */
@@ -164,6 +170,12 @@ protected:
 	virtual bool write_type_end_wrapped(
 		const TSGDataType* type, const char* name,
 		const char* prefix) = 0;
+
+	virtual bool write_block_wrapped(
+		const TSGDataType* type, const void* data, size_t nbytes)
+	{
+		return false;
+	}
 #endif
 
 	/* End of abstract write methods  */
@@ -196,6 +208,15 @@ public:
 	/** is opened */
 	virtual bool is_opened();
 
+	/** whether the file stores the elements of vectors and matrices of
+	 * primitive types, of strings and of sparse vectors as one raw block,
+	 * written and read with write_block() and read_block() instead of one
+	 * call per element
+	 *
+	 * @return whether raw blocks are supported
+	 */
+	virtual bool supports_blocks() const { return false; }
+
 	/* ************************************************************ */
 	/* Begin of public wrappers  */
 
@@ -318,6 +339,13 @@ public:
 		const TSGDataType* type, const char* name, const char* prefix);
 	virtual bool read_type_end(
 		const TSGDataType* type, const char* name, const char* prefix);
+
+	virtual bool write_block(
+		const TSGDataType* type, const char* name, const char* prefix,
+		const void* data, size_t nbytes);
+	virtual bool read_block(
+		const TSGDataType* type, const char* name, const char* prefix,
+		void* data, size_t nbytes);
 #endif
 	/* End of public wrappers  */
 	/* ************************************************************ */
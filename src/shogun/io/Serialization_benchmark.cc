@@ -0,0 +1,73 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "shogun/features/DenseFeatures.h"
+#include "shogun/io/SerializableAsciiFile.h"
+#include "shogun/io/SerializableBinaryFile.h"
+#include "shogun/lib/config.h"
+#include "shogun/util/benchmark_data.h"
+#ifdef HAVE_HDF5
+#include "shogun/io/SerializableHdf5File.h"
+#endif // HAVE_HDF5
+#ifdef HAVE_JSON
+#include "shogun/io/SerializableJsonFile.h"
+#endif // HAVE_JSON
+#ifdef HAVE_XML
+#include "shogun/io/SerializableXmlFile.h"
+#endif // HAVE_XML
+
+#include <stdio.h>
+
+namespace shogun
+{
+
+static const char* SERIALIZATION_FILENAME = "Serialization_benchmark.out";
+
+/** saves and loads dense features of range(0) vectors of dimension 64 */
+template <class FileType>
+void BM_Serialization_round_trip(benchmark::State& state)
+{
+	auto data = benchmark_data::uniform_matrix(64, state.range(0));
+	auto feats = new CDenseFeatures<float64_t>(data);
+	SG_REF(feats);
+
+	for (auto _ : state)
+	{
+		auto writer = new FileType(SERIALIZATION_FILENAME, 'w');
+		feats->save_serializable(writer);
+		SG_UNREF(writer);
+
+		auto reader = new FileType(SERIALIZATION_FILENAME, 'r');
+		auto loaded = new CDenseFeatures<float64_t>();
+		loaded->load_serializable(reader);
+		SG_UNREF(loaded);
+		SG_UNREF(reader);
+	}
+	state.SetBytesProcessed(
+	    int64_t(state.iterations()) * data.num_rows * data.num_cols *
+	    sizeof(float64_t));
+
+	SG_UNREF(feats);
+	remove(SERIALIZATION_FILENAME);
+}
+
+// number of vectors
+#define ADD_SERIALIZATION_ARGS(WHAT)                                           \
+	WHAT->RangeMultiplier(4)->Range(1024, 16384)->Unit(benchmark::kMillisecond);
+
+ADD_SERIALIZATION_ARGS(BENCHMARK_TEMPLATE(BM_Serialization_round_trip, CSerializableAsciiFile))
+ADD_SERIALIZATION_ARGS(BENCHMARK_TEMPLATE(BM_Serialization_round_trip, CSerializableBinaryFile))
+#ifdef HAVE_HDF5
+ADD_SERIALIZATION_ARGS(BENCHMARK_TEMPLATE(BM_Serialization_round_trip, CSerializableHdf5File))
+#endif // HAVE_HDF5
+#ifdef HAVE_JSON
+ADD_SERIALIZATION_ARGS(BENCHMARK_TEMPLATE(BM_Serialization_round_trip, CSerializableJsonFile))
+#endif // HAVE_JSON
+#ifdef HAVE_XML
+ADD_SERIALIZATION_ARGS(BENCHMARK_TEMPLATE(BM_Serialization_round_trip, CSerializableXmlFile))
+#endif // HAVE_XML
+
+}
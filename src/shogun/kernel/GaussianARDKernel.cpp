@@ -263,6 +263,43 @@ float64_t CGaussianARDKernel::get_parameter_gradient_helper(
 	}
 }
 
+SGVector<float64_t> CGaussianARDKernel::get_parameter_gradient_sum(
+		const TParameter* param, SGMatrix<float64_t> weights)
+{
+	REQUIRE(param, "Param not set\n");
+	REQUIRE(lhs , "Left features not set!\n");
+	REQUIRE(rhs, "Right features not set!\n");
+
+	if (strcmp(param->m_name, "log_weights") || m_ARD_type==KT_SCALAR)
+		return CExponentialARDKernel::get_parameter_gradient_sum(param, weights);
+
+	REQUIRE(weights.num_rows==num_lhs && weights.num_cols==num_rhs,
+		"Weights (%dx%d) must match the kernel matrix (%dx%d)\n",
+		weights.num_rows, weights.num_cols, num_lhs, num_rhs)
+
+	SGVector<float64_t> result(m_log_weights.vlen);
+	result.zero();
+
+	for (index_t j=0; j<num_lhs; j++)
+	{
+		SGVector<float64_t> avec=get_feature_vector(j, lhs);
+		for (index_t k=0; k<num_rhs; k++)
+		{
+			if (weights(j,k)==0)
+				continue;
+
+			SGVector<float64_t> bvec=get_feature_vector(k, rhs);
+			bvec=linalg::add(avec, bvec, 1.0, -1.0);
+			float64_t scale=-kernel(j,k)/2.0;
+
+			for (index_t i=0; i<result.vlen; i++)
+				result[i]+=weights(j,k)*compute_gradient_helper(bvec, bvec, scale, i);
+		}
+	}
+
+	return result;
+}
+
 SGMatrix<float64_t> CGaussianARDKernel::get_parameter_gradient(
 		const TParameter* param, index_t index)
 {
@@ -142,6 +142,18 @@ public:
 	virtual SGVector<float64_t> get_parameter_gradient_diagonal(
 		const TParameter* param, index_t index=-1);
 
+	/** return derivatives with respect to all weights, each summed up with
+	 * the given weights matrix. Kernel values and feature differences are
+	 * computed once per pair of vectors and shared by all weights.
+	 *
+	 * @param param the parameter
+	 * @param weights matrix of size num_lhs x num_rhs
+	 *
+	 * @return weighted sum of the gradient for every element of param
+	 */
+	virtual SGVector<float64_t> get_parameter_gradient_sum(
+		const TParameter* param, SGMatrix<float64_t> weights);
+
 protected:
 	/** helper function to compute quadratic terms in
 	 * (a-b)^2 (== a^2+b^2-2ab)
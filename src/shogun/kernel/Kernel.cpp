@@ -241,6 +241,7 @@ void CKernel::get_kernel_row(
 	/* is cached? */
 	if(kernel_cache.index[docnum] != -1)
 	{
+		SG_PROFILE_COUNT("kernel/cache_hits", 1);
 		kernel_cache.lru[kernel_cache.index[docnum]]=kernel_cache.time; /* lru */
 		start=((KERNELCACHE_IDX) kernel_cache.activenum)*kernel_cache.index[docnum];
 
@@ -272,6 +273,7 @@ void CKernel::get_kernel_row(
 	}
 	else
 	{
+		SG_PROFILE_COUNT("kernel/cache_misses", 1);
 		if (full_line)
 		{
 			for(j=0;j<get_num_vec_lhs();j++)
@@ -304,6 +306,7 @@ void CKernel::cache_kernel_row(int32_t m)
 
 	if(!kernel_cache_check(m))   // not cached yet
 	{
+		SG_PROFILE_SCOPE("kernel/cache_fill");
 		cache = kernel_cache_clean_and_malloc(m);
 		if(cache) {
 			l=kernel_cache.totdoc2active[m];
@@ -862,6 +865,34 @@ void CKernel::set_subkernel_weights(const SGVector<float64_t> weights)
 	combined_kernel_weight = weights.vector[0] ;
 }
 
+SGVector<float64_t> CKernel::get_parameter_gradient_sum(
+		const TParameter* param, SGMatrix<float64_t> weights)
+{
+	REQUIRE(param, "Param not set\n");
+	int64_t len=const_cast<TParameter *>(param)->m_datatype.get_num_elements();
+	SGVector<float64_t> result(len);
+
+	for (index_t i=0; i<result.vlen; i++)
+	{
+		SGMatrix<float64_t> dK;
+
+		if (result.vlen==1)
+			dK=get_parameter_gradient(param);
+		else
+			dK=get_parameter_gradient(param, i);
+
+		REQUIRE(dK.num_rows==weights.num_rows && dK.num_cols==weights.num_cols,
+			"Weights (%dx%d) must match the kernel matrix (%dx%d)\n",
+			weights.num_rows, weights.num_cols, dK.num_rows, dK.num_cols)
+
+		result[i]=0;
+		for (int64_t j=0; j<int64_t(dK.num_rows)*dK.num_cols; j++)
+			result[i]+=weights.matrix[j]*dK.matrix[j];
+	}
+
+	return result;
+}
+
 CKernel* CKernel::obtain_from_generic(CSGObject* kernel)
 {
 	if (kernel)
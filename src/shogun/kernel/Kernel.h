@@ -19,6 +19,7 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/features/FeatureTypes.h>
 #include <shogun/base/SGObject.h>
+#include <shogun/lib/Profiler.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/features/Features.h>
 #include <shogun/kernel/normalizer/KernelNormalizer.h>
@@ -205,6 +206,7 @@ class CKernel : public CSGObject
 				"%s::kernel(): index out of Range: idx_a=%d/%d idx_b=%d/%d\n",
 				get_name(), idx_a,num_lhs, idx_b,num_rhs);
 
+			SG_PROFILE_COUNT("kernel/evaluations", 1);
 			return normalizer->normalize(compute(idx_a, idx_b), idx_a, idx_b);
 		}
 
@@ -866,6 +868,25 @@ class CKernel : public CSGObject
 			return get_parameter_gradient(param,index).get_diagonal_vector();
 		}
 
+		/** return derivatives with respect to all elements of the specified
+		 * parameter, each summed up with the given weights
+		 *
+		 * \f[
+		 * r_i = \sum_{a,b} W_{ab} \frac{\partial K_{ab}}{\partial \theta_i}
+		 * \f]
+		 *
+		 * The default implementation computes one gradient matrix per
+		 * element, kernels can override this to evaluate all elements in a
+		 * single pass over the kernel matrix.
+		 *
+		 * @param param the parameter
+		 * @param weights matrix of size num_lhs x num_rhs
+		 *
+		 * @return weighted sum of the gradient for every element of param
+		 */
+		virtual SGVector<float64_t> get_parameter_gradient_sum(
+				const TParameter* param, SGMatrix<float64_t> weights);
+
 		/** Obtains a kernel from a generic SGObject with error checking. Note
 		 * that if passing NULL, result will be NULL
 		 * @param kernel Object to cast to CKernel, is *not* SG_REFed
@@ -0,0 +1,79 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "shogun/features/DenseFeatures.h"
+#include "shogun/kernel/GaussianKernel.h"
+#include "shogun/kernel/LinearKernel.h"
+#include "shogun/kernel/PolyKernel.h"
+#include "shogun/kernel/SigmoidKernel.h"
+#include "shogun/util/benchmark_data.h"
+
+namespace shogun
+{
+
+class KernelFixture : public benchmark::Fixture
+{
+public:
+	void SetUp(const ::benchmark::State& st)
+	{
+		auto data = benchmark_data::uniform_matrix(st.range(1), st.range(0));
+		f = new CDenseFeatures<float64_t>(data);
+		SG_REF(f);
+	}
+
+	void TearDown(const ::benchmark::State&)
+	{
+		SG_UNREF(f);
+	}
+
+	/** computes the full kernel matrix of the features with themselves */
+	void compute(benchmark::State& state, CKernel* kernel)
+	{
+		SG_REF(kernel);
+		kernel->init(f, f);
+		for (auto _ : state)
+			benchmark::DoNotOptimize(kernel->get_kernel_matrix().matrix);
+		state.SetItemsProcessed(
+		    int64_t(state.iterations()) * state.range(0) * state.range(0));
+		SG_UNREF(kernel);
+	}
+
+	CDenseFeatures<float64_t>* f;
+};
+
+BENCHMARK_DEFINE_F(KernelFixture, GaussianKernel)(benchmark::State& state)
+{
+	compute(state, new CGaussianKernel(10, 1.0));
+}
+
+BENCHMARK_DEFINE_F(KernelFixture, LinearKernel)(benchmark::State& state)
+{
+	compute(state, new CLinearKernel());
+}
+
+BENCHMARK_DEFINE_F(KernelFixture, PolyKernel)(benchmark::State& state)
+{
+	compute(state, new CPolyKernel(10, 3, true));
+}
+
+BENCHMARK_DEFINE_F(KernelFixture, SigmoidKernel)(benchmark::State& state)
+{
+	compute(state, new CSigmoidKernel(10, 0.01, 0.5));
+}
+
+// number of vectors x dimension
+#define ADD_KERNEL_ARGS(WHAT)                                                  \
+	BENCHMARK_REGISTER_F(KernelFixture, WHAT)                                  \
+	    ->RangeMultiplier(4)                                                   \
+	    ->Ranges({{256, 4096}, {16, 256}})                                     \
+	    ->Unit(benchmark::kMillisecond);
+
+ADD_KERNEL_ARGS(GaussianKernel)
+ADD_KERNEL_ARGS(LinearKernel)
+ADD_KERNEL_ARGS(PolyKernel)
+ADD_KERNEL_ARGS(SigmoidKernel)
+
+}
@@ -9,10 +9,13 @@
 #include <shogun/features/StringFeatures.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/kernel/string/CommUlongStringKernel.h>
+#include <shogun/kernel/string/KmerSpectrum.h>
 #include <shogun/lib/common.h>
 
 #include <shogun/kernel/normalizer/SqrtDiagKernelNormalizer.h>
 
+#include <vector>
+
 using namespace shogun;
 
 CCommUlongStringKernel::CCommUlongStringKernel(int32_t size, bool us)
@@ -230,9 +233,66 @@ bool CCommUlongStringKernel::init_optimization(
 
 	SG_DEBUG("initializing CCommUlongStringKernel optimization\n")
 
-	for (auto i : SG_PROGRESS(range(0, count)))
+	/* instead of merging every support vector into the dictionary, collect
+	 * the weighted k-mers of all of them in parallel and merge them at once
+	 * by sorting */
+	std::vector<uint64_t> kmers;
+	std::vector<float64_t> kmer_weights;
+
+	CStringFeatures<uint64_t>* str=(CStringFeatures<uint64_t>*) lhs;
+	auto pb=SG_PROGRESS(range(0, count));
+	#pragma omp parallel num_threads(parallel->get_num_threads())
 	{
-		add_to_normal(IDX[i], weights[i]);
+		std::vector<uint64_t> thread_kmers;
+		std::vector<float64_t> thread_weights;
+
+		#pragma omp for schedule(dynamic, 16)
+		for (int32_t i=0; i<count; i++)
+		{
+			SGVector<uint64_t> vec=str->get_feature_vector(IDX[i]);
+			int32_t last_j=0;
+
+			for (int32_t j=1; j<=vec.vlen; j++)
+			{
+				if (j<vec.vlen && vec[j]==vec[j-1])
+					continue;
+
+				float64_t weight=use_sign ? weights[i] : weights[i]*(j-last_j);
+				thread_kmers.push_back(vec[j-1]);
+				thread_weights.push_back(normalizer->normalize_lhs(weight, IDX[i]));
+				last_j=j;
+			}
+			pb.print_progress();
+		}
+
+		#pragma omp critical
+		{
+			kmers.insert(kmers.end(), thread_kmers.begin(), thread_kmers.end());
+			kmer_weights.insert(kmer_weights.end(), thread_weights.begin(),
+				thread_weights.end());
+		}
+	}
+	pb.complete();
+
+	if (!kmers.empty())
+	{
+		CMath::qsort_index(kmers.data(), kmer_weights.data(), kmers.size());
+
+		dictionary=SGVector<uint64_t>(kmers.size());
+		dictionary_weights=SGVector<float64_t>(kmers.size());
+		int32_t t=-1;
+		for (size_t k=0; k<kmers.size(); k++)
+		{
+			if (t<0 || dictionary[t]!=kmers[k])
+			{
+				t++;
+				dictionary[t]=kmers[k];
+				dictionary_weights[t]=0;
+			}
+			dictionary_weights[t]+=kmer_weights[k];
+		}
+		dictionary.resize_vector(t+1);
+		dictionary_weights.resize_vector(t+1);
 	}
 
 	SG_DEBUG("Done.         \n")
@@ -241,6 +301,34 @@ bool CCommUlongStringKernel::init_optimization(
 	return true;
 }
 
+SGMatrix<float64_t> CCommUlongStringKernel::get_spectrum_kernel_matrix()
+{
+	REQUIRE(has_features(), "no features assigned to kernel\n")
+
+	int32_t num_threads=parallel->get_num_threads();
+	KmerSpectrum<uint64_t> lhs_spectrum(
+		(CStringFeatures<uint64_t>*) lhs, use_sign, num_threads);
+
+	SGMatrix<float64_t> result;
+	if (lhs==rhs)
+		result=lhs_spectrum.dot(lhs_spectrum, num_threads);
+	else
+	{
+		KmerSpectrum<uint64_t> rhs_spectrum(
+			(CStringFeatures<uint64_t>*) rhs, use_sign, num_threads);
+		result=lhs_spectrum.dot(rhs_spectrum, num_threads);
+	}
+
+	#pragma omp parallel for num_threads(num_threads)
+	for (index_t j=0; j<result.num_cols; j++)
+	{
+		for (index_t i=0; i<result.num_rows; i++)
+			result(i, j)=normalizer->normalize(result(i, j), i, j);
+	}
+
+	return result;
+}
+
 bool CCommUlongStringKernel::delete_optimization()
 {
 	SG_DEBUG("deleting CCommUlongStringKernel optimization\n")
@@ -161,6 +161,17 @@ class CCommUlongStringKernel: public CStringKernel<uint64_t>
 		/** clear normal */
 		virtual void clear_normal();
 
+		/** compute the kernel matrix as product of the sparse k-mer spectra
+		 * of lhs and rhs, see KmerSpectrum
+		 *
+		 * Gives the same matrix as get_kernel_matrix(), but only visits
+		 * k-mers shared by two strings, which is much faster for many or
+		 * long strings. The strings do not need to be sorted.
+		 *
+		 * @return kernel matrix
+		 */
+		SGMatrix<float64_t> get_spectrum_kernel_matrix();
+
 		/** remove lhs from kernel */
 		virtual void remove_lhs();
 
@@ -12,6 +12,7 @@
 
 #include <shogun/features/StringFeatures.h>
 #include <shogun/kernel/string/CommWordStringKernel.h>
+#include <shogun/kernel/string/KmerSpectrum.h>
 
 #include <shogun/kernel/normalizer/SqrtDiagKernelNormalizer.h>
 
@@ -224,6 +225,13 @@ float64_t CCommWordStringKernel::compute_helper(
 }
 
 void CCommWordStringKernel::add_to_normal(int32_t vec_idx, float64_t weight)
+{
+	if (add_to_dictionary(vec_idx, weight, dictionary_weights))
+		set_is_initialized(true);
+}
+
+bool CCommWordStringKernel::add_to_dictionary(int32_t vec_idx, float64_t weight,
+	SGVector<float64_t> dictionary)
 {
 	int32_t len=-1;
 	bool free_vec;
@@ -240,11 +248,11 @@ void CCommWordStringKernel::add_to_normal(int32_t vec_idx, float64_t weight)
 				if (vec[j]==vec[j-1])
 					continue;
 
-				dictionary_weights[(int32_t) vec[j-1]]+=normalizer->
+				dictionary[(int32_t) vec[j-1]]+=normalizer->
 					normalize_lhs(weight, vec_idx);
 			}
 
-			dictionary_weights[(int32_t) vec[len-1]]+=normalizer->
+			dictionary[(int32_t) vec[len-1]]+=normalizer->
 				normalize_lhs(weight, vec_idx);
 		}
 		else
@@ -254,18 +262,18 @@ void CCommWordStringKernel::add_to_normal(int32_t vec_idx, float64_t weight)
 				if (vec[j]==vec[j-1])
 					continue;
 
-				dictionary_weights[(int32_t) vec[j-1]]+=normalizer->
+				dictionary[(int32_t) vec[j-1]]+=normalizer->
 					normalize_lhs(weight*(j-last_j), vec_idx);
 				last_j = j;
 			}
 
-			dictionary_weights[(int32_t) vec[len-1]]+=normalizer->
+			dictionary[(int32_t) vec[len-1]]+=normalizer->
 				normalize_lhs(weight*(len-last_j), vec_idx);
 		}
-		set_is_initialized(true);
 	}
 
 	((CStringFeatures<uint16_t>*) lhs)->free_feature_vector(vec, vec_idx, free_vec);
+	return len>0;
 }
 
 void CCommWordStringKernel::clear_normal()
@@ -288,15 +296,60 @@ bool CCommWordStringKernel::init_optimization(
 
 	SG_DEBUG("initializing CCommWordStringKernel optimization\n")
 
-	for (auto i : SG_PROGRESS(range(0, count)))
+	// every thread fills its own dictionary, they are summed up afterwards
+	auto pb=SG_PROGRESS(range(0, count));
+	#pragma omp parallel num_threads(parallel->get_num_threads())
 	{
-		add_to_normal(IDX[i], weights[i]);
+		SGVector<float64_t> dictionary(dictionary_weights.vlen);
+		dictionary.zero();
+
+		#pragma omp for schedule(dynamic, 16)
+		for (int32_t i=0; i<count; i++)
+		{
+			add_to_dictionary(IDX[i], weights[i], dictionary);
+			pb.print_progress();
+		}
+
+		#pragma omp critical
+		{
+			for (index_t k=0; k<dictionary.vlen; k++)
+				dictionary_weights[k]+=dictionary[k];
+		}
 	}
+	pb.complete();
 
 	set_is_initialized(true);
 	return true;
 }
 
+SGMatrix<float64_t> CCommWordStringKernel::get_spectrum_kernel_matrix()
+{
+	REQUIRE(has_features(), "no features assigned to kernel\n")
+
+	int32_t num_threads=parallel->get_num_threads();
+	KmerSpectrum<uint16_t> lhs_spectrum(
+		(CStringFeatures<uint16_t>*) lhs, use_sign, num_threads);
+
+	SGMatrix<float64_t> result;
+	if (lhs==rhs)
+		result=lhs_spectrum.dot(lhs_spectrum, num_threads);
+	else
+	{
+		KmerSpectrum<uint16_t> rhs_spectrum(
+			(CStringFeatures<uint16_t>*) rhs, use_sign, num_threads);
+		result=lhs_spectrum.dot(rhs_spectrum, num_threads);
+	}
+
+	#pragma omp parallel for num_threads(num_threads)
+	for (index_t j=0; j<result.num_cols; j++)
+	{
+		for (index_t i=0; i<result.num_rows; i++)
+			result(i, j)=normalizer->normalize(result(i, j), i, j);
+	}
+
+	return result;
+}
+
 bool CCommWordStringKernel::delete_optimization()
 {
 	SG_DEBUG("deleting CCommWordStringKernel optimization\n")
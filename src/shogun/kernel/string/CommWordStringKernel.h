@@ -137,6 +137,17 @@ class CCommWordStringKernel : public CStringKernel<uint16_t>
 		/** clear normal */
 		virtual void clear_normal();
 
+		/** compute the kernel matrix as product of the sparse k-mer spectra
+		 * of lhs and rhs, see KmerSpectrum
+		 *
+		 * Gives the same matrix as get_kernel_matrix(), but only visits
+		 * k-mers shared by two strings, which is much faster for many or
+		 * long strings. The strings do not need to be sorted.
+		 *
+		 * @return kernel matrix
+		 */
+		SGMatrix<float64_t> get_spectrum_kernel_matrix();
+
 		/** return feature type the kernel can deal with
 		 *
 		 * @return feature type WORD
@@ -230,6 +241,16 @@ class CCommWordStringKernel : public CStringKernel<uint16_t>
 		 */
 		virtual float64_t compute_diag(int32_t idx_a);
 
+		/** add the counts of the k-mers of a string to a dictionary
+		 *
+		 * @param idx index of the string in lhs
+		 * @param weight weight of the string
+		 * @param dictionary dictionary to add to
+		 * @return if the string contains any k-mers
+		 */
+		bool add_to_dictionary(int32_t idx, float64_t weight,
+			SGVector<float64_t> dictionary);
+
 	private:
 		void init();
 
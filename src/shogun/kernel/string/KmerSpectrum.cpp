@@ -0,0 +1,128 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/features/StringFeatures.h>
+#include <shogun/kernel/string/KmerSpectrum.h>
+#include <shogun/mathematics/Math.h>
+
+#include <algorithm>
+
+using namespace shogun;
+
+template <class ST>
+KmerSpectrum<ST>::KmerSpectrum() : offsets(1)
+{
+	offsets[0]=0;
+}
+
+template <class ST>
+KmerSpectrum<ST>::KmerSpectrum(CStringFeatures<ST>* features, bool use_sign,
+	int32_t num_threads)
+{
+	REQUIRE(features, "No features given.\n")
+
+	int32_t num_vectors=features->get_num_vectors();
+	offsets=SGVector<index_t>(num_vectors+1);
+	offsets[0]=0;
+
+	// sort a copy of every string and count its distinct k-mers
+	SGVector<ST>* sorted=new SGVector<ST>[num_vectors];
+
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(num_threads)
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		SGVector<ST> vec=features->get_feature_vector(i);
+		CMath::radix_sort(vec.vector, vec.vlen);
+
+		index_t num_distinct=0;
+		for (index_t j=0; j<vec.vlen; j++)
+		{
+			if (j==0 || vec[j]!=vec[j-1])
+				num_distinct++;
+		}
+
+		sorted[i]=vec;
+		offsets[i+1]=num_distinct;
+	}
+
+	for (int32_t i=0; i<num_vectors; i++)
+		offsets[i+1]+=offsets[i];
+
+	kmers=SGVector<ST>(offsets[num_vectors]);
+	counts=SGVector<float64_t>(offsets[num_vectors]);
+
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(num_threads)
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		const SGVector<ST>& vec=sorted[i];
+		index_t entry=offsets[i]-1;
+
+		for (index_t j=0; j<vec.vlen; j++)
+		{
+			if (j==0 || vec[j]!=vec[j-1])
+			{
+				entry++;
+				kmers[entry]=vec[j];
+				counts[entry]=0;
+			}
+
+			if (!use_sign)
+				counts[entry]++;
+			else
+				counts[entry]=1;
+		}
+	}
+
+	delete[] sorted;
+}
+
+template <class ST>
+SGMatrix<float64_t> KmerSpectrum<ST>::dot(const KmerSpectrum<ST>& rhs,
+	int32_t num_threads) const
+{
+	int32_t num_lhs=get_num_vectors();
+	int32_t num_rhs=rhs.get_num_vectors();
+	index_t num_entries=rhs.get_num_entries();
+
+	// inverted index of the right-hand side: its entries sorted by k-mer
+	SGVector<ST> index_kmers=rhs.kmers.clone();
+	SGVector<index_t> index_entries(num_entries);
+	index_entries.range_fill();
+	if (num_entries>0)
+		CMath::qsort_index(index_kmers.vector, index_entries.vector, num_entries);
+
+	SGVector<int32_t> entry_rows(num_entries);
+	for (int32_t j=0; j<num_rhs; j++)
+	{
+		for (index_t e=rhs.offsets[j]; e<rhs.offsets[j+1]; e++)
+			entry_rows[e]=j;
+	}
+
+	SGMatrix<float64_t> result(num_lhs, num_rhs);
+	const ST* first=index_kmers.vector;
+	const ST* last=index_kmers.vector+num_entries;
+
+	// every thread owns the rows of its left-hand side strings
+	#pragma omp parallel for schedule(dynamic, 16) num_threads(num_threads)
+	for (int32_t i=0; i<num_lhs; i++)
+	{
+		// k-mers of a string are ascending, so the search can start
+		// where the previous one ended
+		const ST* pos=first;
+		for (index_t e=offsets[i]; e<offsets[i+1]; e++)
+		{
+			pos=std::lower_bound(pos, last, kmers[e]);
+			for (const ST* p=pos; p<last && *p==kmers[e]; p++)
+			{
+				index_t entry=index_entries[p-first];
+				result(i, entry_rows[entry])+=counts[e]*rhs.counts[entry];
+			}
+		}
+	}
+
+	return result;
+}
+
+template class KmerSpectrum<uint16_t>;
+template class KmerSpectrum<uint64_t>;
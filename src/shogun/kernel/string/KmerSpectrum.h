@@ -0,0 +1,72 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef _KMERSPECTRUM_H___
+#define _KMERSPECTRUM_H___
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+
+namespace shogun
+{
+template <class ST> class CStringFeatures;
+
+/** @brief Sparse k-mer spectrum of strings of k-mers, as used by the
+ * CommWordString and CommUlongString kernels.
+ *
+ * Every string is represented by its distinct k-mers in ascending order and
+ * how often each of them appears, stored row-wise like a compressed sparse
+ * matrix. The spectrum kernel matrix of two sets of strings is the product
+ * of their spectra, which dot() computes by looking up the k-mers of every
+ * left-hand side string in an inverted index of the right-hand side. Its
+ * cost is proportional to the number of shared k-mers instead of to the
+ * total length of all pairs of strings.
+ */
+template <class ST> class KmerSpectrum
+{
+	public:
+		/** default constructor */
+		KmerSpectrum();
+
+		/** constructor, sorts the k-mers of every string in parallel
+		 *
+		 * @param features strings of k-mers, do not need to be sorted
+		 * @param use_sign whether to count every k-mer only once per string
+		 * @param num_threads number of threads
+		 */
+		KmerSpectrum(CStringFeatures<ST>* features, bool use_sign,
+			int32_t num_threads=1);
+
+		/** @return number of strings */
+		int32_t get_num_vectors() const { return offsets.vlen-1; }
+
+		/** @return number of distinct k-mers summed over all strings */
+		int32_t get_num_entries() const { return kmers.vlen; }
+
+		/** compute the spectrum kernel of all pairs of strings
+		 *
+		 * @param rhs spectrum of the right-hand side strings
+		 * @param num_threads number of threads
+		 * @return matrix with the (unnormalized) kernel of every string of
+		 * this spectrum with every string of rhs
+		 */
+		SGMatrix<float64_t> dot(const KmerSpectrum<ST>& rhs,
+			int32_t num_threads=1) const;
+
+	public:
+		/** index of the first k-mer of every string, followed by the
+		 * number of entries */
+		SGVector<index_t> offsets;
+
+		/** distinct k-mers of every string, ascending */
+		SGVector<ST> kmers;
+
+		/** number of occurrences of every k-mer, 1 when using the sign */
+		SGVector<float64_t> counts;
+};
+}
+#endif /* _KMERSPECTRUM_H___ */
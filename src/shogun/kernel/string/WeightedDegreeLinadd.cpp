@@ -0,0 +1,142 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/kernel/string/WeightedDegreeLinadd.h>
+#include <shogun/features/Alphabet.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/mathematics/Math.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace shogun;
+
+void WeightedDegreeLinadd::reset()
+{
+	m_alphas=SGVector<float64_t>();
+	m_idx=SGVector<int32_t>();
+	m_weights=SGVector<float64_t>();
+}
+
+void WeightedDegreeLinadd::store(int32_t num_lhs, int32_t count,
+	int32_t* IDX, float64_t* alphas, float64_t* weights, int32_t num_weights)
+{
+	m_alphas=SGVector<float64_t>(num_lhs);
+	m_alphas.zero();
+	for (int32_t i=0; i<count; i++)
+		m_alphas[IDX[i]]+=alphas[i];
+
+	m_idx=SGVector<int32_t>(IDX, count, false).clone();
+	m_weights=SGVector<float64_t>(weights, num_weights, false).clone();
+}
+
+bool WeightedDegreeLinadd::update(int32_t num_lhs, int32_t count,
+	int32_t* IDX, float64_t* alphas, float64_t* weights, int32_t num_weights,
+	const AddExample& add_example)
+{
+	if (m_alphas.vlen!=num_lhs || m_weights.vlen!=num_weights ||
+			!std::equal(weights, weights+num_weights, m_weights.vector))
+		return false;
+
+	SGVector<float64_t> new_alphas(num_lhs);
+	new_alphas.zero();
+	for (int32_t i=0; i<count; i++)
+		new_alphas[IDX[i]]+=alphas[i];
+
+	// collect the differences on the union of old and new examples,
+	// m_alphas is updated on the way to skip duplicate indices
+	std::vector<std::pair<int32_t, float64_t> > changes;
+	for (auto idx : m_idx)
+	{
+		if (new_alphas[idx]!=m_alphas[idx])
+		{
+			changes.push_back(std::make_pair(idx, new_alphas[idx]-m_alphas[idx]));
+			m_alphas[idx]=new_alphas[idx];
+		}
+	}
+	for (int32_t i=0; i<count; i++)
+	{
+		int32_t idx=IDX[i];
+		if (new_alphas[idx]!=m_alphas[idx])
+		{
+			changes.push_back(std::make_pair(idx, new_alphas[idx]-m_alphas[idx]));
+			m_alphas[idx]=new_alphas[idx];
+		}
+	}
+
+	// rebuilding is cheaper when most of the examples changed
+	if (2*int64_t(changes.size())>count)
+		return false;
+
+	SG_SDEBUG("updating tries with %d changed alphas\n", int32_t(changes.size()))
+	for (auto& change : changes)
+		add_example(change.first, change.second);
+
+	m_idx=SGVector<int32_t>(IDX, count, false).clone();
+	return true;
+}
+
+void WeightedDegreeLinadd::add_examples_parallel(CTrie<DNATrie>& tries,
+	CStringFeatures<char>* features, CAlphabet* alphabet, int32_t count,
+	int32_t* IDX, float64_t* alphas, int32_t seq_length, int32_t degree,
+	bool use_compact, int32_t margin_before, int32_t margin_after,
+	int32_t num_threads, const AddToTrie& add_to_trie)
+{
+	ASSERT(alphabet)
+	ASSERT(alphabet->get_alphabet()==DNA || alphabet->get_alphabet()==RNA)
+
+	int32_t step=seq_length/num_threads;
+
+	// the trees of different positions do not share any nodes, so each
+	// thread fills a private trie for its range of positions
+	CTrie<DNATrie>** thread_tries=SG_MALLOC(CTrie<DNATrie>*, num_threads);
+	for (int32_t t=0; t<num_threads; t++)
+	{
+		thread_tries[t]=new CTrie<DNATrie>(degree, use_compact);
+		thread_tries[t]->create(seq_length, use_compact);
+	}
+
+	#pragma omp parallel for num_threads(num_threads)
+	for (int32_t t=0; t<num_threads; t++)
+	{
+		int32_t start=t*step;
+		int32_t end=(t==num_threads-1) ? seq_length : start+step;
+		int32_t* vec=SG_MALLOC(int32_t, seq_length);
+
+		for (int32_t k=0; k<count; k++)
+		{
+			if (alphas[k]==0.0)
+				continue;
+
+			int32_t len=0;
+			bool free_vec;
+			char* char_vec=features->get_feature_vector(IDX[k], len, free_vec);
+
+			int32_t first=CMath::max(0, start-margin_before);
+			int32_t last=CMath::min(end+margin_after, len);
+			for (int32_t j=first; j<last; j++)
+				vec[j]=alphabet->remap_to_bin(char_vec[j]);
+			features->free_feature_vector(char_vec, IDX[k], free_vec);
+
+			add_to_trie(thread_tries[t], start, end, k, vec, len);
+		}
+
+		SG_FREE(vec);
+	}
+
+	int32_t num_nodes=tries.get_num_used_nodes();
+	for (int32_t t=0; t<num_threads; t++)
+		num_nodes+=thread_tries[t]->get_num_used_nodes();
+	tries.reserve_treemem(num_nodes);
+
+	for (int32_t t=0; t<num_threads; t++)
+	{
+		int32_t start=t*step;
+		int32_t end=(t==num_threads-1) ? seq_length : start+step;
+		tries.merge_trees(*thread_tries[t], start, end);
+		SG_UNREF(thread_tries[t]);
+	}
+	SG_FREE(thread_tries);
+}
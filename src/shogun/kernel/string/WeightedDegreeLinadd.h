@@ -0,0 +1,106 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef _WEIGHTEDDEGREELINADD_H___
+#define _WEIGHTEDDEGREELINADD_H___
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/Trie.h>
+
+#include <functional>
+
+namespace shogun
+{
+class CAlphabet;
+template <class ST> class CStringFeatures;
+
+/** @brief linadd helper shared by the weighted degree string kernels
+ *
+ * Remembers the alphas and weights the tries of a kernel were built from, so
+ * that init_optimization() can add the differences to the tries instead of
+ * rebuilding them when only few alphas changed, and builds the tries of
+ * contiguous ranges of positions in parallel.
+ */
+class WeightedDegreeLinadd
+{
+public:
+	/** adds an example with a weight to the tries */
+	typedef std::function<void(int32_t idx, float64_t alpha)> AddExample;
+
+	/** adds the example with the given number to the trees of the positions
+	 * [start,end) of a trie, given the remapped symbols vec of the example,
+	 * which are valid around that range only, and its length len
+	 */
+	typedef std::function<void(CTrie<DNATrie>* trie, int32_t start,
+		int32_t end, int32_t k, int32_t* vec, int32_t len)> AddToTrie;
+
+	/** forget the alphas the tries were built from */
+	void reset();
+
+	/** remember the alphas the tries were built from
+	 *
+	 * @param num_lhs number of lhs vectors
+	 * @param count number of examples
+	 * @param IDX indices of examples
+	 * @param alphas weights of examples
+	 * @param weights kernel weights
+	 * @param num_weights number of kernel weights
+	 */
+	void store(int32_t num_lhs, int32_t count, int32_t* IDX,
+		float64_t* alphas, float64_t* weights, int32_t num_weights);
+
+	/** update the tries by adding the difference between the given alphas
+	 * and the ones they were built from
+	 *
+	 * @param num_lhs number of lhs vectors
+	 * @param count number of examples
+	 * @param IDX indices of examples
+	 * @param alphas weights of examples
+	 * @param weights kernel weights
+	 * @param num_weights number of kernel weights
+	 * @param add_example adds a changed example to the tries
+	 * @return false if the tries need to be rebuilt from scratch
+	 */
+	bool update(int32_t num_lhs, int32_t count, int32_t* IDX,
+		float64_t* alphas, float64_t* weights, int32_t num_weights,
+		const AddExample& add_example);
+
+	/** add examples to tries in parallel
+	 *
+	 * Every thread builds the trees of a contiguous range of positions in a
+	 * private trie, which are merged into tries afterwards.
+	 *
+	 * @param tries tries to add to
+	 * @param features string features of the examples
+	 * @param alphabet DNA or RNA alphabet of the features
+	 * @param count number of examples
+	 * @param IDX indices of examples
+	 * @param alphas weights of examples, examples of weight 0 are skipped
+	 * @param seq_length number of trees
+	 * @param degree degree of the tries
+	 * @param use_compact if compact terminal nodes are used
+	 * @param margin_before symbols before a range that are remapped
+	 * @param margin_after symbols after a range that are remapped
+	 * @param num_threads number of threads
+	 * @param add_to_trie adds an example to a range of trees
+	 */
+	static void add_examples_parallel(CTrie<DNATrie>& tries,
+		CStringFeatures<char>* features, CAlphabet* alphabet, int32_t count,
+		int32_t* IDX, float64_t* alphas, int32_t seq_length, int32_t degree,
+		bool use_compact, int32_t margin_before, int32_t margin_after,
+		int32_t num_threads, const AddToTrie& add_to_trie);
+
+private:
+	/** alphas (per lhs vector) the tries were built from */
+	SGVector<float64_t> m_alphas;
+	/** indices of the examples the tries were built from */
+	SGVector<int32_t> m_idx;
+	/** weights the tries were built with */
+	SGVector<float64_t> m_weights;
+};
+}
+#endif // _WEIGHTEDDEGREELINADD_H___
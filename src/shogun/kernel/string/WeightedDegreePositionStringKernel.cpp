@@ -171,6 +171,8 @@ void CWeightedDegreePositionStringKernel::create_empty_tries()
 	}
 	else
 		SG_ERROR("unknown optimization type\n")
+
+	linadd.reset();
 }
 
 bool CWeightedDegreePositionStringKernel::init(CFeatures* l, CFeatures* r)
@@ -258,6 +260,18 @@ bool CWeightedDegreePositionStringKernel::init_optimization(
 		return false ;
 	}
 
+	if (tree_num<0 && incremental_linadd && get_is_initialized() &&
+			linadd.update(num_lhs, p_count, IDX, alphas, weights,
+				weights_degree*weights_length,
+				[this](int32_t idx, float64_t alpha)
+				{
+					add_example_to_tree(idx, alpha);
+				}))
+	{
+		SG_DEBUG("updated CWeightedDegreePositionStringKernel optimization\n")
+		return true;
+	}
+
 	if (tree_num<0)
 		SG_DEBUG("deleting CWeightedDegreePositionStringKernel optimization\n")
 
@@ -266,25 +280,39 @@ bool CWeightedDegreePositionStringKernel::init_optimization(
 	if (tree_num<0)
 		SG_DEBUG("initializing CWeightedDegreePositionStringKernel optimization\n")
 
-	for (auto i : SG_PROGRESS(range(p_count)))
+	int32_t num_threads=parallel->get_num_threads();
+	if (tree_num<0 && !use_poim_tries && num_threads>1 && seq_length>=num_threads)
+		add_examples_to_tree_parallel(p_count, IDX, alphas, num_threads);
+	else
 	{
-		if (tree_num<0)
+		for (auto i : SG_PROGRESS(range(p_count)))
 		{
-			add_example_to_tree(IDX[i], alphas[i]);
-		}
-		else
-		{
-			for (int32_t t=tree_num; t<=upto_tree; t++)
-				add_example_to_single_tree(IDX[i], alphas[i], t);
+			if (tree_num<0)
+			{
+				add_example_to_tree(IDX[i], alphas[i]);
+			}
+			else
+			{
+				for (int32_t t=tree_num; t<=upto_tree; t++)
+					add_example_to_single_tree(IDX[i], alphas[i], t);
+			}
 		}
 	}
 
+	if (tree_num<0 && lhs)
+	{
+		linadd.store(num_lhs, p_count, IDX, alphas, weights,
+			weights_degree*weights_length);
+	}
+
 	set_is_initialized(true) ;
 	return true ;
 }
 
 bool CWeightedDegreePositionStringKernel::delete_optimization()
 {
+	linadd.reset();
+
 	if ((opt_type==FASTBUTMEMHUNGRY) && (tries.get_use_compact_terminal_nodes()))
 	{
 		tries.set_use_compact_terminal_nodes(false) ;
@@ -685,6 +713,50 @@ void CWeightedDegreePositionStringKernel::add_example_to_tree(
 	tree_initialized=true ;
 }
 
+void CWeightedDegreePositionStringKernel::add_examples_to_tree_parallel(
+	int32_t count, int32_t* IDX, float64_t* alphas, int32_t num_threads)
+{
+	ASSERT(position_weights_lhs==NULL)
+	ASSERT(position_weights_rhs==NULL)
+	ASSERT(max_mismatch==0)
+
+	if (opt_type!=SLOWBUTMEMEFFICIENT && opt_type!=FASTBUTMEMHUNGRY)
+		SG_ERROR("unknown optimization type\n")
+
+	// trees in a range see k-mers shifted by up to max_shift
+	int32_t shift_range=(opt_type==FASTBUTMEMHUNGRY) ? max_shift : 0;
+	WeightedDegreeLinadd::add_examples_parallel(tries,
+		(CStringFeatures<char>*) lhs, alphabet, count, IDX, alphas,
+		seq_length, degree, tries.get_use_compact_terminal_nodes(),
+		shift_range, shift_range+degree, num_threads,
+		[&](CTrie<DNATrie>* trie, int32_t start, int32_t end, int32_t k,
+			int32_t* vec, int32_t len)
+		{
+			int32_t idx=IDX[k];
+			int32_t first=CMath::max(0, start-shift_range);
+
+			// same order of additions per tree as in add_example_to_tree()
+			for (int32_t i=first; i<end && i<len; i++)
+			{
+				int32_t max_s=(opt_type==FASTBUTMEMHUNGRY) ? shift[i] : 0;
+
+				for (int32_t s=max_s; s>=0; s--)
+				{
+					float64_t alpha_pw=normalizer->normalize_lhs(
+						(s==0) ? (alphas[k]) : (alphas[k]/(2.0*s)), idx);
+					if (i>=start)
+						trie->add_to_trie(i, s, vec, alpha_pw, weights, (length!=0));
+					if ((s==0) || (i+s>=len) || (i+s<start) || (i+s>=end))
+						continue;
+
+					trie->add_to_trie(i+s, -s, vec, alpha_pw, weights, (length!=0));
+				}
+			}
+		});
+
+	tree_initialized=true;
+}
+
 void CWeightedDegreePositionStringKernel::add_example_to_single_tree(
 	int32_t idx, float64_t alpha, int32_t tree_num)
 {
@@ -830,6 +902,7 @@ float64_t* CWeightedDegreePositionStringKernel::compute_abs_weights(
 void CWeightedDegreePositionStringKernel::set_shifts(SGVector<int32_t> shifts)
 {
 	SG_FREE(shift);
+	linadd.reset();
 
 	shift_len = shifts.vlen;
 	shift = SG_MALLOC(int32_t, shift_len);
@@ -1908,6 +1981,7 @@ void CWeightedDegreePositionStringKernel::init()
 
 	tree_initialized=false;
 	use_poim_tries=false;
+	incremental_linadd=true;
 	m_poim_distrib=NULL;
 
 	m_poim=NULL;
@@ -1956,6 +2030,8 @@ void CWeightedDegreePositionStringKernel::init()
 			"Number of allowed mismatches.", ParameterProperties::HYPER);
 	SG_ADD(&block_computation, "block_computation",
 			"If block computation shall be used.");
+	SG_ADD(&incremental_linadd, "incremental_linadd",
+			"If tries shall be updated incrementally.");
 	SG_ADD((machine_int_t*) &type, "type",
 			"WeightedDegree kernel type.", ParameterProperties::HYPER);
 	SG_ADD(&which_degree, "which_degree",
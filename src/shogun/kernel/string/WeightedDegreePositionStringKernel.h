@@ -14,6 +14,7 @@
 #include <shogun/kernel/string/StringKernel.h>
 #include <shogun/kernel/string/WeightedDegreeStringKernel.h>
 #include <shogun/lib/Trie.h>
+#include <shogun/kernel/string/WeightedDegreeLinadd.h>
 
 namespace shogun
 {
@@ -142,6 +143,16 @@ class CWeightedDegreePositionStringKernel: public CStringKernel<char>
 		 */
 		virtual bool delete_optimization();
 
+		/** set optimization type
+		 *
+		 * @param t optimization type to set
+		 */
+		virtual void set_optimization_type(EOptimizationType t)
+		{
+			linadd.reset();
+			CStringKernel<char>::set_optimization_type(t);
+		}
+
 		/** compute optimized
 		*
 		* @param idx index to compute
@@ -198,6 +209,7 @@ class CWeightedDegreePositionStringKernel: public CStringKernel<char>
 
 				set_is_initialized(false);
 			}
+			linadd.reset();
 		}
 
 		/** add to normal
@@ -208,6 +220,7 @@ class CWeightedDegreePositionStringKernel: public CStringKernel<char>
 		virtual void add_to_normal(int32_t idx, float64_t weight)
 		{
 			add_example_to_tree(idx, weight);
+			linadd.reset();
 			set_is_initialized(true);
 		}
 
@@ -596,10 +609,42 @@ class CWeightedDegreePositionStringKernel: public CStringKernel<char>
 		/// cleanup POIM2
 		void cleanup_POIM2();
 
+		/** set if the tries shall be updated incrementally
+		 *
+		 * If enabled, init_optimization() only adds the changes w.r.t. the
+		 * alphas the tries were last built from when few of them changed
+		 * (e.g. between two SVM optimization rounds) instead of rebuilding
+		 * the tries from scratch.
+		 *
+		 * @param incremental if tries shall be updated incrementally
+		 */
+		inline void set_incremental_linadd(bool incremental)
+		{
+			incremental_linadd=incremental;
+		}
+
+		/** check if the tries are updated incrementally
+		 *
+		 * @return if tries are updated incrementally
+		 */
+		inline bool get_incremental_linadd() { return incremental_linadd; }
+
 	protected:
 		/** create emtpy tries */
 		void create_empty_tries();
 
+		/** add examples to tree in parallel, see
+		 * WeightedDegreeLinadd::add_examples_parallel()
+		 *
+		 * @param count number of examples
+		 * @param IDX indices of examples
+		 * @param alphas weights of examples
+		 * @param num_threads number of threads
+		 */
+		void add_examples_to_tree_parallel(
+			int32_t count, int32_t* IDX, float64_t* alphas,
+			int32_t num_threads);
+
 		/** add example to tree
 		 *
 		 * @param idx index
@@ -758,6 +803,11 @@ class CWeightedDegreePositionStringKernel: public CStringKernel<char>
 		/** makes add_example_to_tree (ONLY!) use POIMTrie */
 		bool use_poim_tries;
 
+		/** if tries are updated incrementally */
+		bool incremental_linadd;
+		/** alphas and weights the tries were built from */
+		WeightedDegreeLinadd linadd;
+
 		/** temporary memory for the interface to the poim functions */
 		float64_t* m_poim_distrib;
 		/** temporary memory for the interface to the poim functions */
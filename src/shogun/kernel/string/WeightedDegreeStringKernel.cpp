@@ -133,6 +133,7 @@ void CWeightedDegreeStringKernel::create_empty_tries()
 		tries->destroy() ;
 		tries->create(seq_length, max_mismatch==0) ;
 	}
+	linadd.reset();
 }
 
 bool CWeightedDegreeStringKernel::init(CFeatures* l, CFeatures* r)
@@ -203,6 +204,21 @@ void CWeightedDegreeStringKernel::cleanup()
 
 bool CWeightedDegreeStringKernel::init_optimization(int32_t count, int32_t* IDX, float64_t* alphas, int32_t tree_num)
 {
+	if (tree_num<0 && incremental_linadd && get_is_initialized() &&
+			linadd.update(num_lhs, count, IDX, alphas, weights,
+				weights_degree*weights_length,
+				[this](int32_t idx, float64_t alpha)
+				{
+					if (max_mismatch==0)
+						add_example_to_tree(idx, alpha);
+					else
+						add_example_to_tree_mismatch(idx, alpha);
+				}))
+	{
+		SG_DEBUG("updated CWeightedDegreeStringKernel optimization\n")
+		return true;
+	}
+
 	if (tree_num<0)
 		SG_DEBUG("deleting CWeightedDegreeStringKernel optimization\n")
 
@@ -211,35 +227,49 @@ bool CWeightedDegreeStringKernel::init_optimization(int32_t count, int32_t* IDX,
 	if (tree_num<0)
 		SG_DEBUG("initializing CWeightedDegreeStringKernel optimization\n")
 
-	for (auto i : SG_PROGRESS(range(count)))
+	int32_t num_threads=parallel->get_num_threads();
+	if (tree_num<0 && num_threads>1 && seq_length>=num_threads)
+		add_examples_to_tree_parallel(count, IDX, alphas, num_threads);
+	else
 	{
-		if (tree_num<0)
+		for (auto i : SG_PROGRESS(range(count)))
 		{
+			if (tree_num<0)
+			{
 
-			if (max_mismatch==0)
-				add_example_to_tree(IDX[i], alphas[i]) ;
-			else
-				add_example_to_tree_mismatch(IDX[i], alphas[i]) ;
+				if (max_mismatch==0)
+					add_example_to_tree(IDX[i], alphas[i]) ;
+				else
+					add_example_to_tree_mismatch(IDX[i], alphas[i]) ;
 
-			//SG_DEBUG("number of used trie nodes: %i\n", tries.get_num_used_nodes())
-		}
-		else
-		{
-			if (max_mismatch==0)
-				add_example_to_single_tree(IDX[i], alphas[i], tree_num) ;
+				//SG_DEBUG("number of used trie nodes: %i\n", tries.get_num_used_nodes())
+			}
 			else
-				add_example_to_single_tree_mismatch(IDX[i], alphas[i], tree_num) ;
+			{
+				if (max_mismatch==0)
+					add_example_to_single_tree(IDX[i], alphas[i], tree_num) ;
+				else
+					add_example_to_single_tree_mismatch(IDX[i], alphas[i], tree_num) ;
+			}
 		}
 	}
 
 	//tries.compact_nodes(NO_CHILD, 0, weights) ;
 
+	if (tree_num<0 && lhs)
+	{
+		linadd.store(num_lhs, count, IDX, alphas, weights,
+			weights_degree*weights_length);
+	}
+
 	set_is_initialized(true) ;
 	return true ;
 }
 
 bool CWeightedDegreeStringKernel::delete_optimization()
 {
+	linadd.reset();
+
 	if (get_is_initialized())
 	{
 		if (tries!=NULL)
@@ -251,6 +281,35 @@ bool CWeightedDegreeStringKernel::delete_optimization()
 	return false;
 }
 
+void CWeightedDegreeStringKernel::add_examples_to_tree_parallel(
+	int32_t count, int32_t* IDX, float64_t* alphas, int32_t num_threads)
+{
+	ASSERT(tries)
+
+	// k-mers starting in a range reach degree-1 symbols further
+	WeightedDegreeLinadd::add_examples_parallel(*tries,
+		(CStringFeatures<char>*) lhs, alphabet, count, IDX, alphas,
+		seq_length, degree, max_mismatch==0, 0, degree, num_threads,
+		[&](CTrie<DNATrie>* trie, int32_t start, int32_t end, int32_t k,
+			int32_t* vec, int32_t len)
+		{
+			float64_t alpha=normalizer->normalize_lhs(alphas[k], IDX[k]);
+			for (int32_t j=start; j<end && j<len; j++)
+			{
+				if (max_mismatch==0)
+				{
+					trie->add_to_trie(j, 0, vec, alpha, weights, (length!=0));
+				}
+				else
+				{
+					trie->add_example_to_tree_mismatch_recursion(NO_CHILD, j,
+							alpha, &vec[j], len-j, 0, 0, max_mismatch, weights);
+				}
+			}
+		});
+
+	tree_initialized=true;
+}
 
 float64_t CWeightedDegreeStringKernel::compute_with_mismatch(
 	char* avec, int32_t alen, char* bvec, int32_t blen)
@@ -306,6 +365,48 @@ float64_t CWeightedDegreeStringKernel::compute_using_block(
 	return sum;
 }
 
+float64_t CWeightedDegreeStringKernel::compute_using_block_packed(
+	const uint64_t* avec, int32_t alen, const uint64_t* bvec, int32_t blen,
+	int32_t bits)
+{
+	ASSERT(alen==blen)
+
+	const int32_t symbols_per_word=64/bits;
+	uint64_t lowest_bits=0;
+	for (int32_t i=0; i<symbols_per_word; i++)
+		lowest_bits|=((uint64_t) 1) << (i*bits);
+
+	float64_t sum=0;
+	int32_t match_start=0;
+
+	for (int32_t w=0; w*symbols_per_word<alen; w++)
+	{
+		// collapse the differing bits of every symbol into its lowest bit
+		uint64_t diff=avec[w]^bvec[w];
+		uint64_t mismatch=diff;
+		for (int32_t b=1; b<bits; b++)
+			mismatch|=diff>>b;
+		mismatch&=lowest_bits;
+
+		// unused symbols of the last word are zero in both strings
+		for (int32_t i=0; mismatch; i++, mismatch>>=bits)
+		{
+			if (!(mismatch & 1))
+				continue;
+
+			int32_t pos=w*symbols_per_word+i;
+			if (pos>match_start)
+				sum+=block_weights[pos-match_start-1];
+			match_start=pos+1;
+		}
+	}
+
+	if (alen>match_start)
+		sum+=block_weights[alen-match_start-1];
+
+	return sum;
+}
+
 float64_t CWeightedDegreeStringKernel::compute_without_mismatch(
 	char* avec, int32_t alen, char* bvec, int32_t blen)
 {
@@ -357,6 +458,20 @@ float64_t CWeightedDegreeStringKernel::compute(int32_t idx_a, int32_t idx_b)
 {
 	int32_t alen, blen;
 	bool free_avec, free_bvec;
+
+	CStringFeatures<char>* lhs_str=(CStringFeatures<char>*) lhs;
+	CStringFeatures<char>* rhs_str=(CStringFeatures<char>*) rhs;
+	if (max_mismatch==0 && length==0 && block_computation &&
+			lhs_str->is_packed() &&
+			lhs_str->get_packed_bits()==rhs_str->get_packed_bits())
+	{
+		// equal codes are equal symbols, compare whole words at once
+		const uint64_t* avec=lhs_str->get_packed_vector(idx_a, alen);
+		const uint64_t* bvec=rhs_str->get_packed_vector(idx_b, blen);
+		return compute_using_block_packed(avec, alen, bvec, blen,
+				lhs_str->get_packed_bits());
+	}
+
 	char* avec=((CStringFeatures<char>*) lhs)->get_feature_vector(idx_a, alen, free_avec);
 	char* bvec=((CStringFeatures<char>*) rhs)->get_feature_vector(idx_b, blen, free_bvec);
 	float64_t result=0;
@@ -1000,6 +1115,7 @@ void CWeightedDegreeStringKernel::init()
 	tries=NULL;
 
 	tree_initialized=false;
+	incremental_linadd=true;
 	alphabet=NULL;
 
 	lhs=NULL;
@@ -1024,6 +1140,8 @@ void CWeightedDegreeStringKernel::init()
 			"Number of allowed mismatches.", ParameterProperties::HYPER);
 	SG_ADD(&block_computation, "block_computation",
 			"If block computation shall be used.");
+	SG_ADD(&incremental_linadd, "incremental_linadd",
+			"If tries shall be updated incrementally.");
 	SG_ADD((machine_int_t*) &type, "type",
 			"WeightedDegree kernel type.", ParameterProperties::HYPER);
 	SG_ADD(&which_degree, "which_degree",
@@ -11,6 +11,7 @@
 
 #include <shogun/lib/common.h>
 #include <shogun/lib/Trie.h>
+#include <shogun/kernel/string/WeightedDegreeLinadd.h>
 #include <shogun/kernel/string/StringKernel.h>
 #include <shogun/transfer/multitask/MultitaskKernelMklNormalizer.h>
 #include <shogun/features/StringFeatures.h>
@@ -199,6 +200,7 @@ class CWeightedDegreeStringKernel: public CStringKernel<char>
 				tries->delete_trees(max_mismatch==0);
 				set_is_initialized(false);
 			}
+			linadd.reset();
 		}
 
 		/** add to normal
@@ -217,6 +219,7 @@ class CWeightedDegreeStringKernel: public CStringKernel<char>
 			else
 				add_example_to_tree_mismatch(idx, weight);
 
+			linadd.reset();
 			set_is_initialized(true);
 		}
 
@@ -599,10 +602,42 @@ class CWeightedDegreeStringKernel: public CStringKernel<char>
 		 */
 		inline int32_t get_which_degree() { return which_degree; }
 
+		/** set if the tries shall be updated incrementally
+		 *
+		 * If enabled, init_optimization() only adds the changes w.r.t. the
+		 * alphas the tries were last built from when few of them changed
+		 * (e.g. between two SVM optimization rounds) instead of rebuilding
+		 * the tries from scratch.
+		 *
+		 * @param incremental if tries shall be updated incrementally
+		 */
+		inline void set_incremental_linadd(bool incremental)
+		{
+			incremental_linadd=incremental;
+		}
+
+		/** check if the tries are updated incrementally
+		 *
+		 * @return if tries are updated incrementally
+		 */
+		inline bool get_incremental_linadd() { return incremental_linadd; }
+
 	protected:
 		/** create emtpy tries */
 		void create_empty_tries();
 
+		/** add examples to tree in parallel, see
+		 * WeightedDegreeLinadd::add_examples_parallel()
+		 *
+		 * @param count number of examples
+		 * @param IDX indices of examples
+		 * @param alphas weights of examples
+		 * @param num_threads number of threads
+		 */
+		void add_examples_to_tree_parallel(
+			int32_t count, int32_t* IDX, float64_t* alphas,
+			int32_t num_threads);
+
 		/** add example to tree
 		 *
 		 * @param idx index
@@ -696,6 +731,18 @@ class CWeightedDegreeStringKernel: public CStringKernel<char>
 		float64_t compute_using_block(char* avec, int32_t alen,
 			char* bvec, int32_t blen);
 
+		/** compute using block on packed strings
+		 *
+		 * @param avec packed words of vector a
+		 * @param alen length of vector a
+		 * @param bvec packed words of vector b
+		 * @param blen length of vector b
+		 * @param bits bits per packed symbol
+		 * @return computed value
+		 */
+		float64_t compute_using_block_packed(const uint64_t* avec,
+			int32_t alen, const uint64_t* bvec, int32_t blen, int32_t bits);
+
 		/** remove lhs from kernel */
 		virtual void remove_lhs();
 
@@ -752,6 +799,11 @@ class CWeightedDegreeStringKernel: public CStringKernel<char>
 		/** if tree is initialized */
 		bool tree_initialized;
 
+		/** if tries are updated incrementally */
+		bool incremental_linadd;
+		/** alphas and weights the tries were built from */
+		WeightedDegreeLinadd linadd;
+
 		/** alphabet of features */
 		CAlphabet* alphabet;
 };
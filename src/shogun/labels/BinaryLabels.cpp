@@ -104,6 +104,7 @@ void CBinaryLabels::scores_to_probabilities(float64_t a, float64_t b)
 	SG_DEBUG("using sigmoid: a=%f, b=%f\n", a, b)
 
 	/* now the sigmoid is fitted, convert all values to probabilities */
+	m_current_values.make_unique();
 	for (index_t i = 0; i < m_current_values.vlen; ++i)
 	{
 		float64_t fApB = m_current_values[i] * a + b;
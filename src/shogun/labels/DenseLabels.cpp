@@ -65,6 +65,8 @@ void CDenseLabels::zero()
 void CDenseLabels::set_to_const(float64_t c)
 {
 	ASSERT(m_labels.vector)
+	m_labels.make_unique();
+	m_current_values.make_unique();
 	index_t subset_size=get_num_labels();
 	for (int32_t i=0; i<subset_size; i++)
 	{
@@ -168,6 +170,7 @@ bool CDenseLabels::set_label(int32_t idx, float64_t label)
 	int32_t real_num=m_subset_stack->subset_idx_conversion(idx);
 	if (m_labels.vector && real_num<get_num_labels())
 	{
+		m_labels.make_unique();
 		m_labels.vector[real_num]=label;
 		return true;
 	}
@@ -180,6 +183,7 @@ bool CDenseLabels::set_int_label(int32_t idx, int32_t label)
 	int32_t real_num=m_subset_stack->subset_idx_conversion(idx);
 	if (m_labels.vector && real_num<get_num_labels())
 	{
+		m_labels.make_unique();
 		m_labels.vector[real_num] = (float64_t)label;
 		return true;
 	}
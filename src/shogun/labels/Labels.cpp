@@ -90,6 +90,7 @@ void CLabels::set_value(float64_t value, int32_t idx)
 	        "zero!\n", get_name(), value, idx);
 
 	int32_t real_num = m_subset_stack->subset_idx_conversion(idx);
+	m_current_values.make_unique();
 	m_current_values.vector[real_num] = value;
 }
 
@@ -604,16 +604,25 @@ template <class T> class CDynamicArray :public CSGObject
 
 		virtual CSGObject* clone()
 		{
-			CDynamicArray * cloned = (CDynamicArray*) CSGObject::clone();
-			// Since the array vector is registered with
-			// current_num_elements as size (see parameter
-			// registration) the cloned version has less memory
-			// allocated than known to dynarray. We fix this here.
-			cloned->m_array.num_elements = cloned->m_array.current_num_elements;
-			return cloned;
+			return fix_num_elements((CDynamicArray*) CSGObject::clone());
+		}
+
+		virtual CSGObject* shallow_clone()
+		{
+			return fix_num_elements((CDynamicArray*) CSGObject::shallow_clone());
 		}
 
 	private:
+		/** Since the array vector is registered with
+		 * current_num_elements as size (see parameter
+		 * registration) the cloned version has less memory
+		 * allocated than known to dynarray. We fix this here.
+		 */
+		CDynamicArray* fix_num_elements(CDynamicArray* cloned)
+		{
+			cloned->m_array.num_elements = cloned->m_array.current_num_elements;
+			return cloned;
+		}
 
 		/** register parameters */
 		virtual void init()
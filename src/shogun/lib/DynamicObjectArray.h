@@ -454,16 +454,26 @@ class CDynamicObjectArray : public CSGObject
 
 		virtual CSGObject* clone()
 		{
-			CDynamicObjectArray* cloned = (CDynamicObjectArray*) CSGObject::clone();
-			// Since the array vector is registered with
-			// current_num_elements as size (see parameter
-			// registration) the cloned version has less memory
-			// allocated than known to dynarray. We fix this here.
+			return fix_num_elements((CDynamicObjectArray*) CSGObject::clone());
+		}
+
+		virtual CSGObject* shallow_clone()
+		{
+			return fix_num_elements((CDynamicObjectArray*) CSGObject::shallow_clone());
+		}
+
+	private:
+		/** Since the array vector is registered with
+		 * current_num_elements as size (see parameter
+		 * registration) the cloned version has less memory
+		 * allocated than known to dynarray. We fix this here.
+		 */
+		CDynamicObjectArray* fix_num_elements(CDynamicObjectArray* cloned)
+		{
 			cloned->m_array.num_elements = cloned->m_array.current_num_elements;
 			return cloned;
 		}
 
-	private:
 		/** register parameters */
 		virtual void init()
 		{
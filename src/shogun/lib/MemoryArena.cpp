@@ -0,0 +1,106 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/lib/MemoryArena.h>
+#include <shogun/lib/memory.h>
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace shogun;
+
+const size_t MemoryArena::ALIGNMENT;
+
+MemoryArena::MemoryArena(size_t chunk_size)
+{
+	m_chunk_size = std::max(chunk_size, ALIGNMENT);
+	m_position.chunk = 0;
+	m_position.offset = 0;
+}
+
+MemoryArena::~MemoryArena()
+{
+	for (auto& chunk : m_chunks)
+		SG_FREE(chunk.memory);
+}
+
+void* MemoryArena::allocate(size_t size)
+{
+	size = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+	if (m_position.chunk < m_chunks.size() &&
+	    m_position.offset + size <= m_chunks[m_position.chunk].size)
+	{
+		void* p = m_chunks[m_position.chunk].data + m_position.offset;
+		m_position.offset += size;
+		return p;
+	}
+
+	// move on to the next chunk, which is unused, and replace it if it is
+	// too small
+	size_t next = m_chunks.empty() ? 0 : m_position.chunk + 1;
+	if (next == m_chunks.size())
+		m_chunks.push_back(Chunk{NULL, NULL, 0});
+
+	Chunk& chunk = m_chunks[next];
+	if (chunk.size < size)
+	{
+		SG_FREE(chunk.memory);
+		chunk.size = std::max(size, m_chunk_size);
+		// one extra alignment unit to align the start of the chunk
+		chunk.memory = SG_MALLOC(char, chunk.size + ALIGNMENT);
+		chunk.data = (char*)(
+		    (uintptr_t(chunk.memory) + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+	}
+
+	m_position.chunk = next;
+	m_position.offset = size;
+
+	return chunk.data;
+}
+
+MemoryArena::Position MemoryArena::get_position() const
+{
+	return m_position;
+}
+
+void MemoryArena::rewind(const Position& position)
+{
+	m_position = position;
+}
+
+void MemoryArena::release()
+{
+	m_position.chunk = 0;
+	m_position.offset = 0;
+}
+
+size_t MemoryArena::get_capacity() const
+{
+	size_t capacity = 0;
+	for (const auto& chunk : m_chunks)
+		capacity += chunk.size;
+
+	return capacity;
+}
+
+MemoryArena* MemoryArena::thread_local_arena()
+{
+	static thread_local MemoryArena arena;
+	return &arena;
+}
+
+ArenaScope::ArenaScope() : ArenaScope(MemoryArena::thread_local_arena())
+{
+}
+
+ArenaScope::ArenaScope(MemoryArena* arena) : m_arena(arena)
+{
+	m_position = m_arena->get_position();
+}
+
+ArenaScope::~ArenaScope()
+{
+	m_arena->rewind(m_position);
+}
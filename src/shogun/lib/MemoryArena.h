@@ -0,0 +1,204 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+#ifndef __MEMORY_ARENA_H__
+#define __MEMORY_ARENA_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/common.h>
+
+#include <vector>
+
+namespace shogun
+{
+/** @brief Arena of memory for short lived temporaries.
+ *
+ * Memory is handed out from large chunks by advancing a position and is
+ * released all at once by rewinding to an earlier position, so that hot
+ * loops allocating temporaries on every iteration don't call malloc/free
+ * once the arena has grown to its working size. Chunks are kept until the
+ * arena is destroyed.
+ *
+ * Usually the arena of the calling thread (see thread_local_arena()) is
+ * used through an ArenaScope, which rewinds it when going out of scope.
+ * Vectors and matrices returned by vector() and matrix() are not reference
+ * counted and must not be used after the scope they were created in ended,
+ * clone() them to keep the data.
+ */
+class MemoryArena
+{
+public:
+	/** position of the arena, see get_position() and rewind() */
+	struct Position
+	{
+		/** index of the current chunk */
+		size_t chunk;
+		/** offset in the current chunk */
+		size_t offset;
+	};
+
+	/** constructor
+	 *
+	 * @param chunk_size minimum size of the chunks in bytes
+	 */
+	explicit MemoryArena(size_t chunk_size = 1 << 20);
+
+	/** destructor, frees all chunks */
+	~MemoryArena();
+
+	/** allocate memory aligned to ALIGNMENT bytes
+	 *
+	 * @param size number of bytes
+	 * @return pointer to the memory
+	 */
+	void* allocate(size_t size);
+
+	/** allocate an array
+	 *
+	 * @param len number of elements
+	 * @return pointer to the array
+	 */
+	template <class T>
+	T* allocate_array(size_t len)
+	{
+		return (T*)allocate(sizeof(T) * len);
+	}
+
+	/** allocate a vector that is not reference counted
+	 *
+	 * @param len length of the vector
+	 * @return vector in the arena
+	 */
+	template <class T>
+	SGVector<T> vector(index_t len)
+	{
+		return SGVector<T>(allocate_array<T>(len), len, false);
+	}
+
+	/** allocate a matrix that is not reference counted
+	 *
+	 * @param num_rows number of rows of the matrix
+	 * @param num_cols number of columns of the matrix
+	 * @return matrix in the arena
+	 */
+	template <class T>
+	SGMatrix<T> matrix(index_t num_rows, index_t num_cols)
+	{
+		return SGMatrix<T>(
+		    allocate_array<T>(int64_t(num_rows) * num_cols), num_rows,
+		    num_cols, false);
+	}
+
+	/** @return current position, to be passed to rewind() */
+	Position get_position() const;
+
+	/** release all memory allocated after the given position
+	 *
+	 * @param position earlier position of this arena
+	 */
+	void rewind(const Position& position);
+
+	/** release all memory allocated so far */
+	void release();
+
+	/** @return total size of all chunks in bytes */
+	size_t get_capacity() const;
+
+	/** @return arena of the calling thread */
+	static MemoryArena* thread_local_arena();
+
+	/** alignment of all allocations in bytes */
+	static const size_t ALIGNMENT = 64;
+
+private:
+	/** disable copy */
+	MemoryArena(const MemoryArena&) = delete;
+	MemoryArena& operator=(const MemoryArena&) = delete;
+
+	/** chunk of memory */
+	struct Chunk
+	{
+		/** allocated memory */
+		char* memory;
+		/** aligned start of the chunk in memory */
+		char* data;
+		/** usable size */
+		size_t size;
+	};
+
+	/** minimum size of the chunks */
+	size_t m_chunk_size;
+	/** chunks, the ones after the current chunk are unused */
+	std::vector<Chunk> m_chunks;
+	/** current position */
+	Position m_position;
+};
+
+/** @brief Scope of temporaries in a MemoryArena.
+ *
+ * Everything allocated from the arena during the lifetime of the scope is
+ * released when the scope is destroyed. Scopes can be nested.
+ *
+ * @code
+ * for (auto i : range(num_vectors))
+ * {
+ *     ArenaScope scope;
+ *     auto tmp = scope.vector<float64_t>(dim);
+ *     ...
+ * } // tmp is released here, without calling free
+ * @endcode
+ */
+class ArenaScope
+{
+public:
+	/** constructor, uses the arena of the calling thread */
+	ArenaScope();
+
+	/** constructor
+	 *
+	 * @param arena arena to allocate from
+	 */
+	explicit ArenaScope(MemoryArena* arena);
+
+	/** destructor, releases the memory allocated in this scope */
+	~ArenaScope();
+
+	/** @return arena of this scope */
+	MemoryArena* get_arena() const
+	{
+		return m_arena;
+	}
+
+	/** allocate a vector in the arena of this scope
+	 * @see MemoryArena::vector()
+	 */
+	template <class T>
+	SGVector<T> vector(index_t len)
+	{
+		return m_arena->vector<T>(len);
+	}
+
+	/** allocate a matrix in the arena of this scope
+	 * @see MemoryArena::matrix()
+	 */
+	template <class T>
+	SGMatrix<T> matrix(index_t num_rows, index_t num_cols)
+	{
+		return m_arena->matrix<T>(num_rows, num_cols);
+	}
+
+private:
+	/** disable copy */
+	ArenaScope(const ArenaScope&) = delete;
+	ArenaScope& operator=(const ArenaScope&) = delete;
+
+	/** arena */
+	MemoryArena* m_arena;
+	/** position of the arena when the scope was entered */
+	MemoryArena::Position m_position;
+};
+}
+#endif // __MEMORY_ARENA_H__
@@ -0,0 +1,234 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/io/SGIO.h>
+#include <shogun/lib/Lock.h>
+#include <shogun/lib/Profiler.h>
+#include <shogun/lib/parameter_observers/ObservedValue.h>
+#include <shogun/lib/parameter_observers/ParameterObserverInterface.h>
+
+#include <map>
+#include <stdio.h>
+#include <unordered_map>
+
+using namespace shogun;
+
+/** timings, counters and events recorded by one thread */
+class Profiler::ThreadBuffer
+{
+public:
+	/** timer or counter */
+	struct Entry
+	{
+		int64_t count;
+		float64_t seconds;
+	};
+
+	/** timed scope, in microseconds since the start of the profiler */
+	struct Event
+	{
+		const char* name;
+		float64_t start;
+		float64_t duration;
+	};
+
+	explicit ThreadBuffer(int32_t id) : thread_id(id)
+	{
+	}
+
+	/** only contended while aggregating */
+	CLock lock;
+	/** entries by name */
+	std::unordered_map<const char*, Entry> entries;
+	/** events, if recorded */
+	std::vector<Event> events;
+	/** id of the thread in the trace */
+	int32_t thread_id;
+};
+
+Profiler::Profiler()
+    : m_enabled(false), m_record_events(false),
+      m_start(std::chrono::steady_clock::now())
+{
+}
+
+Profiler* Profiler::instance()
+{
+	static Profiler profiler;
+	return &profiler;
+}
+
+void Profiler::set_enabled(bool enabled)
+{
+	m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::set_record_events(bool record_events)
+{
+	m_record_events.store(record_events, std::memory_order_relaxed);
+}
+
+Profiler::ThreadBuffer* Profiler::get_thread_buffer()
+{
+	static thread_local std::shared_ptr<ThreadBuffer> buffer;
+	if (!buffer)
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+		buffer = std::make_shared<ThreadBuffer>(m_buffers.size());
+		m_buffers.push_back(buffer);
+	}
+
+	return buffer.get();
+}
+
+void Profiler::add_time(
+    const char* name, std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point end)
+{
+	typedef std::chrono::duration<float64_t> seconds;
+	typedef std::chrono::duration<float64_t, std::micro> microseconds;
+
+	ThreadBuffer* buffer = get_thread_buffer();
+	buffer->lock.lock();
+	auto& entry = buffer->entries[name];
+	entry.count++;
+	entry.seconds += std::chrono::duration_cast<seconds>(end - start).count();
+	if (m_record_events.load(std::memory_order_relaxed))
+	{
+		buffer->events.push_back(
+		    {name,
+		     std::chrono::duration_cast<microseconds>(start - m_start).count(),
+		     std::chrono::duration_cast<microseconds>(end - start).count()});
+	}
+	buffer->lock.unlock();
+}
+
+void Profiler::add_count(const char* name, int64_t n)
+{
+	ThreadBuffer* buffer = get_thread_buffer();
+	buffer->lock.lock();
+	buffer->entries[name].count += n;
+	buffer->lock.unlock();
+}
+
+std::vector<Profiler::Statistic> Profiler::get_statistics() const
+{
+	std::map<std::string, Statistic> statistics;
+
+	std::lock_guard<std::mutex> guard(m_lock);
+	for (const auto& buffer : m_buffers)
+	{
+		buffer->lock.lock();
+		for (const auto& entry : buffer->entries)
+		{
+			auto& statistic = statistics[entry.first];
+			statistic.name = entry.first;
+			statistic.count += entry.second.count;
+			statistic.seconds += entry.second.seconds;
+		}
+		buffer->lock.unlock();
+	}
+
+	std::vector<Statistic> result;
+	for (const auto& statistic : statistics)
+		result.push_back(statistic.second);
+
+	return result;
+}
+
+void Profiler::emit(ParameterObserverInterface* observer, int64_t step) const
+{
+	REQUIRE(observer, "No observer provided.\n");
+
+	auto now = std::chrono::steady_clock::now();
+	for (const auto& statistic : get_statistics())
+	{
+		std::string name = "profiler/" + statistic.name;
+		if (observer->filter(name))
+		{
+			observer->on_next(std::make_pair(
+			    ObservedValue::make_observation(
+			        step, name, Any(float64_t(statistic.count))),
+			    now));
+		}
+
+		name += "/seconds";
+		if (statistic.seconds > 0 && observer->filter(name))
+		{
+			observer->on_next(std::make_pair(
+			    ObservedValue::make_observation(
+			        step, name, Any(statistic.seconds)),
+			    now));
+		}
+	}
+}
+
+/** write a string as JSON string literal */
+static void write_json_string(FILE* file, const char* str)
+{
+	fputc('"', file);
+	for (; *str; ++str)
+	{
+		if (*str == '"' || *str == '\\')
+			fputc('\\', file);
+		fputc(*str, file);
+	}
+	fputc('"', file);
+}
+
+bool Profiler::write_chrome_trace(const char* filename) const
+{
+	FILE* file = fopen(filename, "w");
+	if (!file)
+	{
+		SG_SWARNING("Could not open file `%s' for writing.\n", filename);
+		return false;
+	}
+
+	fprintf(file, "{\"traceEvents\":[");
+	bool first = true;
+
+	std::lock_guard<std::mutex> guard(m_lock);
+	for (const auto& buffer : m_buffers)
+	{
+		buffer->lock.lock();
+		for (const auto& event : buffer->events)
+		{
+			fprintf(file, first ? "\n{\"name\":" : ",\n{\"name\":");
+			write_json_string(file, event.name);
+			fprintf(
+			    file,
+			    ",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+			    buffer->thread_id, event.start, event.duration);
+			first = false;
+		}
+		buffer->lock.unlock();
+	}
+
+	fprintf(file, "\n]}\n");
+	return fclose(file) == 0;
+}
+
+void Profiler::print_statistics() const
+{
+	SG_SPRINT("%-40s %14s %14s\n", "name", "count", "seconds")
+	for (const auto& statistic : get_statistics())
+	{
+		SG_SPRINT(
+		    "%-40s %14lld %14.6f\n", statistic.name.c_str(),
+		    (long long int)statistic.count, statistic.seconds)
+	}
+}
+
+void Profiler::reset()
+{
+	std::lock_guard<std::mutex> guard(m_lock);
+	for (const auto& buffer : m_buffers)
+	{
+		buffer->lock.lock();
+		buffer->entries.clear();
+		buffer->events.clear();
+		buffer->lock.unlock();
+	}
+}
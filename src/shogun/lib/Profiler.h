@@ -0,0 +1,193 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace shogun
+{
+class ParameterObserverInterface;
+
+/** @brief Collects timings and counters of instrumented code paths.
+ *
+ * Code is instrumented with SG_PROFILE_SCOPE(name), which times the
+ * enclosing scope, and SG_PROFILE_COUNT(name, n), which adds to a counter,
+ * e.g. kernel evaluations or cache hits. Both compile to nothing unless
+ * shogun is built with ENABLE_PROFILING, and do nothing but check a flag
+ * unless the profiler is enabled at runtime with set_enabled().
+ *
+ * Every thread records into its own buffer, the buffers are only
+ * aggregated when the statistics are requested with get_statistics().
+ * Besides that, the statistics can be sent to a parameter observer (e.g. to
+ * TensorBoard) with emit(), and if recording of events is switched on with
+ * set_record_events(), every timed scope can be written to a Chrome trace
+ * file (to be opened with chrome://tracing) with write_chrome_trace().
+ *
+ * Names have to be string literals (or otherwise outlive the profiler), as
+ * they are stored as pointers. By convention they are prefixed by the
+ * component, as in "kernel/evaluations".
+ */
+class Profiler
+{
+public:
+	/** aggregated statistic of one timer or counter */
+	struct Statistic
+	{
+		/** name of the timer or counter */
+		std::string name;
+		/** number of timed scopes, or sum of a counter */
+		int64_t count;
+		/** total time in seconds spent in timed scopes, 0 for counters */
+		float64_t seconds;
+	};
+
+	/** @return the profiler */
+	static Profiler* instance();
+
+	/** enable or disable recording
+	 * @param enabled whether to record
+	 */
+	void set_enabled(bool enabled);
+
+	/** @return whether recording is enabled */
+	bool is_enabled() const
+	{
+		return m_enabled.load(std::memory_order_relaxed);
+	}
+
+	/** enable or disable recording of single events for
+	 * write_chrome_trace(), which needs memory per timed scope
+	 *
+	 * @param record_events whether to record events
+	 */
+	void set_record_events(bool record_events);
+
+	/** add the duration of a timed scope
+	 *
+	 * @param name name of the timer
+	 * @param start start of the scope
+	 * @param end end of the scope
+	 */
+	void add_time(
+	    const char* name, std::chrono::steady_clock::time_point start,
+	    std::chrono::steady_clock::time_point end);
+
+	/** add to a counter
+	 *
+	 * @param name name of the counter
+	 * @param n value to add
+	 */
+	void add_count(const char* name, int64_t n);
+
+	/** @return statistics of all threads, sorted by name */
+	std::vector<Statistic> get_statistics() const;
+
+	/** send the statistics to an observer, as values "profiler/<name>"
+	 * with the count and "profiler/<name>/seconds" with the time
+	 *
+	 * @param observer observer to send the statistics to
+	 * @param step step of the observed values
+	 */
+	void emit(ParameterObserverInterface* observer, int64_t step = 0) const;
+
+	/** write the recorded events in the Chrome trace event format
+	 *
+	 * @param filename name of the JSON file
+	 * @return whether the file was written
+	 */
+	bool write_chrome_trace(const char* filename) const;
+
+	/** print the statistics */
+	void print_statistics() const;
+
+	/** discard all recorded timings, counters and events */
+	void reset();
+
+private:
+	class ThreadBuffer;
+
+	Profiler();
+
+	/** @return buffer of the calling thread */
+	ThreadBuffer* get_thread_buffer();
+
+	/** whether recording is enabled */
+	std::atomic<bool> m_enabled;
+	/** whether events are recorded */
+	std::atomic<bool> m_record_events;
+	/** start of the profiler, origin of the event timestamps */
+	std::chrono::steady_clock::time_point m_start;
+
+	/** guards m_buffers */
+	mutable std::mutex m_lock;
+	/** buffers of all threads that recorded anything so far */
+	std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+};
+
+/** @brief Times its scope, see SG_PROFILE_SCOPE. */
+class ProfileScope
+{
+public:
+	/** constructor
+	 * @param name name of the timer
+	 */
+	explicit ProfileScope(const char* name) : m_name(NULL)
+	{
+		if (Profiler::instance()->is_enabled())
+		{
+			m_name = name;
+			m_start = std::chrono::steady_clock::now();
+		}
+	}
+
+	/** destructor, adds the duration of the scope */
+	~ProfileScope()
+	{
+		if (m_name)
+		{
+			Profiler::instance()->add_time(
+			    m_name, m_start, std::chrono::steady_clock::now());
+		}
+	}
+
+private:
+	/** name of the timer, NULL if the profiler was disabled */
+	const char* m_name;
+	/** start of the scope */
+	std::chrono::steady_clock::time_point m_start;
+};
+}
+
+#ifdef ENABLE_PROFILING
+#define SG_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SG_PROFILE_CONCAT(a, b) SG_PROFILE_CONCAT_IMPL(a, b)
+/** time the enclosing scope */
+#define SG_PROFILE_SCOPE(name)                                                 \
+	shogun::ProfileScope SG_PROFILE_CONCAT(sg_profile_scope_, __LINE__)(name)
+/** add n to a counter */
+#define SG_PROFILE_COUNT(name, n)                                              \
+	do                                                                         \
+	{                                                                          \
+		if (shogun::Profiler::instance()->is_enabled())                        \
+			shogun::Profiler::instance()->add_count(name, n);                  \
+	} while (0)
+#else
+#define SG_PROFILE_SCOPE(name)
+#define SG_PROFILE_COUNT(name, n)                                              \
+	do                                                                         \
+	{                                                                          \
+	} while (0)
+#endif // ENABLE_PROFILING
+
+#endif // __PROFILER_H__
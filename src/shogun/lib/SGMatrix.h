@@ -326,6 +326,17 @@ template<class T> class SGMatrix : public SGReferencedData
 		/** Clone matrix */
 		SGMatrix<T> clone() const;
 
+		/** Makes sure the matrix does not share its memory with other
+		 * instances by cloning it if it does (copy-on-write). Has to be
+		 * called before modifying data in place that may be shared, e.g.
+		 * after CSGObject::shallow_clone().
+		 */
+		void make_unique()
+		{
+			if (ref_count() > 1)
+				*this = clone();
+		}
+
 		/** Clone matrix */
 		static T* clone_matrix(const T* matrix, int32_t nrows, int32_t ncols);
 
@@ -228,6 +228,17 @@ template<class T> class SGVector : public SGReferencedData
 		/** Clone vector */
 		SGVector<T> clone() const;
 
+		/** Makes sure the vector does not share its memory with other
+		 * instances by cloning it if it does (copy-on-write). Has to be
+		 * called before modifying data in place that may be shared, e.g.
+		 * after CSGObject::shallow_clone().
+		 */
+		void make_unique()
+		{
+			if (ref_count() > 1)
+				*this = clone();
+		}
+
 		/** Clone vector */
 		static T* clone_vector(const T* vec, int32_t len);
 
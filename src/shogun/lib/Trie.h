@@ -235,6 +235,26 @@ IGNORE_IN_CLASSLIST template <class Trie> class CTrie : public CSGObject
 		 */
 		void delete_trees(bool p_use_compact_terminal_nodes=true);
 
+		/** merge trees, i.e. replace the trees of positions [start,end)
+		 * by copies of the corresponding trees of another trie
+		 *
+		 * This is used to combine tries that were built concurrently for
+		 * disjoint position ranges. The copied nodes are stored
+		 * contiguously in depth-first order.
+		 *
+		 * @param other trie to copy the trees from (same degree and length)
+		 * @param start first position to copy
+		 * @param end position after the last one to copy
+		 */
+		void merge_trees(const CTrie & other, int32_t start, int32_t end);
+
+		/** reserve tree memory
+		 *
+		 * @param num_nodes number of nodes the tree memory shall hold
+		 *                  without reallocating
+		 */
+		void reserve_treemem(int32_t num_nodes);
+
 		/** add to trie
 		 *
 		 * @param i i
@@ -624,6 +644,19 @@ IGNORE_IN_CLASSLIST template <class Trie> class CTrie : public CSGObject
 		/** @return object name */
 		virtual const char* get_name() const { return "Trie"; }
 
+	protected:
+		/** copy the subtree rooted at other_node of another trie into
+		 * node of this trie, allocating nodes for all its descendants
+		 *
+		 * @param other trie to copy from
+		 * @param other_node node in other trie
+		 * @param node (already allocated) node in this trie
+		 * @param depth depth of the node
+		 */
+		void copy_subtree(
+			const CTrie & other, int32_t other_node, int32_t node,
+			int32_t depth);
+
 	public:
 		/** number of symbols */
 		int32_t NUM_SYMS;
@@ -1177,6 +1210,59 @@ template <class Trie> void CTrie<Trie>::delete_trees(
 	use_compact_terminal_nodes=p_use_compact_terminal_nodes ;
 }
 
+template <class Trie> void CTrie<Trie>::merge_trees(
+	const CTrie<Trie> & other, int32_t start, int32_t end)
+{
+	ASSERT(trees!=NULL && other.trees!=NULL)
+	ASSERT(other.degree==degree && other.length==length)
+	ASSERT(start>=0 && start<=end && end<=length)
+
+	for (int32_t i=start; i<end; i++)
+		copy_subtree(other, other.trees[i], trees[i], 0);
+}
+
+template <class Trie> void CTrie<Trie>::reserve_treemem(int32_t num_nodes)
+{
+	if (num_nodes+10 < TreeMemPtrMax)
+		return;
+
+	int32_t old_sz=TreeMemPtrMax;
+	TreeMemPtrMax=num_nodes+11;
+	TreeMem=SG_REALLOC(Trie, TreeMem, old_sz, TreeMemPtrMax);
+}
+
+template <class Trie> void CTrie<Trie>::copy_subtree(
+	const CTrie<Trie> & other, int32_t other_node, int32_t node,
+	int32_t depth)
+{
+	TreeMem[node]=other.TreeMem[other_node];
+
+	// nodes at the last level only hold child weights
+	if (depth>=degree-1)
+		return;
+
+	for (int32_t q=0; q<4; q++)
+	{
+		int32_t other_child=other.TreeMem[other_node].children[q];
+		if (other_child==NO_CHILD)
+			continue;
+
+		// note that get_node() may move TreeMem, so index it afresh
+		int32_t child=get_node();
+		if (other_child<0)
+		{
+			// compact terminal node storing the remaining sequence
+			TreeMem[child]=other.TreeMem[-other_child];
+			TreeMem[node].children[q]=-child;
+		}
+		else
+		{
+			TreeMem[node].children[q]=child;
+			copy_subtree(other, other_child, child, depth+1);
+		}
+	}
+}
+
 	template <class Trie>
 float64_t CTrie<Trie>::compute_abs_weights_tree(int32_t tree, int32_t depth)
 {
@@ -36,6 +36,7 @@
 #define _ANY_H_
 
 #include <shogun/base/init.h>
+#include <shogun/lib/SGReferencedData.h>
 
 #include <algorithm>
 #include <limits>
@@ -331,6 +332,55 @@ namespace shogun {
 			existing.reset(value);
 		}
 
+		template <class T>
+		inline auto share_impl(general, T& value)
+		    -> decltype(clone_impl(maybe_most_important(), value))
+		{
+			return clone_impl(maybe_most_important(), value);
+		}
+
+		template <class T>
+		inline auto share_impl(more_important, const T& value) -> typename std::
+		    enable_if<std::is_base_of<SGReferencedData, T>::value, T>::type
+		{
+			/* data that is not reference counted cannot be shared safely */
+			if (const_cast<T&>(value).ref_count() < 0)
+				return clone_impl(maybe_most_important(), value);
+
+			return T(value);
+		}
+
+		template <class T>
+		inline auto share_impl(maybe_most_important, T* value)
+		    -> decltype(static_cast<void*>(value->shallow_clone()))
+		{
+			if (!value)
+				return nullptr;
+
+			return static_cast<void*>(value->shallow_clone());
+		}
+
+		template <class T>
+		inline auto share(void** storage, T& value)
+		    -> decltype(share_impl(maybe_most_important(), value))
+		{
+			auto shared = share_impl(maybe_most_important(), value);
+			mutable_value_of<decltype(shared)>(storage) = shared;
+			return shared;
+		}
+
+		template <class T, class S>
+		inline auto share(void** storage, const ArrayReference<T, S>& value)
+		{
+			return clone(storage, value);
+		}
+
+		template <class T, class S>
+		inline auto share(void** storage, const Array2DReference<T, S>& value)
+		{
+			return clone(storage, value);
+		}
+
 		template <class T>
 		inline const T& value_of(T const* ptr)
 		{
@@ -503,6 +553,13 @@ namespace shogun {
 		 */
 		virtual void clone(void** storage, const void* from) const = 0;
 
+		/** Copies value provided by from into storage, sharing the memory
+		 * of reference counted data and objects where possible.
+		 * @param storage pointer to a pointer to storage
+		 * @param from pointer to value to share
+		 */
+		virtual void share(void** storage, const void* from) const = 0;
+
 		/** Clears storage.
 		 * @param storage pointer to a pointer to storage
 		 */
@@ -613,6 +670,15 @@ namespace shogun {
 			any_detail::clone(storage, value_of(typed_pointer<T>(from)));
 		}
 
+		/** Shares value provided by from into storage
+		 * @param storage pointer to a pointer to storage
+		 * @param from pointer to value to share
+		 */
+		virtual void share(void** storage, const void* from) const override
+		{
+			any_detail::share(storage, value_of(typed_pointer<T>(from)));
+		}
+
 		/** Clears storage.
 		 * @param storage pointer to a pointer to storage
 		 */
@@ -679,6 +745,15 @@ namespace shogun {
 			any_detail::clone(storage, value_of(typed_pointer<T>(from)));
 		}
 
+		/** Shares value provided by from into storage
+		 * @param storage pointer to a pointer to storage
+		 * @param from pointer to value to share
+		 */
+		virtual void share(void** storage, const void* from) const override
+		{
+			any_detail::share(storage, value_of(typed_pointer<T>(from)));
+		}
+
 		/** Clears storage.
 		 * @param storage pointer to a pointer to storage
 		 */
@@ -857,6 +932,32 @@ namespace shogun {
 			return *(this);
 		}
 
+		/** Like clone_from(), but reference counted data and objects are
+		 * shared with other rather than copied.
+		 * @param other Any object to share from
+		 * @return this object
+		 */
+		Any& share_from(const Any& other)
+		{
+			if (!other.cloneable())
+			{
+				throw std::logic_error("Tried to share non-cloneable Any");
+			}
+			if (empty())
+			{
+				policy = other.policy;
+				set_or_inherit(other);
+				return *(this);
+			}
+			if (!policy->matches_policy(other.policy))
+			{
+				throw TypeMismatchException(
+				    other.policy->type(), policy->type());
+			}
+			policy->share(&storage, other.storage);
+			return *(this);
+		}
+
 		/** Equality operator
 		 * @param lhs Any object on left hand side
 		 * @param rhs Any object on right hand side
@@ -39,6 +39,7 @@
 #include <shogun/base/progress.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/kernel/Kernel.h>
+#include <shogun/lib/Profiler.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/Time.h>
 #include <shogun/lib/common.h>
@@ -546,6 +547,7 @@ void Solver::Solve(
 			gap, -CMath::log10(gap), -CMath::log10(1), -CMath::log10(eps));
 
 		++iter;
+		SG_PROFILE_COUNT("svm/libsvm/iterations", 1);
 
 		// update alpha[i] and alpha[j], handle bounds carefully
 
@@ -26,8 +26,53 @@ using namespace shogun;
 
 #ifdef TRACE_MEMORY_ALLOCS
 #include <shogun/lib/Map.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
 extern CMap<void*, shogun::MemoryBlock>* sg_mallocs;
 
+namespace
+{
+	/** number and total size of the allocations of a call site */
+	struct AllocationSite
+	{
+		int64_t count;
+		int64_t bytes;
+	};
+
+	typedef std::map<std::pair<std::string, int>, AllocationSite>
+	    AllocationSites;
+
+	std::mutex& allocation_sites_lock()
+	{
+		static std::mutex lock;
+		return lock;
+	}
+
+	/* never freed, allocations may still happen during static destruction */
+	AllocationSites& allocation_sites()
+	{
+		static AllocationSites* sites = new AllocationSites();
+		return *sites;
+	}
+
+	void record_allocation_site(const char* file, int line, size_t size)
+	{
+		if (!file)
+			return;
+
+		std::lock_guard<std::mutex> guard(allocation_sites_lock());
+		auto& site = allocation_sites()[std::make_pair(std::string(file), line)];
+		site.count++;
+		site.bytes += size;
+	}
+}
+
 MemoryBlock::MemoryBlock() : ptr(NULL), size(0), file(NULL),
 	line(-1), is_sgobject(false)
 {
@@ -200,6 +245,7 @@ void* sg_malloc(size_t size
 #ifdef TRACE_MEMORY_ALLOCS
 	if (sg_mallocs)
 		sg_mallocs->add(p, MemoryBlock(p,size, file, line));
+	record_allocation_site(file, line, size);
 #endif
 	if (!p)
 		allocation_error(p, size, "malloc");
@@ -264,6 +310,7 @@ void* sg_calloc(size_t num, size_t size
 #ifdef TRACE_MEMORY_ALLOCS
 	if (sg_mallocs)
 		sg_mallocs->add(p, MemoryBlock(p,size, file, line));
+	record_allocation_site(file, line, num*size);
 #endif
 	if (!p)
 		allocation_error(p, size, "calloc");
@@ -306,6 +353,7 @@ void* sg_realloc(void* ptr, size_t size
 
 	if (sg_mallocs)
 		sg_mallocs->add(p, MemoryBlock(p,size, file, line));
+	record_allocation_site(file, line, size);
 #endif
 
 	if (!p && (size || !ptr))
@@ -333,6 +381,34 @@ void list_memory_allocs()
 		}
 	}
 }
+
+void list_memory_alloc_sites(int32_t num_sites)
+{
+	std::vector<std::pair<AllocationSites::key_type, AllocationSite>> sites;
+	{
+		std::lock_guard<std::mutex> guard(allocation_sites_lock());
+		sites.assign(allocation_sites().begin(), allocation_sites().end());
+	}
+
+	std::sort(
+	    sites.begin(), sites.end(),
+	    [](const decltype(sites)::value_type& a,
+	       const decltype(sites)::value_type& b) {
+		    return a.second.count > b.second.count;
+	    });
+
+	if (num_sites >= 0 && sites.size() > size_t(num_sites))
+		sites.resize(num_sites);
+
+	printf("Top %d allocation sites:\n", (int32_t) sites.size());
+	for (const auto& site : sites)
+	{
+		printf("%lld allocations of %lld bytes in total in %s line %d\n",
+				(long long int) site.second.count,
+				(long long int) site.second.bytes, site.first.first.c_str(),
+				site.first.second);
+	}
+}
 #endif
 
 }
@@ -212,6 +212,13 @@ class MemoryBlock
 		bool is_sgobject;
 };
 void list_memory_allocs();
+
+/** print the call sites of SG_MALLOC, SG_CALLOC and SG_REALLOC with the most
+ * allocations so far, together with the number of bytes they allocated
+ *
+ * @param num_sites number of call sites to print, -1 for all
+ */
+void list_memory_alloc_sites(int32_t num_sites=20);
 #endif
 
 void* get_copy(void* src, size_t len);
@@ -400,6 +400,102 @@ namespace tapkee
 			 */
 			const ParameterKeyword<ScalarType> sne_theta("SNE theta", 0.5);
 
+			/** The keyword for the value that stores the number of
+			 * gradient descent iterations of t-SNE.
+			 *
+			 * Used by @ref tapkee::tDistributedStochasticNeighborEmbedding.
+			 *
+			 * Default value is 1000.
+			 *
+			 * The corresponding value should have type @ref tapkee::IndexType.
+			 */
+			const ParameterKeyword<IndexType>
+				sne_max_iteration("SNE maximal iteration", 1000);
+
+			/** The keyword for the value that stores the factor the
+			 * input similarities of t-SNE are multiplied with during the
+			 * first iterations (early exaggeration).
+			 *
+			 * Used by @ref tapkee::tDistributedStochasticNeighborEmbedding.
+			 *
+			 * Default value is 12.0.
+			 *
+			 * The corresponding value should have type @ref tapkee::ScalarType.
+			 */
+			const ParameterKeyword<ScalarType>
+				sne_early_exaggeration("SNE early exaggeration", 12.0);
+
+			/** The keyword for the value that stores the number of
+			 * iterations of t-SNE with exaggerated input similarities.
+			 *
+			 * Used by @ref tapkee::tDistributedStochasticNeighborEmbedding.
+			 *
+			 * Default value is 250.
+			 *
+			 * The corresponding value should have type @ref tapkee::IndexType.
+			 */
+			const ParameterKeyword<IndexType>
+				sne_exaggeration_iterations("SNE exaggeration iterations", 250);
+
+			/** The keyword for the value that stores the momentum of
+			 * the first iterations of t-SNE.
+			 *
+			 * Used by @ref tapkee::tDistributedStochasticNeighborEmbedding.
+			 *
+			 * Default value is 0.5.
+			 *
+			 * The corresponding value should have type @ref tapkee::ScalarType.
+			 */
+			const ParameterKeyword<ScalarType> sne_momentum("SNE momentum", 0.5);
+
+			/** The keyword for the value that stores the momentum of
+			 * t-SNE after @ref tapkee::keywords::sne_momentum_switch_iteration
+			 * iterations.
+			 *
+			 * Used by @ref tapkee::tDistributedStochasticNeighborEmbedding.
+			 *
+			 * Default value is 0.8.
+			 *
+			 * The corresponding value should have type @ref tapkee::ScalarType.
+			 */
+			const ParameterKeyword<ScalarType> sne_final_momentum("SNE final momentum", 0.8);
+
+			/** The keyword for the value that stores the iteration
+			 * t-SNE switches to the final momentum at.
+			 *
+			 * Used by @ref tapkee::tDistributedStochasticNeighborEmbedding.
+			 *
+			 * Default value is 250.
+			 *
+			 * The corresponding value should have type @ref tapkee::IndexType.
+			 */
+			const ParameterKeyword<IndexType>
+				sne_momentum_switch_iteration("SNE momentum switch iteration", 250);
+
+			/** The keyword for the value that stores the learning
+			 * rate of t-SNE.
+			 *
+			 * Used by @ref tapkee::tDistributedStochasticNeighborEmbedding.
+			 *
+			 * Default value is 200.0.
+			 *
+			 * The corresponding value should have type @ref tapkee::ScalarType.
+			 */
+			const ParameterKeyword<ScalarType> sne_learning_rate("SNE learning rate", 200.0);
+
+			/** The keyword for the value that stores whether t-SNE
+			 * computes the repulsive forces by interpolation on a grid with
+			 * FFT (as FIt-SNE) instead of a Barnes-Hut tree. Only 2D
+			 * embeddings are supported, theta is ignored then.
+			 *
+			 * Used by @ref tapkee::tDistributedStochasticNeighborEmbedding.
+			 *
+			 * Default is false.
+			 *
+			 * The corresponding value should have type bool.
+			 */
+			const ParameterKeyword<bool> sne_interpolation("SNE interpolation", false);
+
 			/** The keyword for the value that stores the squishingRate
 			 * parameter of the Manifold Sculpting algorithm.
 			 *
@@ -102,7 +102,11 @@ namespace tapkee
 		//! \f$ O(N N \log k) \f$ time complexity.
 		//! Recommended to be used only in debug purposes.
 		Brute,
-		VpTree
+		VpTree,
+		//! Approximate NN-descent method as described in @cite Dong2011,
+		//! with empirical \f$ O(N^{1.14}) \f$ time complexity. Parallel,
+		//! recommended for large datasets of high dimension.
+		NNDescent
 #ifdef TAPKEE_USE_LGPL_COVERTREE
 		//! Covertree-based method with approximate \f$ O(\log N) \f$ time complexity.
 		//! Recommended to be used as a default method.
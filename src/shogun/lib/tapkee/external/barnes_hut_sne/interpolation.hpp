@@ -0,0 +1,210 @@
+/* This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef TSNE_INTERPOLATION_H
+#define TSNE_INTERPOLATION_H
+
+/* Tapkee includes */
+#include <shogun/lib/tapkee/defines.hpp>
+/* End of Tapkee includes */
+
+#include <unsupported/Eigen/FFT>
+
+#include <algorithm>
+#include <complex>
+#include <float.h>
+#include <math.h>
+#include <vector>
+
+namespace tsne
+{
+
+//! Repulsive forces of a 2D t-SNE embedding computed by interpolation
+//! on an equispaced grid as in FIt-SNE (Linderman et al., Fast
+//! interpolation-based t-SNE for improved visualization of single-cell
+//! RNA-seq data, Nature Methods 2019).
+//!
+//! The embedding is covered by boxes with a few interpolation nodes each.
+//! The charges of the points are spread to the nodes with Lagrange
+//! polynomials, the potentials at the nodes are the convolution of the
+//! charges with the kernel, which is computed by FFT as the nodes are
+//! equispaced, and are interpolated back to the points. This needs
+//! O(N + G log G) operations for G nodes instead of O(N log N) of the
+//! Barnes-Hut tree, with the error controlled by the grid and not by theta.
+class InterpolationGrid
+{
+public:
+
+	//! @param n_interpolation_points number of nodes per box and dimension
+	//! @param intervals_per_integer boxes per unit length of the embedding
+	//! @param min_num_intervals minimal number of boxes per dimension
+	InterpolationGrid(int n_interpolation_points = 3, double intervals_per_integer = 1.0,
+	                  int min_num_intervals = 50) :
+		p(n_interpolation_points), boxes_per_unit(intervals_per_integer),
+		min_boxes(min_num_intervals)
+	{
+	}
+
+	//! Computes the unnormalized repulsive forces and the normalization
+	//! like QuadTree::computeNonEdgeForces does for every point
+	//!
+	//! @param Y embedding, N points of two dimensions
+	//! @param N number of points
+	//! @param neg_f unnormalized repulsive forces to be set, N*2 values
+	//! @param sum_Q normalization sum_{i!=j} 1/(1+|y_i-y_j|^2) to be set
+	void computeNonEdgeForces(const double* Y, int N, double* neg_f, double* sum_Q)
+	{
+		// Boxes of a square covering all points
+		double y_min = DBL_MAX, y_max = -DBL_MAX;
+		for(int i = 0; i < N * NO_DIMS; i++) {
+			y_min = std::min(y_min, Y[i]);
+			y_max = std::max(y_max, Y[i]);
+		}
+		int n_boxes = std::max(min_boxes, (int) ceil((y_max - y_min) * boxes_per_unit));
+		n_boxes = fftFriendly(n_boxes);
+		double box_width = (y_max > y_min) ? (y_max - y_min) / n_boxes : 1.0;
+		int n_nodes = n_boxes * p;
+		double h = box_width / p;
+
+		// Interpolation weights of every point
+		std::vector<int> first_node(N * NO_DIMS);
+		std::vector<double> weights(N * NO_DIMS * p);
+#pragma omp parallel for
+		for(int i = 0; i < N * NO_DIMS; i++) {
+			double t = (Y[i] - y_min) / box_width;
+			int box = std::min((int) t, n_boxes - 1);
+			first_node[i] = box * p;
+			lagrangeWeights(t - box, &weights[i * p]);
+		}
+
+		// Spread the charges 1 and y_x + i*y_y to the nodes. All kernels
+		// and charges are real and the kernels are symmetric, so that their
+		// transforms are real as well: two real grids are transformed at
+		// once as real and imaginary part of one complex grid.
+		int M = 2 * n_nodes;
+		std::vector<std::complex<double> > charges(M * M, 0.0), point_charges(M * M, 0.0);
+		for(int i = 0; i < N; i++) {
+			const double* wx = &weights[(i * NO_DIMS) * p];
+			const double* wy = &weights[(i * NO_DIMS + 1) * p];
+			int ix = first_node[i * NO_DIMS], iy = first_node[i * NO_DIMS + 1];
+			std::complex<double> y(Y[i * NO_DIMS], Y[i * NO_DIMS + 1]);
+			for(int b = 0; b < p; b++) {
+				for(int a = 0; a < p; a++) {
+					int g = (ix + a) + (iy + b) * M;
+					double w = wx[a] * wy[b];
+					charges[g] += w;
+					point_charges[g] += w * y;
+				}
+			}
+		}
+		fft2(charges, M, false);
+		fft2(point_charges, M, false);
+
+		// Kernels 1/(1+r^2) + i/(1+r^2)^2 on the circulant embedding of
+		// the grid, the offset n_nodes is never used
+		std::vector<std::complex<double> > kernels(M * M);
+#pragma omp parallel for
+		for(int b = 0; b < M; b++) {
+			double dy = h * ((b <= n_nodes) ? b : M - b);
+			for(int a = 0; a < M; a++) {
+				double dx = h * ((a <= n_nodes) ? a : M - a);
+				double q = (a == n_nodes || b == n_nodes) ? .0 : 1.0 / (1.0 + dx * dx + dy * dy);
+				kernels[a + b * M] = std::complex<double>(q, q * q);
+			}
+		}
+		fft2(kernels, M, false);
+
+		// Potentials at the nodes: of the charges 1 with both kernels as
+		// real and imaginary part, and of the charges y with the second one
+#pragma omp parallel for
+		for(int g = 0; g < M * M; g++) {
+			double kernel1 = kernels[g].real(), kernel2 = kernels[g].imag();
+			charges[g] = (kernel1 + std::complex<double>(0.0, kernel2)) * charges[g];
+			point_charges[g] = kernel2 * point_charges[g];
+		}
+		fft2(charges, M, true);
+		fft2(point_charges, M, true);
+
+		// Interpolate the potentials back to the points
+		double sum = .0;
+#pragma omp parallel for reduction(+:sum)
+		for(int i = 0; i < N; i++) {
+			const double* wx = &weights[(i * NO_DIMS) * p];
+			const double* wy = &weights[(i * NO_DIMS + 1) * p];
+			int ix = first_node[i * NO_DIMS], iy = first_node[i * NO_DIMS + 1];
+			double phi[4] = {.0, .0, .0, .0};
+			for(int b = 0; b < p; b++) {
+				for(int a = 0; a < p; a++) {
+					int g = (ix + a) + (iy + b) * M;
+					double w = wx[a] * wy[b];
+					phi[0] += w * charges[g].real();
+					phi[1] += w * charges[g].imag();
+					phi[2] += w * point_charges[g].real();
+					phi[3] += w * point_charges[g].imag();
+				}
+			}
+			// The self-interaction contributes 1 to phi[0] and nothing to the forces
+			sum += phi[0] - 1.0;
+			neg_f[i * NO_DIMS]     = Y[i * NO_DIMS]     * phi[1] - phi[2];
+			neg_f[i * NO_DIMS + 1] = Y[i * NO_DIMS + 1] * phi[1] - phi[3];
+		}
+		*sum_Q = sum;
+	}
+
+private:
+
+	static const int NO_DIMS = 2;
+
+	//! Lagrange polynomials of the nodes (j+0.5)/p of a box at t in [0,1]
+	void lagrangeWeights(double t, double* w) const
+	{
+		for(int j = 0; j < p; j++) {
+			w[j] = 1.0;
+			for(int l = 0; l < p; l++) {
+				if(l != j) w[j] *= (t - (l + .5) / p) / ((double) (j - l) / p);
+			}
+		}
+	}
+
+	//! @return smallest number not less than n without prime factors above 5
+	static int fftFriendly(int n)
+	{
+		for(;; n++) {
+			int m = n;
+			while(m % 2 == 0) m /= 2;
+			while(m % 3 == 0) m /= 3;
+			while(m % 5 == 0) m /= 5;
+			if(m == 1) return n;
+		}
+	}
+
+	//! In-place 2D FFT of a column-major M x M array, the inverse is scaled
+	static void fft2(std::vector<std::complex<double> >& data, int M, bool inverse)
+	{
+#pragma omp parallel
+		{
+			Eigen::FFT<double> fft;
+			std::vector<std::complex<double> > in(M), out(M);
+#pragma omp for
+			for(int b = 0; b < M; b++) {
+				std::copy(data.begin() + b * M, data.begin() + (b + 1) * M, in.begin());
+				if(inverse) fft.inv(out, in); else fft.fwd(out, in);
+				std::copy(out.begin(), out.end(), data.begin() + b * M);
+			}
+#pragma omp for
+			for(int a = 0; a < M; a++) {
+				for(int b = 0; b < M; b++) in[b] = data[a + b * M];
+				if(inverse) fft.inv(out, in); else fft.fwd(out, in);
+				for(int b = 0; b < M; b++) data[a + b * M] = out[b];
+			}
+		}
+	}
+
+	int p;
+	double boxes_per_unit;
+	int min_boxes;
+};
+
+}
+
+#endif
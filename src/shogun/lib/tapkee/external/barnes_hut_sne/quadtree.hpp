@@ -69,9 +69,6 @@ class QuadTree
 	static const int QT_NO_DIMS = 2;
 	static const int QT_NODE_CAPACITY = 1;
 
-	// A buffer we use when doing force computations
-	double buff[QT_NO_DIMS];
-
 	// Properties of this node in the tree
 	QuadTree* parent;
 	bool is_leaf;
@@ -311,14 +308,16 @@ public:
 		                             southEast->getDepth()));
 	}
 
-	// Compute non-edge forces using Barnes-Hut algorithm
-	void computeNonEdgeForces(int point_index, double theta, double neg_f[], double* sum_Q)
+	// Compute non-edge forces using Barnes-Hut algorithm, the tree is not
+	// modified so that the forces of different points can be computed in parallel
+	void computeNonEdgeForces(int point_index, double theta, double neg_f[], double* sum_Q) const
 	{
 
 		// Make sure that we spend no time on empty nodes or self-interactions
 		if(cum_size == 0 || (is_leaf && size == 1 && index[0] == point_index)) return;
 
 		// Compute distance between point and center-of-mass
+		double buff[QT_NO_DIMS];
 		double D = .0;
 		int ind = point_index * QT_NO_DIMS;
 		for(int d = 0; d < QT_NO_DIMS; d++) buff[d]  = data[ind + d];
@@ -345,9 +344,10 @@ public:
 	}
 
 	// Computes edge forces
-	void computeEdgeForces(int* row_P, int* col_P, double* val_P, int N, double* pos_f)
+	void computeEdgeForces(int* row_P, int* col_P, double* val_P, int N, double* pos_f) const
 	{
 		// Loop over all edges in the graph
+		double buff[QT_NO_DIMS];
 		int ind1, ind2;
 		double D;
 		for(int n = 0; n < N; n++) {
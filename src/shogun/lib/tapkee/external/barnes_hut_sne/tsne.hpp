@@ -37,6 +37,7 @@
 #include <shogun/lib/tapkee/utils/time.hpp>
 #include <shogun/lib/tapkee/external/barnes_hut_sne/quadtree.hpp>
 #include <shogun/lib/tapkee/external/barnes_hut_sne/vptree.hpp>
+#include <shogun/lib/tapkee/external/barnes_hut_sne/interpolation.hpp>
 /* End of Tapkee includes */
 
 #include <math.h>
@@ -55,21 +56,49 @@ static inline double sign(double x) { return (x == .0 ? .0 : (x < .0 ? -1.0 : 1.
 class TSNE
 {
 public:
-	void run(double* X, int N, int D, double* Y, int no_dims, double perplexity, double theta)
+	//! Parameters of the gradient descent: the input similarities are
+	//! multiplied by exaggeration until stop_lying_iter, the momentum is
+	//! switched to final_momentum at mom_switch_iter, eta is the learning rate
+	struct Schedule
+	{
+		Schedule() :
+			max_iter(1000), stop_lying_iter(250), mom_switch_iter(250),
+			exaggeration(12.0), momentum(.5), final_momentum(.8), eta(200.0)
+		{
+		}
+		int max_iter;
+		int stop_lying_iter;
+		int mom_switch_iter;
+		double exaggeration;
+		double momentum;
+		double final_momentum;
+		double eta;
+	};
+
+	//! Embeds the data, the gradient is exact if theta is zero, uses a
+	//! Barnes-Hut tree otherwise, or if interpolation is set (and no_dims
+	//! is 2) interpolates the repulsive forces on a grid like FIt-SNE
+	void run(double* X, int N, int D, double* Y, int no_dims, double perplexity, double theta,
+	         const Schedule& schedule = Schedule(), bool interpolation = false)
 	{
 		// Determine whether we are using an exact algorithm
-		bool exact = (theta == .0) ? true : false;
+		interpolation = interpolation && no_dims == 2;
+		bool exact = (theta == .0 && !interpolation) ? true : false;
 		if (exact)
 			tapkee::LoggingSingleton::instance().message_info("Using exact t-SNE algorithm");
+		else if (interpolation)
+			tapkee::LoggingSingleton::instance().message_info("Using interpolation-based t-SNE algorithm");
 		else
 			tapkee::LoggingSingleton::instance().message_info("Using Barnes-Hut-SNE algorithm");
 
 		// Set learning parameters
 		float total_time = .0;
 		clock_t start, end;
-		int max_iter = 1000, stop_lying_iter = 250, mom_switch_iter = 250;
-		double momentum = .5, final_momentum = .8;
-		double eta = 200.0;
+		int max_iter = schedule.max_iter, stop_lying_iter = schedule.stop_lying_iter,
+		    mom_switch_iter = schedule.mom_switch_iter;
+		double momentum = schedule.momentum, final_momentum = schedule.final_momentum;
+		double eta = schedule.eta;
+		double exaggeration = schedule.exaggeration;
 
 		// Allocate some memory
 		double* dY    = (double*) malloc(N * no_dims * sizeof(double));
@@ -125,8 +154,8 @@ public:
 			}
 
 			// Lie about the P-values
-			if(exact) { for(int i = 0; i < N * N; i++)        P[i] *= 12.0; }
-			else {      for(int i = 0; i < row_P[N]; i++) val_P[i] *= 12.0; }
+			if(exact) { for(int i = 0; i < N * N; i++)        P[i] *= exaggeration; }
+			else {      for(int i = 0; i < row_P[N]; i++) val_P[i] *= exaggeration; }
 
 			// Initialize solution (randomly)
 			for(int i = 0; i < N * no_dims; i++) Y[i] = tapkee::gaussian_random() * .0001;
@@ -138,23 +167,24 @@ public:
 
 				// Compute (approximate) gradient
 				if(exact) computeExactGradient(P, Y, N, no_dims, dY);
-				else computeGradient(P, row_P, col_P, val_P, Y, N, no_dims, dY, theta);
-
-				// Update gains
-				for(int i = 0; i < N * no_dims; i++) gains[i] = (sign(dY[i]) != sign(uY[i])) ? (gains[i] + .2) : (gains[i] * .8);
-				for(int i = 0; i < N * no_dims; i++) if(gains[i] < .01) gains[i] = .01;
-
-				// Perform gradient update (with momentum and gains)
-				for(int i = 0; i < N * no_dims; i++) uY[i] = momentum * uY[i] - eta * gains[i] * dY[i];
-				for(int i = 0; i < N * no_dims; i++)  Y[i] = Y[i] + uY[i];
+				else computeGradient(P, row_P, col_P, val_P, Y, N, no_dims, dY, theta, interpolation);
+
+				// Update gains and perform gradient update (with momentum and gains)
+#pragma omp parallel for
+				for(int i = 0; i < N * no_dims; i++) {
+					gains[i] = (sign(dY[i]) != sign(uY[i])) ? (gains[i] + .2) : (gains[i] * .8);
+					if(gains[i] < .01) gains[i] = .01;
+					uY[i] = momentum * uY[i] - eta * gains[i] * dY[i];
+					Y[i] = Y[i] + uY[i];
+				}
 
 				// Make solution zero-mean
 				zeroMean(Y, N, no_dims);
 
 				// Stop lying about the P-values after a while, and switch momentum
 				if(iter == stop_lying_iter) {
-					if(exact) { for(int i = 0; i < N * N; i++)        P[i] /= 12.0; }
-					else      { for(int i = 0; i < row_P[N]; i++) val_P[i] /= 12.0; }
+					if(exact) { for(int i = 0; i < N * N; i++)        P[i] /= exaggeration; }
+					else      { for(int i = 0; i < row_P[N]; i++) val_P[i] /= exaggeration; }
 				}
 				if(iter == mom_switch_iter) momentum = final_momentum;
 
@@ -281,26 +311,55 @@ public:
 
 private:
 
-	void computeGradient(double* /*P*/, int* inp_row_P, int* inp_col_P, double* inp_val_P, double* Y, int N, int D, double* dC, double theta)
+	void computeGradient(double* /*P*/, int* inp_row_P, int* inp_col_P, double* inp_val_P, double* Y, int N, int D, double* dC, double theta, bool interpolation)
 	{
-		// Construct quadtree on current map
-		QuadTree* tree = new QuadTree(Y, N);
-
 		// Compute all terms required for t-SNE gradient
 		double sum_Q = .0;
 		double* pos_f = (double*) calloc(N * D, sizeof(double));
 		double* neg_f = (double*) calloc(N * D, sizeof(double));
 		if(pos_f == NULL || neg_f == NULL) { printf("Memory allocation failed!\n"); exit(1); }
-		tree->computeEdgeForces(inp_row_P, inp_col_P, inp_val_P, N, pos_f);
-		for(int n = 0; n < N; n++) tree->computeNonEdgeForces(n, theta, neg_f + n * D, &sum_Q);
+		computeEdgeForces(inp_row_P, inp_col_P, inp_val_P, Y, N, D, pos_f);
+		if(interpolation) {
+			InterpolationGrid grid;
+			grid.computeNonEdgeForces(Y, N, neg_f, &sum_Q);
+		}
+		else {
+			// Construct quadtree on current map, it is only read afterwards
+			QuadTree* tree = new QuadTree(Y, N);
+#pragma omp parallel for schedule(dynamic,64) reduction(+:sum_Q)
+			for(int n = 0; n < N; n++) {
+				double point_sum_Q = .0;
+				tree->computeNonEdgeForces(n, theta, neg_f + n * D, &point_sum_Q);
+				sum_Q += point_sum_Q;
+			}
+			delete tree;
+		}
 
 		// Compute final t-SNE gradient
+#pragma omp parallel for
 		for(int i = 0; i < N * D; i++) {
 			dC[i] = pos_f[i] - (neg_f[i] / sum_Q);
 		}
 		free(pos_f);
 		free(neg_f);
-		delete tree;
+	}
+
+	void computeEdgeForces(int* row_P, int* col_P, double* val_P, double* Y, int N, int D, double* pos_f)
+	{
+		// Loop over all edges in the graph, every row only adds to its own forces
+#pragma omp parallel for schedule(dynamic,256)
+		for(int n = 0; n < N; n++) {
+			for(int i = row_P[n]; i < row_P[n + 1]; i++) {
+
+				// Compute pairwise distance and Q-value
+				double Q = .0;
+				for(int d = 0; d < D; d++) Q += (Y[n * D + d] - Y[col_P[i] * D + d]) * (Y[n * D + d] - Y[col_P[i] * D + d]);
+				Q = val_P[i] / (1.0 + Q);
+
+				// Sum positive force
+				for(int d = 0; d < D; d++) pos_f[n * D + d] += Q * (Y[n * D + d] - Y[col_P[i] * D + d]);
+			}
+		}
 	}
 
 	void computeExactGradient(double* P, double* Y, int N, int D, double* dC)
@@ -507,8 +566,6 @@ private:
 		int* row_P = *_row_P;
 		int* col_P = *_col_P;
 		double* val_P = *_val_P;
-		double* cur_P = (double*) malloc((N - 1) * sizeof(double));
-		if(cur_P == NULL) { printf("Memory allocation failed!\n"); exit(1); }
 		row_P[0] = 0;
 		for(int n = 0; n < N; n++) row_P[n + 1] = row_P[n] + K;
 
@@ -518,10 +575,15 @@ private:
 		for(int n = 0; n < N; n++) obj_X[n] = DataPoint(D, n, X + n * D);
 		tree->create(obj_X);
 
-		// Loop over all points to find nearest neighbors
+		// Loop over all points to find nearest neighbors, the searches and
+		// the calibration of the rows are independent and run in parallel
 		//printf("Building tree...\n");
+#pragma omp parallel
+		{
 		std::vector<DataPoint> indices;
 		std::vector<double> distances;
+		std::vector<double> cur_P(K);
+#pragma omp for schedule(dynamic,64)
 		for(int n = 0; n < N; n++) {
 
 			//if(n % 10000 == 0) printf(" - point %d of %d\n", n, N);
@@ -585,10 +647,10 @@ private:
 				val_P[row_P[n] + m] = cur_P[m];
 			}
 		}
+		}
 
 		// Clean up memory
 		obj_X.clear();
-		free(cur_P);
 		delete tree;
 	}
 
@@ -487,9 +487,34 @@ private:
 		DenseMatrix data =
 			dense_matrix_from_features(features, current_dimension, begin, end);
 
+		Parameter n_iterations = parameters(keywords::sne_max_iteration).checked().positive();
+		Parameter exaggeration = parameters(keywords::sne_early_exaggeration).checked().positive();
+		Parameter exaggeration_iterations = parameters(keywords::sne_exaggeration_iterations).checked().nonNegative();
+		Parameter momentum = parameters(keywords::sne_momentum).checked()
+			.inClosedRange(static_cast<ScalarType>(0.0),static_cast<ScalarType>(1.0));
+		Parameter final_momentum = parameters(keywords::sne_final_momentum).checked()
+			.inClosedRange(static_cast<ScalarType>(0.0),static_cast<ScalarType>(1.0));
+		Parameter momentum_switch_iteration = parameters(keywords::sne_momentum_switch_iteration).checked().nonNegative();
+		Parameter learning_rate = parameters(keywords::sne_learning_rate).checked().positive();
+		Parameter interpolation = parameters(keywords::sne_interpolation);
+
+		tsne::TSNE::Schedule schedule;
+		schedule.max_iter = static_cast<IndexType>(n_iterations);
+		schedule.exaggeration = static_cast<ScalarType>(exaggeration);
+		schedule.stop_lying_iter = static_cast<IndexType>(exaggeration_iterations);
+		schedule.momentum = static_cast<ScalarType>(momentum);
+		schedule.final_momentum = static_cast<ScalarType>(final_momentum);
+		schedule.mom_switch_iter = static_cast<IndexType>(momentum_switch_iteration);
+		schedule.eta = static_cast<ScalarType>(learning_rate);
+
+		bool use_interpolation = interpolation;
+		if (use_interpolation && static_cast<IndexType>(target_dimension) != 2)
+			throw wrong_parameter_error("Interpolation-based t-SNE supports 2D embeddings only");
+
 		DenseMatrix embedding(static_cast<IndexType>(target_dimension),n_vectors);
 		tsne::TSNE tsne;
-		tsne.run(data.data(),n_vectors,current_dimension,embedding.data(),target_dimension,perplexity,theta);
+		tsne.run(data.data(),n_vectors,current_dimension,embedding.data(),target_dimension,perplexity,theta,
+		         schedule,use_interpolation);
 
 		return TapkeeOutput(embedding.transpose(), unimplementedProjectingFunction());
 	}
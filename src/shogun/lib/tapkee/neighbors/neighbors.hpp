@@ -12,6 +12,7 @@
 	#include <shogun/lib/tapkee/neighbors/covertree.hpp>
 #endif
 #include <shogun/lib/tapkee/neighbors/connected.hpp>
+#include <shogun/lib/tapkee/neighbors/nndescent.hpp>
 #include <shogun/lib/tapkee/neighbors/vptree.hpp>
 /* End of Tapkee includes */
 
@@ -124,11 +125,14 @@ Neighbors find_neighbors_bruteforce_impl(const RandomAccessIterator& begin, cons
 	typedef std::pair<RandomAccessIterator, ScalarType> DistanceRecord;
 	typedef std::vector<DistanceRecord> Distances;
 
-	Neighbors neighbors;
-	neighbors.reserve(end-begin);
-	for (RandomAccessIterator iter=begin; iter!=end; ++iter)
+	const IndexType N = end-begin;
+	Neighbors neighbors(N);
+#pragma omp parallel for schedule(dynamic,16)
+	for (IndexType i=0; i<N; ++i)
 	{
+		RandomAccessIterator iter = begin+i;
 		Distances distances;
+		distances.reserve(N);
 		for (RandomAccessIterator around_iter=begin; around_iter!=end; ++around_iter)
 			distances.push_back(std::make_pair(around_iter, callback.distance(iter,around_iter)));
 
@@ -143,11 +147,21 @@ Neighbors find_neighbors_bruteforce_impl(const RandomAccessIterator& begin, cons
 			if (neighbors_iter->first != iter)
 				local_neighbors.push_back(neighbors_iter->first - begin);
 		}
-		neighbors.push_back(local_neighbors);
+		neighbors[i] = local_neighbors;
 	}
 	return neighbors;
 }
 
+template <class RandomAccessIterator, class Callback>
+Neighbors find_neighbors_nndescent_impl(const RandomAccessIterator& begin, const RandomAccessIterator& end,
+                                        Callback callback, IndexType k)
+{
+	timed_context context("NN-descent based neighbors search");
+
+	NNDescentGraph<RandomAccessIterator,Callback> nndescent(begin,end,callback,k);
+	return nndescent.compute();
+}
+
 template <class RandomAccessIterator, class Callback>
 Neighbors find_neighbors_vptree_impl(const RandomAccessIterator& begin, const RandomAccessIterator& end,
                                      Callback callback, IndexType k)
@@ -186,6 +200,7 @@ Neighbors find_neighbors(NeighborsMethod method, const RandomAccessIterator& beg
 	{
 		case Brute: neighbors = find_neighbors_bruteforce_impl(begin,end,callback,k); break;
 		case VpTree: neighbors = find_neighbors_vptree_impl(begin,end,callback,k); break;
+		case NNDescent: neighbors = find_neighbors_nndescent_impl(begin,end,callback,k); break;
 #ifdef USE_GPL_SHOGUN
 		case CoverTree: neighbors = find_neighbors_covertree_impl(begin,end,callback,k); break;
 #endif
@@ -0,0 +1,233 @@
+/* This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef TAPKEE_NNDESCENT_H_
+#define TAPKEE_NNDESCENT_H_
+
+/* Tapkee includes */
+#include <shogun/lib/tapkee/defines.hpp>
+/* End of Tapkee includes */
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+namespace tapkee
+{
+namespace tapkee_internal
+{
+
+//! Approximate k-nearest neighbors graph built by NN-descent as
+//! described in @cite Dong2011.
+//!
+//! Starting from random neighbors, every point repeatedly introduces its
+//! neighbors (and reverse neighbors) to each other, as a neighbor of a
+//! neighbor is likely to be a neighbor. The local joins of all points
+//! run in parallel, every neighbors list is guarded by its own lock.
+//! Iterations stop when less than a fraction delta of the lists changed.
+template <class RandomAccessIterator, class DistanceCallback>
+class NNDescentGraph
+{
+public:
+	//! neighbor candidate: distance and index, the flag tells
+	//! whether it was not joined yet
+	struct Candidate
+	{
+		ScalarType distance;
+		IndexType index;
+		bool is_new;
+
+		inline bool operator<(const Candidate& other) const
+		{
+			return distance < other.distance;
+		}
+	};
+
+	NNDescentGraph(const RandomAccessIterator& b, const RandomAccessIterator& e,
+	               const DistanceCallback& c, IndexType k) :
+		begin(b), callback(c), N(e-b), K(k), heaps(N), locks(N)
+	{
+	}
+
+	//! @param max_iteration maximal number of iterations
+	//! @param delta stop when less than delta*N*K updates happened
+	Neighbors compute(IndexType max_iteration = 20, ScalarType delta = 0.001)
+	{
+		initialize();
+
+		for (IndexType iteration=0; iteration<max_iteration; ++iteration)
+		{
+			IndexType n_updates = iterate();
+			if (n_updates <= delta*N*K)
+				break;
+		}
+
+		Neighbors neighbors(N);
+		for (IndexType i=0; i<N; ++i)
+		{
+			std::sort_heap(heaps[i].begin(), heaps[i].end());
+			neighbors[i].reserve(heaps[i].size());
+			for (IndexType j=0; j<static_cast<IndexType>(heaps[i].size()); ++j)
+				neighbors[i].push_back(heaps[i][j].index);
+		}
+		return neighbors;
+	}
+
+private:
+
+	inline ScalarType distance(IndexType i, IndexType j)
+	{
+		return callback.distance(begin+i, begin+j);
+	}
+
+	//! fills every list with K distinct random neighbors, the random
+	//! indices are drawn serially to keep the initialization reproducible
+	void initialize()
+	{
+		std::vector<IndexType> random_neighbors(N*K);
+		for (IndexType i=0; i<N; ++i)
+		{
+			for (IndexType j=0; j<K; ++j)
+			{
+				IndexType candidate;
+				bool seen;
+				do
+				{
+					candidate = uniform_random_index_bounded(N);
+					seen = (candidate == i);
+					for (IndexType l=0; l<j && !seen; ++l)
+						seen = (random_neighbors[i*K+l] == candidate);
+				}
+				while (seen);
+				random_neighbors[i*K+j] = candidate;
+			}
+		}
+
+#pragma omp parallel for
+		for (IndexType i=0; i<N; ++i)
+		{
+			heaps[i].reserve(K);
+			for (IndexType j=0; j<K; ++j)
+			{
+				IndexType neighbor = random_neighbors[i*K+j];
+				Candidate candidate = {distance(i,neighbor), neighbor, true};
+				heaps[i].push_back(candidate);
+			}
+			std::make_heap(heaps[i].begin(), heaps[i].end());
+		}
+	}
+
+	//! tries to insert j into the neighbors of i
+	//! @return whether the neighbors of i changed
+	bool update(IndexType i, IndexType j, ScalarType d)
+	{
+		std::lock_guard<std::mutex> guard(locks[i]);
+		std::vector<Candidate>& heap = heaps[i];
+		if (d >= heap.front().distance)
+			return false;
+		for (IndexType l=0; l<K; ++l)
+		{
+			if (heap[l].index == j)
+				return false;
+		}
+
+		std::pop_heap(heap.begin(), heap.end());
+		Candidate candidate = {d, j, true};
+		heap.back() = candidate;
+		std::push_heap(heap.begin(), heap.end());
+		return true;
+	}
+
+	//! one local join of every point
+	//! @return number of updated neighbors
+	IndexType iterate()
+	{
+		std::vector<LocalNeighbors> new_neighbors(N), old_neighbors(N);
+		for (IndexType i=0; i<N; ++i)
+		{
+			for (IndexType l=0; l<K; ++l)
+			{
+				Candidate& candidate = heaps[i][l];
+				if (candidate.is_new)
+				{
+					new_neighbors[i].push_back(candidate.index);
+					candidate.is_new = false;
+				}
+				else
+				{
+					old_neighbors[i].push_back(candidate.index);
+				}
+			}
+		}
+
+		// reverse neighbors, at most K of each kind
+		std::vector<LocalNeighbors> new_reverse(N), old_reverse(N);
+		for (IndexType i=0; i<N; ++i)
+		{
+			for (IndexType l=0; l<static_cast<IndexType>(new_neighbors[i].size()); ++l)
+			{
+				IndexType j = new_neighbors[i][l];
+				if (static_cast<IndexType>(new_reverse[j].size()) < K)
+					new_reverse[j].push_back(i);
+			}
+			for (IndexType l=0; l<static_cast<IndexType>(old_neighbors[i].size()); ++l)
+			{
+				IndexType j = old_neighbors[i][l];
+				if (static_cast<IndexType>(old_reverse[j].size()) < K)
+					old_reverse[j].push_back(i);
+			}
+		}
+
+		IndexType n_updates = 0;
+#pragma omp parallel for schedule(dynamic,256) reduction(+:n_updates)
+		for (IndexType i=0; i<N; ++i)
+		{
+			LocalNeighbors news = new_neighbors[i];
+			LocalNeighbors olds = old_neighbors[i];
+			news.insert(news.end(), new_reverse[i].begin(), new_reverse[i].end());
+			olds.insert(olds.end(), old_reverse[i].begin(), old_reverse[i].end());
+			std::sort(news.begin(), news.end());
+			news.erase(std::unique(news.begin(), news.end()), news.end());
+			std::sort(olds.begin(), olds.end());
+			olds.erase(std::unique(olds.begin(), olds.end()), olds.end());
+
+			for (IndexType a=0; a<static_cast<IndexType>(news.size()); ++a)
+			{
+				IndexType u = news[a];
+				// new with new, every pair once
+				for (IndexType b=a+1; b<static_cast<IndexType>(news.size()); ++b)
+				{
+					IndexType v = news[b];
+					ScalarType d = distance(u,v);
+					n_updates += update(u,v,d);
+					n_updates += update(v,u,d);
+				}
+				// new with old
+				for (IndexType b=0; b<static_cast<IndexType>(olds.size()); ++b)
+				{
+					IndexType v = olds[b];
+					if (u == v)
+						continue;
+					ScalarType d = distance(u,v);
+					n_updates += update(u,v,d);
+					n_updates += update(v,u,d);
+				}
+			}
+		}
+		return n_updates;
+	}
+
+	RandomAccessIterator begin;
+	DistanceCallback callback;
+	IndexType N;
+	IndexType K;
+	//! max-heaps of the current neighbors of every point
+	std::vector<std::vector<Candidate> > heaps;
+	std::vector<std::mutex> locks;
+};
+
+}
+}
+#endif
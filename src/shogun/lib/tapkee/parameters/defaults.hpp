@@ -32,7 +32,15 @@ const ParametersSet defaults = (
 	tapkee::keywords::cancel_function = tapkee::keywords::by_default,
 	tapkee::keywords::sne_perplexity = tapkee::keywords::by_default,
 	tapkee::keywords::squishing_rate = tapkee::keywords::by_default,
-	tapkee::keywords::sne_theta = tapkee::keywords::by_default);
+	tapkee::keywords::sne_theta = tapkee::keywords::by_default,
+	tapkee::keywords::sne_max_iteration = tapkee::keywords::by_default,
+	tapkee::keywords::sne_early_exaggeration = tapkee::keywords::by_default,
+	tapkee::keywords::sne_exaggeration_iterations = tapkee::keywords::by_default,
+	tapkee::keywords::sne_momentum = tapkee::keywords::by_default,
+	tapkee::keywords::sne_final_momentum = tapkee::keywords::by_default,
+	tapkee::keywords::sne_momentum_switch_iteration = tapkee::keywords::by_default,
+	tapkee::keywords::sne_learning_rate = tapkee::keywords::by_default,
+	tapkee::keywords::sne_interpolation = tapkee::keywords::by_default);
 
 }
 
@@ -200,7 +200,7 @@ DenseMatrix compute_shortest_distances_matrix(const RandomAccessIterator& begin,
 #else
 			heap.insert(landmarks[k],0.0);
 #endif
-			f[k] = true;
+			f[landmarks[k]] = true;
 
 			// while heap is not empty
 			while (!heap.empty())
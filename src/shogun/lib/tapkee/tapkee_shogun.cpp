@@ -81,6 +81,21 @@ CDenseFeatures<float64_t>* shogun::tapkee_embed(const shogun::TAPKEE_PARAMETERS_
 	tapkee::EigenMethod eigen_method = tapkee::Dense;
 #endif
 	tapkee::NeighborsMethod neighbors_method = tapkee::CoverTree;
+	switch (parameters.neighbors_method)
+	{
+		case NEIGHBORS_COVER_TREE:
+			neighbors_method = tapkee::CoverTree;
+			break;
+		case NEIGHBORS_VP_TREE:
+			neighbors_method = tapkee::VpTree;
+			break;
+		case NEIGHBORS_BRUTE_FORCE:
+			neighbors_method = tapkee::Brute;
+			break;
+		case NEIGHBORS_NN_DESCENT:
+			neighbors_method = tapkee::NNDescent;
+			break;
+	}
 	size_t N = 0;
 
 	switch (parameters.method)
@@ -173,6 +188,14 @@ CDenseFeatures<float64_t>* shogun::tapkee_embed(const shogun::TAPKEE_PARAMETERS_
 		 tapkee::keywords::fa_epsilon = parameters.fa_epsilon,
 		 tapkee::keywords::sne_perplexity = parameters.sne_perplexity,
 		 tapkee::keywords::sne_theta = parameters.sne_theta,
+		 tapkee::keywords::sne_max_iteration = parameters.sne_max_iteration,
+		 tapkee::keywords::sne_early_exaggeration = parameters.sne_early_exaggeration,
+		 tapkee::keywords::sne_exaggeration_iterations = parameters.sne_exaggeration_iterations,
+		 tapkee::keywords::sne_momentum = parameters.sne_momentum,
+		 tapkee::keywords::sne_final_momentum = parameters.sne_final_momentum,
+		 tapkee::keywords::sne_momentum_switch_iteration = parameters.sne_momentum_switch_iteration,
+		 tapkee::keywords::sne_learning_rate = parameters.sne_learning_rate,
+		 tapkee::keywords::sne_interpolation = parameters.sne_interpolation,
 		 tapkee::keywords::squishing_rate = parameters.squishing_rate
 		 );
 
@@ -9,6 +9,7 @@
 #include <shogun/lib/config.h>
 
 
+#include <shogun/converter/EmbeddingConverter.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/distance/Distance.h>
@@ -44,17 +45,23 @@ struct TAPKEE_PARAMETERS_FOR_SHOGUN
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN() :
 		method(SHOGUN_KERNEL_LOCALLY_LINEAR_EMBEDDING),
+		neighbors_method(NEIGHBORS_COVER_TREE),
 		n_neighbors(10), n_timesteps(3),
 		target_dimension(2), spe_num_updates(100),
 		eigenshift(1e-9), landmark_ratio(0.5),
 		gaussian_kernel_width(1.0), spe_tolerance(1e-5),
 		spe_global_strategy(false), max_iteration(100),
 		fa_epsilon(1e-5), sne_theta(0.5),
-		sne_perplexity(30.0), squishing_rate(0.99),
+		sne_perplexity(30.0), sne_max_iteration(1000),
+		sne_early_exaggeration(12.0), sne_exaggeration_iterations(250),
+		sne_momentum(0.5), sne_final_momentum(0.8),
+		sne_momentum_switch_iteration(250), sne_learning_rate(200.0),
+		sne_interpolation(false), squishing_rate(0.99),
 		kernel(NULL), distance(NULL), features(NULL)
 	{
 	}
 	TAPKEE_METHODS_FOR_SHOGUN method;
+	ENeighborsMethod neighbors_method;
 	uint32_t n_neighbors;
 	uint32_t n_timesteps;
 	uint32_t target_dimension;
@@ -68,6 +75,14 @@ struct TAPKEE_PARAMETERS_FOR_SHOGUN
 	float64_t fa_epsilon;
 	float64_t sne_theta;
 	float64_t sne_perplexity;
+	uint32_t sne_max_iteration;
+	float64_t sne_early_exaggeration;
+	uint32_t sne_exaggeration_iterations;
+	float64_t sne_momentum;
+	float64_t sne_final_momentum;
+	uint32_t sne_momentum_switch_iteration;
+	float64_t sne_learning_rate;
+	bool sne_interpolation;
 	float64_t squishing_rate;
 	CKernel* kernel;
 	CDistance* distance;
@@ -45,6 +45,7 @@ std::string get_neighbors_method_name(NeighborsMethod m)
 	{
 		case Brute: return "Brute-force";
 		case VpTree: return "VP-tree";
+		case NNDescent: return "NN-descent";
 #ifdef TAPKEE_USE_LGPL_COVERTREE
 		case CoverTree: return "Cover Tree";
 #endif
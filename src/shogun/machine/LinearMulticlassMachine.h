@@ -160,6 +160,33 @@ class CLinearMulticlassMachine : public CMulticlassMachine
 			m_features->remove_subset();
 		}
 
+		/** linear machines can be trained in parallel */
+		virtual bool supports_parallel_training() const
+		{
+			return true;
+		}
+
+		/** get a shallow copy of the base machine that trains on a shallow
+		 * copy of the features with the given subset. The copy gets its own
+		 * normal vector, since training may update it in place, e.g. when
+		 * warm starting from the base machine's hyperplane
+		 *
+		 * @param subset subset indices, empty for all features
+		 * @return machine (SG_REF'ed)
+		 */
+		virtual CMachine* get_machine_for_subset(SGVector<index_t> subset)
+		{
+			CLinearMachine* machine=(CLinearMachine*) m_machine->shallow_clone();
+			machine->set_w(machine->get_w().clone());
+			CDotFeatures* features=(CDotFeatures*) m_features->shallow_clone();
+			if (subset.vlen)
+				features->add_subset(subset);
+
+			machine->set_features(features);
+			SG_UNREF(features);
+			return machine;
+		}
+
 		/** Stores feature data of underlying model. Does nothing because
 		 * Linear machines store the normal vector of the separating hyperplane
 		 * and therefore the model anyway
@@ -14,11 +14,13 @@
 #include <shogun/mathematics/Statistics.h>
 #include <shogun/labels/MultilabelLabels.h>
 
+#include <vector>
+
 using namespace shogun;
 
 CMulticlassMachine::CMulticlassMachine()
 : CBaseMulticlassMachine(), m_multiclass_strategy(new CMulticlassOneVsRestStrategy()),
-	m_machine(NULL)
+	m_machine(NULL), m_parallel_training(false)
 {
 	SG_REF(m_multiclass_strategy);
 	register_parameters();
@@ -33,6 +35,7 @@ CMulticlassMachine::CMulticlassMachine(
 	set_labels(labs);
 	SG_REF(machine);
 	m_machine = machine;
+	m_parallel_training = false;
 	register_parameters();
 }
 
@@ -52,6 +55,8 @@ void CMulticlassMachine::register_parameters()
 {
 	SG_ADD(&m_multiclass_strategy,"multiclass_strategy", "Multiclass strategy");
 	SG_ADD(&m_machine, "machine", "The base machine");
+	SG_ADD(&m_parallel_training, "parallel_training",
+		"Whether to train the submachines in parallel");
 }
 
 void CMulticlassMachine::init_strategy()
@@ -134,22 +139,35 @@ CMulticlassLabels* CMulticlassMachine::apply_multiclass(CFeatures* data)
 				outputs[i]->scores_to_probabilities(0,0);
 		}
 
-		SGVector<float64_t> output_for_i(num_machines);
-		SGVector<float64_t> r_output_for_i(num_machines);
-		if (heuris!=PROB_HEURIS_NONE)
-			r_output_for_i.resize_vector(num_classes);
-
-		for (int32_t i=0; i<num_vectors; i++)
+		if (heuris==PROB_HEURIS_NONE)
 		{
+			// decide all labels at once so that the strategy can batch
+			// the decoding
+			SGMatrix<float64_t> all_outputs(num_machines, num_vectors);
 			for (int32_t j=0; j<num_machines; j++)
-				output_for_i[j] = outputs[j]->get_value(i);
+			{
+				for (int32_t i=0; i<num_vectors; i++)
+					all_outputs(j, i) = outputs[j]->get_value(i);
+			}
 
-			if (heuris==PROB_HEURIS_NONE)
+			SGVector<int32_t> labels=m_multiclass_strategy->decide_labels(all_outputs);
+			for (int32_t i=0; i<num_vectors; i++)
 			{
-				r_output_for_i = output_for_i;
+				result->set_label(i, labels[i]);
+				result->set_multiclass_confidences(i, SGVector<float64_t>(
+					all_outputs.get_column_vector(i), num_machines, false));
 			}
-			else
+		}
+		else
+		{
+			SGVector<float64_t> output_for_i(num_machines);
+			SGVector<float64_t> r_output_for_i(num_classes);
+
+			for (int32_t i=0; i<num_vectors; i++)
 			{
+				for (int32_t j=0; j<num_machines; j++)
+					output_for_i[j] = outputs[j]->get_value(i);
+
 				if (heuris==OVA_SOFTMAX)
 					m_multiclass_strategy->rescale_outputs(output_for_i,As,Bs);
 				else
@@ -161,11 +179,11 @@ CMulticlassLabels* CMulticlassMachine::apply_multiclass(CFeatures* data)
 
 				SG_DEBUG("%s::apply_multiclass(): sum(r_output_for_i) = %f\n",
 					get_name(), SGVector<float64_t>::sum(r_output_for_i.vector,num_classes));
-			}
 
-			// use rescaled outputs for label decision
-			result->set_label(i, m_multiclass_strategy->decide_label(r_output_for_i));
-			result->set_multiclass_confidences(i, r_output_for_i);
+				// use rescaled outputs for label decision
+				result->set_label(i, m_multiclass_strategy->decide_label(r_output_for_i));
+				result->set_multiclass_confidences(i, r_output_for_i);
+			}
 		}
 
 		for (int32_t i=0; i < num_machines; ++i)
@@ -249,22 +267,60 @@ bool CMulticlassMachine::train_machine(CFeatures* data)
 
 	m_multiclass_strategy->train_start(
 	    multiclass_labels(m_labels), train_labels);
-	while (m_multiclass_strategy->train_has_more())
+
+	int32_t num_threads=parallel->get_num_threads();
+	if (m_parallel_training && num_threads>1 && supports_parallel_training())
 	{
-		SGVector<index_t> subset=m_multiclass_strategy->train_prepare_next();
-		if (subset.vlen)
+		std::vector<CMachine*> batch;
+		while (m_multiclass_strategy->train_has_more())
 		{
-			train_labels->add_subset(subset);
-			add_machine_subset(subset);
-		}
+			// strategies write the labels of each dichotomy into the shared
+			// train_labels, so the batch is prepared serially and every
+			// machine gets a copy of its labels
+			batch.clear();
+			while (int32_t(batch.size())<num_threads &&
+					m_multiclass_strategy->train_has_more())
+			{
+				SGVector<index_t> subset=m_multiclass_strategy->train_prepare_next();
+				CBinaryLabels* labels=new CBinaryLabels(train_labels->get_labels_copy());
+				if (subset.vlen)
+					labels->add_subset(subset);
+
+				CMachine* machine=get_machine_for_subset(subset);
+				machine->set_labels(labels);
+				batch.push_back(machine);
+			}
 
-		m_machine->train();
-		m_machines->push_back(get_machine_from_trained(m_machine));
+			#pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads)
+			for (int32_t i=0; i<int32_t(batch.size()); i++)
+				batch[i]->train();
 
-		if (subset.vlen)
+			for (size_t i=0; i<batch.size(); i++)
+			{
+				m_machines->push_back(get_machine_from_trained(batch[i]));
+				SG_UNREF(batch[i]);
+			}
+		}
+	}
+	else
+	{
+		while (m_multiclass_strategy->train_has_more())
 		{
-			train_labels->remove_subset();
-			remove_machine_subset();
+			SGVector<index_t> subset=m_multiclass_strategy->train_prepare_next();
+			if (subset.vlen)
+			{
+				train_labels->add_subset(subset);
+				add_machine_subset(subset);
+			}
+
+			m_machine->train();
+			m_machines->push_back(get_machine_from_trained(m_machine));
+
+			if (subset.vlen)
+			{
+				train_labels->remove_subset();
+				remove_machine_subset();
+			}
 		}
 	}
 
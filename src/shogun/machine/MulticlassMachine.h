@@ -151,6 +151,23 @@ class CMulticlassMachine : public CBaseMulticlassMachine
 			m_multiclass_strategy->set_prob_heuris_type(prob_heuris);
 		}
 
+		/** set whether the submachines are trained in parallel. Each
+		 * submachine then trains on its own shallow copy of the base machine
+		 * and the features. Ignored by machines that do not support it.
+		 *
+		 * @param parallel_training whether to train in parallel
+		 */
+		inline void set_parallel_training(bool parallel_training)
+		{
+			m_parallel_training = parallel_training;
+		}
+
+		/** @return whether the submachines are trained in parallel */
+		inline bool get_parallel_training() const
+		{
+			return m_parallel_training;
+		}
+
 	protected:
 		/** init strategy */
 		void init_strategy();
@@ -185,6 +202,26 @@ class CMulticlassMachine : public CBaseMulticlassMachine
 		/** deletes any subset set to the features of the machine */
 		virtual void remove_machine_subset() = 0;
 
+		/** whether get_machine_for_subset is implemented, i.e. whether the
+		 * submachines can be trained in parallel
+		 */
+		virtual bool supports_parallel_training() const
+		{
+			return false;
+		}
+
+		/** get a copy of the base machine that trains on the given subset of
+		 * the features, independently of the base machine and other copies
+		 *
+		 * @param subset subset indices, empty for all features
+		 * @return machine (SG_REF'ed)
+		 */
+		virtual CMachine* get_machine_for_subset(SGVector<index_t> subset)
+		{
+			SG_NOTIMPLEMENTED
+			return NULL;
+		}
+
 		/** whether the machine is acceptable in set_machine */
 		virtual bool is_acceptable_machine(CMachine *machine)
 		{
@@ -202,6 +239,9 @@ class CMulticlassMachine : public CBaseMulticlassMachine
 
 		/** machine */
 		CMachine* m_machine;
+
+		/** whether to train the submachines in parallel */
+		bool m_parallel_training;
 };
 }
 #endif
@@ -47,7 +47,12 @@ SGVector<float64_t> COnlineLinearMachine::apply_get_outputs(CFeatures* data)
 	if (data)
 	{
 		if (!data->has_property(FP_STREAMING_DOT))
-			SG_ERROR("Specified features are not of type CStreamingDotFeatures\n")
+		{
+			if (data->has_property(FP_DOT))
+				return apply_get_outputs((CDotFeatures*) data);
+
+			SG_ERROR("Specified features are not of type CStreamingDotFeatures or CDotFeatures\n")
+		}
 
 		set_features((CStreamingDotFeatures*) data);
 	}
@@ -72,6 +77,24 @@ SGVector<float64_t> COnlineLinearMachine::apply_get_outputs(CFeatures* data)
 	return labels_array;
 }
 
+SGVector<float64_t> COnlineLinearMachine::apply_get_outputs(CDotFeatures* data)
+{
+	int32_t dim = data->get_dim_feature_space();
+	REQUIRE(m_w.vlen == dim,
+		"Dimension of the features (%d) does not match the weights (%d).\n",
+		dim, m_w.vlen)
+
+	SGVector<float64_t> w(dim);
+	for (int32_t i=0; i<dim; i++)
+		w[i] = m_w[i];
+
+	int32_t num_vectors = data->get_num_vectors();
+	SGVector<float64_t> outputs(num_vectors);
+	data->dense_dot_range(outputs.vector, 0, num_vectors, NULL, w.vector, dim, bias);
+
+	return outputs;
+}
+
 float32_t COnlineLinearMachine::apply_one(float32_t* vec, int32_t len)
 {
 		SGVector<float32_t> wrap(vec, len, false);
@@ -12,6 +12,7 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/lib/common.h>
+#include <shogun/features/DotFeatures.h>
 #include <shogun/features/streaming/StreamingDotFeatures.h>
 #include <shogun/machine/Machine.h>
 
@@ -229,6 +230,13 @@ class COnlineLinearMachine : public CMachine
 		 */
 		SGVector<float64_t> apply_get_outputs(CFeatures* data);
 
+		/** get real outputs for features in memory
+		 *
+		 * @param data features to compute outputs
+		 * @return outputs
+		 */
+		SGVector<float64_t> apply_get_outputs(CDotFeatures* data);
+
 	protected:
 		/** w */
 		SGVector<float32_t> m_w;
@@ -236,16 +236,25 @@ namespace shogun
 
 	CSGObject* CPipeline::clone()
 	{
-		auto result = CMachine::clone()->as<CPipeline>();
+		return copy_stages(CMachine::clone()->as<CPipeline>(), false);
+	}
+
+	CSGObject* CPipeline::shallow_clone()
+	{
+		return copy_stages(CMachine::shallow_clone()->as<CPipeline>(), true);
+	}
+
+	CPipeline* CPipeline::copy_stages(CPipeline* result, bool share) const
+	{
 		for (auto&& stage : m_stages)
 		{
 			visit(
 			    [&](auto object) {
+				    auto copy = share ? object->shallow_clone() : object->clone();
 				    result->m_stages.emplace_back(
 				        stage.first,
-				        object->clone()
-				            ->template as<typename std::remove_pointer<decltype(
-				                object)>::type>());
+				        copy->template as<typename std::remove_pointer<decltype(
+				            object)>::type>());
 				},
 			    stage.second);
 		}
@@ -124,6 +124,8 @@ namespace shogun
 
 		virtual CSGObject* clone() override;
 
+		virtual CSGObject* shallow_clone() override;
+
 		virtual EProblemType get_machine_problem_type() const override;
 
 	protected:
@@ -133,6 +135,14 @@ namespace shogun
 		    m_stages;
 		virtual bool train_require_labels() const override;
 
+		/** Appends copies of the stages to a clone of this pipeline
+		 *
+		 * @param result clone of this pipeline without stages
+		 * @param share whether to shallow clone the stages
+		 * @return result
+		 */
+		CPipeline* copy_stages(CPipeline* result, bool share) const;
+
 		/** Stores feature data of underlying model. This will be forwarded to
 		 * `store_model_features` of underlying machines.
 		 */
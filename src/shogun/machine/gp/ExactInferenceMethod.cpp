@@ -44,12 +44,19 @@ using namespace Eigen;
 
 CExactInferenceMethod::CExactInferenceMethod() : CInference()
 {
+	init();
 }
 
 CExactInferenceMethod::CExactInferenceMethod(CKernel* kern, CFeatures* feat,
 		CMeanFunction* m, CLabels* lab, CLikelihoodModel* mod) :
 		CInference(kern, feat, m, lab, mod)
 {
+	init();
+}
+
+void CExactInferenceMethod::init()
+{
+	m_factorized_sigma=0;
 }
 
 CExactInferenceMethod::~CExactInferenceMethod()
@@ -88,6 +95,90 @@ void CExactInferenceMethod::update()
 	SG_DEBUG("leaving\n");
 }
 
+void CExactInferenceMethod::append_training_data(CFeatures* features,
+		CLabels* labels)
+{
+	REQUIRE(features, "Features to append should not be NULL\n")
+	REQUIRE(labels, "Labels to append should not be NULL\n")
+	REQUIRE(labels->get_label_type()==LT_REGRESSION,
+		"Labels to append must be type of CRegressionLabels\n")
+	REQUIRE(features->get_num_vectors()==labels->get_num_labels(),
+		"Number of appended vectors (%d) must match number of labels (%d)\n",
+		features->get_num_vectors(), labels->get_num_labels())
+
+	bool up_to_date=!parameter_hash_changed();
+	index_t n=m_ktrtr.num_rows;
+	index_t k=features->get_num_vectors();
+
+	// merge old and new training data
+	SGVector<float64_t> y_old=((CRegressionLabels*) m_labels)->get_labels();
+	SGVector<float64_t> y_new=((CRegressionLabels*) labels)->get_labels();
+	SGVector<float64_t> y(y_old.vlen+y_new.vlen);
+	sg_memcpy(y.vector, y_old.vector, sizeof(float64_t)*y_old.vlen);
+	sg_memcpy(y.vector+y_old.vlen, y_new.vector, sizeof(float64_t)*y_new.vlen);
+	set_features(m_features->create_merged_copy(features));
+	set_labels(new CRegressionLabels(y));
+
+	if (!up_to_date)
+	{
+		update();
+		return;
+	}
+
+	if (!m_L.matrix)
+		update_chol_from_kernel();
+
+	// only the columns of the new examples are computed, the kernel matrix
+	// among the old examples is reused
+	m_kernel->init(m_features, m_features);
+	SGMatrix<float64_t> ktrtr(n+k, n+k);
+	Map<MatrixXd> K(ktrtr.matrix, n+k, n+k);
+	K.topLeftCorner(n, n)=Map<MatrixXd>(m_ktrtr.matrix, n, n);
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (index_t j=n; j<n+k; j++)
+	{
+		for (index_t i=0; i<=j; i++)
+		{
+			float64_t value=m_kernel->kernel(i, j);
+			ktrtr(i, j)=value;
+			ktrtr(j, i)=value;
+		}
+	}
+	m_ktrtr=ktrtr;
+
+	CGaussianLikelihood* lik = m_model->as<CGaussianLikelihood>();
+	float64_t sigma=lik->get_sigma();
+	float64_t scale=std::exp(m_log_scale * 2.0);
+	float64_t factor=scale/CMath::sq(sigma);
+
+	// with upper triangular L'*L=K*scale/sigma^2+I, the new factor is
+	// [L U; 0 C] with U=L'\K12*scale/sigma^2 and C'*C=K22*scale/sigma^2+I-U'*U
+	Map<MatrixXd> L_old(m_L.matrix, n, n);
+	SGMatrix<float64_t> chol(n+k, n+k);
+	Map<MatrixXd> L(chol.matrix, n+k, n+k);
+	L.setZero();
+	L.topLeftCorner(n, n)=L_old;
+	L.topRightCorner(n, k)=L_old.triangularView<Upper>().adjoint().solve(
+		K.topRightCorner(n, k)*factor);
+
+	MatrixXd U=L.topRightCorner(n, k);
+	LLT<MatrixXd> llt(K.bottomRightCorner(k, k)*factor+
+		MatrixXd::Identity(k, k)-U.adjoint()*U);
+	L.bottomRightCorner(k, k)=llt.matrixU();
+	m_L=chol;
+
+	m_scaled_ktrtr=SGMatrix<float64_t>(n+k, n+k);
+	Map<MatrixXd>(m_scaled_ktrtr.matrix, n+k, n+k)=K*scale;
+	m_eigenvalues=SGVector<float64_t>();
+	m_eigenvectors=SGMatrix<float64_t>();
+	m_factorized_sigma=sigma;
+
+	update_alpha();
+	m_gradient_update=false;
+	update_parameter_hash();
+}
+
 void CExactInferenceMethod::check_members() const
 {
 	CInference::check_members();
@@ -133,12 +224,21 @@ float64_t CExactInferenceMethod::get_negative_log_marginal_likelihood()
 	SGVector<float64_t> m=m_mean->get_mean_vector(m_features);
 	Map<VectorXd> eigen_m(m.vector, m.vlen);
 
+	// sum(log(diag(L))) is half the log-determinant of K/sigma^2+I
+	float64_t log_det;
+	if (m_eigenvalues.vlen)
+	{
+		Map<VectorXd> eigen_lambda(m_eigenvalues.vector, m_eigenvalues.vlen);
+		log_det=(eigen_lambda.array()/CMath::sq(sigma)+1.0).log().sum()/2.0;
+	}
+	else
+		log_det=eigen_L.diagonal().array().log().sum();
+
 	// compute negative log of the marginal likelihood:
 	// nlZ=(y-m)'*alpha/2+sum(log(diag(L)))+n*log(2*pi*sigma^2)/2
 	float64_t result =
-	    (eigen_y - eigen_m).dot(eigen_alpha) / 2.0 +
-	    eigen_L.diagonal().array().log().sum() +
-	    m_L.num_rows * std::log(2 * CMath::PI * CMath::sq(sigma)) / 2.0;
+	    (eigen_y - eigen_m).dot(eigen_alpha) / 2.0 + log_det +
+	    m_ktrtr.num_rows * std::log(2 * CMath::PI * CMath::sq(sigma)) / 2.0;
 
 	return result;
 }
@@ -156,6 +256,14 @@ SGMatrix<float64_t> CExactInferenceMethod::get_cholesky()
 	if (parameter_hash_changed())
 		update();
 
+	// the factor is only computed on demand while the eigendecomposition is
+	// used, it is a registered parameter, so the hash has to follow it
+	if (!m_L.matrix)
+	{
+		update_chol_from_kernel();
+		update_parameter_hash();
+	}
+
 	return SGMatrix<float64_t>(m_L);
 }
 
@@ -174,6 +282,49 @@ SGMatrix<float64_t> CExactInferenceMethod::get_posterior_covariance()
 }
 
 void CExactInferenceMethod::update_chol()
+{
+	// get the sigma variable from the Gaussian likelihood model
+	CGaussianLikelihood* lik = m_model->as<CGaussianLikelihood>();
+	float64_t sigma=lik->get_sigma();
+	float64_t scale=std::exp(m_log_scale * 2.0);
+	index_t n=m_ktrtr.num_rows;
+
+	Map<MatrixXd> K(m_ktrtr.matrix, n, m_ktrtr.num_cols);
+	Map<MatrixXd> scaled_K(m_scaled_ktrtr.matrix, m_scaled_ktrtr.num_rows,
+		m_scaled_ktrtr.num_cols);
+
+	// the factorisation only depends on K*scale and sigma
+	if (m_scaled_ktrtr.num_rows==n && (K.array()*scale==scaled_K.array()).all())
+	{
+		if (sigma==m_factorized_sigma && (m_L.matrix || m_eigenvalues.vlen))
+			return;
+
+		// otherwise K/sigma^2+I=V*(D/sigma^2+I)*V' for every sigma, where
+		// K=V*D*V' is computed once, and L is only computed on demand
+		if (!m_eigenvalues.vlen)
+		{
+			SelfAdjointEigenSolver<MatrixXd> eig(scaled_K);
+			m_eigenvalues=SGVector<float64_t>(n);
+			m_eigenvectors=SGMatrix<float64_t>(n, n);
+			Map<VectorXd>(m_eigenvalues.vector, n)=eig.eigenvalues();
+			Map<MatrixXd>(m_eigenvectors.matrix, n, n)=eig.eigenvectors();
+		}
+
+		m_factorized_sigma=sigma;
+		m_L=SGMatrix<float64_t>();
+		return;
+	}
+
+	m_scaled_ktrtr=SGMatrix<float64_t>(n, m_ktrtr.num_cols);
+	Map<MatrixXd>(m_scaled_ktrtr.matrix, n, m_ktrtr.num_cols)=K*scale;
+	m_eigenvalues=SGVector<float64_t>();
+	m_eigenvectors=SGMatrix<float64_t>();
+	m_factorized_sigma=sigma;
+
+	update_chol_from_kernel();
+}
+
+void CExactInferenceMethod::update_chol_from_kernel()
 {
 	// get the sigma variable from the Gaussian likelihood model
 	CGaussianLikelihood* lik = m_model->as<CGaussianLikelihood>();
@@ -205,10 +356,24 @@ void CExactInferenceMethod::update_alpha()
 	Map<VectorXd> eigen_m(m.vector, m.vlen);
 
 	m_alpha=SGVector<float64_t>(y.vlen);
+	Map<VectorXd> a(m_alpha.vector, m_alpha.vlen);
+
+	if (m_eigenvalues.vlen)
+	{
+		// a=V*diag(1/(D+sigma^2))*V'*(y-m)
+		Map<VectorXd> eigen_lambda(m_eigenvalues.vector, m_eigenvalues.vlen);
+		Map<MatrixXd> eigen_V(m_eigenvectors.matrix, m_eigenvectors.num_rows,
+			m_eigenvectors.num_cols);
+
+		VectorXd proj=eigen_V.adjoint()*(eigen_y-eigen_m);
+		proj=proj.cwiseQuotient(
+			(eigen_lambda.array()+CMath::sq(sigma)).matrix());
+		a=eigen_V*proj;
+		return;
+	}
 
 	/* creates views on cholesky matrix and alpha and solve system
 	 * (L * L^T) * a = y for a */
-	Map<VectorXd> a(m_alpha.vector, m_alpha.vlen);
 	Map<MatrixXd> L(m_L.matrix, m_L.num_rows, m_L.num_cols);
 
 	a=L.triangularView<Upper>().adjoint().solve(eigen_y-eigen_m);
@@ -244,6 +409,20 @@ void CExactInferenceMethod::update_cov()
 	Map<MatrixXd> eigen_Sigma(m_Sigma.matrix, m_Sigma.num_rows,
 			m_Sigma.num_cols);
 
+	if (m_eigenvalues.vlen)
+	{
+		CGaussianLikelihood* lik = m_model->as<CGaussianLikelihood>();
+		float64_t sigma2=CMath::sq(lik->get_sigma());
+
+		// Sigma = K - K*(K+sigma^2*I)^(-1)*K = V*diag(D*sigma^2/(D+sigma^2))*V'
+		Map<VectorXd> eigen_lambda(m_eigenvalues.vector, m_eigenvalues.vlen);
+		Map<MatrixXd> eigen_U(m_eigenvectors.matrix, m_eigenvectors.num_rows,
+			m_eigenvectors.num_cols);
+		VectorXd d=eigen_lambda.array()*sigma2/(eigen_lambda.array()+sigma2);
+		eigen_Sigma=eigen_U*d.asDiagonal()*eigen_U.adjoint();
+		return;
+	}
+
 	// compute V = L^(-1) * K, using upper triangular factor L^T
 	MatrixXd eigen_V = eigen_L.triangularView<Upper>().adjoint().solve(
 	    eigen_K * std::exp(m_log_scale * 2.0));
@@ -267,16 +446,28 @@ void CExactInferenceMethod::update_deriv()
 	Map<MatrixXd> eigen_L(m_L.matrix, m_L.num_rows, m_L.num_cols);
 	Map<VectorXd> eigen_alpha(m_alpha.vector, m_alpha.vlen);
 
-	m_Q=SGMatrix<float64_t>(m_L.num_rows, m_L.num_cols);
+	m_Q=SGMatrix<float64_t>(m_ktrtr.num_rows, m_ktrtr.num_cols);
 	Map<MatrixXd> eigen_Q(m_Q.matrix, m_Q.num_rows, m_Q.num_cols);
 
-	// solve L * L' * Q = I
-	eigen_Q=eigen_L.triangularView<Upper>().adjoint().solve(
-		MatrixXd::Identity(m_L.num_rows, m_L.num_cols));
-	eigen_Q=eigen_L.triangularView<Upper>().solve(eigen_Q);
+	if (m_eigenvalues.vlen)
+	{
+		// Q=(K+sigma^2*I)^(-1)=V*diag(1/(D+sigma^2))*V'
+		Map<VectorXd> eigen_lambda(m_eigenvalues.vector, m_eigenvalues.vlen);
+		Map<MatrixXd> eigen_V(m_eigenvectors.matrix, m_eigenvectors.num_rows,
+			m_eigenvectors.num_cols);
+		VectorXd d=(eigen_lambda.array()+CMath::sq(sigma)).inverse();
+		eigen_Q=eigen_V*d.asDiagonal()*eigen_V.adjoint();
+	}
+	else
+	{
+		// solve L * L' * Q = I
+		eigen_Q=eigen_L.triangularView<Upper>().adjoint().solve(
+			MatrixXd::Identity(m_L.num_rows, m_L.num_cols));
+		eigen_Q=eigen_L.triangularView<Upper>().solve(eigen_Q);
 
-	// divide Q by sigma^2
-	eigen_Q/=CMath::sq(sigma);
+		// divide Q by sigma^2
+		eigen_Q/=CMath::sq(sigma);
+	}
 
 	// create eigen representation of alpha and compute Q=Q-alpha*alpha'
 	eigen_Q-=eigen_alpha*eigen_alpha.transpose();
@@ -340,29 +531,13 @@ SGVector<float64_t> CExactInferenceMethod::get_derivative_wrt_likelihood_model(
 SGVector<float64_t> CExactInferenceMethod::get_derivative_wrt_kernel(
 		const TParameter* param)
 {
-	// create eigen representation of the matrix Q
-	Map<MatrixXd> eigen_Q(m_Q.matrix, m_Q.num_rows, m_Q.num_cols);
-
 	REQUIRE(param, "Param not set\n");
-	SGVector<float64_t> result;
-	int64_t len=const_cast<TParameter *>(param)->m_datatype.get_num_elements();
-	result=SGVector<float64_t>(len);
 
-	for (index_t i=0; i<result.vlen; i++)
-	{
-		SGMatrix<float64_t> dK;
-
-		if (result.vlen==1)
-			dK=m_kernel->get_parameter_gradient(param);
-		else
-			dK=m_kernel->get_parameter_gradient(param, i);
-
-		Map<MatrixXd> eigen_dK(dK.matrix, dK.num_rows, dK.num_cols);
-
-		// compute derivative wrt kernel parameter: dnlZ=sum(Q.*dK*scale)/2.0
-		result[i]=(eigen_Q.cwiseProduct(eigen_dK)).sum();
-		result[i] *= std::exp(m_log_scale * 2.0) / 2.0;
-	}
+	// compute derivative wrt kernel parameter: dnlZ=sum(Q.*dK*scale)/2.0,
+	// for all elements of the parameter at once
+	SGVector<float64_t> result=m_kernel->get_parameter_gradient_sum(param, m_Q);
+	Map<VectorXd> eigen_result(result.vector, result.vlen);
+	eigen_result*=std::exp(m_log_scale * 2.0) / 2.0;
 
 	return result;
 }
@@ -62,6 +62,12 @@ namespace shogun
  *
  * NOTE: The Gaussian Likelihood Function must be used for this inference
  * method.
+ *
+ * The factorisation is reused where possible: if only \f$\sigma\f$ changed
+ * since the last update, the posterior is computed from an eigendecomposition
+ * of the scaled kernel matrix instead of a new Cholesky factorisation, and
+ * append_training_data() extends an existing factorisation by the new
+ * examples in \f$O(n^2k)\f$.
  */
 class CExactInferenceMethod: public CInference
 {
@@ -187,6 +193,16 @@ public:
 	/** update matrices except gradients*/
 	virtual void update();
 
+	/** append training examples and update the Cholesky factor by the new
+	 * block of rows instead of refactorising the whole kernel matrix.
+	 * Falls back to a full update if the model is not up to date.
+	 *
+	 * @param features features of the new examples, must be mergeable with
+	 * the current training features
+	 * @param labels regression labels of the new examples
+	 */
+	virtual void append_training_data(CFeatures* features, CLabels* labels);
+
         /** Set a minimizer
          *
          * @param minimizer minimizer used in inference method
@@ -255,7 +271,16 @@ protected:
 
 	/** update gradients */
 	virtual void compute_gradient();
+
+	/** compute Cholesky factor of the current kernel matrix, which is only
+	 * done on demand while the eigendecomposition is used
+	 */
+	void update_chol_from_kernel();
+
 private:
+	/** initialize members */
+	void init();
+
 	/** covariance matrix of the the posterior Gaussian distribution */
 	SGMatrix<float64_t> m_Sigma;
 
@@ -263,6 +288,19 @@ private:
 	SGVector<float64_t> m_mu;
 
 	SGMatrix<float64_t> m_Q;
+
+	/** scaled kernel matrix of the current factorisation */
+	SGMatrix<float64_t> m_scaled_ktrtr;
+
+	/** noise level of the current factorisation */
+	float64_t m_factorized_sigma;
+
+	/** eigenvalues of the scaled kernel matrix, only computed when sigma
+	 * changed alone */
+	SGVector<float64_t> m_eigenvalues;
+
+	/** eigenvectors of the scaled kernel matrix */
+	SGMatrix<float64_t> m_eigenvectors;
 };
 }
 #endif /* CEXACTINFERENCEMETHOD_H_ */
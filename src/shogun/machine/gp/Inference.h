@@ -66,7 +66,8 @@ enum EInferenceType
 	INF_KL_CHOLESKY=52,
 	INF_KL_COVARIANCE=53,
 	INF_KL_DUAL=54,
-	INF_KL_SPARSE_REGRESSION=55
+	INF_KL_SPARSE_REGRESSION=55,
+	INF_SVGP_REGRESSION=56
 };
 
 /** @brief The Inference Method base class.
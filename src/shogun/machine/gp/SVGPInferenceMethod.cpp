@@ -0,0 +1,729 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * The reference paper is
+ * Hensman, James, Nicolo Fusi, and Neil D. Lawrence.
+ * "Gaussian processes for big data."
+ * Conference on Uncertainty in Artificial Intelligence. 2013.
+ */
+
+#include <shogun/machine/gp/SVGPInferenceMethod.h>
+#include <shogun/machine/gp/GaussianLikelihood.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/optimization/FirstOrderStochasticCostFunction.h>
+#include <shogun/optimization/FirstOrderStochasticMinimizer.h>
+#include <shogun/optimization/SGDMinimizer.h>
+#include <shogun/optimization/GradientDescendUpdater.h>
+#include <shogun/optimization/ConstLearningRate.h>
+#include <shogun/mathematics/eigen3.h>
+
+using namespace Eigen;
+
+namespace shogun
+{
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+class SVGPInferenceCostFunction: public FirstOrderStochasticCostFunction
+{
+public:
+	SVGPInferenceCostFunction():FirstOrderStochasticCostFunction() { init(); }
+	virtual ~SVGPInferenceCostFunction() { SG_UNREF(m_obj); }
+	void set_target(CSVGPInferenceMethod *obj)
+	{
+		REQUIRE(obj,"Obj must set\n");
+		if(m_obj!=obj)
+		{
+			SG_REF(obj);
+			SG_UNREF(m_obj);
+			m_obj=obj;
+		}
+	}
+	void unset_target(bool is_unref)
+	{
+		if(is_unref)
+		{
+			SG_UNREF(m_obj);
+		}
+		m_obj=NULL;
+	}
+
+	virtual void begin_sample()
+	{
+		REQUIRE(m_obj,"Object not set\n");
+		m_index=SGVector<index_t>(m_obj->m_features->get_num_vectors());
+		m_index.range_fill();
+		CMath::permute(m_index);
+		m_offset=0;
+	}
+	virtual bool next_sample()
+	{
+		if (m_offset>=m_index.vlen)
+			return false;
+
+		index_t len=CMath::min(m_obj->m_batch_size, m_index.vlen-m_offset);
+		m_batch=SGVector<index_t>(m_index.vector+m_offset, len, false);
+		m_offset+=len;
+		return true;
+	}
+
+	virtual float64_t get_cost()
+	{
+		REQUIRE(m_obj,"Object not set\n");
+		m_obj->update_alpha();
+		return m_obj->get_negative_elbo();
+	}
+	virtual SGVector<float64_t> obtain_variable_reference()
+	{
+		REQUIRE(m_obj,"Object not set\n");
+		m_derivatives=SGVector<float64_t>((m_obj->m_natural_params).vlen);
+		return m_obj->m_natural_params;
+	}
+	virtual SGVector<float64_t> get_gradient()
+	{
+		REQUIRE(m_obj,"Object not set\n");
+		m_obj->get_natural_gradient(m_batch, m_derivatives);
+		return m_derivatives;
+	}
+
+	virtual const char* get_name() const { return "SVGPInferenceCostFunction"; }
+private:
+	SGVector<float64_t> m_derivatives;
+	/** shuffled indices of the current pass */
+	SGVector<index_t> m_index;
+	/** indices of the current batch, a view into m_index */
+	SGVector<index_t> m_batch;
+	/** start of the next batch in m_index */
+	index_t m_offset;
+	void init()
+	{
+		m_obj=NULL;
+		m_offset=0;
+		SG_ADD(&m_derivatives, "SVGPInferenceCostFunction__m_derivatives",
+			"derivatives in SVGPInferenceCostFunction");
+		SG_ADD((CSGObject **)&m_obj, "SVGPInferenceCostFunction__m_obj",
+			"obj in SVGPInferenceCostFunction");
+	}
+	CSVGPInferenceMethod *m_obj;
+};
+#endif //DOXYGEN_SHOULD_SKIP_THIS
+
+CSVGPInferenceMethod::CSVGPInferenceMethod() : CSingleSparseInference()
+{
+	init();
+}
+
+CSVGPInferenceMethod::CSVGPInferenceMethod(CKernel* kern, CFeatures* feat,
+		CMeanFunction* m, CLabels* lab, CLikelihoodModel* mod, CFeatures* lat)
+		: CSingleSparseInference(kern, feat, m, lab, mod, lat)
+{
+	init();
+}
+
+void CSVGPInferenceMethod::init()
+{
+	m_batch_size=100;
+	m_log_det_kuu=0.0;
+	m_sigma2=0.0;
+	m_dlik=0.0;
+	m_dscale=0.0;
+
+	SG_ADD(&m_batch_size, "batch_size", "number of training points per mini-batch");
+	SG_ADD(&m_natural_params, "natural_params", "natural parameters of q(u)");
+	SG_ADD(&m_mu, "mu", "mean of q(u)");
+	SG_ADD(&m_Sigma, "Sigma", "covariance of q(u)");
+	SG_ADD(&m_inv_kuu, "inv_kuu", "inverse of the inducing kernel matrix");
+	SG_ADD(&m_log_det_kuu, "log_det_kuu", "log determinant of the inducing kernel matrix");
+	SG_ADD(&m_sigma2, "sigma2", "sigma2");
+	SG_ADD(&m_residual, "residual", "residual");
+	SG_ADD(&m_Tmm, "Tmm", "Tmm");
+	SG_ADD(&m_dlik, "dlik", "dlik");
+	SG_ADD(&m_dscale, "dscale", "dscale");
+
+	SGDMinimizer* opt=new SGDMinimizer();
+	ConstLearningRate* rate=new ConstLearningRate();
+	rate->set_const_learning_rate(0.1);
+	opt->set_learning_rate(rate);
+	opt->set_gradient_updater(new GradientDescendUpdater());
+	opt->set_number_passes(5);
+	register_minimizer(opt);
+}
+
+CSVGPInferenceMethod::~CSVGPInferenceMethod()
+{
+}
+
+void CSVGPInferenceMethod::compute_gradient()
+{
+	CInference::compute_gradient();
+
+	if (!m_gradient_update)
+	{
+		update_deriv();
+		m_gradient_update=true;
+		update_parameter_hash();
+	}
+}
+
+void CSVGPInferenceMethod::update()
+{
+	SG_DEBUG("entering\n");
+
+	CInference::update();
+	update_chol();
+	optimization();
+	update_alpha();
+	m_gradient_update=false;
+	update_parameter_hash();
+
+	SG_DEBUG("leaving\n");
+}
+
+CSVGPInferenceMethod* CSVGPInferenceMethod::obtain_from_generic(
+		CInference* inference)
+{
+	if (inference==NULL)
+		return NULL;
+
+	if (inference->get_inference_type()!=INF_SVGP_REGRESSION)
+		SG_SERROR("Provided inference is not of type CSVGPInferenceMethod!\n")
+
+	SG_REF(inference);
+	return (CSVGPInferenceMethod*)inference;
+}
+
+void CSVGPInferenceMethod::check_members() const
+{
+	CSingleSparseInference::check_members();
+
+	REQUIRE(m_model->get_model_type()==LT_GAUSSIAN,
+			"SVGP inference method can only use Gaussian likelihood function\n")
+	REQUIRE(m_labels->get_label_type()==LT_REGRESSION, "Labels must be type "
+			"of CRegressionLabels\n")
+}
+
+void CSVGPInferenceMethod::register_minimizer(Minimizer* minimizer)
+{
+	REQUIRE(minimizer, "Minimizer must set\n");
+	FirstOrderStochasticMinimizer* opt=
+		dynamic_cast<FirstOrderStochasticMinimizer*>(minimizer);
+	REQUIRE(opt, "FirstOrderStochasticMinimizer is required\n");
+	CInference::register_minimizer(minimizer);
+}
+
+void CSVGPInferenceMethod::set_batch_size(int32_t batch_size)
+{
+	REQUIRE(batch_size>0, "Batch size (%d) must be positive\n", batch_size)
+	m_batch_size=batch_size;
+}
+
+void CSVGPInferenceMethod::reset_variational_distribution()
+{
+	m_natural_params=SGVector<float64_t>();
+}
+
+SGVector<float64_t> CSVGPInferenceMethod::get_diagonal_vector()
+{
+	SG_NOTIMPLEMENTED
+	//the inference method does not need to use this
+	return SGVector<float64_t>();
+}
+
+void CSVGPInferenceMethod::update_train_kernel()
+{
+	// only the m-by-m matrix is kept, everything involving the training
+	// features is evaluated batch by batch
+	check_features();
+	convert_features();
+
+	CFeatures* inducing_features=get_inducing_features();
+	m_kernel->init(inducing_features, inducing_features);
+	m_kuu=m_kernel->get_kernel_matrix();
+	SG_UNREF(inducing_features);
+
+	m_ktru=SGMatrix<float64_t>();
+	m_ktrtr_diag=SGVector<float64_t>();
+}
+
+void CSVGPInferenceMethod::get_batch_terms(SGVector<index_t> batch,
+	SGMatrix<float64_t>& kub, SGVector<float64_t>& kbb_diag,
+	SGVector<float64_t>& residual)
+{
+	float64_t scale2=std::exp(m_log_scale*2.0);
+	CFeatures* inducing_features=get_inducing_features();
+
+	m_features->add_subset(batch);
+	m_kernel->init(inducing_features, m_features);
+	kub=m_kernel->get_kernel_matrix();
+	m_kernel->init(m_features, m_features);
+	kbb_diag=m_kernel->get_kernel_diagonal();
+	residual=m_mean->get_mean_vector(m_features);
+	m_features->remove_subset();
+	SG_UNREF(inducing_features);
+
+	Map<MatrixXd> eigen_kub(kub.matrix, kub.num_rows, kub.num_cols);
+	Map<VectorXd> eigen_kbb_diag(kbb_diag.vector, kbb_diag.vlen);
+	eigen_kub*=scale2;
+	eigen_kbb_diag*=scale2;
+
+	CRegressionLabels* lab=(CRegressionLabels*) m_labels;
+	for (index_t i=0; i<batch.vlen; i++)
+		residual[i]=lab->get_label(batch[i])-residual[i];
+}
+
+SGMatrix<float64_t> CSVGPInferenceMethod::get_batch_weights(
+	SGMatrix<float64_t> kub, SGVector<float64_t> residual)
+{
+	Map<MatrixXd> eigen_kub(kub.matrix, kub.num_rows, kub.num_cols);
+	Map<VectorXd> eigen_residual(residual.vector, residual.vlen);
+	Map<MatrixXd> eigen_inv_kuu(m_inv_kuu.matrix, m_inv_kuu.num_rows, m_inv_kuu.num_cols);
+	Map<VectorXd> eigen_mu(m_mu.vector, m_mu.vlen);
+	Map<MatrixXd> eigen_Sigma(m_Sigma.matrix, m_Sigma.num_rows, m_Sigma.num_cols);
+
+	// a=inv(Kuu)*Kub, e=r-a'*mu
+	MatrixXd a=eigen_inv_kuu*eigen_kub;
+	VectorXd e=eigen_residual-a.transpose()*eigen_mu;
+
+	// W=(inv(Kuu)*(Sigma*a-mu*e')-a)/sigma2
+	SGMatrix<float64_t> weights(kub.num_rows, kub.num_cols);
+	Map<MatrixXd> eigen_weights(weights.matrix, weights.num_rows, weights.num_cols);
+	eigen_weights=(eigen_inv_kuu*(eigen_Sigma*a-eigen_mu*e.transpose())-a)/m_sigma2;
+
+	return weights;
+}
+
+void CSVGPInferenceMethod::update_chol()
+{
+	// get the sigma variable from the Gaussian likelihood model
+	CGaussianLikelihood* lik=m_model->as<CGaussianLikelihood>();
+	float64_t sigma=lik->get_sigma();
+	m_sigma2=sigma*sigma;
+
+	const index_t m=m_kuu.num_rows;
+	Map<MatrixXd> eigen_kuu(m_kuu.matrix, m_kuu.num_rows, m_kuu.num_cols);
+
+	LLT<MatrixXd> Luu(
+	    eigen_kuu*std::exp(m_log_scale*2.0)+
+	    std::exp(m_log_ind_noise)*MatrixXd::Identity(m, m));
+	REQUIRE(Luu.info()==Eigen::Success, "Kernel matrix of the inducing "
+		"features is not positive definite, try a larger inducing noise\n")
+
+	m_inv_kuu=SGMatrix<float64_t>(m, m);
+	Map<MatrixXd> eigen_inv_kuu(m_inv_kuu.matrix, m, m);
+	eigen_inv_kuu=Luu.solve(MatrixXd::Identity(m, m));
+	m_log_det_kuu=2.0*Luu.matrixL().toDenseMatrix().diagonal().array().log().sum();
+
+	// start from the prior q(u)=p(u) unless there is a q(u) to warm start from
+	if (m_natural_params.vlen!=m+m*m)
+	{
+		m_natural_params=SGVector<float64_t>(m+m*m);
+		Map<VectorXd> eigen_eta(m_natural_params.vector, m);
+		Map<MatrixXd> eigen_lambda(m_natural_params.vector+m, m, m);
+		eigen_eta.setZero();
+		eigen_lambda=eigen_inv_kuu;
+	}
+}
+
+void CSVGPInferenceMethod::get_natural_gradient(SGVector<index_t> batch,
+	SGVector<float64_t> gradient)
+{
+	SGMatrix<float64_t> kub;
+	SGVector<float64_t> kbb_diag;
+	SGVector<float64_t> residual;
+	get_batch_terms(batch, kub, kbb_diag, residual);
+
+	const index_t m=m_kuu.num_rows;
+	Map<MatrixXd> eigen_kub(kub.matrix, kub.num_rows, kub.num_cols);
+	Map<VectorXd> eigen_residual(residual.vector, residual.vlen);
+	Map<MatrixXd> eigen_inv_kuu(m_inv_kuu.matrix, m, m);
+
+	Map<VectorXd> eigen_eta(m_natural_params.vector, m);
+	Map<MatrixXd> eigen_lambda(m_natural_params.vector+m, m, m);
+	Map<VectorXd> eigen_grad_eta(gradient.vector, m);
+	Map<MatrixXd> eigen_grad_lambda(gradient.vector+m, m, m);
+
+	// the batch stands in for all n points
+	float64_t c=m_features->get_num_vectors()/(batch.vlen*m_sigma2);
+	MatrixXd a=eigen_inv_kuu*eigen_kub;
+
+	// natural gradient of the negative bound is the current natural
+	// parameters minus the ones implied by the batch
+	eigen_grad_eta=eigen_eta-c*a*eigen_residual;
+	eigen_grad_lambda=eigen_lambda-(eigen_inv_kuu+c*a*a.transpose());
+}
+
+float64_t CSVGPInferenceMethod::optimization()
+{
+	SVGPInferenceCostFunction *cost_fun=new SVGPInferenceCostFunction();
+	cost_fun->set_target(this);
+	bool cleanup=false;
+	if(this->ref_count()>1)
+		cleanup=true;
+
+	FirstOrderStochasticMinimizer* opt=
+		dynamic_cast<FirstOrderStochasticMinimizer*>(m_minimizer);
+
+	REQUIRE(opt, "FirstOrderStochasticMinimizer is required\n")
+	opt->set_cost_function(cost_fun);
+
+	float64_t nelbo=opt->minimize();
+	opt->unset_cost_function(false);
+	cost_fun->unset_target(cleanup);
+
+	SG_UNREF(cost_fun);
+	return nelbo;
+}
+
+void CSVGPInferenceMethod::update_alpha()
+{
+	const index_t m=m_kuu.num_rows;
+	Map<VectorXd> eigen_eta(m_natural_params.vector, m);
+	Map<MatrixXd> eigen_lambda(m_natural_params.vector+m, m, m);
+	Map<MatrixXd> eigen_inv_kuu(m_inv_kuu.matrix, m, m);
+
+	LLT<MatrixXd> chol_lambda(eigen_lambda);
+	REQUIRE(chol_lambda.info()==Eigen::Success, "Precision of q(u) is not "
+		"positive definite, try a smaller learning rate\n")
+
+	// Sigma=inv(Lambda), mu=Sigma*eta
+	m_Sigma=SGMatrix<float64_t>(m, m);
+	Map<MatrixXd> eigen_Sigma(m_Sigma.matrix, m, m);
+	eigen_Sigma=chol_lambda.solve(MatrixXd::Identity(m, m));
+	m_mu=SGVector<float64_t>(m);
+	Map<VectorXd> eigen_mu(m_mu.vector, m);
+	eigen_mu=chol_lambda.solve(eigen_eta);
+
+	// predictive mean is Ksu*alpha with alpha=inv(Kuu)*mu
+	m_alpha=SGVector<float64_t>(m);
+	Map<VectorXd> eigen_alpha(m_alpha.vector, m);
+	eigen_alpha=eigen_inv_kuu*eigen_mu;
+
+	// predictive variance is Kss+Ksu*L*Kus with L=inv(Kuu)*Sigma*inv(Kuu)-inv(Kuu)
+	m_L=SGMatrix<float64_t>(m, m);
+	Map<MatrixXd> eigen_L(m_L.matrix, m, m);
+	eigen_L=eigen_inv_kuu*eigen_Sigma*eigen_inv_kuu-eigen_inv_kuu;
+}
+
+float64_t CSVGPInferenceMethod::get_negative_elbo()
+{
+	const index_t m=m_kuu.num_rows;
+	const index_t n=m_features->get_num_vectors();
+	Map<MatrixXd> eigen_inv_kuu(m_inv_kuu.matrix, m, m);
+	Map<VectorXd> eigen_mu(m_mu.vector, m);
+	Map<MatrixXd> eigen_Sigma(m_Sigma.matrix, m, m);
+
+	// expected negative log likelihood, accumulated batch by batch
+	float64_t nlik=0.5*n*std::log(2.0*CMath::PI*m_sigma2);
+	for (index_t start=0; start<n; start+=m_batch_size)
+	{
+		SGVector<index_t> batch(CMath::min(m_batch_size, n-start));
+		batch.range_fill(start);
+
+		SGMatrix<float64_t> kub;
+		SGVector<float64_t> kbb_diag;
+		SGVector<float64_t> residual;
+		get_batch_terms(batch, kub, kbb_diag, residual);
+
+		Map<MatrixXd> eigen_kub(kub.matrix, kub.num_rows, kub.num_cols);
+		Map<VectorXd> eigen_kbb_diag(kbb_diag.vector, kbb_diag.vlen);
+		Map<VectorXd> eigen_residual(residual.vector, residual.vlen);
+
+		// E[(y-f)^2]=(r-a'*mu)^2+kbb-a'*Kub+a'*Sigma*a
+		MatrixXd a=eigen_inv_kuu*eigen_kub;
+		VectorXd e=eigen_residual-a.transpose()*eigen_mu;
+		float64_t sq=e.squaredNorm()+eigen_kbb_diag.sum()
+			-a.cwiseProduct(eigen_kub).sum()
+			+a.cwiseProduct(eigen_Sigma*a).sum();
+		nlik+=0.5*sq/m_sigma2;
+	}
+
+	// KL(q(u)||p(u))
+	LLT<MatrixXd> chol_Sigma(eigen_Sigma);
+	float64_t log_det_Sigma=
+		2.0*chol_Sigma.matrixL().toDenseMatrix().diagonal().array().log().sum();
+	float64_t kl=0.5*((eigen_inv_kuu*eigen_Sigma).trace()
+		+eigen_mu.dot(eigen_inv_kuu*eigen_mu)-m+m_log_det_kuu-log_det_Sigma);
+
+	return nlik+kl;
+}
+
+float64_t CSVGPInferenceMethod::get_negative_log_marginal_likelihood()
+{
+	if (parameter_hash_changed())
+		update();
+
+	return get_negative_elbo();
+}
+
+void CSVGPInferenceMethod::update_deriv()
+{
+	const index_t m=m_kuu.num_rows;
+	const index_t n=m_features->get_num_vectors();
+	Map<MatrixXd> eigen_inv_kuu(m_inv_kuu.matrix, m, m);
+	Map<MatrixXd> eigen_kuu(m_kuu.matrix, m, m);
+	Map<VectorXd> eigen_mu(m_mu.vector, m);
+	Map<MatrixXd> eigen_Sigma(m_Sigma.matrix, m, m);
+
+	CGaussianLikelihood* lik=m_model->as<CGaussianLikelihood>();
+	float64_t sigma=lik->get_sigma();
+	m_sigma2=sigma*sigma;
+
+	MatrixXd aa=MatrixXd::Zero(m, m);
+	MatrixXd aV=MatrixXd::Zero(m, m);
+	float64_t sq=0.0;
+	float64_t dscale=0.0;
+	m_residual=SGVector<float64_t>(n);
+
+	for (index_t start=0; start<n; start+=m_batch_size)
+	{
+		SGVector<index_t> batch(CMath::min(m_batch_size, n-start));
+		batch.range_fill(start);
+
+		SGMatrix<float64_t> kub;
+		SGVector<float64_t> kbb_diag;
+		SGVector<float64_t> residual;
+		get_batch_terms(batch, kub, kbb_diag, residual);
+
+		Map<MatrixXd> eigen_kub(kub.matrix, kub.num_rows, kub.num_cols);
+		Map<VectorXd> eigen_kbb_diag(kbb_diag.vector, kbb_diag.vlen);
+		Map<VectorXd> eigen_residual(residual.vector, residual.vlen);
+
+		MatrixXd a=eigen_inv_kuu*eigen_kub;
+		VectorXd e=eigen_residual-a.transpose()*eigen_mu;
+		MatrixXd V=eigen_inv_kuu*(eigen_Sigma*a-eigen_mu*e.transpose());
+
+		aa+=a*a.transpose();
+		aV+=a*V.transpose();
+		sq+=e.squaredNorm()+eigen_kbb_diag.sum()
+			-a.cwiseProduct(eigen_kub).sum()
+			+a.cwiseProduct(eigen_Sigma*a).sum();
+
+		// derivative wrt the scaled Kub and diag(Kbb) contracted with
+		// the scaled kernel itself gives the part wrt log scale
+		dscale+=(V-a).cwiseProduct(eigen_kub).sum()/m_sigma2
+			+0.5*eigen_kbb_diag.sum()/m_sigma2;
+
+		Map<VectorXd>(m_residual.vector+start, batch.vlen)=e;
+	}
+
+	// Tmm = (a*a'-a*V'-V*a')/(2*sigma2) + (inv(Kuu)-inv(Kuu)*(Sigma+mu*mu')*inv(Kuu))/2
+	m_Tmm=SGMatrix<float64_t>(m, m);
+	Map<MatrixXd> eigen_Tmm(m_Tmm.matrix, m, m);
+	eigen_Tmm=0.5*(aa-aV-aV.transpose())/m_sigma2
+		+0.5*(eigen_inv_kuu-eigen_inv_kuu*(eigen_Sigma
+		+eigen_mu*eigen_mu.transpose())*eigen_inv_kuu);
+
+	m_dlik=n-sq/m_sigma2;
+	m_dscale=2.0*(dscale
+		+eigen_Tmm.cwiseProduct(eigen_kuu).sum()*std::exp(m_log_scale*2.0));
+}
+
+SGVector<float64_t> CSVGPInferenceMethod::get_posterior_mean()
+{
+	if (parameter_hash_changed())
+		update();
+
+	return SGVector<float64_t>(m_mu);
+}
+
+SGMatrix<float64_t> CSVGPInferenceMethod::get_posterior_covariance()
+{
+	if (parameter_hash_changed())
+		update();
+
+	return SGMatrix<float64_t>(m_Sigma);
+}
+
+SGVector<float64_t> CSVGPInferenceMethod::get_derivative_wrt_likelihood_model(
+		const TParameter* param)
+{
+	REQUIRE(!strcmp(param->m_name, "log_sigma"), "Can't compute derivative of "
+			"the nagative log marginal likelihood wrt %s.%s parameter\n",
+			m_model->get_name(), param->m_name)
+
+	SGVector<float64_t> dlik(1);
+	dlik[0]=m_dlik;
+	return dlik;
+}
+
+SGVector<float64_t> CSVGPInferenceMethod::get_derivative_wrt_inference_method(
+		const TParameter* param)
+{
+	REQUIRE(param, "Param not set\n");
+	if (strcmp(param->m_name, "log_scale"))
+		return CSingleSparseInference::get_derivative_wrt_inference_method(param);
+
+	SGVector<float64_t> result(1);
+	result[0]=m_dscale;
+	return result;
+}
+
+SGVector<float64_t> CSVGPInferenceMethod::get_derivative_wrt_kernel(
+	const TParameter* param)
+{
+	REQUIRE(param, "Param not set\n");
+	const index_t n=m_features->get_num_vectors();
+	CFeatures *inducing_features=get_inducing_features();
+
+	m_lock->lock();
+	m_kernel->init(inducing_features, inducing_features);
+	SGVector<float64_t> result=m_kernel->get_parameter_gradient_sum(param, m_Tmm);
+	Map<VectorXd> eigen_result(result.vector, result.vlen);
+
+	for (index_t start=0; start<n; start+=m_batch_size)
+	{
+		SGVector<index_t> batch(CMath::min(m_batch_size, n-start));
+		batch.range_fill(start);
+
+		SGMatrix<float64_t> kub;
+		SGVector<float64_t> kbb_diag;
+		SGVector<float64_t> residual;
+		get_batch_terms(batch, kub, kbb_diag, residual);
+		SGMatrix<float64_t> weights=get_batch_weights(kub, residual);
+
+		m_features->add_subset(batch);
+		m_kernel->init(inducing_features, m_features);
+		SGVector<float64_t> dkub=m_kernel->get_parameter_gradient_sum(param, weights);
+		eigen_result+=Map<VectorXd>(dkub.vector, dkub.vlen);
+
+		m_kernel->init(m_features, m_features);
+		for (index_t i=0; i<result.vlen; i++)
+		{
+			SGVector<float64_t> deriv_bb=m_kernel->get_parameter_gradient_diagonal(param, i);
+			result[i]+=0.5*Map<VectorXd>(deriv_bb.vector, deriv_bb.vlen).sum()/m_sigma2;
+		}
+		m_features->remove_subset();
+	}
+	m_lock->unlock();
+
+	SG_UNREF(inducing_features);
+
+	eigen_result*=std::exp(m_log_scale*2.0);
+	return result;
+}
+
+float64_t CSVGPInferenceMethod::get_derivative_related_cov(SGVector<float64_t> ddiagKi,
+	SGMatrix<float64_t> dKuui, SGMatrix<float64_t> dKui)
+{
+	Map<VectorXd> eigen_ddiagKi(ddiagKi.vector, ddiagKi.vlen);
+	Map<MatrixXd> eigen_dKuui(dKuui.matrix, dKuui.num_rows, dKuui.num_cols);
+	Map<MatrixXd> eigen_Tmm(m_Tmm.matrix, m_Tmm.num_rows, m_Tmm.num_cols);
+	const index_t n=dKui.num_cols;
+
+	float64_t dkern=eigen_dKuui.cwiseProduct(eigen_Tmm).sum()
+		+0.5*eigen_ddiagKi.sum()/m_sigma2;
+
+	for (index_t start=0; start<n; start+=m_batch_size)
+	{
+		SGVector<index_t> batch(CMath::min(m_batch_size, n-start));
+		batch.range_fill(start);
+
+		SGMatrix<float64_t> kub;
+		SGVector<float64_t> kbb_diag;
+		SGVector<float64_t> residual;
+		get_batch_terms(batch, kub, kbb_diag, residual);
+		SGMatrix<float64_t> weights=get_batch_weights(kub, residual);
+
+		Map<MatrixXd> eigen_weights(weights.matrix, weights.num_rows, weights.num_cols);
+		Map<MatrixXd> eigen_dKui(dKui.matrix+int64_t(start)*dKui.num_rows,
+			dKui.num_rows, batch.vlen);
+		dkern+=eigen_weights.cwiseProduct(eigen_dKui).sum();
+	}
+
+	return dkern;
+}
+
+SGVector<float64_t> CSVGPInferenceMethod::get_derivative_wrt_inducing_features(
+	const TParameter* param)
+{
+	int32_t dim=m_inducing_features.num_rows;
+	int32_t num_samples=m_inducing_features.num_cols;
+	SGVector<float64_t>deriv_lat(dim*num_samples);
+	deriv_lat.zero();
+
+	Map<MatrixXd> eigen_Tmm(m_Tmm.matrix, m_Tmm.num_rows, m_Tmm.num_cols);
+	const index_t n=m_features->get_num_vectors();
+	float64_t scale2=std::exp(m_log_scale*2.0);
+
+	m_lock->lock();
+	CFeatures *inducing_features=get_inducing_features();
+
+	//asymtric part (related to xu and x), batch by batch
+	for (index_t start=0; start<n; start+=m_batch_size)
+	{
+		SGVector<index_t> batch(CMath::min(m_batch_size, n-start));
+		batch.range_fill(start);
+
+		SGMatrix<float64_t> kub;
+		SGVector<float64_t> kbb_diag;
+		SGVector<float64_t> residual;
+		get_batch_terms(batch, kub, kbb_diag, residual);
+		SGMatrix<float64_t> weights=get_batch_weights(kub, residual);
+		Map<MatrixXd> eigen_weights(weights.matrix, weights.num_rows, weights.num_cols);
+
+		m_features->add_subset(batch);
+		m_kernel->init(inducing_features, m_features);
+		for(int32_t lat_idx=0; lat_idx<num_samples; lat_idx++)
+		{
+			Map<VectorXd> deriv_lat_col_vec(deriv_lat.vector+lat_idx*dim,dim);
+			//p by b
+			SGMatrix<float64_t> deriv_mat=m_kernel->get_parameter_gradient(param, lat_idx);
+			Map<MatrixXd> eigen_deriv_mat(deriv_mat.matrix, deriv_mat.num_rows, deriv_mat.num_cols);
+			deriv_lat_col_vec+=eigen_deriv_mat*(scale2*eigen_weights.row(lat_idx).transpose());
+		}
+		m_features->remove_subset();
+	}
+
+	//symtric part (related to xu and xu)
+	m_kernel->init(inducing_features, inducing_features);
+	for(int32_t lat_lidx=0; lat_lidx<num_samples; lat_lidx++)
+	{
+		Map<VectorXd> deriv_lat_col_vec(deriv_lat.vector+lat_lidx*dim,dim);
+		//p by m
+		SGMatrix<float64_t> deriv_mat=m_kernel->get_parameter_gradient(param, lat_lidx);
+		Map<MatrixXd> eigen_deriv_mat(deriv_mat.matrix, deriv_mat.num_rows, deriv_mat.num_cols);
+		deriv_lat_col_vec+=eigen_deriv_mat*(2.0*scale2*eigen_Tmm.col(lat_lidx));
+	}
+	SG_UNREF(inducing_features);
+	m_lock->unlock();
+	return deriv_lat;
+}
+
+SGVector<float64_t> CSVGPInferenceMethod::get_derivative_wrt_inducing_noise(
+	const TParameter* param)
+{
+	REQUIRE(param, "Param not set\n");
+	REQUIRE(!strcmp(param->m_name, "log_inducing_noise"), "Can't compute derivative of "
+			"the nagative log marginal likelihood wrt %s.%s parameter\n",
+			get_name(), param->m_name)
+
+	Map<MatrixXd> eigen_Tmm(m_Tmm.matrix, m_Tmm.num_rows, m_Tmm.num_cols);
+	SGVector<float64_t> result(1);
+	result[0]=std::exp(m_log_ind_noise)*eigen_Tmm.trace();
+	return result;
+}
+
+SGVector<float64_t> CSVGPInferenceMethod::get_derivative_wrt_mean(
+	const TParameter* param)
+{
+	REQUIRE(param, "Param not set\n");
+	SGVector<float64_t> result;
+	int64_t len=const_cast<TParameter *>(param)->m_datatype.get_num_elements();
+	result=SGVector<float64_t>(len);
+
+	Map<VectorXd> eigen_residual(m_residual.vector, m_residual.vlen);
+
+	for (index_t i=0; i<result.vlen; i++)
+	{
+		// other derivatives temporarily put batch subsets on the features
+		m_lock->lock();
+		SGVector<float64_t> dmu=m_mean->get_parameter_derivative(m_features, param, i);
+		m_lock->unlock();
+		Map<VectorXd> eigen_dmu(dmu.vector, dmu.vlen);
+
+		result[i]=-eigen_dmu.dot(eigen_residual)/m_sigma2;
+	}
+	return result;
+}
+
+}
@@ -0,0 +1,343 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef CSVGPINFERENCEMETHOD_H
+#define CSVGPINFERENCEMETHOD_H
+
+#include <shogun/lib/config.h>
+#include <shogun/machine/gp/SingleSparseInference.h>
+
+namespace shogun
+{
+class SVGPInferenceCostFunction;
+
+/** @brief The stochastic variational inference method for sparse
+ * Gaussian process regression (SVGP).
+ *
+ * The method keeps an explicit variational distribution
+ * \f$q(u)=\mathcal{N}(\mu,\Sigma)\f$ over the latent function values at the
+ * inducing points and maximises the (uncollapsed) evidence lower bound
+ *
+ * \f[
+ * \mathcal{L}=\sum_{i=1}^{n} E_{q(f_i)}[\log p(y_i|f_i)]-KL(q(u)||p(u))
+ * \f]
+ *
+ * Since the bound is a sum over training points, it is optimised with
+ * mini-batches: every batch gives an unbiased estimate of the natural
+ * gradient of \f$\mathcal{L}\f$ with respect to the natural parameters
+ * \f$(\Sigma^{-1}\mu, \Sigma^{-1})\f$. For exponential families this natural
+ * gradient is the difference between the current natural parameters and the
+ * ones implied by the batch, so a plain gradient step of size \f$\rho\f$ moves
+ * \f$q(u)\f$ a fraction \f$\rho\f$ towards the batch optimum. The
+ * optimisation is driven by a FirstOrderStochasticMinimizer (SGDMinimizer with
+ * a constant learning rate by default), where one pass of the minimizer is one
+ * pass over the shuffled training data.
+ *
+ * Kernel matrices are only ever evaluated between the inducing features and one
+ * batch, so memory is \f$O(m^2+mb)\f$ for \f$m\f$ inducing points and batch
+ * size \f$b\f$, independent of the number of training points. Derivatives
+ * wrt hyperparameters are accumulated over the batches as well and assume that
+ * \f$q(u)\f$ is (close to) optimal for the current hyperparameters.
+ *
+ * With a full batch and a learning rate of one, a single step reaches the
+ * optimal \f$q(u)\f$ and the method reproduces CVarDTCInferenceMethod.
+ *
+ * The reference paper is
+ * Hensman, James, Nicolo Fusi, and Neil D. Lawrence.
+ * "Gaussian processes for big data."
+ * Conference on Uncertainty in Artificial Intelligence. 2013.
+ *
+ * Note that the method only works with a Gaussian likelihood.
+ */
+class CSVGPInferenceMethod: public CSingleSparseInference
+{
+friend class SVGPInferenceCostFunction;
+
+public:
+	/** default constructor */
+	CSVGPInferenceMethod();
+
+	/** constructor
+	 *
+	 * @param kernel covariance function
+	 * @param features features to use in inference
+	 * @param mean mean function
+	 * @param labels labels of the features
+	 * @param model likelihood model to use
+	 * @param inducing_features features to use
+	 */
+	CSVGPInferenceMethod(CKernel* kernel, CFeatures* features,
+			CMeanFunction* mean, CLabels* labels, CLikelihoodModel* model,
+			CFeatures* inducing_features);
+
+	virtual ~CSVGPInferenceMethod();
+
+	/** returns the name of the inference method
+	 *
+	 * @return name SVGPInferenceMethod
+	 */
+	virtual const char* get_name() const { return "SVGPInferenceMethod"; }
+
+	/** return what type of inference we are
+	 *
+	 * @return inference type SVGP_REGRESSION
+	 */
+	virtual EInferenceType get_inference_type() const { return INF_SVGP_REGRESSION; }
+
+	/** helper method used to specialize a base class instance
+	 *
+	 * @param inference inference method
+	 * @return casted CSVGPInferenceMethod object
+	 */
+	static CSVGPInferenceMethod* obtain_from_generic(CInference* inference);
+
+	/** get negative log marginal likelihood
+	 *
+	 * @return the negative evidence lower bound of the current \f$q(u)\f$,
+	 * which upper-bounds
+	 *
+	 * \f[
+	 * -log(p(y|X, \theta))
+	 * \f]
+	 *
+	 * where \f$y\f$ are the labels, \f$X\f$ are the features, and \f$\theta\f$
+	 * represent hyperparameters.
+	 */
+	virtual float64_t get_negative_log_marginal_likelihood();
+
+	/** get diagonal vector
+	 *
+	 * not used by this inference method
+	 *
+	 * @return empty vector
+	 */
+	virtual SGVector<float64_t> get_diagonal_vector();
+
+	/**
+	 * @return whether combination of sparse inference method and given likelihood
+	 * function supports regression
+	 */
+	virtual bool supports_regression() const
+	{
+		check_members();
+		return m_model->supports_regression();
+	}
+
+	/** returns mean vector \f$\mu\f$ of the variational distribution
+	 * \f$q(u)=\mathcal{N}(\mu,\Sigma)\f$ over the inducing variables
+	 *
+	 * @return mean vector of length m
+	 */
+	virtual SGVector<float64_t> get_posterior_mean();
+
+	/** returns covariance matrix \f$\Sigma\f$ of the variational distribution
+	 * \f$q(u)=\mathcal{N}(\mu,\Sigma)\f$ over the inducing variables
+	 *
+	 * @return covariance matrix of size m x m
+	 */
+	virtual SGMatrix<float64_t> get_posterior_covariance();
+
+	/** update all matrices, running the stochastic optimisation of
+	 * \f$q(u)\f$. The previous \f$q(u)\f$ is used as a warm start as long as
+	 * the number of inducing points does not change.
+	 */
+	virtual void update();
+
+	/** Set a minimizer
+	 *
+	 * @param minimizer stochastic minimizer used to optimise \f$q(u)\f$,
+	 * must be a FirstOrderStochasticMinimizer
+	 */
+	virtual void register_minimizer(Minimizer* minimizer);
+
+	/** set the number of training points used per natural gradient step
+	 *
+	 * @param batch_size mini-batch size
+	 */
+	virtual void set_batch_size(int32_t batch_size);
+
+	/** get the number of training points used per natural gradient step
+	 *
+	 * @return mini-batch size
+	 */
+	virtual int32_t get_batch_size() const { return m_batch_size; }
+
+	/** reset \f$q(u)\f$ to the prior \f$p(u)\f$, so that the next update
+	 * starts the optimisation from scratch
+	 */
+	virtual void reset_variational_distribution();
+
+protected:
+	/** check if members of object are valid for inference */
+	virtual void check_members() const;
+
+	/** compute the kernel matrix of the inducing features only, kernel
+	 * values involving training features are computed per batch
+	 */
+	virtual void update_train_kernel();
+
+	/** update alpha and the matrix used for predictive variances from the
+	 * current \f$q(u)\f$
+	 */
+	virtual void update_alpha();
+
+	/** update the inverse of the inducing kernel matrix */
+	virtual void update_chol();
+
+	/** update matrices which are required to compute negative log marginal
+	 * likelihood derivatives wrt hyperparameter
+	 */
+	virtual void update_deriv();
+
+	/** returns derivative of negative log marginal likelihood wrt parameter of
+	 * likelihood model
+	 *
+	 * @param param parameter of given likelihood model
+	 *
+	 * @return derivative of negative log marginal likelihood
+	 */
+	virtual SGVector<float64_t> get_derivative_wrt_likelihood_model(
+			const TParameter* param);
+
+	/** returns derivative of negative log marginal likelihood wrt parameter of
+	 * CInference class
+	 *
+	 * @param param parameter of CInference class
+	 *
+	 * @return derivative of negative log marginal likelihood
+	 */
+	virtual SGVector<float64_t> get_derivative_wrt_inference_method(
+			const TParameter* param);
+
+	/** returns derivative of negative log marginal likelihood wrt kernel's
+	 * parameter, accumulated over mini-batches
+	 *
+	 * @param param parameter of given kernel
+	 *
+	 * @return derivative of negative log marginal likelihood
+	 */
+	virtual SGVector<float64_t> get_derivative_wrt_kernel(
+			const TParameter* param);
+
+	/** returns derivative of negative log marginal likelihood wrt inducing
+	 * features (input), accumulated over mini-batches
+	 *
+	 * Note that the kernel must support to compute the derivatives wrt inducing features
+	 *
+	 * @param param parameter of given kernel
+	 * @return derivative of negative log marginal likelihood
+	 */
+	virtual SGVector<float64_t> get_derivative_wrt_inducing_features(
+		const TParameter* param);
+
+	/** returns derivative of negative log marginal likelihood wrt inducing noise
+	 *
+	 * @param param parameter of given inference class
+	 *
+	 * @return derivative of negative log marginal likelihood
+	 */
+	virtual SGVector<float64_t> get_derivative_wrt_inducing_noise(
+		const TParameter* param);
+
+	/** returns derivative of negative log marginal likelihood wrt mean
+	 * function's parameter
+	 *
+	 * @param param parameter of given mean function
+	 *
+	 * @return derivative of negative log marginal likelihood
+	 */
+	virtual SGVector<float64_t> get_derivative_wrt_mean(
+			const TParameter* param);
+
+	/** compute variables which are required to compute negative log marginal
+	 * likelihood full derivatives wrt cov-like hyperparameter \f$\theta\f$
+	 *
+	 * @param ddiagKi \f$\textbf{diag}(\frac{\partial {\Sigma_{n}}}{\partial {\theta}})\f$
+	 * @param dKuui \f$\frac{\partial {\Sigma_{m}}}{\partial {\theta}}\f$
+	 * @param dKui \f$\frac{\partial {\Sigma_{m,n}}}{\partial {\theta}}\f$
+	 *
+	 * @return derivative of negative log marginal likelihood
+	 */
+	virtual float64_t get_derivative_related_cov(SGVector<float64_t> ddiagKi,
+		SGMatrix<float64_t> dKuui, SGMatrix<float64_t> dKui);
+
+	/** update gradients */
+	virtual void compute_gradient();
+
+	/** compute the scaled kernel values and residuals of a mini-batch
+	 *
+	 * @param batch indices of the training points in the batch
+	 * @param kub kernel matrix between inducing and batch features (m x b)
+	 * @param kbb_diag diagonal of the kernel matrix of the batch
+	 * @param residual labels minus prior mean of the batch
+	 */
+	virtual void get_batch_terms(SGVector<index_t> batch,
+		SGMatrix<float64_t>& kub, SGVector<float64_t>& kbb_diag,
+		SGVector<float64_t>& residual);
+
+	/** compute the derivative of the expected log likelihood of a batch
+	 * wrt the kernel matrix between inducing and batch features
+	 *
+	 * @param kub kernel matrix between inducing and batch features (m x b)
+	 * @param residual labels minus prior mean of the batch
+	 *
+	 * @return derivative weights (m x b)
+	 */
+	virtual SGMatrix<float64_t> get_batch_weights(SGMatrix<float64_t> kub,
+		SGVector<float64_t> residual);
+
+	/** compute the natural gradient of the negative evidence lower bound
+	 * estimated from a single mini-batch
+	 *
+	 * @param batch indices of the training points in the batch
+	 * @param gradient natural gradient wrt the natural parameters (output)
+	 */
+	virtual void get_natural_gradient(SGVector<index_t> batch,
+		SGVector<float64_t> gradient);
+
+	/** compute the negative evidence lower bound of the current \f$q(u)\f$
+	 * with a full pass over the training data in mini-batches
+	 *
+	 * @return negative evidence lower bound
+	 */
+	virtual float64_t get_negative_elbo();
+
+	/** run the stochastic optimisation of \f$q(u)\f$
+	 *
+	 * @return negative evidence lower bound after optimisation
+	 */
+	virtual float64_t optimization();
+
+protected:
+	/** number of training points per mini-batch */
+	int32_t m_batch_size;
+	/** natural parameters of q(u): Sigma^{-1}*mu followed by Sigma^{-1} (column-major) */
+	SGVector<float64_t> m_natural_params;
+	/** mean of q(u) */
+	SGVector<float64_t> m_mu;
+	/** covariance of q(u) */
+	SGMatrix<float64_t> m_Sigma;
+	/** inverse of the scaled inducing kernel matrix (with inducing noise) */
+	SGMatrix<float64_t> m_inv_kuu;
+	/** log determinant of the scaled inducing kernel matrix */
+	float64_t m_log_det_kuu;
+	/** square of sigma from Gaussian likelihood*/
+	float64_t m_sigma2;
+	/** residuals of the mean of q(f) on all training points, used for
+	 * gradients wrt the mean function
+	 */
+	SGVector<float64_t> m_residual;
+	/** derivative of the negative bound wrt the inducing kernel matrix */
+	SGMatrix<float64_t> m_Tmm;
+	/** derivative of the negative bound wrt log sigma */
+	float64_t m_dlik;
+	/** derivative of the negative bound wrt log scale */
+	float64_t m_dscale;
+
+private:
+	/** init */
+	void init();
+};
+}
+#endif /* CSVGPINFERENCEMETHOD_H */
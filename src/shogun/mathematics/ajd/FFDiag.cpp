@@ -2,6 +2,7 @@
 
 
 #include <shogun/base/init.h>
+#include <shogun/base/Parallel.h>
 
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
@@ -9,7 +10,7 @@
 using namespace shogun;
 using namespace Eigen;
 
-void getW(float64_t *C, int *ptN, int *ptK, float64_t *W);
+void getW(float64_t *C, int *ptN, int *ptK, float64_t *W, int32_t num_threads);
 
 SGMatrix<float64_t> CFFDiag::diagonalize(SGNDArray<float64_t> C0, SGMatrix<float64_t> V0,
 						double eps, int itermax)
@@ -33,6 +34,10 @@ SGMatrix<float64_t> CFFDiag::diagonalize(SGNDArray<float64_t> C0, SGMatrix<float
 	MatrixXd Id(n,n); Id.setIdentity();
 	Map<MatrixXd> EV(V.matrix,n,n);
 
+	Parallel* parallel = shogun::get_global_parallel();
+	int32_t num_threads = parallel->get_num_threads();
+	SG_UNREF(parallel);
+
 	float64_t inum = 0;
 	float64_t df = 1;
 	std::vector<float64_t> crit;
@@ -42,7 +47,7 @@ SGMatrix<float64_t> CFFDiag::diagonalize(SGNDArray<float64_t> C0, SGMatrix<float
 
 		getW(C.get_matrix(0),
 			 &n, &K,
-			 W.data());
+			 W.data(), num_threads);
 
 		W.transposeInPlace();
 		int e = std::ceil(log2(W.array().abs().rowwise().sum().maxCoeff()));
@@ -54,19 +59,16 @@ SGMatrix<float64_t> CFFDiag::diagonalize(SGNDArray<float64_t> C0, SGMatrix<float
 		d.diagonal() = VectorXd::Ones(EV.diagonalSize()).cwiseQuotient((EV * EV.transpose()).diagonal().cwiseSqrt());
 		EV = d * EV;
 
+		// the transformed matrices are independent, the criterion is
+		// computed from them directly
+		float64_t f = 0;
+		#pragma omp parallel for reduction(+:f) num_threads(num_threads)
 		for (int i = 0; i < K; i++)
 		{
 			Map<MatrixXd> Ci(C.get_matrix(i), n, n);
 			Map<MatrixXd> C0i(C0.get_matrix(i), n, n);
 			Ci = EV * C0i * EV.transpose();
-		}
-
-		float64_t f = 0;
-		for (int i = 0; i < K; i++)
-		{
-			Map<MatrixXd> C0i(C0.get_matrix(i), n, n);
-			MatrixXd F = EV * C0i * EV.transpose();
-			f += (F.transpose() * F).diagonal().sum() - F.array().pow(2).matrix().diagonal().sum();
+			f += (Ci.transpose() * Ci).diagonal().sum() - Ci.array().pow(2).matrix().diagonal().sum();
 		}
 
 		crit.push_back(f);
@@ -84,7 +86,7 @@ SGMatrix<float64_t> CFFDiag::diagonalize(SGNDArray<float64_t> C0, SGMatrix<float
 
 }
 
-void getW(float64_t *C, int *ptN, int *ptK, float64_t *W)
+void getW(float64_t *C, int *ptN, int *ptK, float64_t *W, int32_t num_threads)
 {
 	int N=*ptN;
 	int K=*ptK;
@@ -95,6 +97,7 @@ void getW(float64_t *C, int *ptN, int *ptK, float64_t *W)
 	z.zero();
 	y.zero();
 
+	#pragma omp parallel for private(auxij, auxji, auxii, auxjj) num_threads(num_threads)
 	for (int i = 0; i < N; i++)
 	{
 		for (int j = 0; j < N; j++)
@@ -2,6 +2,7 @@
 
 
 #include <shogun/base/init.h>
+#include <shogun/base/Parallel.h>
 
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
@@ -15,6 +16,10 @@ SGMatrix<float64_t> CUWedge::diagonalize(SGNDArray<float64_t> C, SGMatrix<float6
 	int d = C.dims[0];
 	int L = C.dims[2];
 
+	Parallel* parallel = shogun::get_global_parallel();
+	int32_t num_threads = parallel->get_num_threads();
+	SG_UNREF(parallel);
+
 	SGMatrix<float64_t> V;
 	if (V0.num_rows == d && V0.num_cols == d)
 	{
@@ -79,6 +84,7 @@ SGMatrix<float64_t> CUWedge::diagonalize(SGNDArray<float64_t> C, SGMatrix<float6
 		MatrixXd B = Rs * Rs.transpose();
 
 		MatrixXd C1 = MatrixXd::Zero(d,d);
+		#pragma omp parallel for num_threads(num_threads)
 		for (int id = 0; id < d; id++)
 		{
 			// rowSums
@@ -98,15 +104,18 @@ SGMatrix<float64_t> CUWedge::diagonalize(SGNDArray<float64_t> C, SGMatrix<float6
 		MatrixXd aux = Raux.diagonal().cwiseAbs().cwiseSqrt().asDiagonal().inverse();
 		EV = aux * EV;
 
-		crit.push_back(0.0);
+		// the matrices are transformed independently
+		float64_t f = 0;
+		#pragma omp parallel for reduction(+:f) num_threads(num_threads)
 		for (int l = 0; l < L; l++)
 		{
 			Map<MatrixXd> Ci(C.get_matrix(l),d,d);
 			Map<MatrixXd> Csi(Cs.get_matrix(l),d,d);
 			Csi = EV * Ci * EV.transpose();
 			Rs.col(l) = Csi.diagonal();
-			crit.back() += Csi.cwiseAbs2().sum() - Rs.col(l).cwiseAbs2().sum();
+			f += Csi.cwiseAbs2().sum() - Rs.col(l).cwiseAbs2().sum();
 		}
+		crit.push_back(f);
 
 		improve = CMath::abs(crit.back() - crit[iter]);
 		iter++;
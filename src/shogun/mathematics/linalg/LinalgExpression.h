@@ -0,0 +1,334 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef LINALG_EXPRESSION_H_
+#define LINALG_EXPRESSION_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+
+namespace shogun
+{
+
+	namespace linalg
+	{
+
+		/** @brief Lazily evaluated elementwise expression over SGVector and
+		 * SGMatrix.
+		 *
+		 * Expressions are created with lazy() and combined with the
+		 * arithmetic operators (which all work elementwise, i.e. * is the
+		 * elementwise product) and the elementwise functions exponent(),
+		 * logistic() and rectified_linear(). No computation happens until
+		 * the expression is evaluated with evaluate(), which runs the whole
+		 * chain as a single loop of the Eigen backend without any
+		 * intermediate vectors or matrices, e.g.
+		 *
+		 * @code
+		 * // result = a + 0.5 * logistic(b) * c, in one pass
+		 * linalg::evaluate(
+		 *     linalg::lazy(a) + 0.5 * linalg::logistic(linalg::lazy(b)) *
+		 *         linalg::lazy(c),
+		 *     result);
+		 * @endcode
+		 *
+		 * The expression keeps references to the memory of the vectors and
+		 * matrices it was created from, which have to outlive it. Since all
+		 * operations are elementwise, the result can be one of the operands.
+		 * Only data in CPU memory is supported.
+		 */
+		template <typename E>
+		class LazyExpression
+		{
+		public:
+			/** scalar type */
+			typedef typename E::Scalar Scalar;
+
+			/** constructor
+			 * @param expr Eigen array expression
+			 */
+			explicit LazyExpression(const E& expr) : m_expr(expr)
+			{
+			}
+
+			/** @return underlying Eigen array expression */
+			const E& eigen() const
+			{
+				return m_expr;
+			}
+
+			/** @return number of rows */
+			index_t rows() const
+			{
+				return m_expr.rows();
+			}
+
+			/** @return number of columns */
+			index_t cols() const
+			{
+				return m_expr.cols();
+			}
+
+		private:
+			/** Eigen expressions of maps are nested by value, so this is a
+			 * copy of the expression tree only, not of the data
+			 */
+			E m_expr;
+		};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+		namespace expression_detail
+		{
+			template <typename E>
+			LazyExpression<E> make(const E& expr)
+			{
+				return LazyExpression<E>(expr);
+			}
+
+			template <typename E1, typename E2>
+			void check_dims(
+			    const LazyExpression<E1>& a, const LazyExpression<E2>& b)
+			{
+				REQUIRE(
+				    a.rows() == b.rows(),
+				    "Number of rows of expression a (%d) must match "
+				    "expression b (%d).\n",
+				    a.rows(), b.rows());
+				REQUIRE(
+				    a.cols() == b.cols(),
+				    "Number of columns of expression a (%d) must match "
+				    "expression b (%d).\n",
+				    a.cols(), b.cols());
+			}
+		}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+		/** Creates a lazy expression from a vector
+		 *
+		 * @param a The vector
+		 * @return lazy expression referring to the vector
+		 */
+		template <typename T>
+		LazyExpression<Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, 1>>>
+		lazy(const SGVector<T>& a)
+		{
+			REQUIRE(!a.on_gpu(), "Lazy expressions of vectors on GPU are not supported.\n");
+			return expression_detail::make(
+			    Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, 1>>(
+			        a.vector, a.vlen));
+		}
+
+		/** Creates a lazy expression from a matrix
+		 *
+		 * @param a The matrix
+		 * @return lazy expression referring to the matrix
+		 */
+		template <typename T>
+		LazyExpression<Eigen::Map<
+		    const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic>>>
+		lazy(const SGMatrix<T>& a)
+		{
+			REQUIRE(!a.on_gpu(), "Lazy expressions of matrices on GPU are not supported.\n");
+			return expression_detail::make(
+			    Eigen::Map<
+			        const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic>>(
+			        a.matrix, a.num_rows, a.num_cols));
+		}
+
+		/** Elementwise sum of two expressions */
+		template <typename E1, typename E2>
+		auto operator+(const LazyExpression<E1>& a, const LazyExpression<E2>& b)
+		    -> decltype(expression_detail::make(a.eigen() + b.eigen()))
+		{
+			expression_detail::check_dims(a, b);
+			return expression_detail::make(a.eigen() + b.eigen());
+		}
+
+		/** Elementwise difference of two expressions */
+		template <typename E1, typename E2>
+		auto operator-(const LazyExpression<E1>& a, const LazyExpression<E2>& b)
+		    -> decltype(expression_detail::make(a.eigen() - b.eigen()))
+		{
+			expression_detail::check_dims(a, b);
+			return expression_detail::make(a.eigen() - b.eigen());
+		}
+
+		/** Elementwise product of two expressions */
+		template <typename E1, typename E2>
+		auto operator*(const LazyExpression<E1>& a, const LazyExpression<E2>& b)
+		    -> decltype(expression_detail::make(a.eigen() * b.eigen()))
+		{
+			expression_detail::check_dims(a, b);
+			return expression_detail::make(a.eigen() * b.eigen());
+		}
+
+		/** Elementwise quotient of two expressions */
+		template <typename E1, typename E2>
+		auto operator/(const LazyExpression<E1>& a, const LazyExpression<E2>& b)
+		    -> decltype(expression_detail::make(a.eigen() / b.eigen()))
+		{
+			expression_detail::check_dims(a, b);
+			return expression_detail::make(a.eigen() / b.eigen());
+		}
+
+		/** Elementwise negation of an expression */
+		template <typename E>
+		auto operator-(const LazyExpression<E>& a)
+		    -> decltype(expression_detail::make(-a.eigen()))
+		{
+			return expression_detail::make(-a.eigen());
+		}
+
+		/** Adds a scalar to every element of an expression */
+		template <typename E>
+		auto operator+(const LazyExpression<E>& a, typename E::Scalar b)
+		    -> decltype(expression_detail::make(a.eigen() + b))
+		{
+			return expression_detail::make(a.eigen() + b);
+		}
+
+		/** Adds a scalar to every element of an expression */
+		template <typename E>
+		auto operator+(typename E::Scalar a, const LazyExpression<E>& b)
+		    -> decltype(expression_detail::make(b.eigen() + a))
+		{
+			return expression_detail::make(b.eigen() + a);
+		}
+
+		/** Subtracts a scalar from every element of an expression */
+		template <typename E>
+		auto operator-(const LazyExpression<E>& a, typename E::Scalar b)
+		    -> decltype(expression_detail::make(a.eigen() - b))
+		{
+			return expression_detail::make(a.eigen() - b);
+		}
+
+		/** Subtracts every element of an expression from a scalar */
+		template <typename E>
+		auto operator-(typename E::Scalar a, const LazyExpression<E>& b)
+		    -> decltype(expression_detail::make(a - b.eigen()))
+		{
+			return expression_detail::make(a - b.eigen());
+		}
+
+		/** Scales every element of an expression */
+		template <typename E>
+		auto operator*(const LazyExpression<E>& a, typename E::Scalar alpha)
+		    -> decltype(expression_detail::make(a.eigen() * alpha))
+		{
+			return expression_detail::make(a.eigen() * alpha);
+		}
+
+		/** Scales every element of an expression */
+		template <typename E>
+		auto operator*(typename E::Scalar alpha, const LazyExpression<E>& a)
+		    -> decltype(expression_detail::make(a.eigen() * alpha))
+		{
+			return expression_detail::make(a.eigen() * alpha);
+		}
+
+		/** Divides every element of an expression by a scalar */
+		template <typename E>
+		auto operator/(const LazyExpression<E>& a, typename E::Scalar alpha)
+		    -> decltype(expression_detail::make(a.eigen() / alpha))
+		{
+			return expression_detail::make(a.eigen() / alpha);
+		}
+
+		/** Elementwise exponential function of an expression
+		 *
+		 * @param a The expression
+		 * @return lazy expression of exp(a)
+		 */
+		template <typename E>
+		auto exponent(const LazyExpression<E>& a)
+		    -> decltype(expression_detail::make(a.eigen().exp()))
+		{
+			return expression_detail::make(a.eigen().exp());
+		}
+
+		/** Elementwise logistic function f(x) = 1/(1+exp(-x)) of an expression
+		 *
+		 * @param a The expression
+		 * @return lazy expression of the logistic function of a
+		 */
+		template <typename E>
+		auto logistic(const LazyExpression<E>& a)
+		    -> decltype(expression_detail::make(
+		        ((-a.eigen()).exp() + typename E::Scalar(1)).inverse()))
+		{
+			return expression_detail::make(
+			    ((-a.eigen()).exp() + typename E::Scalar(1)).inverse());
+		}
+
+		/** Elementwise rectified linear function f(x) = max(0,x) of an
+		 * expression
+		 *
+		 * @param a The expression
+		 * @return lazy expression of the rectified linear function of a
+		 */
+		template <typename E>
+		auto rectified_linear(const LazyExpression<E>& a)
+		    -> decltype(expression_detail::make(
+		        a.eigen().max(typename E::Scalar(0))))
+		{
+			return expression_detail::make(
+			    a.eigen().max(typename E::Scalar(0)));
+		}
+
+		/** Evaluates an expression into a preallocated vector, which may be
+		 * one of the operands of the expression
+		 *
+		 * @param expr The expression
+		 * @param result The vector that saves the result
+		 */
+		template <typename E, typename T>
+		void evaluate(const LazyExpression<E>& expr, SGVector<T>& result)
+		{
+			REQUIRE(
+			    expr.cols() == 1, "Expression with %d columns cannot be "
+			                      "evaluated into a vector.\n",
+			    expr.cols());
+			REQUIRE(
+			    expr.rows() == result.vlen,
+			    "Length of expression (%d) doesn't match vector result (%d).\n",
+			    expr.rows(), result.vlen);
+			REQUIRE(!result.on_gpu(), "Cannot evaluate expression into vector result on GPU.\n");
+
+			Eigen::Map<Eigen::Array<T, Eigen::Dynamic, 1>>(
+			    result.vector, result.vlen) = expr.eigen();
+		}
+
+		/** Evaluates an expression into a preallocated matrix, which may be
+		 * one of the operands of the expression
+		 *
+		 * @param expr The expression
+		 * @param result The matrix that saves the result
+		 */
+		template <typename E, typename T>
+		void evaluate(const LazyExpression<E>& expr, SGMatrix<T>& result)
+		{
+			REQUIRE(
+			    expr.rows() == result.num_rows,
+			    "Number of rows of expression (%d) must match matrix result "
+			    "(%d).\n",
+			    expr.rows(), result.num_rows);
+			REQUIRE(
+			    expr.cols() == result.num_cols,
+			    "Number of columns of expression (%d) must match matrix "
+			    "result (%d).\n",
+			    expr.cols(), result.num_cols);
+			REQUIRE(!result.on_gpu(), "Cannot evaluate expression into matrix result on GPU.\n");
+
+			Eigen::Map<Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic>>(
+			    result.matrix, result.num_rows, result.num_cols) = expr.eigen();
+		}
+	}
+}
+
+#endif // LINALG_EXPRESSION_H_
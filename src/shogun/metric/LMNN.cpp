@@ -84,6 +84,12 @@ void CLMNN::train(SGMatrix<float64_t> init_transform)
 	bool stop = false;
 	// Make space for the training statistics
 	m_statistics->resize(m_maxiter);
+	// Mini-batch mode, the order of the examples and the start of the next batch
+	index_t num_vectors = x->get_num_vectors();
+	bool mini_batch = m_batch_size > 0 && m_batch_size < num_vectors;
+	SGVector<index_t> permutation(num_vectors);
+	permutation.range_fill();
+	index_t batch_start = num_vectors;
 
 	// Progress bar
 	auto pb = SG_PROGRESS(range(m_maxiter));
@@ -91,27 +97,65 @@ void CLMNN::train(SGMatrix<float64_t> init_transform)
 	// Main loop
 	while (!stop)
 	{
-		// Find current set of impostors
-		SG_DEBUG("Finding impostors.\n")
-		cur_impostors = CLMNNImpl::find_impostors(x,y,L,target_nn,iter,m_correction);
-		SG_DEBUG("Found %d impostors in the current set.\n", cur_impostors.size())
-
-		// (Sub-) gradient computation
-		SG_DEBUG("Updating gradient.\n")
-		CLMNNImpl::update_gradient(x, gradient, cur_impostors, prev_impostors, m_regularization);
-		// Take gradient step
-		SG_DEBUG("Taking gradient step.\n")
-		CLMNNImpl::gradient_step(L, gradient, stepsize, m_diagonal);
-
-		// Compute the objective, trace of Mahalanobis distance matrix (L squared) times the gradient
-		// plus the number of current impostors to account for the margin
-		SG_DEBUG("Computing objective.\n")
-		obj[iter] = m_regularization * cur_impostors.size();
-		obj[iter] +=
-		    linalg::trace_dot(linalg::matrix_prod(L, L, true, false), gradient);
-
-		// Correct step size
-		CLMNNImpl::correct_stepsize(stepsize, obj, iter);
+		if (mini_batch)
+		{
+			// Draw the next batch, shuffling the examples every epoch
+			if (batch_start + m_batch_size > num_vectors)
+			{
+				CMath::permute(permutation);
+				batch_start = 0;
+			}
+			std::vector<index_t> batch(
+			    permutation.vector + batch_start,
+			    permutation.vector + batch_start + m_batch_size);
+			batch_start += m_batch_size;
+
+			// Find the impostors of the examples in the batch
+			SG_DEBUG("Finding impostors of the batch.\n")
+			cur_impostors = CLMNNImpl::find_batch_impostors(x,y,L,target_nn,batch);
+			SG_DEBUG("Found %d impostors in the current batch.\n", cur_impostors.size())
+
+			// Stochastic (sub-) gradient of the batch
+			SG_DEBUG("Computing batch gradient.\n")
+			gradient = CLMNNImpl::compute_batch_gradient(
+			    x, target_nn, batch, cur_impostors, m_regularization);
+			// Take gradient step
+			SG_DEBUG("Taking gradient step.\n")
+			CLMNNImpl::gradient_step(L, gradient, stepsize, m_diagonal);
+
+			// Estimate the objective from the batch; it is noisy, so the step
+			// size is kept fixed
+			SG_DEBUG("Computing objective.\n")
+			obj[iter] = m_regularization * cur_impostors.size() *
+			            float64_t(num_vectors) / m_batch_size;
+			obj[iter] += linalg::trace_dot(
+			    linalg::matrix_prod(L, L, true, false), gradient);
+		}
+		else
+		{
+			// Find current set of impostors
+			SG_DEBUG("Finding impostors.\n")
+			cur_impostors = CLMNNImpl::find_impostors(
+			    x, y, L, target_nn, iter, m_correction, exact_impostors);
+			SG_DEBUG("Found %d impostors in the current set.\n", cur_impostors.size())
+
+			// (Sub-) gradient computation
+			SG_DEBUG("Updating gradient.\n")
+			CLMNNImpl::update_gradient(x, gradient, cur_impostors, prev_impostors, m_regularization);
+			// Take gradient step
+			SG_DEBUG("Taking gradient step.\n")
+			CLMNNImpl::gradient_step(L, gradient, stepsize, m_diagonal);
+
+			// Compute the objective, trace of Mahalanobis distance matrix (L squared) times the gradient
+			// plus the number of current impostors to account for the margin
+			SG_DEBUG("Computing objective.\n")
+			obj[iter] = m_regularization * cur_impostors.size();
+			obj[iter] +=
+			    linalg::trace_dot(linalg::matrix_prod(L, L, true, false), gradient);
+
+			// Correct step size
+			CLMNNImpl::correct_stepsize(stepsize, obj, iter);
+		}
 
 		// Check termination criterion
 		stop = CLMNNImpl::check_termination(stepsize, obj, iter, m_maxiter, m_stepsize_threshold, m_obj_threshold);
@@ -227,6 +271,17 @@ void CLMNN::set_correction(const int32_t correction)
 	m_correction = correction;
 }
 
+int32_t CLMNN::get_batch_size() const
+{
+	return m_batch_size;
+}
+
+void CLMNN::set_batch_size(const int32_t batch_size)
+{
+	REQUIRE(batch_size>=0, "The batch size must be larger or equal to zero\n")
+	m_batch_size = batch_size;
+}
+
 float64_t CLMNN::get_obj_threshold() const
 {
 	return m_obj_threshold;
@@ -269,6 +324,8 @@ void CLMNN::init()
 	SG_ADD(&m_maxiter, "maxiter", "Maximum number of iterations");
 	SG_ADD(&m_correction, "correction",
 			"Iterations between exact impostors search");
+	SG_ADD(&m_batch_size, "batch_size",
+			"Examples per iteration of stochastic gradient descent");
 	SG_ADD(&m_obj_threshold, "obj_threshold", "Objective threshold");
 	SG_ADD(&m_diagonal, "m_diagonal", "Diagonal transformation");
 	SG_ADD((CSGObject**) &m_statistics, "statistics", "Training statistics");
@@ -281,6 +338,7 @@ void CLMNN::init()
 	m_stepsize_threshold = 1e-22;
 	m_maxiter = 1000;
 	m_correction = 15;
+	m_batch_size = 0;
 	m_obj_threshold = 1e-9;
 	m_diagonal = false;
 	m_statistics = NULL;
@@ -28,6 +28,13 @@ class CLMNNStatistics;
  *
  * Weinberger, K. Q., Saul, L. K.
  * Distance Metric Learning for Large Margin Nearest Neighbor Classification.
+ *
+ * By default every iteration takes a (sub-)gradient step over all the
+ * examples, updating the gradient with the changes in the set of impostors.
+ * For large data sets, a batch size can be set with set_batch_size(); then
+ * every iteration only looks for the impostors of the examples in a batch,
+ * drawn without replacement in a random order every epoch, and takes a
+ * stochastic gradient step with the fixed step size.
  */
 class CLMNN : public CSGObject
 {
@@ -144,6 +151,18 @@ class CLMNN : public CSGObject
 		 */
 		void set_correction(const int32_t correction);
 
+		/** get batch size
+		 *
+		 * @return number of examples per iteration, 0 for all
+		 */
+		int32_t get_batch_size() const;
+
+		/** set batch size
+		 *
+		 * @param batch_size number of examples per iteration, 0 for all
+		 */
+		void set_batch_size(const int32_t batch_size);
+
 		/** get objective threshold
 		 *
 		 * @return objective threshold
@@ -219,6 +238,12 @@ class CLMNN : public CSGObject
 		 */
 		int32_t m_correction;
 
+		/**
+		 * number of examples per iteration of the stochastic gradient descent.
+		 * Its default value is 0, which uses all examples in every iteration
+		 */
+		int32_t m_batch_size;
+
 		/**
 		 * objective threshold; stop training if the first order difference in
 		 * absolute value of the objective function in the last three iterations
@@ -18,6 +18,83 @@
 
 using namespace shogun;
 
+namespace
+{
+	/** number of examples per block of distance or outer product computations */
+	const index_t BLOCK_SIZE = 512;
+
+	/** copy the columns idxs[begin], ..., idxs[end-1] of X to a new matrix */
+	SGMatrix<float64_t> gather_columns(
+	    const SGMatrix<float64_t>& X, const std::vector<index_t>& idxs,
+	    index_t begin, index_t end)
+	{
+		SGMatrix<float64_t> result(X.num_rows, end - begin);
+		for (index_t j = begin; j < end; ++j)
+		{
+			sg_memcpy(
+			    result.get_column_vector(j - begin),
+			    X.get_column_vector(idxs[j]), X.num_rows * sizeof(float64_t));
+		}
+		return result;
+	}
+
+	/**
+	 * compute the squared distances between the columns a and b of LX as
+	 * |a|^2 + |b|^2 - 2*a'*b, blocks of a and b at a time, and pass them to
+	 * check(ia, ib, sqdist, impostors), which collects the impostors of the
+	 * block; blocks of a are processed in parallel
+	 */
+	template <typename F>
+	ImpostorsSetType find_blockwise(
+	    const SGMatrix<float64_t>& LX, const std::vector<index_t>& a,
+	    const std::vector<index_t>& b, F check)
+	{
+		ImpostorsSetType N;
+		if (a.empty() || b.empty())
+			return N;
+
+		auto sqnorms = linalg::colwise_sum(linalg::element_prod(LX, LX));
+		auto B = gather_columns(LX, b, 0, b.size());
+
+		index_t num_blocks = (a.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+		std::vector<std::vector<CImpostorNode>> found(num_blocks);
+
+#pragma omp parallel for schedule(dynamic)
+		for (index_t block = 0; block < num_blocks; ++block)
+		{
+			index_t begin = block * BLOCK_SIZE;
+			index_t end = std::min(begin + BLOCK_SIZE, index_t(a.size()));
+			auto A = gather_columns(LX, a, begin, end);
+
+			for (index_t cbegin = 0; cbegin < index_t(b.size());
+			     cbegin += BLOCK_SIZE)
+			{
+				index_t cend =
+				    std::min(cbegin + BLOCK_SIZE, index_t(b.size()));
+				SGMatrix<float64_t> B_block(
+				    B.get_column_vector(cbegin), B.num_rows, cend - cbegin,
+				    false);
+				auto products = linalg::matrix_prod(A, B_block, true, false);
+
+				for (index_t jj = cbegin; jj < cend; ++jj)
+				{
+					for (index_t ii = begin; ii < end; ++ii)
+					{
+						float64_t sqdist = sqnorms[a[ii]] + sqnorms[b[jj]] -
+						                   2 * products(ii - begin, jj - cbegin);
+						check(a[ii], b[jj], sqdist, found[block]);
+					}
+				}
+			}
+		}
+
+		for (const auto& block_found : found)
+			N.insert(block_found.begin(), block_found.end());
+
+		return N;
+	}
+}
+
 CImpostorNode::CImpostorNode(index_t ex, index_t tar, index_t imp)
 : example(ex), target(tar), impostor(imp)
 {
@@ -171,15 +248,17 @@ SGMatrix<float64_t> CLMNNImpl::sum_outer_products(
 	auto X = x->get_feature_matrix();
 
 	// sum the outer products stored in C using the indices specified in target_nn
+	std::vector<index_t> a, b;
 	for (index_t i = 0; i < target_nn.num_cols; ++i)
 	{
 		for (index_t j = 0; j < target_nn.num_rows; ++j)
 		{
-			auto dx = linalg::add(
-			    X.get_column(i), X.get_column(target_nn(j, i)), 1.0, -1.0);
-			linalg::rank_update(sop, dx);
+			a.push_back(i);
+			b.push_back(target_nn(j, i));
 		}
 	}
+	CLMNNImpl::add_outer_products(
+	    X, a, b, std::vector<float64_t>(a.size(), 1.0), sop);
 
 	return sop;
 }
@@ -187,7 +266,8 @@ SGMatrix<float64_t> CLMNNImpl::sum_outer_products(
 ImpostorsSetType CLMNNImpl::find_impostors(
     CDenseFeatures<float64_t>* x, CMulticlassLabels* y,
     const SGMatrix<float64_t>& L, const SGMatrix<index_t>& target_nn,
-    const int32_t iter, const int32_t correction)
+    const int32_t iter, const int32_t correction,
+    ImpostorsSetType& exact_impostors)
 {
 	SG_SDEBUG("Entering CLMNNImpl::find_impostors().\n")
 
@@ -203,22 +283,20 @@ ImpostorsSetType CLMNNImpl::find_impostors(
 
 	// initialize impostors set
 	ImpostorsSetType N;
-	// exact impostors set shared between calls to this method
-	static ImpostorsSetType Nexact;
 
 	// impostors search
 	REQUIRE(correction>0, "The number of iterations between exact updates of the "
 			"impostors set must be greater than 0\n")
 	if ((iter % correction)==0)
 	{
-		Nexact = CLMNNImpl::find_impostors_exact(
+		exact_impostors = CLMNNImpl::find_impostors_exact(
 		    SGMatrix<float64_t>(LX), sqdists, y, target_nn, k);
-		N = Nexact;
+		N = exact_impostors;
 	}
 	else
 	{
 		N = CLMNNImpl::find_impostors_approx(
-		    SGMatrix<float64_t>(LX), sqdists, Nexact, target_nn);
+		    SGMatrix<float64_t>(LX), sqdists, exact_impostors, target_nn);
 	}
 
 	SG_SDEBUG("Leaving CLMNNImpl::find_impostors().\n")
@@ -226,6 +304,105 @@ ImpostorsSetType CLMNNImpl::find_impostors(
 	return N;
 }
 
+ImpostorsSetType CLMNNImpl::find_batch_impostors(
+    CDenseFeatures<float64_t>* x, CMulticlassLabels* y,
+    const SGMatrix<float64_t>& L, const SGMatrix<index_t>& target_nn,
+    const std::vector<index_t>& batch)
+{
+	SG_SDEBUG("Entering CLMNNImpl::find_batch_impostors().\n")
+
+	// get the number of neighbors
+	int32_t k = target_nn.num_rows;
+
+	auto X = x->get_feature_matrix();
+	// transform the feature vectors
+	auto LX = linalg::matrix_prod(L, X);
+
+	// compute square distances plus margin from examples to target neighbors
+	auto sqdists = CLMNNImpl::compute_sqdists(LX, target_nn);
+
+	ImpostorsSetType N;
+
+	// get a vector with unique label values
+	SGVector<float64_t> unique = y->get_unique_labels();
+
+	for (index_t i = 0; i < unique.vlen; ++i)
+	{
+		// the examples in the batch labelled as unique[i], and all the
+		// examples with other labels
+		std::vector<index_t> iidxs, neidxs;
+		for (auto example : batch)
+		{
+			if (y->get_label(example) == unique[i])
+				iidxs.push_back(example);
+		}
+		for (index_t j = 0; j < index_t(y->get_num_labels()); ++j)
+		{
+			if (y->get_label(j) != unique[i])
+				neidxs.push_back(j);
+		}
+
+		auto found = find_blockwise(
+		    LX, iidxs, neidxs,
+		    [&](index_t ex, index_t imp, float64_t distance,
+		        std::vector<CImpostorNode>& impostors) {
+			    for (int32_t j = 0; j < k; ++j)
+			    {
+				    if (distance <= sqdists(j, ex))
+					    impostors.push_back(
+					        CImpostorNode(ex, target_nn(j, ex), imp));
+			    }
+			});
+		N.insert(found.begin(), found.end());
+	}
+
+	SG_SDEBUG("Leaving CLMNNImpl::find_batch_impostors().\n")
+
+	return N;
+}
+
+SGMatrix<float64_t> CLMNNImpl::compute_batch_gradient(
+    CDenseFeatures<float64_t>* x, const SGMatrix<index_t>& target_nn,
+    const std::vector<index_t>& batch, const ImpostorsSetType& impostors,
+    float64_t regularization)
+{
+	int32_t d = x->get_num_features();
+	SGMatrix<float64_t> G(d, d);
+
+	auto X = x->get_feature_matrix();
+	// the batch represents all the examples
+	float64_t scale = float64_t(x->get_num_vectors()) / batch.size();
+
+	std::vector<index_t> a, b;
+	std::vector<float64_t> weights;
+
+	// pull the target neighbors
+	for (auto example : batch)
+	{
+		for (index_t j = 0; j < target_nn.num_rows; ++j)
+		{
+			a.push_back(example);
+			b.push_back(target_nn(j, example));
+			weights.push_back(scale * (1 - regularization));
+		}
+	}
+
+	// G += regularization*(dx1*dx1' - dx2*dx2') for every impostor
+	for (const auto& node : impostors)
+	{
+		a.push_back(node.example);
+		b.push_back(node.target);
+		weights.push_back(scale * regularization);
+		a.push_back(node.example);
+		b.push_back(node.impostor);
+		weights.push_back(-scale * regularization);
+	}
+
+	CLMNNImpl::add_outer_products(X, a, b, weights, G);
+
+	return G;
+}
+
 void CLMNNImpl::update_gradient(
     CDenseFeatures<float64_t>* x, SGMatrix<float64_t>& G,
     const ImpostorsSetType& Nc, const ImpostorsSetType& Np,
@@ -238,29 +415,79 @@ void CLMNNImpl::update_gradient(
 
 	auto X = x->get_feature_matrix();
 
+	std::vector<index_t> a, b;
+	std::vector<float64_t> weights;
+
 	// remove the gradient contributions of the impostors that were in the previous
 	// set but disappeared in the current
 	for (ImpostorsSetType::iterator it = Np_Nc.begin(); it != Np_Nc.end(); ++it)
 	{
 		// G -= regularization*(dx1*dx1' - dx2*dx2');
-		auto dx1 = linalg::add(
-		    X.get_column(it->example), X.get_column(it->target), 1.0, -1.0);
-		auto dx2 = linalg::add(
-		    X.get_column(it->example), X.get_column(it->impostor), 1.0, -1.0);
-		linalg::rank_update(G, dx1, -regularization);
-		linalg::rank_update(G, dx2, regularization);
+		a.push_back(it->example);
+		b.push_back(it->target);
+		weights.push_back(-regularization);
+		a.push_back(it->example);
+		b.push_back(it->impostor);
+		weights.push_back(regularization);
 	}
 
 	// add the gradient contributions of the new impostors
 	for (ImpostorsSetType::iterator it = Nc_Np.begin(); it != Nc_Np.end(); ++it)
 	{
 		// G += regularization*(dx1*dx1' - dx2*dx2');
-		auto dx1 = linalg::add(
-		    X.get_column(it->example), X.get_column(it->target), 1.0, -1.0);
-		auto dx2 = linalg::add(
-		    X.get_column(it->example), X.get_column(it->impostor), 1.0, -1.0);
-		linalg::rank_update(G, dx1, regularization);
-		linalg::rank_update(G, dx2, -regularization);
+		a.push_back(it->example);
+		b.push_back(it->target);
+		weights.push_back(regularization);
+		a.push_back(it->example);
+		b.push_back(it->impostor);
+		weights.push_back(-regularization);
+	}
+
+	CLMNNImpl::add_outer_products(X, a, b, weights, G);
+}
+
+void CLMNNImpl::add_outer_products(
+    const SGMatrix<float64_t>& X, const std::vector<index_t>& a,
+    const std::vector<index_t>& b, const std::vector<float64_t>& weights,
+    SGMatrix<float64_t>& G)
+{
+	ASSERT(a.size() == b.size() && a.size() == weights.size())
+	index_t d = X.num_rows;
+	index_t num_blocks = (a.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+#pragma omp parallel
+	{
+		// outer products of the blocks of this thread
+		SGMatrix<float64_t> G_thread(d, d);
+		bool any = false;
+
+#pragma omp for schedule(dynamic)
+		for (index_t block = 0; block < num_blocks; ++block)
+		{
+			index_t begin = block * BLOCK_SIZE;
+			index_t end = std::min(begin + BLOCK_SIZE, index_t(a.size()));
+
+			// differences, and differences scaled by the weights
+			SGMatrix<float64_t> D(d, end - begin), WD(d, end - begin);
+			for (index_t i = begin; i < end; ++i)
+			{
+				for (index_t r = 0; r < d; ++r)
+				{
+					D(r, i - begin) = X(r, a[i]) - X(r, b[i]);
+					WD(r, i - begin) = weights[i] * D(r, i - begin);
+				}
+			}
+
+			// G_thread += WD*D'
+			linalg::dgemm(1.0, WD, D, false, true, 1.0, G_thread);
+			any = true;
+		}
+
+		if (any)
+		{
+#pragma omp critical
+			linalg::add(G, G_thread, G);
+		}
 	}
 }
 
@@ -277,7 +504,7 @@ void CLMNNImpl::gradient_step(
 		// keep only the elements in the diagonal of M
 		auto m = M.get_diagonal_vector();
 		for (auto i : range(m.vlen))
-			m[i] = m > 0 ? std::sqrt(m[i]) : 0.0;
+			m[i] = m[i] > 0 ? std::sqrt(m[i]) : 0.0;
 
 		// return to representation in L
 		SGMatrix<float64_t>::create_diagonal_matrix(L.matrix, m.vector, m.vlen);
@@ -413,8 +640,15 @@ ImpostorsSetType CLMNNImpl::find_impostors_exact(
 	// initialize empty impostors set
 	ImpostorsSetType N = ImpostorsSetType();
 
-	// create Shogun features from LX to later apply subset
-	CDenseFeatures<float64_t>* lx = new CDenseFeatures<float64_t>(LX);
+	// largest squared distance plus margin to a target neighbor, no example
+	// farther away than that can be an impostor
+	SGVector<float64_t> radius(sqdists.num_cols);
+	for (index_t i = 0; i < sqdists.num_cols; ++i)
+	{
+		radius[i] = 0;
+		for (int32_t j = 0; j < k; ++j)
+			radius[i] = CMath::max(radius[i], sqdists(j, i));
+	}
 
 	// get a vector with unique label values
 	SGVector<float64_t> unique = y->get_unique_labels();
@@ -428,33 +662,27 @@ ImpostorsSetType CLMNNImpl::find_impostors_exact(
 		// pairwise distances are computed once
 		std::vector<index_t> gtidxs = CLMNNImpl::get_examples_gtlabel(y,unique[i]);
 
-		// get distance with features indexed by iidxs and gtidxs separated
-		CEuclideanDistance* euclidean = CLMNNImpl::setup_distance(lx,iidxs,gtidxs);
-		euclidean->set_disable_sqrt(true);
-
-		for (int32_t j = 0; j < k; ++j)
-		{
-			for (std::size_t ii = 0; ii < iidxs.size(); ++ii)
-			{
-				for (std::size_t jj = 0; jj < gtidxs.size(); ++jj)
-				{
-					// FIXME study if using upper bounded distances can be an improvement
-					float64_t distance = euclidean->distance(ii,jj);
-
-					if (distance <= sqdists(j,iidxs[ii]))
-						N.insert( CImpostorNode(iidxs[ii], target_nn(j,iidxs[ii]), gtidxs[jj]) );
-
-					if (distance <= sqdists(j,gtidxs[jj]))
-						N.insert( CImpostorNode(gtidxs[jj], target_nn(j,gtidxs[jj]), iidxs[ii]) );
-				}
-			}
-		}
-
-		SG_UNREF(euclidean);
+		auto found = find_blockwise(
+		    LX, iidxs, gtidxs,
+		    [&](index_t ii, index_t jj, float64_t distance,
+		        std::vector<CImpostorNode>& impostors) {
+			    if (distance > radius[ii] && distance > radius[jj])
+				    return;
+
+			    for (int32_t j = 0; j < k; ++j)
+			    {
+				    if (distance <= sqdists(j, ii))
+					    impostors.push_back(
+					        CImpostorNode(ii, target_nn(j, ii), jj));
+
+				    if (distance <= sqdists(j, jj))
+					    impostors.push_back(
+					        CImpostorNode(jj, target_nn(j, jj), ii));
+			    }
+			});
+		N.insert(found.begin(), found.end());
 	}
 
-	SG_UNREF(lx);
-
 	SG_SDEBUG("Leaving CLMNNImpl::find_impostors_exact().\n")
 
 	return N;
@@ -478,7 +706,7 @@ ImpostorsSetType CLMNNImpl::find_impostors_approx(
 	{
 		// find in target_nn(:,it->example) the position of the target neighbor it->target
 		index_t target_idx = 0;
-		while (target_nn(target_idx, it->example)!=it->target && target_idx<target_nn.num_rows)
+		while (target_idx<target_nn.num_rows && target_nn(target_idx, it->example)!=it->target)
 			++target_idx;
 
 		REQUIRE(target_idx<target_nn.num_rows, "The index of the target neighbour in the "
@@ -502,20 +730,22 @@ SGVector<float64_t> CLMNNImpl::compute_impostors_sqdists(
 
 	/// compute square distances to impostors
 
-	// create Shogun features from LX and distance
-	CDenseFeatures<float64_t>* lx = new CDenseFeatures<float64_t>(LX);
-	CEuclideanDistance* euclidean = new CEuclideanDistance(lx,lx);
-	euclidean->set_disable_sqrt(true);
+	// the set can only be iterated sequentially, compute in parallel from a copy
+	std::vector<CImpostorNode> impostors(Nexact.begin(), Nexact.end());
 
 	// initialize vector of square distances
 	SGVector<float64_t> sqdists(num_impostors);
 	// compute square distances
-	index_t i = 0;
-	for (ImpostorsSetType::iterator it = Nexact.begin(); it != Nexact.end(); ++it)
-		sqdists[i++] = euclidean->distance(it->example,it->impostor);
-
-	// clean up distance
-	SG_UNREF(euclidean);
+#pragma omp parallel for
+	for (index_t i = 0; i < index_t(num_impostors); ++i)
+	{
+		const float64_t* example = LX.get_column_vector(impostors[i].example);
+		const float64_t* impostor = LX.get_column_vector(impostors[i].impostor);
+		float64_t sqdist = 0;
+		for (index_t r = 0; r < LX.num_rows; ++r)
+			sqdist += CMath::sq(example[r] - impostor[r]);
+		sqdists[i] = sqdist;
+	}
 
 	return sqdists;
 }
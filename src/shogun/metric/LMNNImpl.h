@@ -92,11 +92,35 @@ class CLMNNImpl
 		static SGMatrix<float64_t> sum_outer_products(
 		    CDenseFeatures<float64_t>* x, const SGMatrix<index_t>& target_nn);
 
-		/** find the impostors that remain after applying the transformation L */
+		/**
+		 * find the impostors that remain after applying the transformation L;
+		 * every correction iterations the search is exact and its result is
+		 * cached in exact_impostors, in between only the cached impostors
+		 * are checked
+		 */
 		static ImpostorsSetType find_impostors(
 		    CDenseFeatures<float64_t>* x, CMulticlassLabels* y,
 		    const SGMatrix<float64_t>& L, const SGMatrix<index_t>& target_nn,
-		    const int32_t iter, const int32_t correction);
+		    const int32_t iter, const int32_t correction,
+		    ImpostorsSetType& exact_impostors);
+
+		/**
+		 * find the impostors of the examples in batch after applying the
+		 * transformation L, searching exactly among all the data
+		 */
+		static ImpostorsSetType find_batch_impostors(
+		    CDenseFeatures<float64_t>* x, CMulticlassLabels* y,
+		    const SGMatrix<float64_t>& L, const SGMatrix<index_t>& target_nn,
+		    const std::vector<index_t>& batch);
+
+		/**
+		 * compute the (sub-)gradient of the examples in batch, given their
+		 * impostors, scaled to estimate the gradient of all the data
+		 */
+		static SGMatrix<float64_t> compute_batch_gradient(
+		    CDenseFeatures<float64_t>* x, const SGMatrix<index_t>& target_nn,
+		    const std::vector<index_t>& batch,
+		    const ImpostorsSetType& impostors, float64_t regularization);
 
 		/** update the gradient using the last transition in the impostors sets */
 		static void update_gradient(
@@ -143,7 +167,11 @@ class CLMNNImpl
 		static SGVector<float64_t> compute_impostors_sqdists(
 		    const SGMatrix<float64_t>& L, const ImpostorsSetType& Nexact);
 
-		/** find impostors; variant computing the impostors exactly, using all the data */
+		/**
+		 * find impostors; variant computing the impostors exactly, using all
+		 * the data. The squared distances are computed in blocks of examples
+		 * with matrix products, the blocks are processed in parallel
+		 */
 		static ImpostorsSetType find_impostors_exact(
 		    const SGMatrix<float64_t>& LX, const SGMatrix<float64_t>& sqdists,
 		    CMulticlassLabels* y, const SGMatrix<index_t>& target_nn,
@@ -154,6 +182,17 @@ class CLMNNImpl
 		    const SGMatrix<float64_t>& LX, const SGMatrix<float64_t>& sqdists,
 		    const ImpostorsSetType& Nexact, const SGMatrix<index_t>& target_nn);
 
+		/**
+		 * add the weighted outer products of the differences between the
+		 * examples a[i] and b[i] to G; the differences are gathered in blocks
+		 * so that every block is added with a matrix product, the blocks
+		 * are processed in parallel
+		 */
+		static void add_outer_products(
+		    const SGMatrix<float64_t>& X, const std::vector<index_t>& a,
+		    const std::vector<index_t>& b, const std::vector<float64_t>& weights,
+		    SGMatrix<float64_t>& G);
+
 		/** get the indices of the examples whose label is equal to yi */
 		static std::vector<index_t> get_examples_label(CMulticlassLabels* y, float64_t yi);
 
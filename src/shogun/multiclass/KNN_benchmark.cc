@@ -0,0 +1,108 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "shogun/distance/EuclideanDistance.h"
+#include "shogun/features/DenseFeatures.h"
+#include "shogun/labels/MulticlassLabels.h"
+#include "shogun/multiclass/KNN.h"
+#include "shogun/util/benchmark_data.h"
+
+namespace shogun
+{
+
+class KNNFixture : public benchmark::Fixture
+{
+public:
+	void SetUp(const ::benchmark::State& st)
+	{
+		index_t num_train = st.range(0);
+		SGVector<float64_t> lab;
+		auto data =
+		    benchmark_data::gaussian_blobs(16, num_train + 1000, 5, lab);
+
+		// the first vectors for training, the last 1000 for testing
+		SGMatrix<float64_t> train(data.num_rows, num_train);
+		SGMatrix<float64_t> test(data.num_rows, 1000);
+		std::copy(
+		    data.matrix, data.matrix + train.num_rows * train.num_cols,
+		    train.matrix);
+		std::copy(
+		    data.matrix + train.num_rows * train.num_cols,
+		    data.matrix + data.num_rows * data.num_cols, test.matrix);
+
+		train_feats = new CDenseFeatures<float64_t>(train);
+		test_feats = new CDenseFeatures<float64_t>(test);
+		SGVector<float64_t> train_lab(num_train);
+		std::copy(lab.vector, lab.vector + num_train, train_lab.vector);
+		labels = new CMulticlassLabels(train_lab);
+		SG_REF(train_feats);
+		SG_REF(test_feats);
+		SG_REF(labels);
+	}
+
+	void TearDown(const ::benchmark::State&)
+	{
+		SG_UNREF(train_feats);
+		SG_UNREF(test_feats);
+		SG_UNREF(labels);
+	}
+
+	/** trains on range(0) vectors and classifies 1000 vectors */
+	void classify(benchmark::State& state, KNN_SOLVER solver)
+	{
+		auto knn = new CKNN(10, new CEuclideanDistance(), labels, solver);
+		SG_REF(knn);
+		for (auto _ : state)
+		{
+			knn->train(train_feats);
+			auto result = knn->apply_multiclass(test_feats);
+			SG_UNREF(result);
+		}
+		SG_UNREF(knn);
+	}
+
+	CDenseFeatures<float64_t>* train_feats;
+	CDenseFeatures<float64_t>* test_feats;
+	CMulticlassLabels* labels;
+};
+
+BENCHMARK_DEFINE_F(KNNFixture, Brute)(benchmark::State& state)
+{
+	classify(state, KNN_BRUTE);
+}
+
+BENCHMARK_DEFINE_F(KNNFixture, KDTree)(benchmark::State& state)
+{
+	classify(state, KNN_KDTREE);
+}
+
+#ifdef USE_GPL_SHOGUN
+BENCHMARK_DEFINE_F(KNNFixture, CoverTree)(benchmark::State& state)
+{
+	classify(state, KNN_COVER_TREE);
+}
+#endif // USE_GPL_SHOGUN
+
+BENCHMARK_DEFINE_F(KNNFixture, LSH)(benchmark::State& state)
+{
+	classify(state, KNN_LSH);
+}
+
+// number of training vectors
+#define ADD_KNN_ARGS(WHAT)                                                     \
+	BENCHMARK_REGISTER_F(KNNFixture, WHAT)                                     \
+	    ->RangeMultiplier(4)                                                   \
+	    ->Range(1024, 16384)                                                   \
+	    ->Unit(benchmark::kMillisecond);
+
+ADD_KNN_ARGS(Brute)
+ADD_KNN_ARGS(KDTree)
+#ifdef USE_GPL_SHOGUN
+ADD_KNN_ARGS(CoverTree)
+#endif // USE_GPL_SHOGUN
+ADD_KNN_ARGS(LSH)
+
+}
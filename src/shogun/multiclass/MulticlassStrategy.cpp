@@ -56,6 +56,18 @@ SGVector<int32_t> CMulticlassStrategy::train_prepare_next()
 	return SGVector<int32_t>();
 }
 
+SGVector<int32_t> CMulticlassStrategy::decide_labels(SGMatrix<float64_t> outputs)
+{
+	SGVector<int32_t> labels(outputs.num_cols);
+	for (int32_t i=0; i<outputs.num_cols; i++)
+	{
+		SGVector<float64_t> output_for_i(outputs.get_column_vector(i), outputs.num_rows, false);
+		labels[i]=decide_label(output_for_i);
+	}
+
+	return labels;
+}
+
 void CMulticlassStrategy::train_stop()
 {
 	SG_UNREF(m_train_labels);
@@ -108,6 +108,13 @@ public:
 	 */
 	virtual int32_t decide_label(SGVector<float64_t> outputs)=0;
 
+	/** decide the final labels of many vectors at once.
+	 * The default implementation calls decide_label for every vector.
+	 * @param outputs outputs of each machine (rows) for every vector (columns)
+	 * @return decided labels
+	 */
+	virtual SGVector<int32_t> decide_labels(SGMatrix<float64_t> outputs);
+
 	/** decide the final label.
 	 * @param outputs a vector of output from each machine (in that order)
 	 * @param n_outputs number of outputs
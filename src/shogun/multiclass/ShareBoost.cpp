@@ -123,21 +123,6 @@ void CShareBoost::compute_pred()
 	SG_UNREF(subset_fea);
 }
 
-void CShareBoost::compute_pred(const float64_t *W)
-{
-	int32_t w_len = m_activeset.vlen;
-
-	for (int32_t i=0; i < m_multiclass_strategy->get_num_classes(); ++i)
-	{
-		CLinearMachine *machine = dynamic_cast<CLinearMachine *>(m_machines->get_element(i));
-		SGVector<float64_t> w(w_len);
-		std::copy(W + i*w_len, W + (i+1)*w_len, w.vector);
-		machine->set_w(w);
-		SG_UNREF(machine);
-	}
-	compute_pred();
-}
-
 void CShareBoost::compute_rho()
 {
 	auto lab = multiclass_labels(m_labels);
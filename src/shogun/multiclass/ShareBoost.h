@@ -65,7 +65,6 @@ private:
 	int32_t choose_feature(); ///< choose next feature greedily
 	void optimize_coefficients(); ///< optimize coefficients with gradient descent
 	void compute_pred(); ///< compute predictions on training data, according to W in m_machines
-	void compute_pred(const float64_t *W); ///< compute predictions on training data, according to given W
 
 	int32_t m_nonzero_feas; ///< number of non-zero features to seek
 	SGVector<int32_t> m_activeset; ///< selected features
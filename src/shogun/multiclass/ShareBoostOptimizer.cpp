@@ -6,37 +6,109 @@
 
 #include <algorithm>
 
+#include <shogun/base/Parallel.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/optimization/lbfgs/lbfgs.h>
 #include <shogun/multiclass/ShareBoostOptimizer.h>
 
 using namespace shogun;
 
+ShareBoostCostFunction::ShareBoostCostFunction(SGMatrix<float64_t> fea,
+	SGVector<int32_t> labels, int32_t num_classes)
+	:FirstOrderShardedCostFunction(), m_fea(fea), m_labels(labels),
+	m_num_classes(num_classes), m_W(num_classes*fea.num_rows)
+{
+	m_W.zero();
+}
+
+int32_t ShareBoostCostFunction::get_num_shards()
+{
+	// a fixed number of shards keeps the result independent of the threads
+	return CMath::max(1, CMath::min(64, m_fea.num_cols/256));
+}
+
+float64_t ShareBoostCostFunction::get_shard_cost(int32_t shard, SGVector<float64_t> gradient)
+{
+	int32_t num_shards = get_num_shards();
+	index_t start = get_shard_start(shard, num_shards, m_fea.num_cols);
+	index_t end = get_shard_start(shard+1, num_shards, m_fea.num_cols);
+
+	int32_t m = m_fea.num_rows;
+	int32_t k = m_num_classes;
+	SGVector<float64_t> rho(k);
+
+	float64_t objval = 0;
+	for (index_t ii=start; ii < end; ++ii)
+	{
+		const float64_t *x = m_fea.get_column_vector(ii);
+		int32_t label = m_labels[ii];
+
+		for (int32_t j=0; j < k; ++j)
+		{
+			float64_t pred = 0;
+			for (int32_t i=0; i < m; ++i)
+				pred += x[i] * m_W[j*m + i];
+			rho[j] = pred;
+		}
+
+		float64_t pred_label = rho[label];
+		float64_t rho_norm = 0;
+		for (int32_t j=0; j < k; ++j)
+		{
+			rho[j] = std::exp((label == j) - pred_label + rho[j]);
+			rho_norm += rho[j];
+		}
+		objval += std::log(rho_norm);
+
+		for (int32_t j=0; j < k; ++j)
+		{
+			float64_t coef = rho[j]/rho_norm - (j == label);
+			for (int32_t i=0; i < m; ++i)
+				gradient[j*m + i] += x[i] * coef;
+		}
+	}
+
+	for (index_t i=0; i < gradient.vlen; ++i)
+		gradient[i] /= m_fea.num_cols;
+
+	return objval / m_fea.num_cols;
+}
+
 void ShareBoostOptimizer::optimize()
 {
-	int32_t N = m_sb->m_multiclass_strategy->get_num_classes() * m_sb->m_activeset.vlen;
-	float64_t *W = SG_CALLOC(float64_t, N); // should use this function, if sse is enabled for liblbfgs
+	int32_t num_classes = m_sb->m_multiclass_strategy->get_num_classes();
+	int32_t w_len = m_sb->m_activeset.vlen;
+
+	// gather the active features so that each sample is contiguous
+	SGMatrix<float64_t> fea(w_len, m_sb->m_fea.num_cols);
+	for (int32_t ii=0; ii < fea.num_cols; ++ii)
+		for (int32_t i=0; i < w_len; ++i)
+			fea(i, ii) = m_sb->m_fea(m_sb->m_activeset[i], ii);
+
+	SGVector<int32_t> labels = multiclass_labels(m_sb->m_labels)->get_int_labels();
+
+	m_fun = new ShareBoostCostFunction(fea, labels, num_classes);
+	SG_REF(m_fun);
+
+	SGVector<float64_t> W = m_fun->obtain_variable_reference();
 	float64_t objval;
 	lbfgs_parameter_t param;
 	lbfgs_parameter_init(&param);
 
-	std::fill(W, W+N, 0);
-
 	lbfgs_progress_t progress = m_verbose ? &ShareBoostOptimizer::lbfgs_progress : NULL;
 
-	lbfgs(N, W, &objval, &ShareBoostOptimizer::lbfgs_evaluate, progress, this, &param);
+	lbfgs(W.vlen, W.vector, &objval, &ShareBoostOptimizer::lbfgs_evaluate, progress, this, &param);
 
-	int32_t w_len = m_sb->m_activeset.vlen;
-	for (int32_t i=0; i < m_sb->m_multiclass_strategy->get_num_classes(); ++i)
+	for (int32_t i=0; i < num_classes; ++i)
 	{
 		CLinearMachine *machine = dynamic_cast<CLinearMachine *>(m_sb->m_machines->get_element(i));
 		SGVector<float64_t> w(w_len);
-		std::copy(W + i*w_len, W + (i+1)*w_len, w.vector);
+		std::copy(W.vector + i*w_len, W.vector + (i+1)*w_len, w.vector);
 		machine->set_w(w);
 		SG_UNREF(machine);
 	}
 
-	SG_FREE(W);
+	SG_UNREF(m_fun);
 }
 
 float64_t ShareBoostOptimizer::lbfgs_evaluate(void *userdata, const float64_t *W,
@@ -44,40 +116,8 @@ float64_t ShareBoostOptimizer::lbfgs_evaluate(void *userdata, const float64_t *W
 {
 	ShareBoostOptimizer *optimizer = static_cast<ShareBoostOptimizer *>(userdata);
 
-	optimizer->m_sb->compute_pred(W);
-	optimizer->m_sb->compute_rho();
-
-	int32_t m = optimizer->m_sb->m_activeset.vlen;
-	int32_t k = optimizer->m_sb->m_multiclass_strategy->get_num_classes();
-
-	SGMatrix<float64_t> fea = optimizer->m_sb->m_fea;
-	auto lab = multiclass_labels(optimizer->m_sb->m_labels);
-
-	// compute gradient
-	for (int32_t i=0; i < m; ++i)
-	{
-		for (int32_t j=0; j < k; ++j)
-		{
-			int32_t idx = j*m + i;
-			float64_t g=0;
-			for (int32_t ii=0; ii < fea.num_cols; ++ii)
-				g += fea(optimizer->m_sb->m_activeset[i], ii) *
-					(optimizer->m_sb->m_rho(j,ii)/optimizer->m_sb->m_rho_norm[ii] -
-					 (j == lab->get_int_label(ii)));
-			g /= fea.num_cols;
-			grad[idx] = g;
-		}
-	}
-
-	// compute objective function
-	float64_t objval = 0;
-	for (int32_t ii=0; ii < fea.num_cols; ++ii)
-	{
-		objval += std::log(optimizer->m_sb->m_rho_norm[ii]);
-	}
-	objval /= fea.num_cols;
-
-	return objval;
+	// W is the variable of the cost function, updated in place by l-bfgs
+	return optimizer->m_fun->get_cost_and_gradient(SGVector<float64_t>(grad, n, false));
 }
 
 int ShareBoostOptimizer::lbfgs_progress(
@@ -10,17 +10,59 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/multiclass/ShareBoost.h>
+#include <shogun/optimization/FirstOrderShardedCostFunction.h>
 
 namespace shogun
 {
 
+/** The ShareBoost objective for the coefficients of the active features,
+ * i.e. the mean multiclass log-loss over the training samples. Samples are
+ * split into shards that are evaluated in parallel.
+ */
+class ShareBoostCostFunction: public FirstOrderShardedCostFunction
+{
+public:
+	/** constructor
+	 *
+	 * @param fea active features, one row per active feature and one
+	 * column per sample
+	 * @param labels class of each sample
+	 * @param num_classes number of classes
+	 */
+	ShareBoostCostFunction(SGMatrix<float64_t> fea, SGVector<int32_t> labels,
+		int32_t num_classes);
+
+	virtual ~ShareBoostCostFunction() {}
+
+	/** @return coefficients, the ones of class j are at j*num_active_features */
+	virtual SGVector<float64_t> obtain_variable_reference() { return m_W; }
+
+	/** @return number of shards */
+	virtual int32_t get_num_shards();
+
+	/** @return the log-loss of the samples in a shard */
+	virtual float64_t get_shard_cost(int32_t shard, SGVector<float64_t> gradient);
+
+	virtual const char* get_name() const { return "ShareBoostCostFunction"; }
+
+private:
+	/** active features */
+	SGMatrix<float64_t> m_fea;
+	/** labels of samples */
+	SGVector<int32_t> m_labels;
+	/** number of classes */
+	int32_t m_num_classes;
+	/** coefficients */
+	SGVector<float64_t> m_W;
+};
+
 /** Utility for ShareBoost to handle optimization */
 class ShareBoostOptimizer
 {
 public:
 	/** constructor */
 	ShareBoostOptimizer(CShareBoost *sb, bool verbose=false)
-		:m_sb(sb), m_verbose(verbose) { SG_REF(m_sb); }
+		:m_sb(sb), m_fun(NULL), m_verbose(verbose) { SG_REF(m_sb); }
 	/** destructor */
 	~ShareBoostOptimizer() { SG_UNREF(m_sb); }
 
@@ -45,6 +87,7 @@ private:
 			);
 
 	CShareBoost *m_sb;
+	ShareBoostCostFunction *m_fun;
 	bool m_verbose;
 };
 
@@ -0,0 +1,33 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/multiclass/ecoc/ECOCEDDecoder.h>
+
+using namespace shogun;
+
+SGVector<int32_t> CECOCEDDecoder::decide_labels(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook)
+{
+    SGMatrix<float64_t> products = code_products(outputs, codebook);
+
+    SGVector<float64_t> code_norms(codebook.num_cols);
+    for (int32_t c=0; c < codebook.num_cols; ++c)
+    {
+        code_norms[c] = 0;
+        for (int32_t j=0; j < codebook.num_rows; ++j)
+            code_norms[c] += codebook(j, c)*codebook(j, c);
+    }
+
+    // the norm of the query is the same for all classes and is left out
+    SGVector<int32_t> labels(outputs.num_cols);
+    for (int32_t i=0; i < outputs.num_cols; ++i)
+    {
+        float64_t* dist = products.get_column_vector(i);
+        for (int32_t c=0; c < codebook.num_cols; ++c)
+            dist[c] = code_norms[c] - 2*dist[c];
+
+        labels[i] = CMath::arg_min(dist, 1, codebook.num_cols);
+    }
+
+    return labels;
+}
@@ -33,6 +33,14 @@ public:
     /** get name */
     virtual const char* get_name() const { return "ECOCEDDecoder"; }
 
+    /** decide labels of many vectors at once. Uses
+     * \f$\|q-b_i\|^2 = \|q\|^2 - 2 q^\top b_i + \|b_i\|^2\f$ so that all
+     * distances are obtained from one matrix product.
+     * @param outputs outputs by classifiers, one column per vector
+     * @param codebook ECOC codebook
+     * @return decided labels
+     */
+    virtual SGVector<int32_t> decide_labels(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook);
 
 protected:
     /** whether to turn the output into binary before decoding */
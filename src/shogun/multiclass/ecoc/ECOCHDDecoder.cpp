@@ -0,0 +1,63 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/multiclass/ecoc/ECOCHDDecoder.h>
+
+using namespace shogun;
+
+SGVector<int32_t> CECOCHDDecoder::decide_labels(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook)
+{
+    REQUIRE(outputs.num_rows == codebook.num_rows,
+        "Number of outputs (%d) does not match the code length (%d)\n",
+        outputs.num_rows, codebook.num_rows);
+
+    int32_t code_length = codebook.num_rows;
+    int32_t num_classes = codebook.num_cols;
+    int32_t num_words = CECOCUtil::num_packed_words(code_length);
+
+    SGMatrix<uint64_t> signs(num_words, num_classes);
+    SGMatrix<uint64_t> masks(num_words, num_classes);
+    SGVector<int32_t> num_zeros(num_classes);
+    for (int32_t c=0; c < num_classes; ++c)
+    {
+        CECOCUtil::pack_code(codebook.get_column_vector(c), code_length,
+            signs.get_column_vector(c), masks.get_column_vector(c));
+
+        num_zeros[c] = code_length;
+        for (int32_t w=0; w < num_words; ++w)
+            num_zeros[c] -= CECOCUtil::popcount(masks(w, c));
+    }
+
+    SGVector<int32_t> labels(outputs.num_cols);
+
+    #pragma omp parallel num_threads(parallel->get_num_threads())
+    {
+        SGVector<uint64_t> query(num_words);
+
+        #pragma omp for
+        for (int32_t i=0; i < outputs.num_cols; ++i)
+        {
+            // same as binarize(): non-negative outputs become +1
+            CECOCUtil::pack_code(outputs.get_column_vector(i), code_length,
+                query.vector, NULL, true);
+
+            int32_t result = 0;
+            int32_t min_dist = 0;
+            for (int32_t c=0; c < num_classes; ++c)
+            {
+                int32_t dist = CECOCUtil::packed_hamming_distance(query.vector,
+                    signs.get_column_vector(c), masks.get_column_vector(c),
+                    num_zeros[c], num_words);
+                if (c == 0 || dist < min_dist)
+                {
+                    min_dist = dist;
+                    result = c;
+                }
+            }
+            labels[i] = result;
+        }
+    }
+
+    return labels;
+}
@@ -15,7 +15,12 @@
 namespace shogun
 {
 
-/** Hamming Distance Decoder */
+/** Hamming Distance Decoder.
+ *
+ * When decoding many vectors at once, the codebook and the binarized
+ * outputs are packed into 64 bit words so that the distance to each
+ * code is computed with a few popcounts.
+ */
 class CECOCHDDecoder: public CECOCSimpleDecoder
 {
 public:
@@ -31,6 +36,13 @@ public:
         return "ECOCHDDecoder";
     }
 
+    /** decide labels of many vectors at once using the bit-packed codebook.
+     * @param outputs outputs by classifiers, one column per vector
+     * @param codebook ECOC codebook
+     * @return decided labels
+     */
+    virtual SGVector<int32_t> decide_labels(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook);
+
 protected:
     /** whether to turn the output into binary before decoding */
     virtual bool binary_decoding()
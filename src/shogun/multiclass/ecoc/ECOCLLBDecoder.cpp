@@ -9,3 +9,15 @@ float64_t CECOCLLBDecoder::compute_distance(SGVector<float64_t> outputs, const i
         loss += outputs[i]*code[i];
     return -loss;
 }
+
+SGVector<int32_t> CECOCLLBDecoder::decide_labels(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook)
+{
+    // the loss of each class is the negated product of its code and the outputs
+    SGMatrix<float64_t> products = code_products(outputs, codebook);
+
+    SGVector<int32_t> labels(outputs.num_cols);
+    for (int32_t i=0; i < outputs.num_cols; ++i)
+        labels[i] = CMath::arg_max(products.get_column_vector(i), 1, products.num_rows);
+
+    return labels;
+}
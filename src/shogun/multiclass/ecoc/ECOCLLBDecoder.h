@@ -30,6 +30,14 @@ public:
     /** get name */
     virtual const char* get_name() const { return "ECOCLLBDecoder"; }
 
+    /** decide labels of many vectors at once, the losses of all vectors
+     * are computed with one matrix product.
+     * @param outputs outputs by classifiers, one column per vector
+     * @param codebook ECOC codebook
+     * @return decided labels
+     */
+    virtual SGVector<int32_t> decide_labels(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook);
+
 protected:
     /** whether to turn the output into binary before decoding */
     virtual bool binary_decoding() { return false; }
@@ -6,6 +6,7 @@
 
 #include <shogun/multiclass/ecoc/ECOCSimpleDecoder.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 using namespace shogun;
 
@@ -23,3 +24,31 @@ int32_t CECOCSimpleDecoder::decide_label(const SGVector<float64_t> outputs, cons
     int32_t result = CMath::arg_min(distances.vector, 1, distances.vlen);
     return result;
 }
+
+SGVector<int32_t> CECOCSimpleDecoder::decide_labels(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook)
+{
+    SGVector<int32_t> labels(outputs.num_cols);
+
+    // distances only depend on the query and the codebook
+    #pragma omp parallel for num_threads(parallel->get_num_threads())
+    for (int32_t i=0; i < outputs.num_cols; ++i)
+    {
+        SGVector<float64_t> query(outputs.get_column_vector(i), outputs.num_rows, false);
+        labels[i] = decide_label(query, codebook);
+    }
+
+    return labels;
+}
+
+SGMatrix<float64_t> CECOCSimpleDecoder::code_products(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook)
+{
+    REQUIRE(outputs.num_rows == codebook.num_rows,
+        "Number of outputs (%d) does not match the code length (%d)\n",
+        outputs.num_rows, codebook.num_rows);
+
+    SGMatrix<float64_t> codes(codebook.num_rows, codebook.num_cols);
+    for (int64_t i=0; i < int64_t(codebook.num_rows)*codebook.num_cols; ++i)
+        codes.matrix[i] = codebook.matrix[i];
+
+    return linalg::matrix_prod(codes, outputs, true, false);
+}
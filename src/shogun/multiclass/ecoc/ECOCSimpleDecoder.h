@@ -37,12 +37,27 @@ public:
      */
     virtual int32_t decide_label(const SGVector<float64_t> outputs, const SGMatrix<int32_t> codebook);
 
+    /** decide labels of many vectors at once, in parallel.
+     * @param outputs outputs by classifiers, one column per vector
+     * @param codebook ECOC codebook
+     * @return decided labels
+     */
+    virtual SGVector<int32_t> decide_labels(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook);
+
 protected:
     /** whether to turn the output into binary before decoding */
     virtual bool binary_decoding()=0;
 
     /** compute distance */
     virtual float64_t compute_distance(SGVector<float64_t> outputs, const int32_t *code)=0;
+
+    /** compute the inner products of every code with every output vector
+     * as a single matrix product.
+     * @param outputs outputs by classifiers, one column per vector
+     * @param codebook ECOC codebook
+     * @return num_classes x num_vectors matrix of products
+     */
+    SGMatrix<float64_t> code_products(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook);
 };
 
 } /* shogun */
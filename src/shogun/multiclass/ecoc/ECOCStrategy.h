@@ -51,6 +51,12 @@ public:
      */
     virtual int32_t decide_label(SGVector<float64_t> outputs);
 
+    /** decide the final labels of many vectors at once, lets the decoder
+     * decode all of them in one batch.
+     * @param outputs outputs of each machine (rows) for every vector (columns)
+     */
+    virtual SGVector<int32_t> decide_labels(SGMatrix<float64_t> outputs);
+
     /** get number of machines used in this strategy.
      */
     virtual int32_t get_num_machines();
@@ -31,6 +31,68 @@ public:
                 dist += static_cast<int32_t>(CMath::abs((c1[i]-c2[i])));
             return dist/2;
         }
+
+    /** number of bits set in a word */
+    static inline int32_t popcount(uint64_t word)
+    {
+#ifdef __GNUC__
+        return __builtin_popcountll(word);
+#else
+        word = word - ((word >> 1) & 0x5555555555555555ULL);
+        word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+        word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        return static_cast<int32_t>((word * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    /** number of 64 bit words needed to pack a code of given length */
+    static inline int32_t num_packed_words(int32_t len)
+    {
+        return (len+63)/64;
+    }
+
+    /** pack a code into bit words.
+     *
+     * bit i of sign is set when c[i] is positive (>= 0 if zero_is_positive),
+     * bit i of mask is set when c[i] is nonzero. Either may be NULL.
+     */
+    template<typename T>
+        static void pack_code(const T *c, int32_t len, uint64_t *sign, uint64_t *mask,
+                bool zero_is_positive=false)
+        {
+            int32_t num_words = num_packed_words(len);
+            for (int32_t w=0; w < num_words; ++w)
+            {
+                if (sign)
+                    sign[w] = 0;
+                if (mask)
+                    mask[w] = 0;
+            }
+
+            for (int32_t i=0; i < len; ++i)
+            {
+                uint64_t bit = uint64_t(1) << (i%64);
+                if (sign && (c[i] > 0 || (zero_is_positive && c[i] == 0)))
+                    sign[i/64] |= bit;
+                if (mask && c[i] != 0)
+                    mask[i/64] |= bit;
+            }
+        }
+
+    /** compute hamming distance between a binary query and a code, both
+     * packed with pack_code.
+     *
+     * Gives the same result as hamming_distance, num_zeros is the number of
+     * 0 elements of the code, each of which counts as half a mismatch.
+     */
+    static inline int32_t packed_hamming_distance(const uint64_t *query,
+            const uint64_t *sign, const uint64_t *mask, int32_t num_zeros, int32_t num_words)
+    {
+        int32_t dist = 0;
+        for (int32_t w=0; w < num_words; ++w)
+            dist += popcount((query[w]^sign[w]) & mask[w]);
+        return dist + num_zeros/2;
+    }
 };
 
 } /* shogun */
@@ -0,0 +1,120 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "shogun/ensemble/MajorityVote.h"
+#include "shogun/features/DenseFeatures.h"
+#include "shogun/labels/MulticlassLabels.h"
+#include "shogun/machine/RandomForest.h"
+#include "shogun/mathematics/Math.h"
+#include "shogun/multiclass/tree/CARTree.h"
+#include "shogun/util/benchmark_data.h"
+
+namespace shogun
+{
+
+class TreeFixture : public benchmark::Fixture
+{
+public:
+	void SetUp(const ::benchmark::State& st)
+	{
+		SGVector<float64_t> lab;
+		auto data = benchmark_data::gaussian_blobs(16, st.range(0), 4, lab);
+		feats = new CDenseFeatures<float64_t>(data);
+		labels = new CMulticlassLabels(lab);
+		SG_REF(feats);
+		SG_REF(labels);
+
+		// all features are continuous
+		feature_types = SGVector<bool>(data.num_rows);
+		feature_types.set_const(false);
+
+		// bagging and feature subsets are random
+		CMath::init_random(benchmark_data::DEFAULT_SEED);
+	}
+
+	void TearDown(const ::benchmark::State&)
+	{
+		SG_UNREF(feats);
+		SG_UNREF(labels);
+	}
+
+	CCARTree* create_tree()
+	{
+		auto tree = new CCARTree();
+		tree->set_feature_types(feature_types);
+		tree->set_labels(labels);
+		SG_REF(tree);
+		return tree;
+	}
+
+	CRandomForest* create_forest()
+	{
+		auto forest = new CRandomForest(4, 20);
+		forest->set_feature_types(feature_types);
+		forest->set_combination_rule(new CMajorityVote());
+		forest->set_labels(labels);
+		SG_REF(forest);
+		return forest;
+	}
+
+	CDenseFeatures<float64_t>* feats;
+	CMulticlassLabels* labels;
+	SGVector<bool> feature_types;
+};
+
+BENCHMARK_DEFINE_F(TreeFixture, CARTree_train)(benchmark::State& state)
+{
+	auto tree = create_tree();
+	for (auto _ : state)
+		tree->train(feats);
+	SG_UNREF(tree);
+}
+
+BENCHMARK_DEFINE_F(TreeFixture, CARTree_apply)(benchmark::State& state)
+{
+	auto tree = create_tree();
+	tree->train(feats);
+	for (auto _ : state)
+	{
+		auto result = tree->apply_multiclass(feats);
+		SG_UNREF(result);
+	}
+	SG_UNREF(tree);
+}
+
+BENCHMARK_DEFINE_F(TreeFixture, RandomForest_train)(benchmark::State& state)
+{
+	auto forest = create_forest();
+	for (auto _ : state)
+		forest->train(feats);
+	SG_UNREF(forest);
+}
+
+BENCHMARK_DEFINE_F(TreeFixture, RandomForest_apply)(benchmark::State& state)
+{
+	auto forest = create_forest();
+	forest->train(feats);
+	for (auto _ : state)
+	{
+		auto result = forest->apply_multiclass(feats);
+		SG_UNREF(result);
+	}
+	SG_UNREF(forest);
+}
+
+// number of vectors
+#define ADD_TREE_ARGS(WHAT)                                                    \
+	BENCHMARK_REGISTER_F(TreeFixture, WHAT)                                    \
+	    ->RangeMultiplier(4)                                                   \
+	    ->Range(1024, 16384)                                                   \
+	    ->Unit(benchmark::kMillisecond);
+
+ADD_TREE_ARGS(CARTree_train)
+ADD_TREE_ARGS(CARTree_apply)
+ADD_TREE_ARGS(RandomForest_train)
+ADD_TREE_ARGS(RandomForest_apply)
+
+}
@@ -0,0 +1,96 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/optimization/FirstOrderShardedCostFunction.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/lib/SGMatrix.h>
+
+#include <algorithm>
+
+using namespace shogun;
+
+FirstOrderShardedCostFunction::FirstOrderShardedCostFunction()
+	:FirstOrderCostFunction()
+{
+	init();
+}
+
+void FirstOrderShardedCostFunction::init()
+{
+	m_cached_cost=0.0;
+}
+
+void FirstOrderShardedCostFunction::reset_cache()
+{
+	m_cached_variable=SGVector<float64_t>();
+	m_cached_gradient=SGVector<float64_t>();
+}
+
+index_t FirstOrderShardedCostFunction::get_shard_start(int32_t shard,
+	int32_t num_shards, index_t num_items)
+{
+	return (int64_t(num_items)*shard)/num_shards;
+}
+
+float64_t FirstOrderShardedCostFunction::get_cost()
+{
+	SGVector<float64_t> gradient(obtain_variable_reference().vlen);
+	return get_cost_and_gradient(gradient);
+}
+
+SGVector<float64_t> FirstOrderShardedCostFunction::get_gradient()
+{
+	SGVector<float64_t> gradient(obtain_variable_reference().vlen);
+	get_cost_and_gradient(gradient);
+	return gradient;
+}
+
+float64_t FirstOrderShardedCostFunction::get_cost_and_gradient(SGVector<float64_t> gradient)
+{
+	SGVector<float64_t> variable=obtain_variable_reference();
+	REQUIRE(gradient.vlen==variable.vlen,
+		"The length of gradient (%d) and the length of variable (%d) do not match\n",
+		gradient.vlen, variable.vlen);
+
+	if (m_cached_variable.vlen==variable.vlen && m_cached_gradient.vlen==variable.vlen &&
+		std::equal(variable.vector, variable.vector+variable.vlen, m_cached_variable.vector))
+	{
+		std::copy(m_cached_gradient.vector, m_cached_gradient.vector+variable.vlen, gradient.vector);
+		return m_cached_cost;
+	}
+
+	int32_t num_shards=get_num_shards();
+	REQUIRE(num_shards>0, "Number of shards (%d) must be positive\n", num_shards);
+
+	index_t dim=variable.vlen;
+	SGMatrix<float64_t> shard_gradients(dim, num_shards);
+	SGVector<float64_t> shard_costs(num_shards);
+	shard_gradients.zero();
+
+	#pragma omp parallel for schedule(dynamic) num_threads(parallel->get_num_threads())
+	for (int32_t s=0; s<num_shards; s++)
+	{
+		SGVector<float64_t> shard_gradient(shard_gradients.get_column_vector(s), dim, false);
+		shard_costs[s]=get_shard_cost(s, shard_gradient);
+	}
+
+	// sum in shard order, whatever thread computed which shard
+	gradient.zero();
+	float64_t cost=get_shared_cost(gradient);
+	for (int32_t s=0; s<num_shards; s++)
+		cost+=shard_costs[s];
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (index_t j=0; j<dim; j++)
+	{
+		for (int32_t s=0; s<num_shards; s++)
+			gradient[j]+=shard_gradients(j, s);
+	}
+
+	m_cached_variable=variable.clone();
+	m_cached_gradient=gradient.clone();
+	m_cached_cost=cost;
+
+	return cost;
+}
@@ -0,0 +1,112 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef FIRSTORDERSHARDEDCOSTFUNCTION_H
+#define FIRSTORDERSHARDEDCOSTFUNCTION_H
+#include <shogun/lib/config.h>
+#include <shogun/optimization/FirstOrderCostFunction.h>
+namespace shogun
+{
+/** @brief The first order cost function base class for costs that are sums
+ * over shards of the data.
+ *
+ * \f[
+ * f(w)=r(w)+\sum_{s=1}^{S}{f_s(w)}
+ * \f]
+ * where \f$f_s\f$ is the cost of the samples in shard \f$s\f$ and \f$r\f$
+ * holds the terms that do not depend on the data, such as a regulariser.
+ *
+ * The shards are evaluated in parallel into separate gradient buffers that are
+ * summed in shard order, so the result does not depend on the number of
+ * threads. Cost and gradient are computed together and cached until the
+ * variables change, so a minimizer asking for both pays for one pass.
+ */
+class FirstOrderShardedCostFunction: public FirstOrderCostFunction
+{
+public:
+	/** constructor */
+	FirstOrderShardedCostFunction();
+
+	virtual ~FirstOrderShardedCostFunction() {};
+
+	/** Get the cost given current target variables
+	 *
+	 * @return cost
+	 */
+	virtual float64_t get_cost();
+
+	/** Get the gradient value wrt target variables
+	 *
+	 * @return gradient of variables
+	 */
+	virtual SGVector<float64_t> get_gradient();
+
+	/** Get cost and gradient given current target variables in one
+	 * parallel pass over the shards
+	 *
+	 * @param gradient vector the gradient is written to, the same length as
+	 * the target variables
+	 * @return cost
+	 */
+	virtual float64_t get_cost_and_gradient(SGVector<float64_t> gradient);
+
+	/** Get the number of shards. It should not depend on the number of
+	 * threads, otherwise results may differ between runs
+	 *
+	 * @return number of shards
+	 */
+	virtual int32_t get_num_shards()=0;
+
+	/** Get the cost of one shard given current target variables.
+	 * Shards are evaluated concurrently, so this must not modify shared
+	 * state
+	 *
+	 * @param shard index of the shard
+	 * @param gradient zero initialised vector the gradient of the shard is
+	 * added to
+	 * @return cost of the shard
+	 */
+	virtual float64_t get_shard_cost(int32_t shard, SGVector<float64_t> gradient)=0;
+
+	/** Get the cost of the terms that do not depend on the data
+	 *
+	 * @param gradient vector the gradient of these terms is added to
+	 * @return cost
+	 */
+	virtual float64_t get_shared_cost(SGVector<float64_t> gradient)
+	{
+		return 0.0;
+	}
+
+	/** Get the first index of a shard when splitting items into contiguous
+	 * shards of nearly equal size. The shard ends where the next one starts.
+	 *
+	 * @param shard index of the shard, num_shards gives the end of the last
+	 * @param num_shards number of shards
+	 * @param num_items number of items
+	 * @return first index of the shard
+	 */
+	static index_t get_shard_start(int32_t shard, int32_t num_shards, index_t num_items);
+
+protected:
+	/** Forget the cached cost and gradient. Needed when the cost changes
+	 * without its variables changing
+	 */
+	void reset_cache();
+
+private:
+	/** init */
+	void init();
+
+	/** variables the cached values were computed at */
+	SGVector<float64_t> m_cached_variable;
+
+	/** cached gradient */
+	SGVector<float64_t> m_cached_gradient;
+
+	/** cached cost */
+	float64_t m_cached_cost;
+};
+}
+#endif
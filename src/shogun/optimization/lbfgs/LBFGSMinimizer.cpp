@@ -30,6 +30,7 @@
  */
 #include <shogun/optimization/lbfgs/LBFGSMinimizer.h>
 #include <shogun/optimization/FirstOrderBoundConstraintsCostFunction.h>
+#include <shogun/optimization/FirstOrderShardedCostFunction.h>
 #include <shogun/base/Parameter.h>
 
 namespace shogun
@@ -47,12 +48,6 @@ CLBFGSMinimizer::~CLBFGSMinimizer()
 CLBFGSMinimizer::CLBFGSMinimizer(FirstOrderCostFunction *fun)
 	:FirstOrderMinimizer(fun)
 {
-	FirstOrderBoundConstraintsCostFunction* bound_constraints_fun
-		=dynamic_cast<FirstOrderBoundConstraintsCostFunction *>(m_fun);
-	if(m_fun && bound_constraints_fun)
-	{
-		SG_SWARNING("The minimizer does not support constrained minimization. All constraints will be ignored.\n")
-	}
 	init();
 }
 
@@ -61,6 +56,7 @@ void CLBFGSMinimizer::init()
 	set_lbfgs_parameters();
 	m_min_step=1e-6;
 	m_xtol=1e-6;
+	m_bound_constraints=false;
 	SG_ADD(&m_linesearch_id, "CLBFGSMinimizer__m_linesearch_id",
 		"linesearch_id in CLBFGSMinimizer");
 	SG_ADD(&m_m, "CLBFGSMinimizer__m_m",
@@ -93,6 +89,8 @@ void CLBFGSMinimizer::init()
 		"orthantwise_start in CLBFGSMinimizer");
 	SG_ADD(&m_orthantwise_end, "CLBFGSMinimizer__m_orthantwise_end",
 		"orthantwise_end in CLBFGSMinimizer");
+	SG_ADD(&m_bound_constraints, "CLBFGSMinimizer__m_bound_constraints",
+		"bound_constraints in CLBFGSMinimizer");
 	SG_ADD(&m_target_variable, "CLBFGSMinimizer__m_target_variable",
 		"m_target_variable in CLBFGSMinimizer");
 }
@@ -138,6 +136,57 @@ void CLBFGSMinimizer::init_minimization()
 	REQUIRE(m_fun, "Cost function not set!\n");
 	m_target_variable=m_fun->obtain_variable_reference();
 	REQUIRE(m_target_variable.vlen>0,"Target variable from cost function must not empty!\n");
+
+	FirstOrderBoundConstraintsCostFunction* bound_constraints_fun
+		=dynamic_cast<FirstOrderBoundConstraintsCostFunction *>(m_fun);
+	if (!bound_constraints_fun)
+		return;
+
+	if (!m_bound_constraints)
+	{
+		SG_SWARNING("Bound constraints are disabled in the minimizer. All constraints will be ignored.\n")
+		return;
+	}
+
+	SGVector<float64_t> lower=bound_constraints_fun->get_lower_bound();
+	SGVector<float64_t> upper=bound_constraints_fun->get_upper_bound();
+	REQUIRE(lower.vlen==1 || lower.vlen==m_target_variable.vlen,
+		"The length of lower bound (%d) must be 1 or the length of variable (%d)\n",
+		lower.vlen, m_target_variable.vlen);
+	REQUIRE(upper.vlen==1 || upper.vlen==m_target_variable.vlen,
+		"The length of upper bound (%d) must be 1 or the length of variable (%d)\n",
+		upper.vlen, m_target_variable.vlen);
+
+	for (index_t i=0; i<m_target_variable.vlen; i++)
+	{
+		float64_t lb=lower[lower.vlen==1 ? 0 : i];
+		float64_t ub=upper[upper.vlen==1 ? 0 : i];
+		REQUIRE(lb<=ub, "The lower bound (%f) of variable %d is larger than its upper bound (%f)\n",
+			lb, i, ub);
+	}
+}
+
+void CLBFGSMinimizer::project_to_bounds(float64_t *gradient)
+{
+	FirstOrderBoundConstraintsCostFunction* bound_constraints_fun
+		=dynamic_cast<FirstOrderBoundConstraintsCostFunction *>(m_fun);
+	SGVector<float64_t> lower=bound_constraints_fun->get_lower_bound();
+	SGVector<float64_t> upper=bound_constraints_fun->get_upper_bound();
+
+	for (index_t i=0; i<m_target_variable.vlen; i++)
+	{
+		float64_t lb=lower[lower.vlen==1 ? 0 : i];
+		float64_t ub=upper[upper.vlen==1 ? 0 : i];
+		if (gradient)
+		{
+			/* variables at a bound only move back into the box */
+			if ((m_target_variable[i]<=lb && gradient[i]>0) ||
+				(m_target_variable[i]>=ub && gradient[i]<0))
+				gradient[i]=0.0;
+		}
+		else
+			m_target_variable[i]=CMath::clamp(m_target_variable[i], lb, ub);
+	}
 }
 
 float64_t CLBFGSMinimizer::minimize()
@@ -167,6 +216,26 @@ float64_t CLBFGSMinimizer::minimize()
 		&cost, CLBFGSMinimizer::evaluate,
 		NULL, this, &lbfgs_param);
 
+	if (is_bounded())
+	{
+		/* Projection makes the curvature pairs inconsistent once variables
+		 * hit the bounds, which shows up as a failed line search. Restart
+		 * with an empty history as long as the cost keeps decreasing. */
+		for (int32_t restart=0; restart<m_max_iterations; restart++)
+		{
+			if (error_code==0 || error_code==LBFGS_ALREADY_MINIMIZED ||
+				error_code==LBFGSERR_MAXIMUMITERATION)
+				break;
+
+			float64_t last_cost=cost;
+			error_code=lbfgs(m_target_variable.vlen, m_target_variable.vector,
+				&cost, CLBFGSMinimizer::evaluate,
+				NULL, this, &lbfgs_param);
+			if (!(cost<last_cost))
+				break;
+		}
+	}
+
 	if(error_code!=0 && error_code!=LBFGS_ALREADY_MINIMIZED)
 	{
 		SG_SWARNING("Error(s) happened during L-BFGS optimization (error code:%d)\n",
@@ -185,7 +254,27 @@ float64_t CLBFGSMinimizer::evaluate(void *obj, const float64_t *variable,
 
 	REQUIRE(obj_prt, "The instance object passed to L-BFGS optimizer should not be NULL\n");
 
-	float64_t cost=obj_prt->m_fun->get_cost();
+	/* the variable is the one L-BFGS updates, so projecting it
+	 * moves the iterate back into the box */
+	bool bounded=obj_prt->is_bounded();
+	if (bounded)
+		obj_prt->project_to_bounds();
+
+	float64_t cost=0.0;
+	// sharded costs compute both in one parallel pass
+	FirstOrderShardedCostFunction* sharded_fun
+		=dynamic_cast<FirstOrderShardedCostFunction *>(obj_prt->m_fun);
+	if (sharded_fun)
+	{
+		cost=sharded_fun->get_cost_and_gradient(SGVector<float64_t>(gradient, dim, false));
+		if (CMath::is_nan(cost) || std::isinf(cost))
+			return cost;
+		if (bounded)
+			obj_prt->project_to_bounds(gradient);
+		return cost;
+	}
+
+	cost=obj_prt->m_fun->get_cost();
 
 	if (CMath::is_nan(cost) || std::isinf(cost))
 		return cost;
@@ -197,7 +286,15 @@ float64_t CLBFGSMinimizer::evaluate(void *obj, const float64_t *variable,
 		grad.vlen,dim);
 
 	std::copy(grad.vector,grad.vector+dim,gradient);
+	if (bounded)
+		obj_prt->project_to_bounds(gradient);
 	return cost;
 }
 
+bool CLBFGSMinimizer::is_bounded()
+{
+	return m_bound_constraints &&
+		dynamic_cast<FirstOrderBoundConstraintsCostFunction *>(m_fun);
+}
+
 }
@@ -124,6 +124,25 @@ public:
 		int32_t orthantwise_start = 0,
 		int32_t orthantwise_end = 1);
 
+	/** set whether the bounds of a FirstOrderBoundConstraintsCostFunction
+	 * are respected. If enabled, every iterate is projected into the box and
+	 * the gradient components pushing variables at a bound outwards are
+	 * dropped. L-BFGS is restarted when projection stalls the line search.
+	 * Otherwise the constraints are ignored.
+	 *
+	 * @param bound_constraints whether to respect bound constraints
+	 */
+	virtual void set_bound_constraints(bool bound_constraints)
+	{
+		m_bound_constraints=bound_constraints;
+	}
+
+	/** get whether bound constraints are respected
+	 *
+	 * @return whether bound constraints are respected
+	 */
+	virtual bool get_bound_constraints() const { return m_bound_constraints; }
+
 private:
 	/** A helper function is used in the C-style LBFGS API
 	 * Note that this function should be static and
@@ -141,6 +160,19 @@ protected:
 	/** Init before minimization */
 	virtual void init_minimization();
 
+	/** whether the bounds of the cost function are respected
+	 *
+	 * @return whether minimization is bounded
+	 */
+	bool is_bounded();
+
+	/** Project the target variable into the bounds or, if a gradient is
+	 * given, drop its components pointing out of the bounds
+	 *
+	 * @param gradient gradient wrt target variable
+	 */
+	void project_to_bounds(float64_t *gradient=NULL);
+
 	/** The number of corrections to approximate the inverse hessian matrix.*/
 	int32_t m_m;
 
@@ -189,6 +221,9 @@ protected:
 	/** End index for computing L1 norm of the variables.*/
 	int32_t m_orthantwise_end;
 
+	/** Whether bound constraints are respected */
+	bool m_bound_constraints;
+
 	/** Target variable */
 	SGVector<float64_t> m_target_variable;
 };
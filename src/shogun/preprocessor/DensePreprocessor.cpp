@@ -133,6 +133,19 @@ CDensePreprocessor<ST>::inverse_apply_to_matrix(SGMatrix<ST> matrix)
 	return SGMatrix<ST>();
 }
 
+template <class ST>
+bool CDensePreprocessor<ST>::supports_inplace() const
+{
+	return false;
+}
+
+template <class ST>
+bool CDensePreprocessor<ST>::get_affine_form(SGVector<int32_t>& idx,
+	SGVector<ST>& scale, SGVector<ST>& shift)
+{
+	return false;
+}
+
 template class CDensePreprocessor<bool>;
 template class CDensePreprocessor<char>;
 template class CDensePreprocessor<int8_t>;
@@ -27,6 +27,8 @@ template <class ST> class CDenseFeatures;
  */
 template <class ST> class CDensePreprocessor : public CPreprocessor
 {
+	friend class CDenseFeatures<ST>;
+
 	public:
 		/** constructor
 		 */
@@ -54,6 +56,29 @@ template <class ST> class CDensePreprocessor : public CPreprocessor
 		/// result in feature matrix
 		virtual SGVector<ST> apply_to_feature_vector(SGVector<ST> vector) = 0;
 
+		/** Whether apply_to_matrix() works in place, transforms every column
+		 * independently of the others and never increases the number of
+		 * rows. CDenseFeatures applies chains made only of such
+		 * preprocessors on a single buffer, without any intermediate
+		 * allocation.
+		 *
+		 * @return whether the preprocessor can be applied in place
+		 */
+		virtual bool supports_inplace() const;
+
+		/** Obtain the preprocessor as an affine map on a selection of
+		 * features, \f$y_i = a_i x_{j_i} + b_i\f$, with strictly increasing
+		 * indices \f$j_i\f$. Consecutive affine preprocessors are composed
+		 * into a single pass when applied to blocks of vectors.
+		 *
+		 * @param idx input feature index of every output feature
+		 * @param scale factor of every output feature
+		 * @param shift offset of every output feature
+		 * @return false if the preprocessor is not affine
+		 */
+		virtual bool get_affine_form(SGVector<int32_t>& idx,
+			SGVector<ST>& scale, SGVector<ST>& shift);
+
 		/// return that we are dense features (just fixed size matrices)
 		virtual EFeatureClass get_feature_class();
 		/// return feature type
@@ -17,9 +17,16 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/lib/common.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <algorithm>
+
 using namespace shogun;
+using namespace Eigen;
+
+/** number of vectors whose kernel rows are computed at once when transforming */
+static const index_t TRANSFORM_BLOCK_SIZE = 1024;
 
 CKernelPCA::CKernelPCA() : CPreprocessor()
 {
@@ -40,6 +47,8 @@ void CKernelPCA::init()
 	m_bias_vector = SGVector<float64_t>();
 	m_target_dim = 1;
 	m_kernel = NULL;
+	m_num_landmarks = 0;
+	m_center_kernel = true;
 
 	SG_ADD(&m_transformation_matrix, "transformation_matrix",
 		"matrix used to transform data");
@@ -49,6 +58,10 @@ void CKernelPCA::init()
 	    &m_target_dim, "target_dim", "target dimensionality of preprocessor",
 	    ParameterProperties::HYPER);
 	SG_ADD(&m_kernel, "kernel", "kernel to be used", ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_num_landmarks, "num_landmarks",
+	    "number of landmarks of the Nystroem approximation",
+	    ParameterProperties::HYPER);
 }
 
 void CKernelPCA::cleanup()
@@ -75,6 +88,17 @@ void CKernelPCA::fit(CFeatures* features)
 	if (m_fitted)
 		cleanup();
 
+	if (m_num_landmarks > 0 && m_num_landmarks < features->get_num_vectors())
+		fit_nystroem(features);
+	else
+		fit_exact(features);
+
+	m_fitted = true;
+	SG_INFO("Done\n")
+}
+
+void CKernelPCA::fit_exact(CFeatures* features)
+{
 	SG_REF(features);
 	m_init_features = features;
 
@@ -87,7 +111,7 @@ void CKernelPCA::fit(CFeatures* features)
 	if (m_target_dim > n)
 	{
 		SG_SWARNING(
-		    "Target dimension (%d) is not a valid value, it must be"
+		    "Target dimension (%d) is not a valid value, it must be "
 		    "less or equal than the number of vectors."
 		    "Setting it to maximum allowed size (%d).",
 		    m_target_dim, n);
@@ -121,9 +145,76 @@ void CKernelPCA::fit(CFeatures* features)
 
 	m_bias_vector = SGVector<float64_t>(m_target_dim);
 	linalg::matrix_prod(m_transformation_matrix, bias_tmp, m_bias_vector, true);
+	m_center_kernel = true;
+}
 
-	m_fitted = true;
-	SG_INFO("Done\n")
+void CKernelPCA::fit_nystroem(CFeatures* features)
+{
+	int32_t n = features->get_num_vectors();
+	int32_t m = m_num_landmarks;
+	if (m_target_dim > m)
+	{
+		SG_SWARNING(
+		    "Target dimension (%d) is not a valid value, it must be "
+		    "less or equal than the number of landmarks."
+		    "Setting it to maximum allowed size (%d).",
+		    m_target_dim, m);
+		m_target_dim = m;
+	}
+
+	SGVector<index_t> permutation(n);
+	permutation.range_fill();
+	CMath::permute(permutation);
+	SGVector<index_t> landmarks(m);
+	std::copy(permutation.vector, permutation.vector + m, landmarks.vector);
+	std::sort(landmarks.vector, landmarks.vector + m);
+
+	m_init_features = features->copy_subset(landmarks);
+	SG_REF(m_init_features);
+
+	SG_INFO("Computing kernel to %d landmarks\n", m)
+	m_kernel->init(features, m_init_features);
+	SGMatrix<float64_t> kernel_matrix = m_kernel->get_kernel_matrix();
+	m_kernel->init(m_init_features, m_init_features);
+	SGMatrix<float64_t> landmark_kernel_matrix = m_kernel->get_kernel_matrix();
+	m_kernel->cleanup();
+
+	Map<MatrixXd> C(kernel_matrix.matrix, n, m);
+	Map<MatrixXd> W(landmark_kernel_matrix.matrix, m, m);
+
+	// pseudo inverse square root of the landmark kernel matrix
+	SelfAdjointEigenSolver<MatrixXd> w_solver(W);
+	VectorXd w_eigenvalues = w_solver.eigenvalues();
+	auto tolerance = std::max(w_eigenvalues.maxCoeff(), 0.0) * m *
+	                 std::numeric_limits<float64_t>::epsilon();
+	for (index_t i = 0; i < m; i++)
+	{
+		w_eigenvalues[i] = w_eigenvalues[i] > tolerance
+		                       ? 1.0 / std::sqrt(w_eigenvalues[i])
+		                       : 0.0;
+	}
+	MatrixXd W_inv_sqrt = w_solver.eigenvectors() *
+	                      w_eigenvalues.asDiagonal() *
+	                      w_solver.eigenvectors().transpose();
+
+	// centered Nystroem feature map of the training vectors, the kernel
+	// matrix is approximated by F*F^T, so its leading eigenvectors are
+	// given by the ones of F^T*F
+	MatrixXd F = C * W_inv_sqrt;
+	RowVectorXd F_mean = F.colwise().mean();
+	F.rowwise() -= F_mean;
+
+	SelfAdjointEigenSolver<MatrixXd> f_solver(F.transpose() * F);
+	MatrixXd V = f_solver.eigenvectors().rightCols(m_target_dim).rowwise().reverse();
+
+	m_transformation_matrix = SGMatrix<float64_t>(m, m_target_dim);
+	Map<MatrixXd> transformation(m_transformation_matrix.matrix, m, m_target_dim);
+	transformation = W_inv_sqrt * V;
+
+	m_bias_vector = SGVector<float64_t>(m_target_dim);
+	Map<VectorXd> bias(m_bias_vector.vector, m_target_dim);
+	bias = -V.transpose() * F_mean.transpose();
+	m_center_kernel = false;
 }
 
 CFeatures* CKernelPCA::transform(CFeatures* features, bool inplace)
@@ -149,17 +240,39 @@ SGMatrix<float64_t> CKernelPCA::apply_to_feature_matrix(CFeatures* features)
 {
 	assert_fitted();
 	int32_t n = m_init_features->get_num_vectors();
+	int32_t num_vectors = features->get_num_vectors();
+	int32_t num_dim = m_transformation_matrix.num_cols;
 
 	m_kernel->init(features, m_init_features);
-	auto kernel_matrix = m_kernel->get_kernel_matrix();
 
-	auto rows_sum = linalg::rowwise_sum(kernel_matrix);
-	linalg::add_vector(kernel_matrix, rows_sum, kernel_matrix, 1.0, -1.0 / n);
+	Map<MatrixXd> transformation(m_transformation_matrix.matrix, n, num_dim);
+	Map<VectorXd> bias(m_bias_vector.vector, num_dim);
+
+	SGMatrix<float64_t> new_feature_matrix(num_dim, num_vectors);
+	Map<MatrixXd> result(new_feature_matrix.matrix, num_dim, num_vectors);
+
+	// kernel rows are computed for a block of vectors at a time, which are
+	// then projected with a single matrix product
+	MatrixXd kernel_block(n, std::min(TRANSFORM_BLOCK_SIZE, num_vectors));
+	for (index_t start = 0; start < num_vectors; start += TRANSFORM_BLOCK_SIZE)
+	{
+		index_t block_size = std::min(TRANSFORM_BLOCK_SIZE, num_vectors - start);
+
+		#pragma omp parallel for num_threads(parallel->get_num_threads())
+		for (index_t i = 0; i < block_size; i++)
+		{
+			for (index_t j = 0; j < n; j++)
+				kernel_block(j, i) = m_kernel->kernel(start + i, j);
+		}
 
-	SGMatrix<float64_t> new_feature_matrix =
-	    linalg::matrix_prod(m_transformation_matrix, kernel_matrix, true, true);
+		auto block = kernel_block.leftCols(block_size);
+		if (m_center_kernel)
+			block.rowwise() -= block.colwise().mean();
 
-	linalg::add_vector(new_feature_matrix, m_bias_vector, new_feature_matrix);
+		result.middleCols(start, block_size).noalias() =
+		    transformation.transpose() * block;
+		result.middleCols(start, block_size).colwise() += bias;
+	}
 
 	m_kernel->cleanup();
 	return new_feature_matrix;
@@ -181,33 +294,7 @@ SGVector<float64_t> CKernelPCA::apply_to_feature_vector(SGVector<float64_t> vect
 
 CDenseFeatures<float64_t>* CKernelPCA::apply_to_string_features(CFeatures* features)
 {
-	assert_fitted();
-
-	int32_t num_vectors = features->get_num_vectors();
-	int32_t i,j,k;
-	int32_t n = m_transformation_matrix.num_cols;
-
-	m_kernel->init(features,m_init_features);
-
-	SGMatrix<float64_t> new_feature_matrix(m_target_dim * num_vectors);
-
-	for (i=0; i<num_vectors; i++)
-	{
-		for (j=0; j<m_target_dim; j++)
-			new_feature_matrix[i*m_target_dim+j] = m_bias_vector.vector[j];
-
-		for (j=0; j<n; j++)
-		{
-			float64_t kij = m_kernel->kernel(i,j);
-
-			for (k=0; k<m_target_dim; k++)
-				new_feature_matrix[k+i*m_target_dim] += kij*m_transformation_matrix.matrix[(n-k-1)*n+j];
-		}
-	}
-
-	m_kernel->cleanup();
-
-	return new CDenseFeatures<float64_t>(SGMatrix<float64_t>(new_feature_matrix,m_target_dim,num_vectors));
+	return new CDenseFeatures<float64_t>(apply_to_feature_matrix(features));
 }
 
 EFeatureClass CKernelPCA::get_feature_class()
@@ -243,3 +330,14 @@ CKernel* CKernelPCA::get_kernel() const
 	SG_REF(m_kernel);
 	return m_kernel;
 }
+
+void CKernelPCA::set_num_landmarks(int32_t num_landmarks)
+{
+	ASSERT(num_landmarks >= 0)
+	m_num_landmarks = num_landmarks;
+}
+
+int32_t CKernelPCA::get_num_landmarks() const
+{
+	return m_num_landmarks;
+}
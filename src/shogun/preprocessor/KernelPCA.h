@@ -27,6 +27,19 @@ class CKernel;
  * Advances in kernel methods support vector learning, 1327(3), 327-352. MIT Press.
  * Retrieved from http://citeseerx.ist.psu.edu/viewdoc/summary?doi=10.1.1.32.8744
  *
+ * By default the full kernel matrix of the training data is computed and
+ * its leading eigenvectors are found. If a number of landmarks is set with
+ * set_num_landmarks(), the kernel matrix is approximated using the Nystroem
+ * method from a random subset of the training vectors instead:
+ *
+ * Williams, C. K. I., & Seeger, M. (2001).
+ * Using the Nystroem method to speed up kernel machines.
+ * Advances in Neural Information Processing Systems 13, 682-688.
+ *
+ * which needs \f$O(nm)\f$ kernel evaluations and memory for \f$n\f$ vectors
+ * and \f$m\f$ landmarks, and only \f$m\f$ kernel evaluations to transform a
+ * vector.
+ *
  */
 class CKernelPCA : public CPreprocessor
 {
@@ -111,11 +124,28 @@ public:
 		 */
 		CKernel* get_kernel() const;
 
+		/** setter for number of landmarks of the Nystroem approximation
+		 * @param num_landmarks number of landmarks, 0 to use the full kernel
+		 * matrix
+		 */
+		void set_num_landmarks(int32_t num_landmarks);
+
+		/** getter for number of landmarks of the Nystroem approximation
+		 * @return number of landmarks
+		 */
+		int32_t get_num_landmarks() const;
+
 	protected:
 
 		/** default init */
 		void init();
 
+		/** fit using the full kernel matrix */
+		void fit_exact(CFeatures* features);
+
+		/** fit using the Nystroem approximation of the kernel matrix */
+		void fit_nystroem(CFeatures* features);
+
 	protected:
 
 		/** features used by init. needed for apply */
@@ -132,6 +162,14 @@ public:
 
 		/** kernel to be used */
 		CKernel* m_kernel;
+
+		/** number of landmarks of the Nystroem approximation */
+		int32_t m_num_landmarks;
+
+		/** whether kernel rows need to be centered when transforming, which is
+		 * not the case for the Nystroem approximation
+		 */
+		bool m_center_kernel;
 };
 }
 #endif
@@ -48,6 +48,9 @@ class CNormOne : public CDensePreprocessor<float64_t>
 		/// result in feature matrix
 		virtual SGVector<float64_t> apply_to_feature_vector(SGVector<float64_t> vector);
 
+		/** @return true, the preprocessor is applied column-wise in place */
+		virtual bool supports_inplace() const { return true; }
+
 		/** @return object name */
 		virtual const char* get_name() const { return "NormOne"; }
 
@@ -51,6 +51,9 @@ void CPCA::init()
 	m_method = AUTO;
 	m_eigenvalue_zero_tolerance=1e-15;
 	m_target_dim = 1;
+	m_oversampling = 10;
+	m_num_power_iterations = 2;
+	m_block_size = 1024;
 
 	SG_ADD(&m_transformation_matrix, "transformation_matrix",
 	    "Transformation matrix (Eigenvectors of covariance matrix).");
@@ -70,6 +73,12 @@ void CPCA::init()
 	SG_ADD(
 	    &m_target_dim, "target_dim", "target dimensionality of preprocessor",
 	    ParameterProperties::HYPER);
+	SG_ADD(&m_oversampling, "oversampling",
+	    "Extra dimensions of the random subspace of the randomized method");
+	SG_ADD(&m_num_power_iterations, "num_power_iterations",
+	    "Number of power iterations of the randomized method");
+	SG_ADD(&m_block_size, "block_size",
+	    "Number of vectors processed at once by the randomized method");
 }
 
 CPCA::~CPCA()
@@ -95,12 +104,21 @@ void CPCA::fit(CFeatures* features)
 	    m_target_dim <= max_dim_allowed,
 	    "target dimension should be less or equal to than minimum of N and D")
 
-	// center data
 	Map<MatrixXd> fmatrix(feature_matrix.matrix, num_features, num_vectors);
 
 	m_mean_vector = SGVector<float64_t>(num_features);
 	Map<VectorXd> data_mean(m_mean_vector.vector, num_features);
 	data_mean = fmatrix.rowwise().sum() / (float64_t)num_vectors;
+
+	if (m_method == RANDOMIZED)
+	{
+		// centers blocks on the fly, data is not modified
+		init_with_randomized(feature_matrix, max_dim_allowed);
+		m_fitted = true;
+		return;
+	}
+
+	// center data
 	fmatrix = fmatrix.colwise() - data_mean;
 
 	m_eigenvalues_vector = SGVector<float64_t>(max_dim_allowed);
@@ -275,6 +293,82 @@ void CPCA::init_with_svd(const SGMatrix<float64_t> &feature_matrix, int32_t max_
 	}
 }
 
+void CPCA::init_with_randomized(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed)
+{
+	REQUIRE(m_mode == FIXED_NUMBER,
+	    "Randomized PCA only supports FIXED_NUMBER mode\n");
+	REQUIRE(m_block_size > 0, "Block size (%d) must be positive\n", m_block_size);
+
+	int32_t num_vectors = feature_matrix.num_cols;
+	int32_t num_features = feature_matrix.num_rows;
+	num_dim = m_target_dim;
+	num_old_dim = num_features;
+	auto subspace_dim = std::min(num_dim + std::max(m_oversampling, 0), max_dim_allowed);
+
+	Map<MatrixXd> fmatrix(feature_matrix.matrix, num_features, num_vectors);
+	Map<VectorXd> data_mean(m_mean_vector.vector, num_features);
+
+	// multiplies with the (unnormalized) covariance, one centered block
+	// of vectors at a time
+	auto covariance_prod = [&](const MatrixXd& Q) {
+		MatrixXd Z = MatrixXd::Zero(num_features, Q.cols());
+		for (index_t start = 0; start < num_vectors; start += m_block_size)
+		{
+			auto block_size = std::min(m_block_size, num_vectors - start);
+			MatrixXd block = fmatrix.middleCols(start, block_size).colwise() - data_mean;
+			Z.noalias() += block * (block.transpose() * Q);
+		}
+		return Z;
+	};
+	auto orthonormalize = [&](const MatrixXd& Z) -> MatrixXd {
+		HouseholderQR<MatrixXd> qr(Z);
+		return qr.householderQ() * MatrixXd::Identity(num_features, Z.cols());
+	};
+
+	SG_INFO("Computing %d dimensional subspace\n", subspace_dim)
+	MatrixXd Q(num_features, subspace_dim);
+	for (index_t i = 0; i < Q.size(); i++)
+		Q.data()[i] = CMath::randn_double();
+
+	for (int32_t i = 0; i <= m_num_power_iterations; i++)
+		Q = orthonormalize(covariance_prod(Q));
+
+	// covariance projected onto the subspace
+	MatrixXd B = Q.transpose() * covariance_prod(Q);
+	B /= (num_vectors - 1);
+	SelfAdjointEigenSolver<MatrixXd> eigenSolve(B);
+
+	// eigenvalues are in increasing order, store them decreasing like SVD
+	m_eigenvalues_vector = SGVector<float64_t>(num_dim);
+	Map<VectorXd> eigenValues(m_eigenvalues_vector.vector, num_dim);
+	eigenValues = eigenSolve.eigenvalues().tail(num_dim).reverse();
+
+	SG_INFO("Reducing from %i to %i features\n", num_features, num_dim)
+	m_transformation_matrix = SGMatrix<float64_t>(num_features, num_dim);
+	Map<MatrixXd> transformMatrix(m_transformation_matrix.matrix, num_features, num_dim);
+	transformMatrix = Q * eigenSolve.eigenvectors().rightCols(num_dim).rowwise().reverse();
+
+	if (m_whitening)
+	{
+		for (int32_t i = 0; i < num_dim; i++)
+		{
+			if (CMath::fequals_abs<float64_t>(0.0, eigenValues[i], m_eigenvalue_zero_tolerance))
+			{
+				SG_WARNING("Covariance matrix has almost zero Eigenvalue (ie "
+					"Eigenvalue within a tolerance of %E around 0) at "
+					"dimension %d. Consider reducing its dimension.",
+					m_eigenvalue_zero_tolerance, i + 1)
+
+				transformMatrix.col(i) = MatrixXd::Zero(num_features, 1);
+				continue;
+			}
+
+			transformMatrix.col(i) /=
+			    std::sqrt(eigenValues[i] * (num_vectors - 1));
+		}
+	}
+}
+
 void CPCA::cleanup()
 {
 	m_transformation_matrix=SGMatrix<float64_t>();
@@ -395,3 +489,21 @@ int32_t CPCA::get_target_dim() const
 {
 	return m_target_dim;
 }
+
+void CPCA::set_oversampling(int32_t oversampling)
+{
+	ASSERT(oversampling >= 0)
+	m_oversampling = oversampling;
+}
+
+void CPCA::set_num_power_iterations(int32_t num_iterations)
+{
+	ASSERT(num_iterations >= 0)
+	m_num_power_iterations = num_iterations;
+}
+
+void CPCA::set_block_size(int32_t block_size)
+{
+	ASSERT(block_size > 0)
+	m_block_size = block_size;
+}
@@ -29,7 +29,13 @@ enum EPCAMethod
 	/** Eigenvalue decomposition of covariance matrix.
 	 * Time complexity ~10d^3 (d-dimensions n-number of vectors)
 	 */
-	EVD = 30
+	EVD = 30,
+	/** Randomized subspace iteration on the covariance matrix, which only
+	 * supports FIXED_NUMBER mode. The data is streamed in blocks of vectors
+	 * and memory is ~D(T+P) (P oversampling), time complexity ~DN(T+P)
+	 * per pass over the data.
+	 */
+	RANDOMIZED = 40
 };
 
 /** mode of pca */
@@ -83,7 +89,17 @@ enum EPCAMemoryMode
  * using the formula \f$e_i = \frac{\sqrt{d_i}}{N-1}\f$.
  * The time complexity of this method is \f$~14DN^2\f$ and should be used when N < D.
  *
- * <em>AUTO</em> : This mode automagically chooses one of the above modes for the user
+ * <em>RANDOMIZED</em> : Randomized range finder with power iterations
+ * (Halko et al., 2011) applied to the covariance matrix. Starting from a
+ * random Gaussian \f$D\times(T+P)\f$ matrix, each pass over the data
+ * multiplies it with \f$XX^T\f$ one block of vectors at a time and
+ * orthonormalizes the result. The eigenvectors are then taken from the
+ * projection of the covariance onto this subspace. Neither the covariance
+ * nor a copy of the data is formed, so this is meant for the leading
+ * components of large data, in FIXED_NUMBER mode only. The eigenvalues
+ * vector then only contains the T leading eigenvalues.
+ *
+ * <em>AUTO</em> : This mode automagically chooses one of the EVD and SVD modes for the user
  * based on whether N > D (chooses EVD) or N < D (chooses SVD).
  *
  * This class provides 3 modes to determine the value of T :
@@ -188,6 +204,23 @@ class CPCA : public CDensePreprocessor<float64_t>
 		 */
 		int32_t get_target_dim() const;
 
+		/** set number of extra dimensions of the random subspace used by
+		 * the RANDOMIZED method
+		 * @param oversampling number of extra dimensions
+		 */
+		void set_oversampling(int32_t oversampling);
+
+		/** set number of power iterations of the RANDOMIZED method, more
+		 * iterations give more accurate results if the spectrum decays slowly
+		 * @param num_iterations number of power iterations
+		 */
+		void set_num_power_iterations(int32_t num_iterations);
+
+		/** set number of vectors processed at once by the RANDOMIZED method
+		 * @param block_size number of vectors per block
+		 */
+		void set_block_size(int32_t block_size);
+
 	protected:
 
 		void init();
@@ -225,11 +258,24 @@ class CPCA : public CDensePreprocessor<float64_t>
 		/** target dimension */
 		int32_t m_target_dim;
 
+		/** oversampling of the RANDOMIZED method */
+		int32_t m_oversampling;
+
+		/** number of power iterations of the RANDOMIZED method */
+		int32_t m_num_power_iterations;
+
+		/** block size of the RANDOMIZED method */
+		int32_t m_block_size;
+
 	private:
 		/** Computes the transformation matrix using an eigenvalue decomposition. */
 		void init_with_evd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
 		/** Computes the transformation matrix using svd */
 		void init_with_svd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
+		/** Computes the transformation matrix using randomized subspace
+		 * iteration on the uncentered feature matrix
+		 */
+		void init_with_randomized(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
 };
 }
 #endif // PCA_H_
@@ -146,6 +146,24 @@ SGVector<float64_t> CPruneVarSubMean::apply_to_feature_vector(SGVector<float64_t
 	return out;
 }
 
+bool CPruneVarSubMean::get_affine_form(SGVector<int32_t>& idx,
+	SGVector<float64_t>& scale, SGVector<float64_t>& shift)
+{
+	assert_fitted();
+
+	idx = m_idx.clone();
+	scale = SGVector<float64_t>(m_num_idx);
+	shift = SGVector<float64_t>(m_num_idx);
+
+	for (auto i : range(m_num_idx))
+	{
+		scale[i] = m_divide_by_std ? 1.0 / m_std[i] : 1.0;
+		shift[i] = -m_mean[i] * scale[i];
+	}
+
+	return true;
+}
+
 void CPruneVarSubMean::init()
 {
 	m_fitted = false;
@@ -45,6 +45,20 @@ class CPruneVarSubMean : public CDensePreprocessor<float64_t>
 		/// result in feature matrix
 		virtual SGVector<float64_t> apply_to_feature_vector(SGVector<float64_t> vector);
 
+		/** @return true, the preprocessor is applied column-wise in place */
+		virtual bool supports_inplace() const { return true; }
+
+		/** the preprocessor as affine map on the features with non-zero
+		 * variance, \f$y_i = (x_{idx_i} - mean_i)/std_i\f$
+		 *
+		 * @param idx indices of the kept features
+		 * @param scale inverse standard deviations (or ones)
+		 * @param shift negative scaled means
+		 * @return true
+		 */
+		virtual bool get_affine_form(SGVector<int32_t>& idx,
+			SGVector<float64_t>& scale, SGVector<float64_t>& shift);
+
 		/** @return object name */
 		virtual const char* get_name() const { return "PruneVarSubMean"; }
 
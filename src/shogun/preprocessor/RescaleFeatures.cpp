@@ -102,6 +102,22 @@ SGVector<float64_t> CRescaleFeatures::apply_to_feature_vector(SGVector<float64_t
 	return SGVector<float64_t>(ret,vector.vlen);
 }
 
+bool CRescaleFeatures::get_affine_form(SGVector<int32_t>& idx,
+	SGVector<float64_t>& scale, SGVector<float64_t>& shift)
+{
+	assert_fitted();
+
+	idx = SGVector<int32_t>(m_min.vlen);
+	idx.range_fill();
+	scale = m_range.clone();
+	shift = SGVector<float64_t>(m_min.vlen);
+
+	for (auto i : range(m_min.vlen))
+		shift[i] = -m_min[i] * m_range[i];
+
+	return true;
+}
+
 void CRescaleFeatures::register_parameters()
 {
 	SG_ADD(&m_min, "min", "minimum values of each feature");
@@ -51,6 +51,22 @@ namespace shogun
 		virtual SGVector<float64_t>
 		apply_to_feature_vector(SGVector<float64_t> vector);
 
+		/** @return true, the preprocessor is applied column-wise in place */
+		virtual bool supports_inplace() const
+		{
+			return true;
+		}
+
+		/** the rescaling as affine map \f$y_i = (x_i - min_i)/range_i\f$
+		 *
+		 * @param idx identity indices
+		 * @param scale inverse ranges
+		 * @param shift negative scaled minima
+		 * @return true
+		 */
+		virtual bool get_affine_form(SGVector<int32_t>& idx,
+			SGVector<float64_t>& scale, SGVector<float64_t>& shift);
+
 		/** @return object name */
 		virtual const char* get_name() const
 		{
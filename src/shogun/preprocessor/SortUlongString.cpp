@@ -44,12 +44,12 @@ bool CSortUlongString::save(FILE* f)
 
 void CSortUlongString::apply_to_string_list(SGStringList<uint64_t> string_list)
 {
-	for (auto i : range(string_list.num_strings))
+	// strings are sorted independently, radix_sort keeps its state per thread
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(parallel->get_num_threads())
+	for (index_t i=0; i<string_list.num_strings; i++)
 	{
 		auto& vec = string_list.strings[i];
 
-		SG_DEBUG("sorting string of length %i\n", vec.slen);
-
 		//CMath::qsort(vec, len);
 		CMath::radix_sort(vec.string, vec.slen);
 	}
@@ -43,9 +43,10 @@ bool CSortWordString::save(FILE* f)
 
 void CSortWordString::apply_to_string_list(SGStringList<uint16_t> string_list)
 {
-	for (auto i : range(string_list.num_strings))
+	// strings are sorted independently, radix_sort keeps its state per thread
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(parallel->get_num_threads())
+	for (index_t i=0; i<string_list.num_strings; i++)
 	{
-		int32_t len = 0 ;
 		auto& vec = string_list.strings[i];
 
 		//CMath::qsort(vec, len);
@@ -31,10 +31,12 @@
 
 #include <vector>
 #include <memory>
+#include <future>
 #include <type_traits>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/kernel/CustomKernel.h>
 #include <shogun/kernel/CombinedKernel.h>
+#include <shogun/kernel/GaussianKernel.h>
 #include <shogun/features/Features.h>
 #include <shogun/statistical_testing/TestEnums.h>
 #include <shogun/statistical_testing/MMD.h>
@@ -45,6 +47,7 @@
 #include <shogun/statistical_testing/internals/DataManager.h>
 #include <shogun/statistical_testing/internals/KernelManager.h>
 #include <shogun/statistical_testing/internals/ComputationManager.h>
+#include <shogun/statistical_testing/internals/GaussianBlockKernel.h>
 #include <shogun/statistical_testing/internals/mmd/ComputeMMD.h>
 #include <shogun/statistical_testing/internals/mmd/WithinBlockDirect.h>
 #include <shogun/statistical_testing/internals/mmd/WithinBlockPermutation.h>
@@ -62,6 +65,8 @@ struct CStreamingMMD::Self
 	void create_computation_jobs();
 
 	void merge_samples(NextSamples&, std::vector<CFeatures*>&) const;
+	std::future<NextSamples> prefetch(DataManager&, bool) const;
+	SGMatrix<float32_t> compute_kernel(CFeatures*, CKernel*) const;
 	void compute_kernel(ComputationManager&, std::vector<CFeatures*>&, CKernel*) const;
 	void compute_jobs(ComputationManager&) const;
 
@@ -145,6 +150,31 @@ void CStreamingMMD::Self::merge_samples(NextSamples& next_burst, std::vector<CFe
 	next_burst.clear();
 }
 
+std::future<NextSamples> CStreamingMMD::Self::prefetch(DataManager& data_mgr, bool overlap) const
+{
+	// the next burst is fetched while the current one is being processed,
+	// the merged blocks of the current burst do not share any state with it.
+	// streamed samples may be drawn from the global random generator, so
+	// computations using random permutations have to fetch in order instead
+	auto policy=overlap ? std::launch::async : std::launch::deferred;
+	return std::async(policy, [&data_mgr]() { return data_mgr.next(); });
+}
+
+SGMatrix<float32_t> CStreamingMMD::Self::compute_kernel(CFeatures* block, CKernel* kernel) const
+{
+	if (GaussianBlockKernel::is_supported(kernel, block))
+	{
+		GaussianBlockKernel gaussian(static_cast<CGaussianKernel*>(kernel)->get_width());
+		return gaussian(block);
+	}
+
+	auto kernel_clone=std::unique_ptr<CKernel>(static_cast<CKernel*>(kernel->clone()));
+	kernel_clone->init(block, block);
+	auto kernel_matrix=kernel_clone->get_kernel_matrix<float32_t>();
+	kernel_clone->remove_lhs_and_rhs();
+	return kernel_matrix;
+}
+
 void CStreamingMMD::Self::compute_kernel(ComputationManager& cm, std::vector<CFeatures*>& blocks, CKernel* kernel) const
 {
 	REQUIRE(kernel->get_kernel_type()!=K_CUSTOM, "Underlying kernel cannot be custom!\n");
@@ -154,10 +184,7 @@ void CStreamingMMD::Self::compute_kernel(ComputationManager& cm, std::vector<CFe
 	{
 		try
 		{
-			auto kernel_clone=std::unique_ptr<CKernel>(static_cast<CKernel*>(kernel->clone()));
-			kernel_clone->init(blocks[i], blocks[i]);
-			cm.data(i)=kernel_clone->get_kernel_matrix<float32_t>();
-			kernel_clone->remove_lhs_and_rhs();
+			cm.data(i)=compute_kernel(blocks[i], kernel);
 		}
 		catch (ShogunException e)
 		{
@@ -201,6 +228,7 @@ std::pair<float64_t, float64_t> CStreamingMMD::Self::compute_statistic_variance(
 		while (!next_burst.empty())
 		{
 			merge_samples(next_burst, blocks);
+			auto prefetched_burst=prefetch(data_mgr, variance_estimation_method!=VEM_PERMUTATION);
 			compute_kernel(cm, blocks, kernel);
 			blocks.resize(0);
 			compute_jobs(cm);
@@ -234,7 +262,7 @@ std::pair<float64_t, float64_t> CStreamingMMD::Self::compute_statistic_variance(
 					variance_term_counter++;
 				}
 			}
-			next_burst=data_mgr.next();
+			next_burst=prefetched_burst.get();
 		}
 		cm.done();
 	}
@@ -270,9 +298,13 @@ std::pair<SGVector<float64_t>, SGMatrix<float64_t> > CStreamingMMD::Self::comput
 	std::fill(term_counters_Q.data(), term_counters_Q.data()+term_counters_Q.size(), 1);
 
 	DataManager& data_mgr=owner.get_data_mgr();
-	ComputationManager cm;
-	create_computation_jobs();
-	cm.enqueue_job(statistic_job);
+	create_statistic_job();
+
+	for (auto k=0; k<num_kernels; ++k)
+	{
+		REQUIRE(kernel_selection_mgr.kernel_at(k)->get_kernel_type()!=K_CUSTOM,
+			"Underlying kernel cannot be custom!\n");
+	}
 
 	data_mgr.start();
 	auto next_burst=data_mgr.next();
@@ -285,13 +317,32 @@ std::pair<SGVector<float64_t>, SGMatrix<float64_t> > CStreamingMMD::Self::comput
 				"The number of blocks per burst (%d this burst) has to be even!\n",
 				num_blocks);
 		merge_samples(next_burst, blocks);
+		auto prefetched_burst=prefetch(data_mgr, true);
 		std::for_each(blocks.begin(), blocks.end(), [](CFeatures* ptr) { SG_REF(ptr); });
+		for (auto k=0; k<num_kernels; ++k)
+			mmds[k].resize(num_blocks);
+
+		// kernels and blocks are processed together, so that all the threads
+		// are busy even when there are only a few blocks per burst
+		const int64_t num_jobs=int64_t(num_kernels)*num_blocks;
+#pragma omp parallel for schedule(dynamic)
+		for (int64_t job=0; job<num_jobs; ++job)
+		{
+			const index_t k=job/num_blocks;
+			const index_t i=job%num_blocks;
+			try
+			{
+				auto kernel_matrix=compute_kernel(blocks[i], kernel_selection_mgr.kernel_at(k));
+				mmds[k][i]=statistic_job(kernel_matrix);
+			}
+			catch (ShogunException& e)
+			{
+				SG_SERROR("%s, Try using less number of blocks per burst!\n", e.what());
+			}
+		}
+
 		for (auto k=0; k<num_kernels; ++k)
 		{
-			CKernel* kernel=kernel_selection_mgr.kernel_at(k);
-			compute_kernel(cm, blocks, kernel);
-			compute_jobs(cm);
-			mmds[k]=cm.result(0);
 			for (auto i=0; i<num_blocks; ++i)
 			{
 				auto delta=mmds[k][i]-statistic[k];
@@ -312,12 +363,11 @@ std::pair<SGVector<float64_t>, SGMatrix<float64_t> > CStreamingMMD::Self::comput
 				Q(j, i)=Q(i, j);
 			}
 		}
-		next_burst=data_mgr.next();
+		next_burst=prefetched_burst.get();
 	}
 	mmds.clear();
 
 	data_mgr.end();
-	cm.done();
 
 	std::for_each(statistic.data(), statistic.data()+statistic.size(), [this](float64_t val)
 	{
@@ -352,6 +402,7 @@ SGVector<float64_t> CStreamingMMD::Self::sample_null()
 	while (!next_burst.empty())
 	{
 		merge_samples(next_burst, blocks);
+		auto prefetched_burst=prefetch(data_mgr, false);
 		compute_kernel(cm, blocks, kernel);
 		blocks.resize(0);
 
@@ -366,7 +417,7 @@ SGVector<float64_t> CStreamingMMD::Self::sample_null()
 				term_counters[j]++;
 			}
 		}
-		next_burst=data_mgr.next();
+		next_burst=prefetched_burst.get();
 	}
 
 	data_mgr.end();
@@ -0,0 +1,63 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/io/SGIO.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/Kernel.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/normalizer/IdentityKernelNormalizer.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/statistical_testing/internals/GaussianBlockKernel.h>
+
+using namespace shogun;
+using namespace internal;
+
+bool GaussianBlockKernel::is_supported(CKernel* kernel, CFeatures* block)
+{
+	if (kernel==nullptr || block==nullptr || kernel->get_kernel_type()!=K_GAUSSIAN)
+		return false;
+
+	// CGaussianShortRealKernel reports K_GAUSSIAN as well, but is no
+	// CGaussianKernel, whose width the caller relies on
+	if (dynamic_cast<CGaussianKernel*>(kernel)==nullptr)
+		return false;
+
+	if (block->get_feature_class()!=C_DENSE || block->get_feature_type()!=F_DREAL)
+		return false;
+
+	auto normalizer=kernel->get_normalizer();
+	bool identity=dynamic_cast<CIdentityKernelNormalizer*>(normalizer)!=nullptr;
+	SG_UNREF(normalizer);
+	return identity;
+}
+
+GaussianBlockKernel::GaussianBlockKernel(float64_t width) : m_width(width)
+{
+	REQUIRE(width>0, "Kernel width (%f) must be positive!\n", width);
+}
+
+SGMatrix<float32_t> GaussianBlockKernel::operator()(CFeatures* block) const
+{
+	auto dense=static_cast<CDenseFeatures<float64_t>*>(block);
+	SGMatrix<float64_t> data=dense->get_feature_matrix();
+	const index_t size=data.num_cols;
+
+	Eigen::Map<const Eigen::MatrixXd> X(data.matrix, data.num_rows, data.num_cols);
+	Eigen::VectorXd sq_norms=X.colwise().squaredNorm().transpose();
+
+	// ||x_i-x_j||^2=||x_i||^2+||x_j||^2-2<x_i,x_j>, the Gram matrix being the
+	// only quadratic term
+	Eigen::MatrixXd dist(size, size);
+	dist.noalias()=-2.0*X.transpose()*X;
+	dist.colwise()+=sq_norms;
+	dist.rowwise()+=sq_norms.transpose();
+
+	SGMatrix<float32_t> kernel_matrix(size, size);
+	Eigen::Map<Eigen::MatrixXf> K(kernel_matrix.matrix, size, size);
+	K=(-dist.array()*(1.0/m_width)).exp().cast<float32_t>();
+	K.diagonal().setOnes();
+
+	return kernel_matrix;
+}
@@ -0,0 +1,57 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef GAUSSIAN_BLOCK_KERNEL_H__
+#define GAUSSIAN_BLOCK_KERNEL_H__
+
+#include <shogun/lib/common.h>
+
+namespace shogun
+{
+
+class CKernel;
+class CFeatures;
+template <typename T> class SGMatrix;
+
+namespace internal
+{
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/**
+ * @brief Computes the Gaussian kernel matrix of a block of dense samples at
+ * once. The pairwise squared distances are obtained from the Gram matrix of
+ * the block, which is a single matrix product, and the exponential is
+ * applied element-wise, instead of evaluating the kernel for every pair.
+ */
+class GaussianBlockKernel
+{
+public:
+	/**
+	 * @param kernel the kernel
+	 * @param block the samples
+	 * @return whether the kernel matrix of the kernel on the block can be
+	 * computed by this class, which is the case for Gaussian kernels without
+	 * normalization on dense real features
+	 */
+	static bool is_supported(CKernel* kernel, CFeatures* block);
+
+	/**
+	 * @param width the width of the Gaussian kernel
+	 */
+	explicit GaussianBlockKernel(float64_t width);
+
+	/**
+	 * @param block the samples, has to be dense real features
+	 * @return the kernel matrix of the samples
+	 */
+	SGMatrix<float32_t> operator()(CFeatures* block) const;
+private:
+	float64_t m_width;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+}
+
+}
+#endif // GAUSSIAN_BLOCK_KERNEL_H__
@@ -34,6 +34,7 @@
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/GPUMatrix.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/statistical_testing/MMD.h>
 #include <shogun/statistical_testing/TestEnums.h>
 #include <shogun/statistical_testing/internals/mmd/WithinBlockPermutation.h>
@@ -43,58 +44,47 @@ using namespace internal;
 using namespace mmd;
 
 WithinBlockPermutation::WithinBlockPermutation(index_t nx, index_t ny, EStatisticType type)
-: n_x(nx), n_y(ny), stype(type), terms()
+: n_x(nx), n_y(ny), stype(type)
 {
 	SG_SDEBUG("number of samples are %d and %d!\n", n_x, n_y);
-	permuted_inds=SGVector<index_t>(n_x+n_y);
-	inverted_permuted_inds=SGVector<index_t>(permuted_inds.vlen);
-}
-
-void WithinBlockPermutation::add_term(float32_t val, index_t i, index_t j)
-{
-	if (i<n_x && j<n_x && i<=j)
-	{
-		SG_SDEBUG("Adding Kernel(%d,%d)=%f to term_0!\n", i, j, val);
-		terms.term[0]+=val;
-		if (i==j)
-			terms.diag[0]+=val;
-	}
-	else if (i>=n_x && j>=n_x && i<=j)
-	{
-		SG_SDEBUG("Adding Kernel(%d,%d)=%f to term_1!\n", i, j, val);
-		terms.term[1]+=val;
-		if (i==j)
-			terms.diag[1]+=val;
-	}
-	else if (i>=n_x && j<n_x)
-	{
-		SG_SDEBUG("Adding Kernel(%d,%d)=%f to term_2!\n", i, j, val);
-		terms.term[2]+=val;
-		if (i-n_x==j)
-			terms.diag[2]+=val;
-	}
 }
 
 float32_t WithinBlockPermutation::operator()(const SGMatrix<float32_t>& km)
 {
 	SG_SDEBUG("Entering!\n");
 
+	// the same instance is used for all blocks of a burst in parallel, so
+	// the buffers are local
+	SGVector<index_t> permuted_inds(n_x+n_y);
+	terms_t terms;
 	std::iota(permuted_inds.vector, permuted_inds.vector+permuted_inds.vlen, 0);
 	CMath::permute(permuted_inds);
-	for (int i=0; i<permuted_inds.vlen; ++i)
-		inverted_permuted_inds[permuted_inds[i]]=i;
 
-	std::fill(&terms.term[0], &terms.term[2]+1, 0);
-	std::fill(&terms.diag[0], &terms.diag[2]+1, 0);
+	// the first n_x permuted indices are the samples from p. the sums over
+	// the blocks of the permuted kernel matrix are computed using matrix
+	// products with the membership vectors of the permuted samples instead
+	// of visiting the entries one by one
+	const index_t size=n_x+n_y;
+	Eigen::Map<const Eigen::MatrixXf> map(km.matrix, km.num_rows, km.num_cols);
+	Eigen::MatrixXf membership=Eigen::MatrixXf::Zero(size, 2);
+	for (auto i=0; i<n_x; ++i)
+		membership(permuted_inds[i], 0)=1;
+	for (auto i=n_x; i<size; ++i)
+		membership(permuted_inds[i], 1)=1;
 
-	for (auto j=0; j<n_x+n_y; ++j)
-	{
-		for (auto i=0; i<n_x+n_y; ++i)
-			add_term(km(i, j), inverted_permuted_inds[i], inverted_permuted_inds[j]);
-	}
+	Eigen::MatrixXd block_sums=(map*membership).cast<float64_t>().transpose()*membership.cast<float64_t>();
+
+	std::fill(&terms.diag[0], &terms.diag[2]+1, 0);
+	for (auto i=0; i<n_x; ++i)
+		terms.diag[0]+=km(permuted_inds[i], permuted_inds[i]);
+	for (auto i=n_x; i<size; ++i)
+		terms.diag[1]+=km(permuted_inds[i], permuted_inds[i]);
+	for (auto i=0; i<n_x && n_x+i<size; ++i)
+		terms.diag[2]+=km(permuted_inds[n_x+i], permuted_inds[i]);
 
-	terms.term[0]=2*(terms.term[0]-terms.diag[0]);
-	terms.term[1]=2*(terms.term[1]-terms.diag[1]);
+	terms.term[0]=block_sums(0, 0)-terms.diag[0];
+	terms.term[1]=block_sums(1, 1)-terms.diag[1];
+	terms.term[2]=block_sums(0, 1);
 	SG_SDEBUG("term_0 sum (without diagonal) = %f!\n", terms.term[0]);
 	SG_SDEBUG("term_1 sum (without diagonal) = %f!\n", terms.term[1]);
 	if (stype!=ST_BIASED_FULL)
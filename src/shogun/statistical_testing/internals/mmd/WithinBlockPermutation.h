@@ -56,19 +56,14 @@ public:
 	return_type operator()(const SGMatrix<return_type>& kernel_matrix);
 //	return_type operator()(const CGPUMatrix<return_type>& kernel_matrix);
 private:
-	void add_term(float32_t, index_t, index_t);
-
 	const index_t n_x;
 	const index_t n_y;
 	const EStatisticType stype;
-	SGVector<index_t> permuted_inds;
-	SGVector<index_t> inverted_permuted_inds;
 	struct terms_t
 	{
-		float32_t term[3];
-		float32_t diag[3];
+		float64_t term[3];
+		float64_t diag[3];
 	};
-	terms_t terms;
 };
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 }
@@ -21,6 +21,10 @@
 #include <ctype.h>
 #include <limits.h>
 
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace shogun;
 
 //#define USE_TMP_ARRAYCLASS
@@ -94,7 +98,8 @@ CDynProg::CDynProg(int32_t num_svms /*= 8 */)
 	  m_num_raw_data(0),
 
 	  m_long_transitions(true),
-	  m_long_transition_threshold(1000)
+	  m_long_transition_threshold(1000),
+	  m_beam_score_gap(CMath::INFTY)
 {
 	trans_list_forward = NULL ;
 	trans_list_forward_cnt = NULL ;
@@ -1006,14 +1011,11 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		SG_PRINT("\n")
 #endif
 
-		float64_t* svm_value = SG_MALLOC(float64_t , m_num_lin_feat_plifs_cum[m_num_raw_data]+m_num_intron_plifs);
-		{ // initialize svm_svalue
-			for (int32_t s=0; s<m_num_lin_feat_plifs_cum[m_num_raw_data]+m_num_intron_plifs; s++)
-				svm_value[s]=0 ;
-		}
+		const int32_t num_svm_values = m_num_lin_feat_plifs_cum[m_num_raw_data]+m_num_intron_plifs;
 
 		{ // convert seq_input to seq
 			// this is independent of the svm values
+			float64_t* svm_value = SG_CALLOC(float64_t, num_svm_values);
 
 			CDynamicArray<float64_t> *seq_input=NULL ; // 3d
 			if (seq_array!=NULL)
@@ -1134,11 +1136,14 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		long_transition_content_end_position.set_const(0) ;
 #endif
 
-		svm_value = SG_MALLOC(float64_t , m_num_lin_feat_plifs_cum[m_num_raw_data]+m_num_intron_plifs);
-		{ // initialize svm_svalue
-			for (int32_t s=0; s<m_num_lin_feat_plifs_cum[m_num_raw_data]+m_num_intron_plifs; s++)
-				svm_value[s]=0 ;
-		}
+		// states at one position are independent of each other and are
+		// computed in parallel, every thread using its own scratch buffers
+#if defined(DYNPROG_TIMING) || defined(DYNPROG_TIMING_DETAIL) || defined(DYNPROG_DEBUG)
+		const int32_t num_threads = 1 ;
+#else
+		const int32_t num_threads = CMath::max(1, CMath::min(parallel->get_num_threads(), m_N)) ;
+#endif
+		float64_t* svm_value_buf = SG_CALLOC(float64_t, num_threads*num_svm_values);
 
 		CDynamicArray<int32_t> look_back(m_N,m_N) ; // 2d
 		//CDynamicArray<int32_t> look_back_orig(m_N,m_N) ;
@@ -1290,10 +1295,12 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 	    CDynamicArray<int16_t> ktable_end(nbest);
 	    // ktable_end.set_const(0) ;
 
-	    float64_t* fixedtempvv = SG_MALLOC(float64_t, look_back_buflen);
-	    memset(fixedtempvv, 0, look_back_buflen * sizeof(float64_t));
-	    int32_t* fixedtempii = SG_MALLOC(int32_t, look_back_buflen);
-	    memset(fixedtempii, 0, look_back_buflen * sizeof(int32_t));
+	    // at most nbest candidates are kept per state
+	    float64_t* fixedtempvv_buf = SG_CALLOC(float64_t, num_threads*nbest);
+	    int32_t* fixedtempii_buf = SG_CALLOC(int32_t, num_threads*nbest);
+
+	    // best score per position, used as reference for beam pruning
+	    SGVector<float64_t> best_delta(m_seq_len);
 
 	    CDynamicArray<float64_t> oldtempvv(look_back_buflen);
 
@@ -1341,11 +1348,6 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		path_ends.display_size() ;
 		ktable_end.display_size() ;
 
-#ifdef USE_TMP_ARRAYCLASS
-		fixedtempvv.display_size() ;
-		fixedtempii.display_size() ;
-#endif
-
 		//oldtempvv.display_size() ;
 		//oldtempii.display_size() ;
 
@@ -1412,13 +1414,27 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 			}
 		}
 
+		best_delta[0] = -CMath::INFTY ;
+		for (T_STATES i=0; i<m_N; i++)
+			best_delta[0] = CMath::max(best_delta[0], delta.element(delta_array, 0, i, 0, m_seq_len, m_N)) ;
+
 		SG_DEBUG("START_RECURSION \n\n")
 
 		// recursion
 		for (int32_t t=1; t<m_seq_len; t++)
 		{
-			for (T_STATES j=0; j<m_N; j++)
+			#pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+			for (int32_t j=0; j<m_N; j++)
 			{
+#ifdef HAVE_OPENMP
+				const int32_t thread_num = omp_get_thread_num() ;
+#else
+				const int32_t thread_num = 0 ;
+#endif
+				float64_t* svm_value = svm_value_buf + thread_num*num_svm_values ;
+				float64_t* fixedtempvv = fixedtempvv_buf + thread_num*nbest ;
+				int32_t* fixedtempii = fixedtempii_buf + thread_num*nbest ;
+
 				if (seq.element(j,t)<=-1e20)
 				{ // if we cannot observe the symbol here, then we can omit the rest
 					for (int16_t k=0; k<nbest; k++)
@@ -1501,6 +1517,10 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 							else
 								ok=false ;
 
+							/* beam pruning: skip segment starts far below the best score at ts */
+							if (ok && delta.element(delta_array, ts, ii, 0, m_seq_len, m_N) < best_delta[ts]-m_beam_score_gap)
+								ok=false ;
+
 							if (ok)
 							{
 
@@ -1562,6 +1582,10 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 										if (with_loss)
 											val              += segment_loss ;
 
+										/* nbest scores are sorted, the remaining ones are pruned too */
+										if (delta.element(delta_array, ts, ii, diff, m_seq_len, m_N) < best_delta[ts]-m_beam_score_gap)
+											break ;
+
 										float64_t mval = -(val + delta.element(delta_array, ts, ii, diff, m_seq_len, m_N)) ;
 
 										/* only place -val in fixedtempvv if it is one of the nbest lowest values in there */
@@ -1901,6 +1925,10 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 					}
 				}
 			}
+
+			best_delta[t] = -CMath::INFTY ;
+			for (T_STATES j=0; j<m_N; j++)
+				best_delta[t] = CMath::max(best_delta[t], delta.element(delta_array, t, j, 0, m_seq_len, m_N)) ;
 		}
 		{ //termination
 			int32_t list_len = 0 ;
@@ -1975,8 +2003,9 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		SG_PRINT("Timing:  orf=%1.2f s \n Segment_init=%1.2f s Segment_pos=%1.2f s  Segment_extend=%1.2f s Segment_clean=%1.2f s\nsvm_init=%1.2f s  svm_pos=%1.2f  svm_clean=%1.2f\n  content_svm_values_time=%1.2f  content_plifs_time=%1.2f\ninner_loop_max_time=%1.2f inner_loop=%1.2f long_transition_time=%1.2f\n total=%1.2f\n", orf_time, segment_init_time, segment_pos_time, segment_extend_time, segment_clean_time, svm_init_time, svm_pos_time, svm_clean_time, content_svm_values_time, content_plifs_time, inner_loop_max_time, inner_loop_time, long_transition_time, MyTime2.time_diff_sec())
 #endif
 
-		SG_FREE(fixedtempvv);
-		SG_FREE(fixedtempii);
+		SG_FREE(fixedtempvv_buf);
+		SG_FREE(fixedtempii_buf);
+		SG_FREE(svm_value_buf);
 	}
 
 
@@ -478,6 +478,30 @@ public:
 		//m_long_transition_max = max_len;
 	}
 
+	/** set beam pruning score gap
+	 *
+	 * candidate segments starting at a position are only extended from
+	 * states whose score is within gap of the best score at that position,
+	 * which skips most content and PLiF lookups on long sequences. The
+	 * default of infinity disables pruning and keeps decoding exact.
+	 *
+	 * @param gap maximal score difference to the best state (>=0)
+	 */
+	void set_beam_score_gap(float64_t gap)
+	{
+		REQUIRE(gap>=0, "Beam score gap (%f) must be non-negative\n", gap)
+		m_beam_score_gap = gap;
+	}
+
+	/** get beam pruning score gap
+	 *
+	 * @return maximal score difference to the best state
+	 */
+	float64_t get_beam_score_gap() const
+	{
+		return m_beam_score_gap;
+	}
+
 protected:
 
 	/* helper functions */
@@ -755,6 +779,9 @@ protected:
 	 */
 	//int32_t m_long_transition_max ;
 
+	/** score gap for beam pruning of segment start states */
+	float64_t m_beam_score_gap;
+
 	/**default values defining the k-mer degrees
 	 * used for content type prediction
 	 */
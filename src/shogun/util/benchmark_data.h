@@ -0,0 +1,135 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef _BENCHMARK_DATA_H_
+#define _BENCHMARK_DATA_H_
+
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
+#include <shogun/lib/SGSparseVector.h>
+#include <shogun/lib/SGVector.h>
+
+#include <algorithm>
+#include <random>
+
+namespace shogun
+{
+
+/** Synthetic data for the benchmarks. Every generator draws from its own
+ * generator with a fixed seed, so the data is the same on every run and
+ * does not depend on the order in which the benchmarks are executed.
+ */
+namespace benchmark_data
+{
+
+/** default seed of the generators */
+static const uint32_t DEFAULT_SEED = 12345;
+
+/** Gaussian blobs: every class has a unit variance Gaussian around its own
+ * mean, the means are drawn with standard deviation 3
+ *
+ * @param num_features dimension of the data
+ * @param num_vectors number of vectors
+ * @param num_classes number of classes
+ * @param labels labels to be set, in {-1,+1} for two classes and
+ * 0,...,num_classes-1 otherwise
+ * @param seed seed of the generator
+ * @return data, shape = [num_features, num_vectors]
+ */
+inline SGMatrix<float64_t> gaussian_blobs(
+    index_t num_features, index_t num_vectors, index_t num_classes,
+    SGVector<float64_t>& labels, uint32_t seed = DEFAULT_SEED)
+{
+	std::mt19937_64 prng(seed);
+	std::normal_distribution<float64_t> normal;
+
+	SGMatrix<float64_t> means(num_features, num_classes);
+	for (index_t i = 0; i < means.num_rows * means.num_cols; ++i)
+		means.matrix[i] = 3 * normal(prng);
+
+	SGMatrix<float64_t> data(num_features, num_vectors);
+	labels = SGVector<float64_t>(num_vectors);
+	for (index_t j = 0; j < num_vectors; ++j)
+	{
+		index_t c = j % num_classes;
+		labels[j] = num_classes == 2 ? 2.0 * c - 1.0 : c;
+		for (index_t i = 0; i < num_features; ++i)
+			data(i, j) = means(i, c) + normal(prng);
+	}
+
+	return data;
+}
+
+/** Gaussian blobs of two classes, see gaussian_blobs() */
+inline SGMatrix<float64_t> binary_blobs(
+    index_t num_features, index_t num_vectors, SGVector<float64_t>& labels,
+    uint32_t seed = DEFAULT_SEED)
+{
+	return gaussian_blobs(num_features, num_vectors, 2, labels, seed);
+}
+
+/** Uniform data in [0,1)
+ *
+ * @param num_features dimension of the data
+ * @param num_vectors number of vectors
+ * @param seed seed of the generator
+ * @return data, shape = [num_features, num_vectors]
+ */
+inline SGMatrix<float64_t> uniform_matrix(
+    index_t num_features, index_t num_vectors, uint32_t seed = DEFAULT_SEED)
+{
+	std::mt19937_64 prng(seed);
+	std::uniform_real_distribution<float64_t> uniform;
+
+	SGMatrix<float64_t> data(num_features, num_vectors);
+	for (index_t i = 0; i < data.num_rows * data.num_cols; ++i)
+		data.matrix[i] = uniform(prng);
+
+	return data;
+}
+
+/** Sparse data with uniform entries in [0,1) at random positions
+ *
+ * @param num_features dimension of the data
+ * @param num_vectors number of vectors
+ * @param num_nonzeros number of non-zero entries of every vector
+ * @param seed seed of the generator
+ * @return data with num_vectors sparse vectors
+ */
+inline SGSparseMatrix<float64_t> sparse_matrix(
+    index_t num_features, index_t num_vectors, index_t num_nonzeros,
+    uint32_t seed = DEFAULT_SEED)
+{
+	std::mt19937_64 prng(seed);
+	std::uniform_real_distribution<float64_t> uniform;
+
+	SGSparseMatrix<float64_t> data(num_features, num_vectors);
+	SGVector<index_t> indices(num_features);
+	indices.range_fill();
+	for (index_t j = 0; j < num_vectors; ++j)
+	{
+		// first num_nonzeros entries of a partial Fisher-Yates shuffle
+		for (index_t i = 0; i < num_nonzeros; ++i)
+		{
+			std::uniform_int_distribution<index_t> pick(i, num_features - 1);
+			std::swap(indices[i], indices[pick(prng)]);
+		}
+		std::sort(indices.vector, indices.vector + num_nonzeros);
+
+		data[j] = SGSparseVector<float64_t>(num_nonzeros);
+		for (index_t i = 0; i < num_nonzeros; ++i)
+		{
+			data[j].features[i].feat_index = indices[i];
+			data[j].features[i].entry = uniform(prng);
+		}
+	}
+
+	return data;
+}
+
+} // namespace benchmark_data
+
+} // namespace shogun
+
+#endif /* _BENCHMARK_DATA_H_ */
@@ -12,6 +12,7 @@
 #include <shogun/io/SerializableAsciiFile.h>
 #include <shogun/kernel/GaussianKernel.h>
 #include <shogun/kernel/LinearKernel.h>
+#include <shogun/labels/BinaryLabels.h>
 #include <shogun/lib/DataType.h>
 #include <shogun/machine/gp/ExactInferenceMethod.h>
 #include <shogun/machine/gp/GaussianLikelihood.h>
@@ -278,6 +279,57 @@ TYPED_TEST(SGObjectClone, equals_other_has_null_param)
 	SG_UNREF(clone);
 }
 
+TYPED_TEST(SGObjectClone, shallow_clone_shares_data)
+{
+	auto obj = some<CCloneEqualsMock<TypeParam>>();
+	CSGObject* clone = obj->shallow_clone();
+	auto clone_casted = clone->as<CCloneEqualsMock<TypeParam>>();
+	ASSERT_NE(clone_casted, nullptr);
+	EXPECT_EQ(clone->ref_count(), 1);
+	EXPECT_TRUE(clone->equals(obj));
+
+	EXPECT_EQ(clone_casted->m_sg_vector.vector, obj->m_sg_vector.vector);
+	EXPECT_EQ(clone_casted->m_sg_matrix.matrix, obj->m_sg_matrix.matrix);
+	EXPECT_NE(clone_casted->m_object, obj->m_object);
+
+	SG_UNREF(clone);
+}
+
+TEST(SGObject, shallow_clone_copy_on_write)
+{
+	SGMatrix<float64_t> data(2, 4);
+	for (auto i : range(data.num_rows * data.num_cols))
+		data.matrix[i] = i;
+	SGVector<float64_t> lab(4);
+	lab.set_const(1);
+
+	auto feats = some<CDenseFeatures<float64_t>>(data);
+	auto labels = some<CBinaryLabels>(lab);
+
+	auto feats_clone = feats->shallow_clone()->as<CDenseFeatures<float64_t>>();
+	auto labels_clone = labels->shallow_clone()->as<CBinaryLabels>();
+	EXPECT_EQ(
+	    feats_clone->get_feature_matrix().matrix,
+	    feats->get_feature_matrix().matrix);
+	EXPECT_EQ(labels_clone->get_labels().vector, labels->get_labels().vector);
+
+	int32_t idx[] = {1, 3};
+	feats_clone->vector_subset(idx, 2);
+	labels_clone->set_label(0, -1);
+
+	EXPECT_EQ(feats_clone->get_num_vectors(), 2);
+	EXPECT_EQ(feats_clone->get_feature_vector(0)[0], 2);
+	EXPECT_EQ(labels_clone->get_label(0), -1);
+
+	EXPECT_EQ(feats->get_num_vectors(), 4);
+	for (auto i : range(data.num_rows * data.num_cols))
+		EXPECT_EQ(feats->get_feature_matrix().matrix[i], i);
+	EXPECT_EQ(labels->get_label(0), 1);
+
+	SG_UNREF(feats_clone);
+	SG_UNREF(labels_clone);
+}
+
 TEST(SGObject,DISABLED_ref_copy_constructor)
 {
 	CBinaryLabels* labs = new CBinaryLabels(10);
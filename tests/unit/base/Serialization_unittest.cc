@@ -8,10 +8,18 @@
 #include <gtest/gtest.h>
 #include <shogun/labels/BinaryLabels.h>
 #include <shogun/labels/MulticlassLabels.h>
+#include <shogun/labels/RegressionLabels.h>
 #include <shogun/io/SerializableAsciiFile.h>
+#include <shogun/io/SerializableBinaryFile.h>
 #include <shogun/classifier/svm/LibLinear.h>
 #include <shogun/features/DataGenerator.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <vector>
 
 using namespace shogun;
 
@@ -130,3 +138,119 @@ TEST(Serialization, liblinear)
 	SG_UNREF(pred);
 }
 #endif
+
+TEST(Serialization, binary_sparse_features)
+{
+	SGMatrix<float64_t> data(5, 30);
+	for (index_t i=0; i<data.num_rows*data.num_cols; ++i)
+		data.matrix[i]=i%3 ? 0 : CMath::randn_double();
+
+	CSparseFeatures<float64_t>* features=new CSparseFeatures<float64_t>(data);
+
+	const char* filename="sparse_features.bin";
+	CSerializableBinaryFile* file=new CSerializableBinaryFile(filename, 'w');
+	features->save_serializable(file);
+	SG_UNREF(file);
+
+	file=new CSerializableBinaryFile(filename, 'r');
+	CSparseFeatures<float64_t>* features_loaded=new CSparseFeatures<float64_t>();
+	EXPECT_TRUE(features_loaded->load_serializable(file));
+	SG_UNREF(file);
+
+	EXPECT_TRUE(features_loaded->get_full_feature_matrix().equals(data));
+
+	SG_UNREF(features_loaded);
+	SG_UNREF(features);
+}
+
+TEST(Serialization, binary_nested_objects)
+{
+	SGMatrix<float64_t> data(3, 10);
+	for (index_t i=0; i<data.num_rows*data.num_cols; ++i)
+		data.matrix[i]=CMath::randn_double();
+
+	SGVector<float64_t> lab(data.num_cols);
+	for (index_t i=0; i<lab.vlen; ++i)
+		lab[i]=i%2 ? 1.0 : -1.0;
+
+	CLibLinear* liblin=new CLibLinear();
+	liblin->set_features(new CDenseFeatures<float64_t>(data));
+	liblin->set_labels(new CBinaryLabels(lab));
+	SGVector<float64_t> w(data.num_rows);
+	w.random(-1.0, 1.0);
+	liblin->set_w(w);
+	liblin->set_bias(0.5);
+
+	const char* filename="nested_objects.bin";
+	CSerializableBinaryFile* file=new CSerializableBinaryFile(filename, 'w');
+	liblin->save_serializable(file);
+	SG_UNREF(file);
+
+	file=new CSerializableBinaryFile(filename, 'r');
+	CLibLinear* liblin_loaded=new CLibLinear();
+	EXPECT_TRUE(liblin_loaded->load_serializable(file));
+	SG_UNREF(file);
+
+	EXPECT_TRUE(liblin_loaded->get_w().equals(w));
+	EXPECT_EQ(liblin_loaded->get_bias(), 0.5);
+
+	CDenseFeatures<float64_t>* features_loaded=
+		liblin_loaded->get_features()->as<CDenseFeatures<float64_t>>();
+	EXPECT_TRUE(features_loaded->get_feature_matrix().equals(data));
+	SG_UNREF(features_loaded);
+
+	CBinaryLabels* labels_loaded=
+		liblin_loaded->get_labels()->as<CBinaryLabels>();
+	EXPECT_TRUE(labels_loaded->get_labels().equals(lab));
+	SG_UNREF(labels_loaded);
+
+	SG_UNREF(liblin_loaded);
+	SG_UNREF(liblin);
+}
+
+TEST(Serialization, binary_corrupt_length)
+{
+	SGVector<float64_t> lab(10);
+	lab.random(-1.0, 1.0);
+
+	CRegressionLabels* labels=new CRegressionLabels(lab);
+
+	const char* filename="corrupt_length.bin";
+	CSerializableBinaryFile* file=new CSerializableBinaryFile(filename, 'w');
+	labels->save_serializable(file);
+	SG_UNREF(file);
+
+	std::ifstream in(filename, std::ios::binary);
+	std::vector<char> buf((std::istreambuf_iterator<char>(in)),
+		std::istreambuf_iterator<char>());
+	in.close();
+
+	/* the length prefix sits right before the aligned block of labels */
+	const size_t nbytes=lab.vlen*sizeof(float64_t);
+	size_t data=0;
+	while (data+nbytes<=buf.size()
+		&& memcmp(&buf[data], lab.vector, nbytes)!=0)
+		data++;
+	ASSERT_LE(data+nbytes, buf.size());
+
+	size_t len_pos=data-sizeof(index_t);
+	while (len_pos>0 && *(index_t*) &buf[len_pos]!=lab.vlen)
+		len_pos--;
+	ASSERT_GT(len_pos, size_t(0));
+
+	/* a corrupt length must not be used to allocate */
+	const index_t huge_length=std::numeric_limits<index_t>::max();
+	memcpy(&buf[len_pos], &huge_length, sizeof(index_t));
+
+	std::ofstream out(filename, std::ios::binary);
+	out.write(buf.data(), buf.size());
+	out.close();
+
+	file=new CSerializableBinaryFile(filename, 'r');
+	CRegressionLabels* labels_loaded=new CRegressionLabels();
+	EXPECT_FALSE(labels_loaded->load_serializable(file));
+	SG_UNREF(file);
+
+	SG_UNREF(labels_loaded);
+	SG_UNREF(labels);
+}
@@ -0,0 +1,109 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/init.h>
+#include <shogun/classifier/svm/OnlineLibLinear.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/Math.h>
+
+using namespace shogun;
+
+class OnlineLibLinear : public ::testing::Test
+{
+public:
+	virtual void SetUp()
+	{
+		CMath::init_random(17);
+
+		// two Gaussian blobs, separated in the first two dimensions
+		index_t num_features = 10;
+		index_t num_vectors = 2000;
+		data = SGMatrix<float32_t>(num_features, num_vectors);
+		labels = SGVector<float64_t>(num_vectors);
+		for (index_t i = 0; i < num_vectors; i++)
+		{
+			labels[i] = i % 2 ? 1 : -1;
+			for (index_t j = 0; j < num_features; j++)
+				data(j, i) = CMath::randn_double() + (j < 2 ? 1.5 * labels[i] : 0);
+		}
+	}
+
+	/** @return machine trained on a stream of data */
+	COnlineLibLinear* train(bool hogwild)
+	{
+		CDenseFeatures<float32_t>* dense = new CDenseFeatures<float32_t>(data);
+		CStreamingDenseFeatures<float32_t>* features =
+		    new CStreamingDenseFeatures<float32_t>(dense, labels.vector);
+		SG_REF(features);
+
+		COnlineLibLinear* svm = new COnlineLibLinear(1.0);
+		SG_REF(svm);
+		svm->set_hogwild_enabled(hogwild);
+		svm->set_chunk_size(256);
+		svm->train(features);
+
+		SG_UNREF(features);
+		return svm;
+	}
+
+	/** @return training error of the machine on data */
+	float64_t training_error(COnlineLibLinear* svm)
+	{
+		CDenseFeatures<float32_t>* features = new CDenseFeatures<float32_t>(data);
+		SG_REF(features);
+		CBinaryLabels* predicted = svm->apply_binary(features);
+
+		index_t num_errors = 0;
+		for (index_t i = 0; i < labels.vlen; i++)
+		{
+			if (predicted->get_label(i) != labels[i])
+				num_errors++;
+		}
+
+		SG_UNREF(predicted);
+		SG_UNREF(features);
+		return float64_t(num_errors) / labels.vlen;
+	}
+
+	SGMatrix<float32_t> data;
+	SGVector<float64_t> labels;
+};
+
+TEST_F(OnlineLibLinear, train_hogwild_single_thread_matches_serial)
+{
+	int32_t num_threads = get_global_parallel()->get_num_threads();
+	get_global_parallel()->set_num_threads(1);
+
+	COnlineLibLinear* serial = train(false);
+	COnlineLibLinear* hogwild = train(true);
+
+	SGVector<float32_t> w = serial->get_w();
+	SGVector<float32_t> w_hogwild = hogwild->get_w();
+	ASSERT_EQ(w.vlen, w_hogwild.vlen);
+	for (index_t i = 0; i < w.vlen; i++)
+		EXPECT_NEAR(w[i], w_hogwild[i], 1e-3);
+	EXPECT_NEAR(serial->get_bias(), hogwild->get_bias(), 1e-3);
+
+	SG_UNREF(serial);
+	SG_UNREF(hogwild);
+	get_global_parallel()->set_num_threads(num_threads);
+}
+
+TEST_F(OnlineLibLinear, train_hogwild)
+{
+	int32_t num_threads = get_global_parallel()->get_num_threads();
+	get_global_parallel()->set_num_threads(4);
+
+	COnlineLibLinear* svm = train(true);
+
+	EXPECT_EQ(svm->get_w().vlen, data.num_rows);
+	EXPECT_LT(training_error(svm), 0.05);
+
+	SG_UNREF(svm);
+	get_global_parallel()->set_num_threads(num_threads);
+}
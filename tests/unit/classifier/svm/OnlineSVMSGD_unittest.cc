@@ -0,0 +1,107 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/classifier/svm/OnlineSVMSGD.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/Math.h>
+
+using namespace shogun;
+
+class OnlineSVMSGD : public ::testing::Test
+{
+public:
+	virtual void SetUp()
+	{
+		CMath::init_random(17);
+
+		// two Gaussian blobs, separated in the first two dimensions
+		index_t num_features = 10;
+		index_t num_vectors = 2000;
+		data = SGMatrix<float64_t>(num_features, num_vectors);
+		labels = SGVector<float64_t>(num_vectors);
+		for (index_t i = 0; i < num_vectors; i++)
+		{
+			labels[i] = i % 2 ? 1 : -1;
+			for (index_t j = 0; j < num_features; j++)
+				data(j, i) = CMath::randn_double() + (j < 2 ? 1.5 * labels[i] : 0);
+		}
+	}
+
+	/** @return training error of the machine on data */
+	float64_t training_error(COnlineSVMSGD* svm)
+	{
+		CDenseFeatures<float64_t>* features = new CDenseFeatures<float64_t>(data);
+		SG_REF(features);
+		CBinaryLabels* predicted = svm->apply_binary(features);
+
+		index_t num_errors = 0;
+		for (index_t i = 0; i < labels.vlen; i++)
+		{
+			if (predicted->get_label(i) != labels[i])
+				num_errors++;
+		}
+
+		SG_UNREF(predicted);
+		SG_UNREF(features);
+		return float64_t(num_errors) / labels.vlen;
+	}
+
+	SGMatrix<float64_t> data;
+	SGVector<float64_t> labels;
+};
+
+TEST_F(OnlineSVMSGD, train_dot_features)
+{
+	CDenseFeatures<float64_t>* features = new CDenseFeatures<float64_t>(data);
+	COnlineSVMSGD* svm = new COnlineSVMSGD(1.0);
+	svm->set_labels(new CBinaryLabels(labels));
+	svm->set_epochs(5);
+	svm->train(features);
+
+	EXPECT_EQ(svm->get_w().vlen, data.num_rows);
+	EXPECT_LT(training_error(svm), 0.05);
+
+	SG_UNREF(features);
+	SG_UNREF(svm);
+}
+
+TEST_F(OnlineSVMSGD, train_dot_features_hogwild)
+{
+	CDenseFeatures<float64_t>* features = new CDenseFeatures<float64_t>(data);
+	COnlineSVMSGD* svm = new COnlineSVMSGD(1.0);
+	svm->set_labels(new CBinaryLabels(labels));
+	svm->set_epochs(5);
+	svm->set_hogwild_enabled(true);
+	svm->set_chunk_size(256);
+	svm->set_averaging_enabled(true);
+	svm->train(features);
+
+	EXPECT_EQ(svm->get_w().vlen, data.num_rows);
+	EXPECT_LT(training_error(svm), 0.05);
+
+	SG_UNREF(features);
+	SG_UNREF(svm);
+}
+
+TEST_F(OnlineSVMSGD, train_streaming_hogwild)
+{
+	CDenseFeatures<float64_t>* dense = new CDenseFeatures<float64_t>(data);
+	CStreamingDenseFeatures<float64_t>* features =
+	    new CStreamingDenseFeatures<float64_t>(dense, labels.vector);
+	SG_REF(features);
+
+	COnlineSVMSGD* svm = new COnlineSVMSGD(1.0);
+	svm->set_hogwild_enabled(true);
+	svm->set_chunk_size(256);
+	svm->train(features);
+
+	EXPECT_EQ(svm->get_w().vlen, data.num_rows);
+	EXPECT_LT(training_error(svm), 0.05);
+
+	SG_UNREF(features);
+	SG_UNREF(svm);
+}
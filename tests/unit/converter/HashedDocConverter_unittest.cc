@@ -4,6 +4,8 @@
  * Authors: Evangelos Anagnostopoulos, Heiko Strathmann
  */
 #include <gtest/gtest.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/init.h>
 #include <shogun/converter/HashedDocConverter.h>
 #include <shogun/features/hashed/HashedDocDotFeatures.h>
 #include <shogun/lib/SGVector.h>
@@ -169,3 +171,51 @@ TEST(HashedDocConverterTest, apply_quadratic_test)
 	SG_FREE(hashes);
 	SG_UNREF(converter);
 }
+
+TEST(HashedDocConverterTest, transform_multithread)
+{
+	const char* words[] = {"never", "too", "old", "to", "rock", "and", "roll"};
+	const index_t num_docs = 200;
+
+	SGStringList<char> list(num_docs, 64);
+	for (index_t i=0; i<num_docs; i++)
+	{
+		std::string doc;
+		for (index_t j=0; j<=i%10; j++)
+			doc += std::string(words[(i+3*j)%7]) + " ";
+
+		list.strings[i] = SGString<char>(doc.size());
+		for (index_t j=0; j<(index_t)doc.size(); j++)
+			list.strings[i].string[j] = doc[j];
+	}
+
+	CStringFeatures<char>* s_feats = new CStringFeatures<char>(list, RAWBYTE);
+	SG_REF(s_feats);
+	CHashedDocConverter* converter = new CHashedDocConverter(8, true, 2, 1);
+	int32_t num_threads = get_global_parallel()->get_num_threads();
+	get_global_parallel()->set_num_threads(4);
+
+	CSparseFeatures<float64_t>* transformed =
+	    (CSparseFeatures<float64_t>*)converter->transform(s_feats);
+	ASSERT_EQ(transformed->get_num_vectors(), num_docs);
+
+	for (index_t i=0; i<num_docs; i++)
+	{
+		SGSparseVector<float64_t> expected = converter->apply(
+			SGVector<char>(list.strings[i].string, list.strings[i].slen, false));
+		SGSparseVector<float64_t> result = transformed->get_sparse_feature_vector(i);
+
+		ASSERT_EQ(result.num_feat_entries, expected.num_feat_entries);
+		for (index_t j=0; j<expected.num_feat_entries; j++)
+		{
+			EXPECT_EQ(result.features[j].feat_index, expected.features[j].feat_index);
+			EXPECT_EQ(result.features[j].entry, expected.features[j].entry);
+		}
+		transformed->free_sparse_feature_vector(i);
+	}
+
+	SG_UNREF(transformed);
+	SG_UNREF(converter);
+	SG_UNREF(s_feats);
+	get_global_parallel()->set_num_threads(num_threads);
+}
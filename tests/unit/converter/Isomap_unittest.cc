@@ -7,6 +7,7 @@
 #include <vector>
 #include <set>
 #include <queue>
+#include <cmath>
 
 #include <shogun/converter/Isomap.h>
 #include <shogun/distance/EuclideanDistance.h>
@@ -216,3 +217,55 @@ void fill_matrix_with_test_data(SGMatrix<float64_t>& matrix_to_fill)
 	}
 }
 
+
+TEST(IsomapTest, nn_descent_neighbors)
+{
+	const index_t n_samples = 300;
+	const index_t n_neighbors = 10;
+
+	// points on a curved two-dimensional surface
+	CMath::init_random(17);
+	SGMatrix<float64_t> data(3, n_samples);
+	for (index_t i = 0; i < n_samples; ++i)
+	{
+		data(0, i) = CMath::random(0.0, 3.0);
+		data(1, i) = CMath::random(0.0, 3.0);
+		data(2, i) = std::sin(data(0, i));
+	}
+
+	CDenseFeatures<float64_t>* features = new CDenseFeatures<float64_t>(data);
+	CDistance* distance = new CEuclideanDistance(features, features);
+	SG_REF(distance);
+
+	CIsomap* isomap = new CIsomap();
+	isomap->set_target_dim(2);
+	isomap->set_k(n_neighbors);
+	// the cover tree is only available in GPL builds
+	isomap->set_neighbors_method(NEIGHBORS_BRUTE_FORCE);
+
+	CDenseFeatures<float64_t>* exact = isomap->embed_distance(distance);
+	isomap->set_neighbors_method(NEIGHBORS_NN_DESCENT);
+	EXPECT_EQ(NEIGHBORS_NN_DESCENT, isomap->get_neighbors_method());
+	CDenseFeatures<float64_t>* approximate = isomap->embed_distance(distance);
+
+	// the embeddings are unique up to reflections, compare the distances
+	CEuclideanDistance* exact_distance = new CEuclideanDistance(exact, exact);
+	CEuclideanDistance* approximate_distance =
+	    new CEuclideanDistance(approximate, approximate);
+	SGMatrix<float64_t> exact_matrix = exact_distance->get_distance_matrix();
+	SGMatrix<float64_t> approximate_matrix =
+	    approximate_distance->get_distance_matrix();
+
+	float64_t error = 0, total = 0;
+	for (index_t i = 0; i < n_samples * n_samples; ++i)
+	{
+		error += CMath::abs(exact_matrix[i] - approximate_matrix[i]);
+		total += exact_matrix[i];
+	}
+	EXPECT_LT(error / total, 1e-2);
+
+	SG_UNREF(exact_distance);
+	SG_UNREF(approximate_distance);
+	SG_UNREF(isomap);
+	SG_UNREF(distance);
+}
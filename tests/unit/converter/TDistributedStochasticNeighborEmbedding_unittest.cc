@@ -7,6 +7,7 @@
 #include <shogun/converter/TDistributedStochasticNeighborEmbedding.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/features/DataGenerator.h>
+#include <shogun/mathematics/Math.h>
 
 using namespace shogun;
 
@@ -42,5 +43,53 @@ TEST(TDistributedStochasticNeighborEmbeddingTest,basic)
 	SG_UNREF(high_dimensional_features);
 	SG_UNREF(low_dimensional_features);
 }
+
+/* Two well separated Gaussians stay separated when the repulsive forces
+ * are interpolated on a grid
+ */
+TEST(TDistributedStochasticNeighborEmbeddingTest,interpolation)
+{
+	const index_t n_samples = 50;
+	const index_t n_dimensions = 3;
+	CDenseFeatures<float64_t>* high_dimensional_features =
+		new CDenseFeatures<float64_t>(CDataGenerator::generate_gaussians(n_samples, 2, n_dimensions));
+
+	CTDistributedStochasticNeighborEmbedding* embedder =
+		new CTDistributedStochasticNeighborEmbedding();
+	embedder->set_target_dim(2);
+	embedder->set_perplexity(10);
+	embedder->set_max_iteration(100);
+	embedder->set_exaggeration_iterations(50);
+	embedder->set_momentum_switch_iteration(50);
+	embedder->set_interpolation(true);
+	EXPECT_TRUE(embedder->get_interpolation());
+
+	auto low_dimensional_features =
+	    embedder->transform(high_dimensional_features)
+	        ->as<CDenseFeatures<float64_t>>();
+	SGMatrix<float64_t> embedding = low_dimensional_features->get_feature_matrix();
+	ASSERT_EQ(2, embedding.num_rows);
+	ASSERT_EQ(2*n_samples, embedding.num_cols);
+
+	float64_t within = 0, between = 0;
+	for (index_t i=0; i<2*n_samples; i++)
+	{
+		for (index_t j=i+1; j<2*n_samples; j++)
+		{
+			float64_t dx = embedding(0,i)-embedding(0,j);
+			float64_t dy = embedding(1,i)-embedding(1,j);
+			float64_t distance = CMath::sqrt(dx*dx+dy*dy);
+			if ((i<n_samples) == (j<n_samples))
+				within += distance/(n_samples*(n_samples-1));
+			else
+				between += distance/(n_samples*n_samples);
+		}
+	}
+	EXPECT_LT(within, between);
+
+	SG_UNREF(embedder);
+	SG_UNREF(high_dimensional_features);
+	SG_UNREF(low_dimensional_features);
+}
 #endif // HAVE_LAPACK
 
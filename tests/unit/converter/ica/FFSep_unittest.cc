@@ -60,3 +60,49 @@ TEST(CFFSep, blind_source_separation)
 	EXPECT_EQ(isperm,true);
 }
 
+
+TEST(CFFSep, block_wise_covariances)
+{
+	int FS = 1000;
+	EVector t(FS+1, true);
+	t.setLinSpaced(FS+1,0,1);
+
+	EMatrix S(2,FS+1);
+	for(int i = 0; i < FS+1; i++)
+	{
+		S(0,i) = sin(2*M_PI*55*t[i]);
+		S(1,i) = cos(2*M_PI*100*t[i]);
+	}
+
+	EMatrix A(2,2);
+	A(0,0) = 1;    A(0,1) = 0.85;
+	A(1,0) = 0.55;  A(1,1) = 1;
+
+	SGMatrix<float64_t> X(2,FS+1);
+	Eigen::Map<EMatrix> EX(X.matrix,2,FS+1);
+	EX = A * S;
+	auto mixed_signals = some<CDenseFeatures<float64_t>>(X);
+
+	// blocks that do not divide the number of samples
+	auto ffsep = some<CFFSep>();
+	ffsep->set_block_size(33);
+	ffsep->fit(mixed_signals);
+	SGNDArray<float64_t> covs = ffsep->get_covs();
+	SGVector<float64_t> tau = ffsep->get_tau();
+
+	int n = FS+1;
+	EMatrix centered = EX.colwise() - EX.rowwise().mean();
+	for (int k = 0; k < tau.vlen; k++)
+	{
+		int lag = tau[k];
+		EMatrix K = centered.leftCols(n-lag) * centered.rightCols(n-lag).transpose() / (n-lag);
+		K = (K + K.transpose()) / 2.0;
+
+		Eigen::Map<EMatrix> C(covs.get_matrix(k),2,2);
+		for (int i = 0; i < 2; i++)
+		{
+			for (int j = 0; j < 2; j++)
+				EXPECT_NEAR(C(i,j), K(i,j), 1e-12);
+		}
+	}
+}
@@ -61,3 +61,41 @@ TEST(CJade, blind_source_separation)
 	EXPECT_EQ(isperm,true);
 }
 
+
+TEST(CJade, block_wise_cumulants)
+{
+	int FS = 1000;
+	EVector t(FS+1, true);
+	t.setLinSpaced(FS+1,0,1);
+
+	EMatrix S(2,FS+1);
+	for(int i = 0; i < FS+1; i++)
+	{
+		S(0,i) = sin(2*M_PI*55*t[i]);
+		S(1,i) = cos(2*M_PI*100*t[i]);
+	}
+
+	EMatrix A(2,2);
+	A(0,0) = 1;    A(0,1) = 0.85;
+	A(1,0) = 0.55;  A(1,1) = 1;
+
+	SGMatrix<float64_t> X(2,FS+1);
+	Eigen::Map<EMatrix> EX(X.matrix,2,FS+1);
+	EX = A * S;
+	auto mixed_signals = some<CDenseFeatures<float64_t>>(X);
+
+	// one block versus many blocks that do not divide the number of samples
+	auto jade = some<CJade>();
+	jade->fit(mixed_signals);
+	SGMatrix<float64_t> cumulants = jade->get_cumulant_matrix();
+
+	auto blocked_jade = some<CJade>();
+	blocked_jade->set_block_size(64);
+	blocked_jade->fit(mixed_signals);
+	SGMatrix<float64_t> blocked_cumulants = blocked_jade->get_cumulant_matrix();
+
+	ASSERT_EQ(cumulants.num_rows, blocked_cumulants.num_rows);
+	ASSERT_EQ(cumulants.num_cols, blocked_cumulants.num_cols);
+	for (int64_t i = 0; i < int64_t(cumulants.num_rows)*cumulants.num_cols; i++)
+		EXPECT_NEAR(cumulants.matrix[i], blocked_cumulants.matrix[i], 1e-10);
+}
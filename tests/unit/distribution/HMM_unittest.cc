@@ -0,0 +1,101 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/init.h>
+#include <shogun/distributions/HMM.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/lib/SGString.h>
+#include <shogun/lib/SGStringList.h>
+#include <shogun/mathematics/Math.h>
+
+using namespace shogun;
+
+static CStringFeatures<uint16_t>* random_observations(
+	index_t num_strings, index_t min_len, index_t max_len)
+{
+	const char acgt[]="ACGT";
+	SGStringList<char> list(num_strings, max_len);
+	for (index_t i=0; i<num_strings; ++i)
+	{
+		SGString<char> str(CMath::random(min_len, max_len));
+		for (index_t l=0; l<str.slen; ++l)
+			str.string[l]=acgt[CMath::random(0, 3)];
+		list.strings[i]=str;
+	}
+
+	CStringFeatures<char>* chars=new CStringFeatures<char>(list, DNA);
+	CStringFeatures<uint16_t>* obs=new CStringFeatures<uint16_t>(DNA);
+	obs->obtain_from_char(chars, 0, 1, 0, false);
+	SG_UNREF(chars);
+
+	return obs;
+}
+
+TEST(HMM, model_probability_scaled)
+{
+	CStringFeatures<uint16_t>* obs=random_observations(10, 20, 50);
+	CHMM* hmm=new CHMM(obs, 3, 4, 1e-10);
+	SG_REF(hmm);
+	int32_t num_threads=get_global_parallel()->get_num_threads();
+	get_global_parallel()->set_num_threads(2);
+
+	float64_t expected=hmm->model_probability_comp();
+	EXPECT_NEAR(hmm->model_probability_scaled(), expected, 1E-6*CMath::abs(expected));
+
+	SG_UNREF(hmm);
+	get_global_parallel()->set_num_threads(num_threads);
+}
+
+TEST(HMM, best_path_batch)
+{
+	CStringFeatures<uint16_t>* obs=random_observations(10, 20, 50);
+	CHMM* hmm=new CHMM(obs, 3, 4, 1e-10);
+	SG_REF(hmm);
+	int32_t num_threads=get_global_parallel()->get_num_threads();
+	get_global_parallel()->set_num_threads(2);
+
+	SGVector<float64_t> path_prob=hmm->best_path_batch();
+	ASSERT_EQ(path_prob.vlen, obs->get_num_vectors());
+	for (index_t i=0; i<path_prob.vlen; ++i)
+		EXPECT_NEAR(path_prob[i], hmm->best_path(i), 1E-8*CMath::abs(path_prob[i]));
+
+	SG_UNREF(hmm);
+	get_global_parallel()->set_num_threads(num_threads);
+}
+
+TEST(HMM, estimate_model_baum_welch_scaled)
+{
+	CStringFeatures<uint16_t>* obs=random_observations(10, 20, 50);
+	CHMM* estimate=new CHMM(obs, 3, 4, 1e-10);
+	SG_REF(estimate);
+
+	CHMM* log_domain=new CHMM(estimate);
+	SG_REF(log_domain);
+	CHMM* scaled=new CHMM(estimate);
+	SG_REF(scaled);
+	int32_t num_threads=get_global_parallel()->get_num_threads();
+	get_global_parallel()->set_num_threads(3);
+
+	log_domain->estimate_model_baum_welch(estimate);
+	float64_t mod_prob=estimate->model_probability();
+	scaled->estimate_model_baum_welch_scaled(estimate);
+	EXPECT_NEAR(estimate->model_probability(), mod_prob, 1E-6*CMath::abs(mod_prob));
+
+	for (int32_t i=0; i<3; ++i)
+	{
+		EXPECT_NEAR(scaled->get_p(i), log_domain->get_p(i), 1E-6);
+		EXPECT_NEAR(scaled->get_q(i), log_domain->get_q(i), 1E-6);
+		for (int32_t j=0; j<3; ++j)
+			EXPECT_NEAR(scaled->get_a(i,j), log_domain->get_a(i,j), 1E-6);
+		for (int32_t j=0; j<4; ++j)
+			EXPECT_NEAR(scaled->get_b(i,j), log_domain->get_b(i,j), 1E-6);
+	}
+
+	SG_UNREF(scaled);
+	SG_UNREF(log_domain);
+	SG_UNREF(estimate);
+	get_global_parallel()->set_num_threads(num_threads);
+}
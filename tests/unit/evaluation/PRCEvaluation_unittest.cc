@@ -0,0 +1,31 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/evaluation/PRCEvaluation.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+TEST(PRCEvaluation,ties)
+{
+	SGVector<float64_t> scores({0.9, 0.5, 0.5, 0.1});
+	SGVector<float64_t> labels({1, -1, 1, -1});
+	auto predicted = some<CBinaryLabels>(scores);
+	auto gt = some<CBinaryLabels>(labels);
+
+	auto prc = some<CPRCEvaluation>();
+	prc->evaluate(predicted, gt);
+
+	// the tied scores give a single point regardless of their order
+	SGMatrix<float64_t> graph = prc->get_PRC();
+	SGVector<float64_t> thresholds = prc->get_thresholds();
+	ASSERT_EQ(graph.num_cols, 3);
+	EXPECT_EQ(graph(0, 0), 1.0);
+	EXPECT_EQ(graph(1, 0), 0.5);
+	EXPECT_NEAR(graph(0, 1), 2.0/3.0, 1E-15);
+	EXPECT_EQ(graph(1, 1), 1.0);
+	EXPECT_EQ(graph(0, 2), 0.5);
+	EXPECT_EQ(thresholds[1], 0.5);
+}
@@ -6,8 +6,11 @@
 
 #include <shogun/labels/BinaryLabels.h>
 #include <shogun/evaluation/ROCEvaluation.h>
+#include <shogun/mathematics/Math.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 using namespace shogun;
 
 TEST(ROCEvaluation,one)
@@ -29,3 +32,94 @@ TEST(ROCEvaluation,one)
 	SG_UNREF(roc);
 	SG_UNREF(gt);
 }
+
+TEST(ROCEvaluation,ties)
+{
+	SGVector<float64_t> scores({0.5, 0.2, 0.5, 0.2});
+	SGVector<float64_t> labels({1, 1, -1, -1});
+	auto predicted = some<CBinaryLabels>(scores);
+	auto gt = some<CBinaryLabels>(labels);
+
+	auto roc = some<CROCEvaluation>();
+	EXPECT_EQ(roc->evaluate(predicted, gt), 0.5);
+
+	SGMatrix<float64_t> graph = roc->get_ROC();
+	SGVector<float64_t> thresholds = roc->get_thresholds();
+	EXPECT_EQ(graph.num_cols, 3);
+	EXPECT_EQ(thresholds.vlen, 3);
+	EXPECT_EQ(graph(0, 1), 0.5);
+	EXPECT_EQ(graph(1, 1), 0.5);
+	EXPECT_EQ(thresholds[1], 0.2);
+}
+
+TEST(ROCEvaluation,streaming_and_bins)
+{
+	index_t num_labels=199998;
+	index_t num_batches=3;
+
+	CMath::init_random(17);
+	SGVector<float64_t> scores(num_labels);
+	SGVector<float64_t> labels(num_labels);
+	for (index_t i=0; i<num_labels; i++)
+	{
+		labels[i]=i%2==0 ? -1 : 1;
+		scores[i]=CMath::randn_double()+labels[i]*0.5;
+	}
+
+	// auROC is the normalized rank sum of the positive examples
+	SGVector<index_t> idx(num_labels);
+	idx.range_fill();
+	std::sort(idx.vector, idx.vector+num_labels,
+	    [&](index_t a, index_t b) { return scores[a]<scores[b]; });
+	float64_t num_pos=num_labels/2;
+	float64_t rank_sum=0;
+	for (index_t i=0; i<num_labels; i++)
+	{
+		if (labels[idx[i]]>0)
+			rank_sum+=i+1;
+	}
+	float64_t expected=(rank_sum-num_pos*(num_pos+1)/2)/(num_pos*num_pos);
+
+	auto roc = some<CROCEvaluation>();
+	auto predicted = some<CBinaryLabels>(scores);
+	auto gt = some<CBinaryLabels>(labels);
+	EXPECT_NEAR(roc->evaluate(predicted, gt), expected, 1E-12);
+
+	for (index_t b=0; b<num_batches; b++)
+	{
+		SGVector<index_t> batch(num_labels/num_batches);
+		for (index_t i=0; i<batch.vlen; i++)
+			batch[i]=b*batch.vlen+i;
+
+		predicted->add_subset(batch);
+		gt->add_subset(batch);
+		roc->add_scores(predicted, gt);
+		predicted->remove_subset();
+		gt->remove_subset();
+	}
+	float64_t streamed_auc=roc->evaluate_scores();
+	EXPECT_NEAR(streamed_auc, expected, 1E-12);
+
+	roc->set_num_bins(1000, -6, 6);
+	EXPECT_EQ(roc->get_num_bins(), 1000);
+	EXPECT_NEAR(roc->evaluate(predicted, gt), expected, 1E-3);
+	EXPECT_LE(roc->get_ROC().num_cols, 1001);
+}
+
+TEST(ROCEvaluation,evaluate_keeps_added_scores)
+{
+	SGVector<float64_t> scores({0.9, 0.8, 0.3, 0.1});
+	SGVector<float64_t> labels({1, -1, 1, -1});
+	auto predicted = some<CBinaryLabels>(scores);
+	auto gt = some<CBinaryLabels>(labels);
+
+	SGVector<float64_t> other_scores({0.5, 0.2});
+	SGVector<float64_t> other_labels({-1, 1});
+	auto other_predicted = some<CBinaryLabels>(other_scores);
+	auto other_gt = some<CBinaryLabels>(other_labels);
+
+	auto roc = some<CROCEvaluation>();
+	roc->add_scores(predicted, gt);
+	EXPECT_EQ(roc->evaluate(other_predicted, other_gt), 0.0);
+	EXPECT_EQ(roc->evaluate_scores(), 0.75);
+}
@@ -8,9 +8,15 @@
 #include <algorithm>
 #include <gtest/gtest.h>
 #include <numeric>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/init.h>
 #include <shogun/base/some.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/lib/View.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/preprocessor/NormOne.h>
+#include <shogun/preprocessor/PruneVarSubMean.h>
+#include <shogun/preprocessor/RescaleFeatures.h>
 
 namespace shogun
 {
@@ -288,3 +294,111 @@ TEST(DenseFeaturesTest, view)
 			    feature_matrix_subset2(i, j), data(i, subset1[subset2[j]]));
 	}
 }
+
+static CDenseFeatures<float64_t>* preprocessed_features(SGMatrix<float64_t> data)
+{
+	auto features=new CDenseFeatures<float64_t>(data);
+
+	auto rescale=new CRescaleFeatures();
+	rescale->fit(features);
+	auto prune=new CPruneVarSubMean(true);
+	prune->fit(features);
+
+	features->add_preprocessor(rescale);
+	features->add_preprocessor(prune);
+	features->add_preprocessor(new CNormOne());
+
+	return features;
+}
+
+static SGVector<float64_t> apply_chain(CDenseFeatures<float64_t>* features,
+	SGVector<float64_t> vec)
+{
+	for (auto i : range(features->get_num_preprocessors()))
+	{
+		auto preprocessor=features->get_preprocessor(i)
+			->as<CDensePreprocessor<float64_t>>();
+		vec=preprocessor->apply_to_feature_vector(vec);
+		SG_UNREF(preprocessor);
+	}
+
+	return vec;
+}
+
+TEST(DenseFeaturesTest, get_feature_vector_inplace_preprocessors)
+{
+	index_t dim=4;
+	index_t n=12;
+
+	SGMatrix<float64_t> data(dim, n);
+	for (index_t j=0; j<n; ++j)
+	{
+		for (index_t i=0; i<dim; ++i)
+			data(i, j)=CMath::random(-5.0, 5.0);
+		// constant feature which is pruned
+		data(2, j)=1.0;
+	}
+
+	auto features=preprocessed_features(data);
+	SG_REF(features);
+
+	for (index_t j=0; j<n; ++j)
+	{
+		SGVector<float64_t> expected=apply_chain(features,
+			SGVector<float64_t>(data.get_column_vector(j), dim, false));
+		SGVector<float64_t> vec=features->get_feature_vector(j);
+
+		ASSERT_EQ(vec.vlen, dim-1);
+		for (index_t i=0; i<vec.vlen; ++i)
+			EXPECT_NEAR(vec[i], expected[i], 1E-12);
+		features->free_feature_vector(vec, j);
+	}
+
+	// original data is untouched
+	for (index_t j=0; j<n; ++j)
+		EXPECT_EQ(data(2, j), 1.0);
+
+	SG_UNREF(features);
+}
+
+TEST(DenseFeaturesTest, get_preprocessed_feature_vectors)
+{
+	index_t dim=5;
+	index_t n=20;
+
+	SGMatrix<float64_t> data(dim, n);
+	for (index_t j=0; j<n; ++j)
+	{
+		for (index_t i=0; i<dim; ++i)
+			data(i, j)=CMath::random(-5.0, 5.0);
+		data(0, j)=-2.0;
+		data(3, j)=3.0;
+	}
+
+	auto features=preprocessed_features(data);
+	SG_REF(features);
+	int32_t num_threads=get_global_parallel()->get_num_threads();
+	get_global_parallel()->set_num_threads(2);
+
+	SGVector<index_t> subset(n/2);
+	for (index_t j=0; j<subset.vlen; ++j)
+		subset[j]=2*j+1;
+	features->add_subset(subset);
+
+	SGVector<index_t> indices(6);
+	indices.random(0, subset.vlen-1);
+	SGMatrix<float64_t> block=features->get_preprocessed_feature_vectors(indices);
+
+	ASSERT_EQ(block.num_rows, dim-2);
+	ASSERT_EQ(block.num_cols, indices.vlen);
+	for (index_t j=0; j<indices.vlen; ++j)
+	{
+		SGVector<float64_t> expected=apply_chain(features, SGVector<float64_t>(
+			data.get_column_vector(subset[indices[j]]), dim, false));
+		for (index_t i=0; i<block.num_rows; ++i)
+			EXPECT_NEAR(block(i, j), expected[i], 1E-12);
+	}
+
+	SG_UNREF(features);
+	get_global_parallel()->set_num_threads(num_threads);
+}
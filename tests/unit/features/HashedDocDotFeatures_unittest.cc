@@ -305,3 +305,59 @@ TEST(HashedDocDotFeaturesTest, quadratic_add_to_dense)
 	SG_UNREF(hddf);
 	SG_FREE(hashes);
 }
+
+TEST(HashedDocDotFeaturesTest, hashed_cache)
+{
+	const char* docs[] = {
+		"You're never too old to rock and roll, if you're too young to die",
+		"Give me some rope, tie me to dream, give me the hope to run out of steam",
+		"Thank you Jack Daniels, Old Number Seven, Tennessee Whiskey got me drinking in heaven"};
+
+	SGStringList<char> list(3, 85);
+	for (index_t i=0; i<3; i++)
+	{
+		index_t len = strlen(docs[i]);
+		list.strings[i] = SGString<char>(len);
+		for (index_t j=0; j<len; j++)
+			list.strings[i].string[j] = docs[i][j];
+	}
+
+	int32_t hash_bits = 6;
+	int32_t dimension = 64;
+
+	CStringFeatures<char>* doc_collection = new CStringFeatures<char>(list, RAWBYTE);
+	CHashedDocDotFeatures* hddf = new CHashedDocDotFeatures(hash_bits, doc_collection,
+			NULL, true, 2, 1);
+	CHashedDocDotFeatures* cached = new CHashedDocDotFeatures(hash_bits, doc_collection,
+			NULL, true, 2, 1);
+	cached->set_hashed_cache_size(2);
+	EXPECT_EQ(cached->get_hashed_cache_size(), 2);
+
+	SGVector<float64_t> dense_vec(dimension);
+	for (index_t i=0; i<dimension; i++)
+		dense_vec[i] = i;
+
+	/* two passes, so that documents are both found in and evicted from the cache */
+	for (index_t pass=0; pass<2; pass++)
+	{
+		for (index_t i=0; i<3; i++)
+		{
+			EXPECT_NEAR(cached->dense_dot(i, dense_vec.vector, dimension),
+					hddf->dense_dot(i, dense_vec.vector, dimension), 1E-10);
+			EXPECT_NEAR(cached->dot(i, cached, (i+1)%3),
+					hddf->dot(i, hddf, (i+1)%3), 1E-10);
+
+			SGVector<float64_t> expected(dimension);
+			SGVector<float64_t> result(dimension);
+			expected.zero();
+			result.zero();
+			hddf->add_to_dense_vec(-0.5, i, expected.vector, dimension, true);
+			cached->add_to_dense_vec(-0.5, i, result.vector, dimension, true);
+			for (index_t j=0; j<dimension; j++)
+				EXPECT_NEAR(result[j], expected[j], 1E-10);
+		}
+	}
+
+	SG_UNREF(hddf);
+	SG_UNREF(cached);
+}
@@ -9,7 +9,10 @@
 #include <gtest/gtest.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/lib/SGStringList.h>
+#include <shogun/lib/exception/ShogunException.h>
 #include <shogun/lib/memory.h>
+#include <shogun/mathematics/Math.h>
+#include <cstdio>
 
 using namespace shogun;
 
@@ -104,3 +107,193 @@ TEST(StringFeaturesTest,clone)
 	SG_UNREF(f);
 	SG_UNREF(f_clone);
 }
+
+static SGStringList<char> random_sequences(const char* symbols,
+		index_t num_symbols, index_t num_strings)
+{
+	SGStringList<char> list(num_strings, 0);
+	for (index_t i=0; i<num_strings; ++i)
+	{
+		SGString<char> str(CMath::random(0, 100));
+		for (index_t l=0; l<str.slen; ++l)
+			str.string[l]=symbols[CMath::random(0, num_symbols-1)];
+		list.strings[i]=str;
+		list.max_string_length=CMath::max(list.max_string_length, str.slen);
+	}
+
+	return list;
+}
+
+static void check_equal_strings(
+		CStringFeatures<char>* f, CStringFeatures<char>* expected)
+{
+	ASSERT_EQ(f->get_num_vectors(), expected->get_num_vectors());
+	EXPECT_EQ(f->get_max_vector_length(), expected->get_max_vector_length());
+	for (index_t i=0; i<f->get_num_vectors(); ++i)
+	{
+		SGVector<char> vec=f->get_feature_vector(i);
+		SGVector<char> expected_vec=expected->get_feature_vector(i);
+		ASSERT_EQ(vec.vlen, expected_vec.vlen);
+		EXPECT_EQ(f->get_vector_length(i), expected_vec.vlen);
+		for (index_t j=0; j<vec.vlen; ++j)
+			EXPECT_EQ(vec[j], expected_vec[j]);
+		f->free_feature_vector(vec, i);
+		expected->free_feature_vector(expected_vec, i);
+	}
+}
+
+TEST(StringFeaturesTest,pack_unpack)
+{
+	CMath::init_random(17);
+	SGStringList<char> dna=random_sequences("ACGT", 4, 20);
+	SGStringList<char> protein=random_sequences("ACDEFGHIKLMNPQRSTVWY", 20, 20);
+
+	CStringFeatures<char>* f=new CStringFeatures<char>(dna, DNA);
+	CStringFeatures<char>* expected=new CStringFeatures<char>(dna.clone(), DNA);
+	EXPECT_TRUE(f->pack());
+	EXPECT_TRUE(f->is_packed());
+	EXPECT_EQ(f->get_packed_bits(), 2);
+	EXPECT_EQ(f->get_symbols_per_packed_word(), 32);
+	check_equal_strings(f, expected);
+
+	f->unpack();
+	EXPECT_FALSE(f->is_packed());
+	check_equal_strings(f, expected);
+	SG_UNREF(f);
+	SG_UNREF(expected);
+
+	f=new CStringFeatures<char>(protein, PROTEIN);
+	expected=new CStringFeatures<char>(protein.clone(), PROTEIN);
+	EXPECT_TRUE(f->pack());
+	EXPECT_EQ(f->get_packed_bits(), 5);
+	check_equal_strings(f, expected);
+
+	/* subsets see the packed strings as well */
+	SGVector<index_t> subset(5);
+	subset.range_fill(3);
+	f->add_subset(subset);
+	expected->add_subset(subset);
+	check_equal_strings(f, expected);
+	SG_UNREF(f);
+	SG_UNREF(expected);
+}
+
+TEST(StringFeaturesTest,clone_packed)
+{
+	CMath::init_random(17);
+	SGStringList<char> dna=random_sequences("ACGT", 4, 20);
+
+	CStringFeatures<char>* f=new CStringFeatures<char>(dna, DNA);
+	CStringFeatures<char>* expected=new CStringFeatures<char>(dna.clone(), DNA);
+	ASSERT_TRUE(f->pack());
+
+	/* packed strings are cloned as unpacked strings */
+	CStringFeatures<char>* f_clone=(CStringFeatures<char>*) f->clone();
+	EXPECT_TRUE(f->is_packed());
+	EXPECT_FALSE(f_clone->is_packed());
+	check_equal_strings(f_clone, expected);
+	EXPECT_TRUE(f->equals(f_clone));
+	EXPECT_TRUE(f_clone->equals(f));
+
+	/* subsets are cloned with them */
+	SGVector<index_t> subset(5);
+	subset.range_fill(3);
+	f->add_subset(subset);
+	expected->add_subset(subset);
+	CStringFeatures<char>* f_shallow=(CStringFeatures<char>*) f->shallow_clone();
+	EXPECT_TRUE(f->is_packed());
+	check_equal_strings(f_shallow, expected);
+	EXPECT_TRUE(f->equals(f_shallow));
+
+	SG_UNREF(f_shallow);
+	SG_UNREF(f_clone);
+	SG_UNREF(f);
+	SG_UNREF(expected);
+}
+
+TEST(StringFeaturesTest,save_load_packed)
+{
+	CMath::init_random(17);
+	SGStringList<char> dna=random_sequences("ACGT", 4, 20);
+	char fname[]="StringFeatures_save_load_packed.XXXXXX";
+	generate_temp_filename(fname);
+
+	CStringFeatures<char>* f=new CStringFeatures<char>(dna, DNA);
+	CStringFeatures<char>* expected=new CStringFeatures<char>(dna.clone(), DNA);
+	ASSERT_TRUE(f->pack());
+	EXPECT_TRUE(f->save_packed(fname));
+
+	CStringFeatures<char>* loaded=new CStringFeatures<char>(DNA);
+	EXPECT_TRUE(loaded->load_packed(fname));
+	EXPECT_TRUE(loaded->is_packed());
+	check_equal_strings(loaded, expected);
+
+	/* histogram is restored for the k-mer embedding */
+	CAlphabet* alpha=loaded->get_alphabet();
+	EXPECT_EQ(alpha->get_num_symbols_in_histogram(), 4);
+	SG_UNREF(alpha);
+
+	SG_UNREF(loaded);
+	SG_UNREF(f);
+	SG_UNREF(expected);
+	std::remove(fname);
+}
+
+TEST(StringFeaturesTest,load_packed_invalid_offset)
+{
+	CMath::init_random(17);
+	SGStringList<char> dna=random_sequences("ACGT", 4, 20);
+	char fname[]="StringFeatures_load_packed_invalid_offset.XXXXXX";
+	generate_temp_filename(fname);
+
+	CStringFeatures<char>* f=new CStringFeatures<char>(dna, DNA);
+	ASSERT_TRUE(f->pack());
+	EXPECT_TRUE(f->save_packed(fname));
+
+	/* point the first string past the packed words, which follow the
+	 * 32 byte header and the 256 entry histogram */
+	FILE* file=fopen(fname, "r+b");
+	ASSERT_TRUE(file!=NULL);
+	int64_t offset=int64_t(1) << 40;
+	ASSERT_EQ(fseek(file, 32+256*sizeof(int64_t), SEEK_SET), 0);
+	ASSERT_EQ(fwrite(&offset, sizeof(offset), 1, file), 1u);
+	fclose(file);
+
+	CStringFeatures<char>* loaded=new CStringFeatures<char>(DNA);
+	EXPECT_THROW(loaded->load_packed(fname), ShogunException);
+	EXPECT_FALSE(loaded->is_packed());
+
+	SG_UNREF(loaded);
+	SG_UNREF(f);
+	std::remove(fname);
+}
+
+TEST(StringFeaturesTest,obtain_from_packed_char)
+{
+	CMath::init_random(17);
+	SGStringList<char> dna=random_sequences("ACGT", 4, 20);
+
+	CStringFeatures<char>* f=new CStringFeatures<char>(dna, DNA);
+	CStringFeatures<char>* expected=new CStringFeatures<char>(dna.clone(), DNA);
+	ASSERT_TRUE(f->pack());
+
+	CStringFeatures<uint16_t>* words=new CStringFeatures<uint16_t>(DNA);
+	CStringFeatures<uint16_t>* expected_words=new CStringFeatures<uint16_t>(DNA);
+	EXPECT_TRUE(words->obtain_from_char(f, 0, 3, 0, false));
+	EXPECT_TRUE(expected_words->obtain_from_char(expected, 0, 3, 0, false));
+
+	ASSERT_EQ(words->get_num_vectors(), expected_words->get_num_vectors());
+	for (index_t i=0; i<words->get_num_vectors(); ++i)
+	{
+		SGVector<uint16_t> vec=words->get_feature_vector(i);
+		SGVector<uint16_t> expected_vec=expected_words->get_feature_vector(i);
+		ASSERT_EQ(vec.vlen, expected_vec.vlen);
+		for (index_t j=0; j<vec.vlen; ++j)
+			EXPECT_EQ(vec[j], expected_vec[j]);
+	}
+
+	SG_UNREF(words);
+	SG_UNREF(expected_words);
+	SG_UNREF(f);
+	SG_UNREF(expected);
+}
@@ -4,11 +4,14 @@
  * Authors: Heiko Strathmann
  */
 #include <gtest/gtest.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/init.h>
 #include <shogun/kernel/string/CommUlongStringKernel.h>
 #include <shogun/kernel/normalizer/IdentityKernelNormalizer.h>
 #include <shogun/preprocessor/SortUlongString.h>
 #include <shogun/lib/NGramTokenizer.h>
 #include <shogun/lib/SGStringList.h>
+#include <shogun/mathematics/Math.h>
 #include <shogun/features/hashed/HashedDocDotFeatures.h>
 
 using namespace shogun;
@@ -69,3 +72,73 @@ TEST(CommUlongStringKernel, kernel_matrix)
 			EXPECT_EQ(feat_matrix(i,j), kernel_matrix(i,j));
 	}
 }
+
+static CStringFeatures<uint64_t>* random_sorted_kmers(
+	index_t num_strings, index_t len, int32_t order)
+{
+	const char acgt[]="ACGT";
+	SGStringList<char> list(num_strings, len);
+	for (index_t i=0; i<num_strings; ++i)
+	{
+		SGString<char> str(len);
+		for (index_t l=0; l<len; ++l)
+			str.string[l]=acgt[CMath::random(0, 3)];
+		list.strings[i]=str;
+	}
+
+	auto s_feats=some<CStringFeatures<char>>(list, DNA);
+	auto alphabet=s_feats->get_alphabet();
+	auto l_feats=some<CStringFeatures<uint64_t>>(alphabet);
+	l_feats->obtain_from_char(s_feats, order-1, order, 0, false);
+	SG_UNREF(alphabet);
+
+	auto preproc=some<CSortUlongString>();
+	preproc->fit(l_feats);
+	return preproc->transform(l_feats)->as<CStringFeatures<uint64_t>>();
+}
+
+TEST(CommUlongStringKernel, spectrum_kernel_matrix)
+{
+	CMath::init_random(17);
+	auto feats=wrap(random_sorted_kmers(20, 50, 12));
+
+	for (auto use_sign : {false, true})
+	{
+		auto kernel=some<CCommUlongStringKernel>(feats, feats, use_sign);
+		SGMatrix<float64_t> expected=kernel->get_kernel_matrix();
+		SGMatrix<float64_t> computed=kernel->get_spectrum_kernel_matrix();
+
+		for (index_t i=0; i<expected.num_rows*expected.num_cols; ++i)
+			EXPECT_NEAR(computed[i], expected[i], 1E-12);
+	}
+}
+
+TEST(CommUlongStringKernel, parallel_init_optimization)
+{
+	CMath::init_random(17);
+	const index_t num_strings=20;
+	auto feats=wrap(random_sorted_kmers(num_strings, 50, 5));
+	auto kernel=some<CCommUlongStringKernel>(feats, feats);
+	int32_t num_threads=get_global_parallel()->get_num_threads();
+	get_global_parallel()->set_num_threads(3);
+
+	SGVector<int32_t> idx(num_strings/2);
+	SGVector<float64_t> alphas(num_strings/2);
+	for (index_t i=0; i<idx.vlen; ++i)
+	{
+		idx[i]=2*i;
+		alphas[i]=CMath::random(-1.0, 1.0);
+	}
+
+	kernel->init_optimization(idx.vlen, idx.vector, alphas.vector);
+	for (index_t j=0; j<num_strings; ++j)
+	{
+		float64_t expected=0;
+		for (index_t i=0; i<idx.vlen; ++i)
+			expected+=alphas[i]*kernel->kernel(idx[i], j);
+
+		EXPECT_NEAR(kernel->compute_optimized(j), expected, 1E-10);
+	}
+
+	get_global_parallel()->set_num_threads(num_threads);
+}
@@ -0,0 +1,120 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/init.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/kernel/string/CommWordStringKernel.h>
+#include <shogun/lib/SGStringList.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/preprocessor/SortWordString.h>
+
+using namespace shogun;
+
+static CStringFeatures<char>* random_dna(index_t num_strings, index_t len)
+{
+	const char acgt[]="ACGT";
+	SGStringList<char> list(num_strings, len);
+	for (index_t i=0; i<num_strings; ++i)
+	{
+		SGString<char> str(len);
+		for (index_t l=0; l<len; ++l)
+			str.string[l]=acgt[CMath::random(0, 3)];
+		list.strings[i]=str;
+	}
+
+	return new CStringFeatures<char>(list, DNA);
+}
+
+static CStringFeatures<uint16_t>* sorted_words(
+	CStringFeatures<char>* s_feats, int32_t order, bool hashed)
+{
+	auto alphabet=s_feats->get_alphabet();
+	auto w_feats=some<CStringFeatures<uint16_t>>(alphabet);
+	SG_UNREF(alphabet);
+
+	if (hashed)
+		w_feats->obtain_hashed_from_char(s_feats, order);
+	else
+		w_feats->obtain_from_char(s_feats, order-1, order, 0, false);
+
+	auto preproc=some<CSortWordString>();
+	preproc->fit(w_feats);
+	return preproc->transform(w_feats)->as<CStringFeatures<uint16_t>>();
+}
+
+TEST(CommWordStringKernel, spectrum_kernel_matrix)
+{
+	CMath::init_random(17);
+	auto s_feats=wrap(random_dna(20, 60));
+
+	for (auto hashed : {false, true})
+	{
+		/* hashing is needed for more than 8 DNA symbols per word */
+		auto feats=wrap(sorted_words(s_feats, hashed ? 12 : 6, hashed));
+
+		for (auto use_sign : {false, true})
+		{
+			auto kernel=some<CCommWordStringKernel>(feats, feats, use_sign);
+			SGMatrix<float64_t> expected=kernel->get_kernel_matrix();
+			SGMatrix<float64_t> computed=kernel->get_spectrum_kernel_matrix();
+
+			for (index_t i=0; i<expected.num_rows*expected.num_cols; ++i)
+				EXPECT_NEAR(computed[i], expected[i], 1E-12);
+		}
+	}
+}
+
+TEST(CommWordStringKernel, hashed_kmers)
+{
+	CMath::init_random(17);
+	auto s_feats=wrap(random_dna(10, 40));
+	auto feats=wrap(sorted_words(s_feats, 12, true));
+
+	EXPECT_EQ(feats->get_num_vectors(), 10);
+	for (index_t i=0; i<feats->get_num_vectors(); ++i)
+		EXPECT_EQ(feats->get_vector_length(i), 40-12+1);
+
+	/* identical k-mers are hashed to identical words */
+	auto copy=wrap(sorted_words(s_feats, 12, true));
+	for (index_t i=0; i<feats->get_num_vectors(); ++i)
+	{
+		SGVector<uint16_t> vec=feats->get_feature_vector(i);
+		SGVector<uint16_t> copy_vec=copy->get_feature_vector(i);
+		for (index_t j=0; j<vec.vlen; ++j)
+			EXPECT_EQ(vec[j], copy_vec[j]);
+	}
+}
+
+TEST(CommWordStringKernel, parallel_init_optimization)
+{
+	CMath::init_random(17);
+	const index_t num_strings=20;
+	auto s_feats=wrap(random_dna(num_strings, 50));
+	auto feats=wrap(sorted_words(s_feats, 5, false));
+	auto kernel=some<CCommWordStringKernel>(feats, feats);
+	int32_t num_threads=get_global_parallel()->get_num_threads();
+	get_global_parallel()->set_num_threads(3);
+
+	SGVector<int32_t> idx(num_strings/2);
+	SGVector<float64_t> alphas(num_strings/2);
+	for (index_t i=0; i<idx.vlen; ++i)
+	{
+		idx[i]=2*i;
+		alphas[i]=CMath::random(-1.0, 1.0);
+	}
+
+	kernel->init_optimization(idx.vlen, idx.vector, alphas.vector);
+	for (index_t j=0; j<num_strings; ++j)
+	{
+		float64_t expected=0;
+		for (index_t i=0; i<idx.vlen; ++i)
+			expected+=alphas[i]*kernel->kernel(idx[i], j);
+
+		EXPECT_NEAR(kernel->compute_optimized(j), expected, 1E-10);
+	}
+
+	get_global_parallel()->set_num_threads(num_threads);
+}
@@ -729,3 +729,57 @@ TEST(GaussianARDKernel,get_parameter_gradient_diagonal)
 	SG_UNREF(features_train)
 	SG_UNREF(latent_features_train)
 }
+
+TEST(GaussianARDKernel,get_parameter_gradient_sum)
+{
+	index_t n=5;
+	index_t dim=3;
+
+	SGMatrix<float64_t> feat_train(dim, n);
+	for (index_t i=0; i<dim*n; i++)
+		feat_train[i]=CMath::random(-2.0, 2.0);
+	CDenseFeatures<float64_t>* features_train=new CDenseFeatures<float64_t>(feat_train);
+	SG_REF(features_train)
+
+	SGMatrix<float64_t> weights(n, n);
+	for (index_t i=0; i<n*n; i++)
+		weights[i]=CMath::random(-1.0, 1.0);
+
+	SGVector<float64_t> vector_weights(dim);
+	SGMatrix<float64_t> matrix_weights(dim, dim);
+	matrix_weights.zero();
+	for (index_t i=0; i<dim; i++)
+	{
+		vector_weights[i]=CMath::random(0.5, 2.0);
+		for (index_t j=0; j<=i; j++)
+			matrix_weights(i,j)=(i==j) ? vector_weights[i] : CMath::random(-0.5, 0.5);
+	}
+
+	for (index_t type=0; type<2; type++)
+	{
+		CExponentialARDKernel* kernel=new CGaussianARDKernel(10);
+		if (type==0)
+			kernel->set_vector_weights(vector_weights);
+		else
+			kernel->set_matrix_weights(matrix_weights);
+		kernel->init(features_train, features_train);
+
+		TParameter* param=kernel->m_gradient_parameters->get_parameter("log_weights");
+		SGVector<float64_t> sum=kernel->get_parameter_gradient_sum(param, weights);
+		int64_t len=param->m_datatype.get_num_elements();
+		ASSERT_EQ(sum.vlen, len);
+
+		for (index_t i=0; i<sum.vlen; i++)
+		{
+			SGMatrix<float64_t> dK=kernel->get_parameter_gradient(param, i);
+			float64_t expected=0;
+			for (index_t j=0; j<n*n; j++)
+				expected+=weights[j]*dK[j];
+			EXPECT_NEAR(sum[i], expected, 1E-10);
+		}
+
+		SG_UNREF(kernel);
+	}
+
+	SG_UNREF(features_train)
+}
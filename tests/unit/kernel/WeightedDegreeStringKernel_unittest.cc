@@ -0,0 +1,162 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/init.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/kernel/string/WeightedDegreePositionStringKernel.h>
+#include <shogun/kernel/string/WeightedDegreeStringKernel.h>
+#include <shogun/kernel/normalizer/IdentityKernelNormalizer.h>
+#include <shogun/lib/SGString.h>
+#include <shogun/lib/SGStringList.h>
+#include <shogun/mathematics/Math.h>
+
+using namespace shogun;
+
+static CStringFeatures<char>* random_dna(index_t num_strings, index_t len)
+{
+	const char acgt[]="ACGT";
+	SGStringList<char> list(num_strings, len);
+	for (index_t i=0; i<num_strings; ++i)
+	{
+		SGString<char> str(len);
+		for (index_t l=0; l<len; ++l)
+			str.string[l]=acgt[CMath::random(0, 3)];
+		list.strings[i]=str;
+	}
+
+	return new CStringFeatures<char>(list, DNA);
+}
+
+static void check_linadd(
+	CKernel* kernel, SGVector<int32_t> idx, SGVector<float64_t> alphas)
+{
+	for (index_t j=0; j<kernel->get_num_vec_rhs(); ++j)
+	{
+		float64_t expected=0;
+		for (index_t i=0; i<idx.vlen; ++i)
+			expected+=alphas[i]*kernel->kernel(idx[i], j);
+
+		EXPECT_NEAR(kernel->compute_optimized(j), expected, 1E-4);
+	}
+}
+
+TEST(WeightedDegreeStringKernel, parallel_init_optimization)
+{
+	const index_t num_strings=20;
+	const index_t len=30;
+
+	CStringFeatures<char>* feats=random_dna(num_strings, len);
+	CWeightedDegreeStringKernel* kernel=new CWeightedDegreeStringKernel(5);
+	kernel->set_normalizer(new CIdentityKernelNormalizer());
+	kernel->init(feats, feats);
+	int32_t num_threads=get_global_parallel()->get_num_threads();
+	get_global_parallel()->set_num_threads(3);
+
+	SGVector<int32_t> idx(num_strings/2);
+	SGVector<float64_t> alphas(num_strings/2);
+	for (index_t i=0; i<idx.vlen; ++i)
+	{
+		idx[i]=2*i;
+		alphas[i]=CMath::random(-1.0, 1.0);
+	}
+
+	kernel->init_optimization(idx.vlen, idx.vector, alphas.vector);
+	check_linadd(kernel, idx, alphas);
+
+	SG_UNREF(kernel);
+	get_global_parallel()->set_num_threads(num_threads);
+}
+
+TEST(WeightedDegreeStringKernel, incremental_init_optimization)
+{
+	const index_t num_strings=20;
+	const index_t len=30;
+
+	CStringFeatures<char>* feats=random_dna(num_strings, len);
+	CWeightedDegreeStringKernel* kernel=new CWeightedDegreeStringKernel(5);
+	kernel->set_normalizer(new CIdentityKernelNormalizer());
+	kernel->init(feats, feats);
+	EXPECT_TRUE(kernel->get_incremental_linadd());
+
+	SGVector<int32_t> idx(num_strings);
+	SGVector<float64_t> alphas(num_strings);
+	for (index_t i=0; i<idx.vlen; ++i)
+	{
+		idx[i]=i;
+		alphas[i]=CMath::random(-1.0, 1.0);
+	}
+	kernel->init_optimization(idx.vlen, idx.vector, alphas.vector);
+
+	// few changed alphas, one example dropping out
+	alphas[3]=0.5;
+	alphas[7]=0.0;
+	alphas[11]*=2;
+	kernel->init_optimization(idx.vlen, idx.vector, alphas.vector);
+	check_linadd(kernel, idx, alphas);
+
+	SG_UNREF(kernel);
+}
+
+TEST(WeightedDegreeStringKernel, packed_block_computation)
+{
+	const index_t num_strings=10;
+	const index_t len=70;
+
+	CStringFeatures<char>* feats=random_dna(num_strings, len);
+	CStringFeatures<char>* packed=new CStringFeatures<char>(
+		feats->get_features().clone(), DNA);
+	ASSERT_TRUE(packed->pack());
+
+	CWeightedDegreeStringKernel* kernel=new CWeightedDegreeStringKernel(8);
+	kernel->set_normalizer(new CIdentityKernelNormalizer());
+	kernel->init(feats, feats);
+	SGMatrix<float64_t> expected=kernel->get_kernel_matrix();
+
+	kernel->init(packed, packed);
+	SGMatrix<float64_t> computed=kernel->get_kernel_matrix();
+
+	for (index_t i=0; i<expected.num_rows*expected.num_cols; ++i)
+		EXPECT_NEAR(computed[i], expected[i], 1E-10);
+
+	SG_UNREF(kernel);
+}
+
+TEST(WeightedDegreePositionStringKernel, parallel_init_optimization)
+{
+	const index_t num_strings=20;
+	const index_t len=30;
+
+	CStringFeatures<char>* feats=random_dna(num_strings, len);
+	CWeightedDegreePositionStringKernel* kernel=
+		new CWeightedDegreePositionStringKernel(10, 5);
+	kernel->set_normalizer(new CIdentityKernelNormalizer());
+
+	SGVector<int32_t> shifts(len);
+	shifts.set_const(2);
+	kernel->set_shifts(shifts);
+	kernel->init(feats, feats);
+	int32_t num_threads=get_global_parallel()->get_num_threads();
+	get_global_parallel()->set_num_threads(3);
+
+	SGVector<int32_t> idx(num_strings/2);
+	SGVector<float64_t> alphas(num_strings/2);
+	for (index_t i=0; i<idx.vlen; ++i)
+	{
+		idx[i]=2*i+1;
+		alphas[i]=CMath::random(-1.0, 1.0);
+	}
+
+	kernel->init_optimization(idx.vlen, idx.vector, alphas.vector);
+	check_linadd(kernel, idx, alphas);
+
+	alphas[0]=0.0;
+	alphas[4]=0.25;
+	kernel->init_optimization(idx.vlen, idx.vector, alphas.vector);
+	check_linadd(kernel, idx, alphas);
+
+	SG_UNREF(kernel);
+	get_global_parallel()->set_num_threads(num_threads);
+}
@@ -0,0 +1,83 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/lib/MemoryArena.h>
+
+#include <cstdint>
+
+using namespace shogun;
+
+TEST(MemoryArena, allocate_aligned)
+{
+	MemoryArena arena(1024);
+	for (auto size : {1, 7, 64, 100, 5000})
+	{
+		void* p = arena.allocate(size);
+		EXPECT_EQ(uintptr_t(p) % MemoryArena::ALIGNMENT, 0u);
+	}
+
+	// the allocation larger than a chunk gets a chunk of its own
+	EXPECT_GE(arena.get_capacity(), 5000u + 1024u);
+}
+
+TEST(MemoryArena, scope_reuses_memory)
+{
+	MemoryArena arena(1024);
+	float64_t* first = NULL;
+
+	for (auto i = 0; i < 10; ++i)
+	{
+		ArenaScope scope(&arena);
+		auto vec = scope.vector<float64_t>(16);
+		auto mat = scope.matrix<float64_t>(4, 4);
+		vec.set_const(i);
+		mat.set_const(-i);
+		EXPECT_EQ(vec[15], i);
+		EXPECT_EQ(mat(3, 3), -i);
+
+		if (!first)
+			first = vec.vector;
+		EXPECT_EQ(vec.vector, first);
+	}
+
+	EXPECT_EQ(arena.get_capacity(), 1024u);
+}
+
+TEST(MemoryArena, nested_scopes)
+{
+	MemoryArena arena(256);
+	ArenaScope outer(&arena);
+	auto a = outer.vector<int32_t>(32);
+	a.set_const(1);
+
+	MemoryArena::Position position = arena.get_position();
+	{
+		ArenaScope inner(&arena);
+		auto b = inner.vector<int32_t>(1000);
+		b.set_const(2);
+	}
+	EXPECT_EQ(arena.get_position().chunk, position.chunk);
+	EXPECT_EQ(arena.get_position().offset, position.offset);
+
+	// memory of the outer scope is untouched
+	auto c = outer.vector<int32_t>(32);
+	c.set_const(3);
+	for (auto i = 0; i < a.vlen; ++i)
+		EXPECT_EQ(a[i], 1);
+}
+
+TEST(MemoryArena, thread_local_arena)
+{
+	MemoryArena* arena = MemoryArena::thread_local_arena();
+	EXPECT_EQ(arena, MemoryArena::thread_local_arena());
+
+	MemoryArena::Position position = arena->get_position();
+	{
+		ArenaScope scope;
+		EXPECT_EQ(scope.get_arena(), arena);
+		scope.vector<float64_t>(100);
+	}
+	EXPECT_EQ(arena->get_position().offset, position.offset);
+}
@@ -0,0 +1,99 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/lib/Profiler.h>
+
+#include "utils/Utils.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace shogun;
+
+static const Profiler::Statistic*
+find_statistic(const std::vector<Profiler::Statistic>& statistics, const char* name)
+{
+	for (const auto& statistic : statistics)
+	{
+		if (statistic.name == name)
+			return &statistic;
+	}
+	return NULL;
+}
+
+TEST(Profiler, counters_of_all_threads)
+{
+	auto profiler = Profiler::instance();
+	profiler->reset();
+	profiler->set_enabled(true);
+
+	#pragma omp parallel for
+	for (int32_t i = 0; i < 1000; i++)
+		profiler->add_count("test/count", 2);
+
+	auto statistic = find_statistic(profiler->get_statistics(), "test/count");
+	ASSERT_TRUE(statistic != NULL);
+	EXPECT_EQ(statistic->count, 2000);
+	EXPECT_EQ(statistic->seconds, 0);
+
+	profiler->reset();
+	EXPECT_TRUE(find_statistic(profiler->get_statistics(), "test/count") == NULL);
+	profiler->set_enabled(false);
+}
+
+TEST(Profiler, scope)
+{
+	auto profiler = Profiler::instance();
+	profiler->reset();
+
+	// disabled profiler records nothing
+	{
+		ProfileScope scope("test/scope");
+	}
+	EXPECT_TRUE(find_statistic(profiler->get_statistics(), "test/scope") == NULL);
+
+	profiler->set_enabled(true);
+	for (int32_t i = 0; i < 3; i++)
+	{
+		ProfileScope scope("test/scope");
+	}
+
+	auto statistic = find_statistic(profiler->get_statistics(), "test/scope");
+	ASSERT_TRUE(statistic != NULL);
+	EXPECT_EQ(statistic->count, 3);
+	EXPECT_GE(statistic->seconds, 0);
+
+	profiler->reset();
+	profiler->set_enabled(false);
+}
+
+TEST(Profiler, chrome_trace)
+{
+	auto profiler = Profiler::instance();
+	profiler->reset();
+	profiler->set_enabled(true);
+	profiler->set_record_events(true);
+
+	auto start = std::chrono::steady_clock::now();
+	profiler->add_time("test/\"quoted\"", start, start + std::chrono::milliseconds(2));
+
+	char filename[] = "profiler_trace_XXXXXX";
+	generate_temp_filename(filename);
+	ASSERT_TRUE(profiler->write_chrome_trace(filename));
+
+	std::ifstream file(filename);
+	std::stringstream contents;
+	contents << file.rdbuf();
+	std::remove(filename);
+
+	EXPECT_NE(contents.str().find("\"traceEvents\""), std::string::npos);
+	EXPECT_NE(contents.str().find("\"test/\\\"quoted\\\"\""), std::string::npos);
+	EXPECT_NE(contents.str().find("\"dur\":2000.000"), std::string::npos);
+
+	profiler->set_record_events(false);
+	profiler->reset();
+	profiler->set_enabled(false);
+}
@@ -489,3 +489,99 @@ TEST(ExactInferenceMethod,get_posterior_mean2)
 	// clean up
 	SG_UNREF(inf);
 }
+
+static CExactInferenceMethod* sine_regression(index_t start, index_t n,
+		float64_t sigma)
+{
+	SGMatrix<float64_t> X(1, n);
+	SGVector<float64_t> Y(n);
+
+	for (index_t i=0; i<n; ++i)
+	{
+		X[i]=(start+i)*0.7;
+		Y[i]=std::sin(X[i]);
+	}
+
+	CGaussianLikelihood* lik=new CGaussianLikelihood();
+	lik->set_sigma(sigma);
+
+	return new CExactInferenceMethod(new CGaussianKernel(10, 2),
+			new CDenseFeatures<float64_t>(X), new CZeroMean(),
+			new CRegressionLabels(Y), lik);
+}
+
+TEST(ExactInferenceMethod,append_training_data)
+{
+	CExactInferenceMethod* inf=sine_regression(0, 4, 0.5);
+	CExactInferenceMethod* full=sine_regression(0, 7, 0.5);
+	CExactInferenceMethod* rest=sine_regression(4, 3, 0.5);
+
+	// factorise before appending, so that the factor is extended
+	inf->get_cholesky();
+	CFeatures* feat_rest=rest->get_features();
+	CLabels* label_rest=rest->get_labels();
+	inf->append_training_data(feat_rest, label_rest);
+	SG_UNREF(feat_rest);
+	SG_UNREF(label_rest);
+
+	SGMatrix<float64_t> L=inf->get_cholesky();
+	SGMatrix<float64_t> L_full=full->get_cholesky();
+	ASSERT_EQ(L.num_rows, 7);
+	for (index_t i=0; i<L.num_rows*L.num_cols; ++i)
+		EXPECT_NEAR(L[i], L_full[i], 1E-12);
+
+	SGVector<float64_t> alpha=inf->get_alpha();
+	SGVector<float64_t> alpha_full=full->get_alpha();
+	for (index_t i=0; i<alpha.vlen; ++i)
+		EXPECT_NEAR(alpha[i], alpha_full[i], 1E-10);
+
+	EXPECT_NEAR(inf->get_negative_log_marginal_likelihood(),
+			full->get_negative_log_marginal_likelihood(), 1E-10);
+
+	SG_UNREF(rest);
+	SG_UNREF(full);
+	SG_UNREF(inf);
+}
+
+TEST(ExactInferenceMethod,change_sigma_only)
+{
+	CExactInferenceMethod* inf=sine_regression(0, 6, 1.0);
+	inf->get_negative_log_marginal_likelihood();
+
+	// only the noise changes, the kernel matrix stays the same
+	for (index_t k=0; k<2; ++k)
+	{
+		float64_t sigma=0.5/(k+1);
+		CGaussianLikelihood* lik=inf->get_model()->as<CGaussianLikelihood>();
+		lik->set_sigma(sigma);
+		SG_UNREF(lik);
+
+		CExactInferenceMethod* fresh=sine_regression(0, 6, sigma);
+
+		EXPECT_NEAR(inf->get_negative_log_marginal_likelihood(),
+				fresh->get_negative_log_marginal_likelihood(), 1E-10);
+
+		SGVector<float64_t> alpha=inf->get_alpha();
+		SGVector<float64_t> alpha_fresh=fresh->get_alpha();
+		for (index_t i=0; i<alpha.vlen; ++i)
+			EXPECT_NEAR(alpha[i], alpha_fresh[i], 1E-9);
+
+		SGMatrix<float64_t> Sigma=inf->get_posterior_covariance();
+		SGMatrix<float64_t> Sigma_fresh=fresh->get_posterior_covariance();
+		for (index_t i=0; i<Sigma.num_rows*Sigma.num_cols; ++i)
+			EXPECT_NEAR(Sigma[i], Sigma_fresh[i], 1E-10);
+
+		SGMatrix<float64_t> L=inf->get_cholesky();
+		SGMatrix<float64_t> L_fresh=fresh->get_cholesky();
+		ASSERT_EQ(L.num_rows, L_fresh.num_rows);
+		for (index_t i=0; i<L.num_rows*L.num_cols; ++i)
+			EXPECT_NEAR(L[i], L_fresh[i], 1E-12);
+
+		// computing the factor on demand must not invalidate the model
+		EXPECT_FALSE(inf->parameter_hash_changed());
+
+		SG_UNREF(fresh);
+	}
+
+	SG_UNREF(inf);
+}
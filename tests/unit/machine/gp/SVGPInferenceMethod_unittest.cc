@@ -0,0 +1,191 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/lib/config.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/machine/gp/SVGPInferenceMethod.h>
+#include <shogun/machine/gp/VarDTCInferenceMethod.h>
+#include <shogun/machine/gp/ConstMean.h>
+#include <shogun/machine/gp/GaussianLikelihood.h>
+#include <shogun/optimization/SGDMinimizer.h>
+#include <shogun/optimization/GradientDescendUpdater.h>
+#include <shogun/optimization/ConstLearningRate.h>
+#include <shogun/optimization/InverseScalingLearningRate.h>
+
+using namespace shogun;
+
+static SGMatrix<float64_t> training_features()
+{
+	SGMatrix<float64_t> feat_train(2, 6);
+
+	feat_train(0,0)=-0.81263;
+	feat_train(0,1)=-0.99976;
+	feat_train(0,2)=1.17037;
+	feat_train(0,3)=1.51752;
+	feat_train(0,4)=1.57765;
+	feat_train(0,5)=3.89440;
+
+	feat_train(1,0)=0.5;
+	feat_train(1,1)=0.4576;
+	feat_train(1,2)=5.17637;
+	feat_train(1,3)=2.56752;
+	feat_train(1,4)=4.57765;
+	feat_train(1,5)=2.89440;
+
+	return feat_train;
+}
+
+static SGMatrix<float64_t> inducing_features()
+{
+	SGMatrix<float64_t> lat_feat_train(2, 3);
+
+	lat_feat_train(0,0)=1.00000;
+	lat_feat_train(0,1)=3.00000;
+	lat_feat_train(0,2)=4.00000;
+
+	lat_feat_train(1,0)=3.00000;
+	lat_feat_train(1,1)=2.00000;
+	lat_feat_train(1,2)=-5.00000;
+
+	return lat_feat_train;
+}
+
+static SGVector<float64_t> training_labels()
+{
+	SGVector<float64_t> lab_train(6);
+
+	lab_train[0]=0.46;
+	lab_train[1]=0.7;
+	lab_train[2]=-1.16;
+	lab_train[3]=1.5;
+	lab_train[4]=3.5;
+	lab_train[5]=-5.0;
+
+	return lab_train;
+}
+
+/* step sizes 1/t make the natural parameters the running average of the
+ * batch estimates, which is exact after every complete pass
+ */
+static void register_averaging_minimizer(CSVGPInferenceMethod* inf)
+{
+	SGDMinimizer* opt=new SGDMinimizer();
+	InverseScalingLearningRate* rate=new InverseScalingLearningRate();
+	rate->set_initial_learning_rate(1.0);
+	rate->set_exponent(1.0);
+	rate->set_slope(1.0);
+	rate->set_intercept(0.0);
+	opt->set_learning_rate(rate);
+	opt->set_gradient_updater(new GradientDescendUpdater());
+	opt->set_number_passes(2);
+	inf->register_minimizer(opt);
+}
+
+template <class T>
+static T* create_inference()
+{
+	CDenseFeatures<float64_t>* features_train=new CDenseFeatures<float64_t>(training_features());
+	CDenseFeatures<float64_t>* inducing_features_train=new CDenseFeatures<float64_t>(inducing_features());
+	CRegressionLabels* labels_train=new CRegressionLabels(training_labels());
+
+	float64_t ell=log(2.0);
+	CKernel* kernel=new CGaussianKernel(10,2.0*exp(ell*2.0));
+	CConstMean* mean=new CConstMean(0.0);
+	CGaussianLikelihood* lik=new CGaussianLikelihood(0.5);
+
+	T* inf=new T(kernel, features_train, mean, labels_train, lik,
+		inducing_features_train);
+	SG_REF(inf);
+
+	inf->set_inducing_noise(1e-6);
+	inf->set_scale(1.5);
+	inf->enable_optimizing_inducing_features(false);
+
+	return inf;
+}
+
+TEST(SVGPInferenceMethod,full_batch_get_negative_log_marginal_likelihood)
+{
+	CSVGPInferenceMethod* inf=create_inference<CSVGPInferenceMethod>();
+
+	// with all points in one batch a single step of size one reaches the
+	// optimal q(u), so the bound equals the collapsed VarDTC bound
+	SGDMinimizer* opt=new SGDMinimizer();
+	ConstLearningRate* rate=new ConstLearningRate();
+	rate->set_const_learning_rate(1.0);
+	opt->set_learning_rate(rate);
+	opt->set_gradient_updater(new GradientDescendUpdater());
+	opt->set_number_passes(1);
+	inf->register_minimizer(opt);
+	inf->set_batch_size(6);
+
+	// result from varsgp package:
+	// http://www.aueb.gr/users/mtitsias/code/varsgp.tar.gz
+	float64_t nlz=inf->get_negative_log_marginal_likelihood();
+	EXPECT_NEAR(nlz, 58.616164107936129, 1E-6);
+
+	SG_UNREF(inf);
+}
+
+TEST(SVGPInferenceMethod,get_marginal_likelihood_derivatives)
+{
+	CSVGPInferenceMethod* inf=create_inference<CSVGPInferenceMethod>();
+	register_averaging_minimizer(inf);
+	inf->set_batch_size(2);
+
+	CMap<TParameter*, CSGObject*>* parameter_dictionary=new CMap<TParameter*, CSGObject*>();
+	inf->build_gradient_parameter_dictionary(parameter_dictionary);
+
+	CMap<TParameter*, SGVector<float64_t> >* gradient=
+		inf->get_negative_log_marginal_likelihood_derivatives(parameter_dictionary);
+
+	CKernel* kernel=inf->get_kernel();
+	CLikelihoodModel* lik=inf->get_model();
+	TParameter* scale_param=inf->m_gradient_parameters->get_parameter("log_scale");
+	TParameter* sigma_param=lik->m_gradient_parameters->get_parameter("log_sigma");
+	TParameter* width_param=kernel->m_gradient_parameters->get_parameter("log_width");
+
+	// at the optimal q(u) the derivatives equal the ones of the collapsed
+	// bound, result from varsgp package
+	EXPECT_NEAR((gradient->get_element(sigma_param))[0], -91.123579890090099, 1E-5);
+	EXPECT_NEAR((gradient->get_element(width_param))[0], 11.103836410254763, 1E-5);
+	EXPECT_NEAR((gradient->get_element(scale_param))[0], 17.692318958964869, 1E-5);
+
+	SG_UNREF(kernel);
+	SG_UNREF(lik);
+	SG_UNREF(gradient);
+	SG_UNREF(parameter_dictionary);
+	SG_UNREF(inf);
+}
+
+TEST(SVGPInferenceMethod,mini_batch_matches_vardtc)
+{
+	CSVGPInferenceMethod* inf=create_inference<CSVGPInferenceMethod>();
+	CVarDTCInferenceMethod* vardtc=create_inference<CVarDTCInferenceMethod>();
+
+	register_averaging_minimizer(inf);
+	inf->set_batch_size(2);
+
+	EXPECT_NEAR(inf->get_negative_log_marginal_likelihood(),
+		vardtc->get_negative_log_marginal_likelihood(), 1E-6);
+
+	SGVector<float64_t> alpha=inf->get_alpha();
+	SGVector<float64_t> alpha_vardtc=vardtc->get_alpha();
+	ASSERT_EQ(alpha.vlen, alpha_vardtc.vlen);
+	for (index_t i=0; i<alpha.vlen; i++)
+		EXPECT_NEAR(alpha[i], alpha_vardtc[i], 1E-6);
+
+	SGMatrix<float64_t> L=inf->get_cholesky();
+	SGMatrix<float64_t> L_vardtc=vardtc->get_cholesky();
+	ASSERT_EQ(L.num_rows, L_vardtc.num_rows);
+	ASSERT_EQ(L.num_cols, L_vardtc.num_cols);
+	for (index_t i=0; i<L.num_rows*L.num_cols; i++)
+		EXPECT_NEAR(L[i], L_vardtc[i], 1E-6);
+
+	SG_UNREF(vardtc);
+	SG_UNREF(inf);
+}
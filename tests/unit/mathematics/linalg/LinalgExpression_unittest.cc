@@ -0,0 +1,107 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/lib/exception/ShogunException.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/linalg/LinalgExpression.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+#include <shogun/mathematics/linalg/LinalgSpecialPurposes.h>
+
+using namespace shogun;
+
+TEST(LinalgExpression, vector_chain)
+{
+	const index_t size = 10;
+	SGVector<float64_t> a(size), b(size), c(size);
+	for (index_t i = 0; i < size; ++i)
+	{
+		a[i] = i;
+		b[i] = 0.5 * i - 2;
+		c[i] = 1.0 / (i + 1);
+	}
+
+	SGVector<float64_t> result(size);
+	linalg::evaluate(
+	    2.0 * linalg::lazy(a) - linalg::lazy(b) * linalg::lazy(c) + 1.0,
+	    result);
+
+	// eager evaluation of the same chain
+	auto expected = linalg::add(
+	    linalg::scale(a, 2.0), linalg::element_prod(b, c), 1.0, -1.0);
+	linalg::add_scalar(expected, 1.0);
+
+	for (index_t i = 0; i < size; ++i)
+		EXPECT_NEAR(result[i], expected[i], 1E-15);
+}
+
+TEST(LinalgExpression, matrix_functions)
+{
+	const index_t rows = 3, cols = 4;
+	SGMatrix<float64_t> a(rows, cols);
+	for (index_t i = 0; i < a.size(); ++i)
+		a[i] = i - 5.5;
+
+	SGMatrix<float64_t> logistic(rows, cols), expected_logistic(rows, cols);
+	linalg::evaluate(linalg::logistic(linalg::lazy(a)), logistic);
+	linalg::logistic(a, expected_logistic);
+
+	SGMatrix<float64_t> relu(rows, cols), expected_relu(rows, cols);
+	linalg::evaluate(linalg::rectified_linear(linalg::lazy(a)), relu);
+	linalg::rectified_linear(a, expected_relu);
+
+	SGMatrix<float64_t> exp(rows, cols);
+	linalg::evaluate(linalg::exponent(linalg::lazy(a)), exp);
+	auto expected_exp = linalg::exponent(a);
+
+	for (index_t i = 0; i < a.size(); ++i)
+	{
+		EXPECT_NEAR(logistic[i], expected_logistic[i], 1E-15);
+		EXPECT_EQ(relu[i], expected_relu[i]);
+		EXPECT_NEAR(exp[i], expected_exp[i], 1E-12);
+	}
+}
+
+TEST(LinalgExpression, evaluate_in_place)
+{
+	const index_t size = 5;
+	SGVector<float64_t> a(size), b(size);
+	for (index_t i = 0; i < size; ++i)
+	{
+		a[i] = i;
+		b[i] = 2 * i;
+	}
+
+	linalg::evaluate(linalg::lazy(a) * linalg::lazy(b) - linalg::lazy(a), a);
+
+	for (index_t i = 0; i < size; ++i)
+		EXPECT_EQ(a[i], 2.0 * i * i - i);
+}
+
+TEST(LinalgExpression, dimension_mismatch)
+{
+	SGVector<float64_t> a(3);
+	SGVector<float64_t> result(4);
+	a.zero();
+
+	EXPECT_THROW(
+	    linalg::evaluate(linalg::lazy(a) + 1.0, result), ShogunException);
+}
+
+TEST(LinalgExpression, operand_dimension_mismatch)
+{
+	SGVector<float64_t> a(3), b(4);
+	SGMatrix<float64_t> A(2, 3), B(3, 2);
+	a.zero();
+	b.zero();
+	A.zero();
+	B.zero();
+
+	EXPECT_THROW(linalg::lazy(a) + linalg::lazy(b), ShogunException);
+	EXPECT_THROW(linalg::lazy(a) - linalg::lazy(b), ShogunException);
+	EXPECT_THROW(linalg::lazy(a) * linalg::lazy(b), ShogunException);
+	EXPECT_THROW(linalg::lazy(a) / linalg::lazy(b), ShogunException);
+	EXPECT_THROW(linalg::lazy(A) + linalg::lazy(B), ShogunException);
+}
@@ -167,8 +167,10 @@ TEST(LMNNImpl,find_impostors_exact)
 	// find impostors with exact search (force exact search by setting correction=1)
 	SGMatrix<float64_t> L(d, d);
 	linalg::identity(L);
-	ImpostorsSetType impostors =
-	    CLMNNImpl::find_impostors(features, labels, L, target_nn, 0, 1);
+	ImpostorsSetType exact_impostors;
+	ImpostorsSetType impostors = CLMNNImpl::find_impostors(
+	    features, labels, L, target_nn, 0, 1, exact_impostors);
+	EXPECT_EQ(impostors.size(), exact_impostors.size());
 
 	// impostors ground truth computed externally
 	index_t impostors_arr[] = {0,1,2, 0,1,3, 2,3,0, 2,3,1, 3,2,0, 3,2,1};
@@ -189,3 +191,67 @@ TEST(LMNNImpl,find_impostors_exact)
 	SG_UNREF(features)
 	SG_UNREF(labels)
 }
+
+TEST(LMNNImpl,find_batch_impostors)
+{
+	// create features, each column is a feature vector
+	SGMatrix<float64_t> feat_mat(2,4);
+	// 1st feature vector
+	feat_mat(0,0)=0;
+	feat_mat(1,0)=0;
+	// 2nd feature vector
+	feat_mat(0,1)=0;
+	feat_mat(1,1)=-1;
+	// 3rd feature vector
+	feat_mat(0,2)=1;
+	feat_mat(1,2)=1;
+	// 4th feature vector
+	feat_mat(0,3)=-1;
+	feat_mat(1,3)=1;
+	// wrap feat_mat in Shogun features
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(feat_mat);
+	// shorthand for the number of features
+	int32_t d=features->get_num_features();
+
+	// create labels
+	SGVector<float64_t> lab_vec(4);
+	lab_vec[0]=0;
+	lab_vec[1]=0;
+	lab_vec[2]=1;
+	lab_vec[3]=1;
+	CMulticlassLabels* labels=new CMulticlassLabels(lab_vec);
+
+	// find target neighbors
+	int32_t k=1;	// number of target neighbors per example
+	SGMatrix<index_t> target_nn=CLMNNImpl::find_target_nn(features,labels,k);
+
+	SGMatrix<float64_t> L(d, d);
+	linalg::identity(L);
+
+	// a batch with all the examples has the same impostors as the exact search
+	std::vector<index_t> batch = {0, 1, 2, 3};
+	ImpostorsSetType impostors =
+	    CLMNNImpl::find_batch_impostors(features, labels, L, target_nn, batch);
+	ImpostorsSetType exact_impostors;
+	ImpostorsSetType impostors_gt = CLMNNImpl::find_impostors(
+	    features, labels, L, target_nn, 0, 1, exact_impostors);
+	EXPECT_EQ(impostors.size(), impostors_gt.size());
+	for (ImpostorsSetType::iterator it=impostors.begin(), it_gt=impostors_gt.begin();
+	     it!=impostors.end() && it_gt!=impostors_gt.end(); it++, it_gt++)
+	{
+		EXPECT_EQ(it_gt->example, it->example);
+		EXPECT_EQ(it_gt->target, it->target);
+		EXPECT_EQ(it_gt->impostor, it->impostor);
+	}
+
+	// a batch only has the impostors of its examples
+	batch = {2};
+	impostors =
+	    CLMNNImpl::find_batch_impostors(features, labels, L, target_nn, batch);
+	EXPECT_EQ(impostors.size(), 2u);
+	for (ImpostorsSetType::iterator it=impostors.begin(); it!=impostors.end(); it++)
+		EXPECT_EQ(it->example, 2);
+
+	SG_UNREF(features)
+	SG_UNREF(labels)
+}
@@ -9,6 +9,7 @@
 #include <shogun/base/some.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/labels/MulticlassLabels.h>
+#include <shogun/mathematics/Math.h>
 #include <shogun/metric/LMNN.h>
 
 using namespace shogun;
@@ -198,3 +199,41 @@ TEST(LMNN,train_diagonal)
 
 	SG_UNREF(lmnn)
 }
+
+TEST(LMNN,train_mini_batch)
+{
+	CMath::init_random(17);
+	// two Gaussian blobs, 20 vectors each
+	index_t num_vectors = 40;
+	SGMatrix<float64_t> feat_mat(2, num_vectors);
+	SGVector<float64_t> lab_vec(num_vectors);
+	for (index_t i = 0; i < num_vectors; ++i)
+	{
+		lab_vec[i] = i % 2;
+		feat_mat(0, i) = 4 * lab_vec[i] + CMath::randn_double();
+		feat_mat(1, i) = CMath::randn_double();
+	}
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(feat_mat);
+	CMulticlassLabels* labels=new CMulticlassLabels(lab_vec);
+
+	int32_t k=3;	// number of target neighbors per example
+	CLMNN* lmnn=new CLMNN(features,labels,k);
+	SGMatrix<float64_t> init_transform=SGMatrix<float64_t>::create_identity_matrix(2,1);
+	lmnn->set_batch_size(8);
+	lmnn->set_maxiter(50);
+	lmnn->set_stepsize(1e-4);
+	lmnn->train(init_transform);
+
+	// the step size stays fixed in stochastic gradient descent
+	CLMNNStatistics* statistics = lmnn->get_statistics();
+	EXPECT_EQ(statistics->obj.vlen, 50);
+	for (index_t i = 0; i < statistics->stepsize.vlen; ++i)
+		EXPECT_EQ(statistics->stepsize[i], 1e-4);
+
+	SGMatrix<float64_t> L=lmnn->get_linear_transform();
+	for (index_t i = 0; i < L.num_rows * L.num_cols; ++i)
+		EXPECT_TRUE(std::isfinite(L.matrix[i]));
+
+	SG_UNREF(statistics)
+	SG_UNREF(lmnn)
+}
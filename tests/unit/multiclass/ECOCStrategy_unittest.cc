@@ -0,0 +1,194 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/init.h>
+#include <shogun/classifier/Perceptron.h>
+#include <shogun/classifier/svm/LibLinear.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/machine/LinearMulticlassMachine.h>
+#include <shogun/multiclass/ecoc/ECOCAEDDecoder.h>
+#include <shogun/multiclass/ecoc/ECOCEDDecoder.h>
+#include <shogun/multiclass/ecoc/ECOCHDDecoder.h>
+#include <shogun/multiclass/ecoc/ECOCLLBDecoder.h>
+#include <shogun/multiclass/ecoc/ECOCOVOEncoder.h>
+#include <shogun/multiclass/ecoc/ECOCStrategy.h>
+#include <shogun/multiclass/MulticlassOneVsRestStrategy.h>
+
+using namespace shogun;
+
+TEST(ECOCStrategy, batch_decoding)
+{
+	CMath::init_random(17);
+
+	// longer than one 64 bit word to exercise the packed codes
+	const int32_t code_length=100;
+	const int32_t num_classes=7;
+	const int32_t num_vectors=50;
+
+	SGMatrix<int32_t> codebook(code_length, num_classes);
+	for (int64_t i=0; i<int64_t(code_length)*num_classes; ++i)
+		codebook.matrix[i]=CMath::random(-1, 1);
+
+	SGMatrix<float64_t> outputs(code_length, num_vectors);
+	for (int64_t i=0; i<int64_t(code_length)*num_vectors; ++i)
+		outputs.matrix[i]=CMath::randn_double();
+
+	CECOCDecoder* decoders[]={new CECOCHDDecoder(), new CECOCLLBDecoder(),
+		new CECOCEDDecoder(), new CECOCAEDDecoder()};
+
+	for (int32_t d=0; d<4; ++d)
+	{
+		SG_REF(decoders[d]);
+		SGVector<int32_t> labels=decoders[d]->decide_labels(outputs, codebook);
+		ASSERT_EQ(labels.vlen, num_vectors);
+
+		for (int32_t i=0; i<num_vectors; ++i)
+		{
+			SGVector<float64_t> query(outputs.get_column_vector(i), code_length, false);
+			EXPECT_EQ(labels[i], decoders[d]->decide_label(query, codebook))
+				<< decoders[d]->get_name() << " vector " << i;
+		}
+		SG_UNREF(decoders[d]);
+	}
+}
+
+TEST(ECOCStrategy, parallel_training)
+{
+	CMath::init_random(17);
+
+	const int32_t num_classes=4;
+	const int32_t num_feats=num_classes;
+	const int32_t num_vectors=120;
+
+	SGMatrix<float64_t> data(num_feats, num_vectors);
+	CMulticlassLabels* labels=new CMulticlassLabels(num_vectors);
+	for (int32_t i=0; i<num_vectors; ++i)
+	{
+		int32_t label=i%num_classes;
+		for (int32_t j=0; j<num_feats; ++j)
+			data(j, i)=CMath::randn_double()+(j==label ? 3 : 0);
+		labels->set_label(i, label);
+	}
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+	SG_REF(labels);
+
+	int32_t num_threads=get_global_parallel()->get_num_threads();
+	CMulticlassLabels* predictions[2];
+	for (int32_t p=0; p<2; ++p)
+	{
+		// one-vs-one codes exclude classes, so the dichotomies train on subsets
+		CECOCStrategy* strategy=new CECOCStrategy(new CECOCOVOEncoder(), new CECOCHDDecoder());
+		CLibLinear* svm=new CLibLinear(L2R_LR);
+		CLinearMulticlassMachine* machine=new CLinearMulticlassMachine(strategy, features, svm, labels);
+		SG_REF(machine);
+		machine->parallel->set_num_threads(4);
+		machine->set_parallel_training(p==1);
+
+		machine->train();
+		predictions[p]=machine->apply_multiclass(features);
+		EXPECT_EQ(machine->get_num_machines(), num_classes*(num_classes-1)/2);
+		SG_UNREF(machine);
+	}
+	get_global_parallel()->set_num_threads(num_threads);
+
+	for (int32_t i=0; i<num_vectors; ++i)
+	{
+		EXPECT_EQ(predictions[0]->get_label(i), predictions[1]->get_label(i));
+		SGVector<float64_t> serial=predictions[0]->get_multiclass_confidences(i);
+		SGVector<float64_t> parallel=predictions[1]->get_multiclass_confidences(i);
+		for (int32_t j=0; j<serial.vlen; ++j)
+			EXPECT_NEAR(serial[j], parallel[j], 1e-10);
+	}
+
+	SG_UNREF(predictions[0]);
+	SG_UNREF(predictions[1]);
+	SG_UNREF(features);
+	SG_UNREF(labels);
+}
+
+TEST(ECOCStrategy, parallel_training_warm_start)
+{
+	CMath::init_random(17);
+
+	const int32_t num_classes=4;
+	const int32_t num_feats=num_classes;
+	const int32_t num_vectors=120;
+
+	SGMatrix<float64_t> data(num_feats, num_vectors);
+	CMulticlassLabels* labels=new CMulticlassLabels(num_vectors);
+	for (int32_t i=0; i<num_vectors; ++i)
+	{
+		int32_t label=i%num_classes;
+		for (int32_t j=0; j<num_feats; ++j)
+			data(j, i)=CMath::randn_double()+(j==label ? 3 : 0);
+		labels->set_label(i, label);
+	}
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+	SG_REF(labels);
+
+	SGVector<float64_t> w_init(num_feats);
+	for (int32_t j=0; j<num_feats; ++j)
+		w_init[j]=CMath::randn_double();
+	const float64_t bias_init=0.5;
+
+	// perceptrons update the hyperplane they start from in place
+	CPerceptron* perceptron=new CPerceptron();
+	perceptron->set_initialize_hyperplane(false);
+	perceptron->set_w(w_init.clone());
+	perceptron->set_bias(bias_init);
+
+	CLinearMulticlassMachine* machine=new CLinearMulticlassMachine(
+		new CMulticlassOneVsRestStrategy(), features, perceptron, labels);
+	SG_REF(machine);
+	int32_t num_threads=get_global_parallel()->get_num_threads();
+	get_global_parallel()->set_num_threads(4);
+	machine->set_parallel_training(true);
+	machine->train();
+	get_global_parallel()->set_num_threads(num_threads);
+	ASSERT_EQ(machine->get_num_machines(), num_classes);
+
+	// the base machine keeps its hyperplane
+	SGVector<float64_t> w_base=perceptron->get_w();
+	for (int32_t j=0; j<num_feats; ++j)
+		EXPECT_EQ(w_base[j], w_init[j]);
+	EXPECT_EQ(perceptron->get_bias(), bias_init);
+
+	// each dichotomy matches a serially trained perceptron that starts from
+	// the same hyperplane
+	for (int32_t c=0; c<num_classes; ++c)
+	{
+		CBinaryLabels* binary=new CBinaryLabels(num_vectors);
+		for (int32_t i=0; i<num_vectors; ++i)
+			binary->set_label(i, labels->get_int_label(i)==c ? +1.0 : -1.0);
+
+		CPerceptron* reference=new CPerceptron();
+		SG_REF(reference);
+		reference->set_initialize_hyperplane(false);
+		reference->set_w(w_init.clone());
+		reference->set_bias(bias_init);
+		reference->set_labels(binary);
+		reference->train(features);
+
+		CLinearMachine* trained=(CLinearMachine*) machine->get_machine(c);
+		SGVector<float64_t> w_ref=reference->get_w();
+		SGVector<float64_t> w=trained->get_w();
+		ASSERT_EQ(w.vlen, num_feats);
+		for (int32_t j=0; j<num_feats; ++j)
+			EXPECT_EQ(w[j], w_ref[j]) << "dichotomy " << c;
+		EXPECT_EQ(trained->get_bias(), reference->get_bias()) << "dichotomy " << c;
+
+		SG_UNREF(trained);
+		SG_UNREF(reference);
+	}
+
+	SG_UNREF(machine);
+	SG_UNREF(features);
+	SG_UNREF(labels);
+}
@@ -31,7 +31,13 @@
 #include <gtest/gtest.h>
 #include "LBFGSMinimizer_unittest.h"
 #include <shogun/base/Parameter.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/init.h>
 #include <shogun/lib/Map.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
+
+using namespace Eigen;
 LBFGSTestCostFunction::LBFGSTestCostFunction()
 	:FirstOrderCostFunction()
 {
@@ -232,3 +238,191 @@ TEST(CLBFGSMinimizer,test2)
 	SG_UNREF(obj);
 	delete opt;
 }
+
+ShardedLeastSquaresCostFunction::ShardedLeastSquaresCostFunction(
+	SGMatrix<float64_t> X, SGVector<float64_t> y, int32_t num_shards)
+	:FirstOrderShardedCostFunction(), m_X(X), m_y(y), m_num_shards(num_shards),
+	m_w(X.num_rows)
+{
+	m_w.zero();
+}
+
+float64_t ShardedLeastSquaresCostFunction::get_shard_cost(int32_t shard,
+	SGVector<float64_t> gradient)
+{
+	index_t start=get_shard_start(shard, m_num_shards, m_X.num_cols);
+	index_t end=get_shard_start(shard+1, m_num_shards, m_X.num_cols);
+
+	float64_t cost=0.0;
+	for (index_t i=start; i<end; i++)
+	{
+		float64_t r=-m_y[i];
+		for (index_t j=0; j<m_X.num_rows; j++)
+			r+=m_X(j,i)*m_w[j];
+		cost+=0.5*r*r/m_X.num_cols;
+		for (index_t j=0; j<m_X.num_rows; j++)
+			gradient[j]+=m_X(j,i)*r/m_X.num_cols;
+	}
+	return cost;
+}
+
+float64_t ShardedLeastSquaresCostFunction::get_shared_cost(SGVector<float64_t> gradient)
+{
+	const float64_t lambda=0.1;
+	float64_t cost=0.0;
+	for (index_t j=0; j<m_w.vlen; j++)
+	{
+		cost+=0.5*lambda*m_w[j]*m_w[j];
+		gradient[j]+=lambda*m_w[j];
+	}
+	return cost;
+}
+
+BoundedQuadraticCostFunction::BoundedQuadraticCostFunction(SGVector<float64_t> x,
+	SGVector<float64_t> target, float64_t lower, float64_t upper)
+	:FirstOrderBoundConstraintsCostFunction(), m_x(x), m_target(target),
+	m_lower(lower), m_upper(upper)
+{
+}
+
+float64_t BoundedQuadraticCostFunction::get_cost()
+{
+	float64_t cost=0.0;
+	for (index_t i=0; i<m_x.vlen; i++)
+		cost+=CMath::sq(m_x[i]-m_target[i]);
+	return cost;
+}
+
+SGVector<float64_t> BoundedQuadraticCostFunction::get_gradient()
+{
+	SGVector<float64_t> gradient(m_x.vlen);
+	for (index_t i=0; i<m_x.vlen; i++)
+		gradient[i]=2.0*(m_x[i]-m_target[i]);
+	return gradient;
+}
+
+SGVector<float64_t> BoundedQuadraticCostFunction::get_lower_bound()
+{
+	SGVector<float64_t> bound(1);
+	bound[0]=m_lower;
+	return bound;
+}
+
+SGVector<float64_t> BoundedQuadraticCostFunction::get_upper_bound()
+{
+	SGVector<float64_t> bound(1);
+	bound[0]=m_upper;
+	return bound;
+}
+
+TEST(CLBFGSMinimizer,sharded_cost_function)
+{
+	CMath::init_random(17);
+	const index_t dim=4;
+	const index_t num_samples=250;
+	SGMatrix<float64_t> X(dim, num_samples);
+	SGVector<float64_t> y(num_samples);
+	for (index_t i=0; i<num_samples; i++)
+	{
+		y[i]=CMath::randn_double();
+		for (index_t j=0; j<dim; j++)
+			X(j,i)=CMath::randn_double();
+	}
+
+	ShardedLeastSquaresCostFunction *b=new ShardedLeastSquaresCostFunction(X, y, 7);
+	SG_REF(b);
+	CLBFGSMinimizer* opt=new CLBFGSMinimizer(b);
+	opt->minimize();
+
+	// ridge regression solution
+	Map<MatrixXd> eigen_X(X.matrix, dim, num_samples);
+	Map<VectorXd> eigen_y(y.vector, num_samples);
+	MatrixXd A=eigen_X*eigen_X.transpose()/num_samples+0.1*MatrixXd::Identity(dim, dim);
+	VectorXd expected=A.ldlt().solve(eigen_X*eigen_y/num_samples);
+
+	SGVector<float64_t> w=b->obtain_variable_reference();
+	for (index_t j=0; j<dim; j++)
+		EXPECT_NEAR(w[j], expected[j], 1e-4);
+
+	delete opt;
+	SG_UNREF(b);
+}
+
+TEST(FirstOrderShardedCostFunction,thread_independent_reduction)
+{
+	CMath::init_random(17);
+	const index_t dim=5;
+	const index_t num_samples=1000;
+	SGMatrix<float64_t> X(dim, num_samples);
+	SGVector<float64_t> y(num_samples);
+	for (index_t i=0; i<num_samples; i++)
+	{
+		y[i]=CMath::randn_double();
+		for (index_t j=0; j<dim; j++)
+			X(j,i)=CMath::randn_double();
+	}
+
+	ShardedLeastSquaresCostFunction *serial=new ShardedLeastSquaresCostFunction(X, y, 13);
+	ShardedLeastSquaresCostFunction *threaded=new ShardedLeastSquaresCostFunction(X, y, 13);
+	SG_REF(serial);
+	SG_REF(threaded);
+
+	for (index_t j=0; j<dim; j++)
+	{
+		float64_t w=CMath::randn_double();
+		serial->obtain_variable_reference()[j]=w;
+		threaded->obtain_variable_reference()[j]=w;
+	}
+
+	SGVector<float64_t> serial_gradient(dim);
+	SGVector<float64_t> threaded_gradient(dim);
+	// both objects use the global parallel object, so they are evaluated
+	// one after the other with a different number of threads
+	int32_t num_threads=get_global_parallel()->get_num_threads();
+	get_global_parallel()->set_num_threads(1);
+	float64_t serial_cost=serial->get_cost_and_gradient(serial_gradient);
+	get_global_parallel()->set_num_threads(4);
+	float64_t threaded_cost=threaded->get_cost_and_gradient(threaded_gradient);
+	get_global_parallel()->set_num_threads(num_threads);
+
+	EXPECT_EQ(serial_cost, threaded_cost);
+	for (index_t j=0; j<dim; j++)
+		EXPECT_EQ(serial_gradient[j], threaded_gradient[j]);
+
+	// cost and gradient are served from the same evaluation
+	EXPECT_EQ(threaded->get_cost(), threaded_cost);
+	SGVector<float64_t> gradient=threaded->get_gradient();
+	for (index_t j=0; j<dim; j++)
+		EXPECT_EQ(gradient[j], threaded_gradient[j]);
+
+	SG_UNREF(serial);
+	SG_UNREF(threaded);
+}
+
+TEST(CLBFGSMinimizer,bound_constraints)
+{
+	SGVector<float64_t> x(5);
+	x.set_const(0.5);
+	SGVector<float64_t> target(5);
+	target[0]=1.0;
+	target[1]=3.0;
+	target[2]=-1.0;
+	target[3]=0.5;
+	target[4]=2.5;
+
+	BoundedQuadraticCostFunction *b=new BoundedQuadraticCostFunction(x, target, 0.0, 2.0);
+	SG_REF(b);
+	CLBFGSMinimizer* opt=new CLBFGSMinimizer(b);
+	opt->set_bound_constraints(true);
+	float64_t cost=opt->minimize();
+
+	EXPECT_NEAR(x[0], 1.0, 1e-5);
+	EXPECT_NEAR(x[1], 2.0, 1e-5);
+	EXPECT_NEAR(x[2], 0.0, 1e-5);
+	EXPECT_NEAR(x[3], 0.5, 1e-5);
+	EXPECT_NEAR(x[4], 2.0, 1e-5);
+	EXPECT_NEAR(cost, 2.25, 1e-5);
+
+	delete opt;
+	SG_UNREF(b);
+}
@@ -32,6 +32,9 @@
 #define LBFGSMINIMIZER_UNITTEST_H
 #include <shogun/lib/config.h>
 #include <shogun/optimization/FirstOrderCostFunction.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/optimization/FirstOrderShardedCostFunction.h>
+#include <shogun/optimization/FirstOrderBoundConstraintsCostFunction.h>
 #include <shogun/optimization/lbfgs/LBFGSMinimizer.h>
 using namespace shogun;
 class CPiecewiseQuadraticObject;
@@ -68,4 +71,38 @@ private:
 	SGVector<float64_t> m_init_x;
 	SGVector<float64_t> m_truth_x;
 };
+class ShardedLeastSquaresCostFunction: public FirstOrderShardedCostFunction
+{
+public:
+	ShardedLeastSquaresCostFunction(SGMatrix<float64_t> X, SGVector<float64_t> y,
+		int32_t num_shards);
+	virtual SGVector<float64_t> obtain_variable_reference() { return m_w; }
+	virtual int32_t get_num_shards() { return m_num_shards; }
+	virtual float64_t get_shard_cost(int32_t shard, SGVector<float64_t> gradient);
+	virtual float64_t get_shared_cost(SGVector<float64_t> gradient);
+	virtual const char* get_name() const { return "ShardedLeastSquaresCostFunction"; }
+private:
+	SGMatrix<float64_t> m_X;
+	SGVector<float64_t> m_y;
+	int32_t m_num_shards;
+	SGVector<float64_t> m_w;
+};
+
+class BoundedQuadraticCostFunction: public FirstOrderBoundConstraintsCostFunction
+{
+public:
+	BoundedQuadraticCostFunction(SGVector<float64_t> x, SGVector<float64_t> target,
+		float64_t lower, float64_t upper);
+	virtual float64_t get_cost();
+	virtual SGVector<float64_t> obtain_variable_reference() { return m_x; }
+	virtual SGVector<float64_t> get_gradient();
+	virtual SGVector<float64_t> get_lower_bound();
+	virtual SGVector<float64_t> get_upper_bound();
+	virtual const char* get_name() const { return "BoundedQuadraticCostFunction"; }
+private:
+	SGVector<float64_t> m_x;
+	SGVector<float64_t> m_target;
+	float64_t m_lower;
+	float64_t m_upper;
+};
 #endif
@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 #include <shogun/preprocessor/KernelPCA.h>
 #include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/LinearKernel.h>
 #include <shogun/lib/SGMatrix.h>
 
 
@@ -101,3 +102,50 @@ TEST(KernelPCA, apply_to_feature_vector)
 	SG_UNREF(kpca);
 	SG_UNREF(kernel);
 }
+
+TEST(KernelPCA, nystroem_low_rank)
+{
+	const index_t num_train_vectors = 20;
+	const index_t num_test_vectors = 4;
+	const index_t num_landmarks = 6;
+
+	// a linear kernel on three dimensional data has rank three, so the
+	// Nystroem approximation with more landmarks is exact
+	CMath::init_random(17);
+	SGMatrix<float64_t> train_matrix(num_features, num_train_vectors);
+	SGMatrix<float64_t> test_matrix(num_features, num_test_vectors);
+	for (index_t i = 0; i < train_matrix.size(); ++i)
+		train_matrix[i] = CMath::randn_double();
+	for (index_t i = 0; i < test_matrix.size(); ++i)
+		test_matrix[i] = CMath::randn_double();
+
+	auto train_feats = some<CDenseFeatures<float64_t>>(train_matrix);
+	auto test_feats = some<CDenseFeatures<float64_t>>(test_matrix);
+
+	auto exact = some<CKernelPCA>(new CLinearKernel());
+	exact->set_target_dim(target_dim);
+	exact->fit(train_feats);
+
+	auto nystroem = some<CKernelPCA>(new CLinearKernel());
+	nystroem->set_target_dim(target_dim);
+	nystroem->set_num_landmarks(num_landmarks);
+	nystroem->fit(train_feats);
+	EXPECT_EQ(nystroem->get_num_landmarks(), num_landmarks);
+
+	SGMatrix<float64_t> exact_embedding =
+	    exact->transform(test_feats)
+	        ->as<CDenseFeatures<float64_t>>()
+	        ->get_feature_matrix();
+	SGMatrix<float64_t> nystroem_embedding =
+	    nystroem->transform(test_feats)
+	        ->as<CDenseFeatures<float64_t>>()
+	        ->get_feature_matrix();
+
+	// allow embedding with opposite sign
+	for (index_t i = 0; i < num_test_vectors * target_dim; ++i)
+	{
+		EXPECT_NEAR(
+		    CMath::abs(exact_embedding[i]), CMath::abs(nystroem_embedding[i]),
+		    1E-6);
+	}
+}
@@ -603,3 +603,63 @@ TEST(PCA, PCA_WHITEN_EVD)
 	EXPECT_NEAR(0.0,covariance_mat(2,1),epsilon);
 	EXPECT_NEAR(1.0,covariance_mat(2,2),epsilon);
 }
+
+TEST(PCA, PCA_RANDOMIZED)
+{
+	const index_t num_features = 10;
+	const index_t num_vectors = 50;
+	const index_t rank = 3;
+
+	// low rank data with an offset, which the randomized range finder
+	// captures exactly once the subspace exceeds the rank
+	CMath::init_random(17);
+	SGMatrix<float64_t> basis(num_features, rank);
+	SGMatrix<float64_t> coefficients(rank, num_vectors);
+	for (index_t i = 0; i < basis.size(); i++)
+		basis[i] = CMath::randn_double();
+	for (index_t i = 0; i < coefficients.size(); i++)
+		coefficients[i] = CMath::randn_double();
+	SGMatrix<float64_t> data = linalg::matrix_prod(basis, coefficients);
+	for (index_t j = 0; j < num_vectors; j++)
+		for (index_t i = 0; i < num_features; i++)
+			data(i, j) += i;
+
+	auto features = some<CDenseFeatures<float64_t>>(data);
+
+	auto evd = some<CPCA>(EVD);
+	evd->set_target_dim(rank);
+	evd->fit(features);
+
+	auto randomized = some<CPCA>(RANDOMIZED);
+	randomized->set_target_dim(rank);
+	randomized->set_oversampling(2);
+	randomized->set_block_size(7);
+	randomized->fit(features);
+
+	auto evd_eigenvalues = evd->get_eigenvalues();
+	auto randomized_eigenvalues = randomized->get_eigenvalues();
+	ASSERT_EQ(randomized_eigenvalues.vlen, rank);
+	for (index_t i = 0; i < rank; i++)
+	{
+		EXPECT_NEAR(
+		    evd_eigenvalues[evd_eigenvalues.vlen - 1 - i],
+		    randomized_eigenvalues[i], 1e-8);
+	}
+
+	// EVD stores the leading components last
+	auto evd_embedding = evd->transform(features)
+	                         ->as<CDenseFeatures<float64_t>>()
+	                         ->get_feature_matrix();
+	auto randomized_embedding = randomized->transform(features)
+	                                ->as<CDenseFeatures<float64_t>>()
+	                                ->get_feature_matrix();
+	for (index_t j = 0; j < num_vectors; j++)
+	{
+		for (index_t i = 0; i < rank; i++)
+		{
+			EXPECT_NEAR(
+			    CMath::abs(evd_embedding(rank - 1 - i, j)),
+			    CMath::abs(randomized_embedding(i, j)), 1e-8);
+		}
+	}
+}
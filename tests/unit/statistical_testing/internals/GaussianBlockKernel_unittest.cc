@@ -0,0 +1,93 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/some.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/GaussianShortRealKernel.h>
+#include <shogun/kernel/LinearKernel.h>
+#include <shogun/kernel/normalizer/SqrtDiagKernelNormalizer.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/statistical_testing/internals/GaussianBlockKernel.h>
+
+using namespace shogun;
+using namespace internal;
+
+TEST(GaussianBlockKernel, kernel_matrix)
+{
+	const index_t dim=3;
+	const index_t num_vec=20;
+	const float64_t width=0.5;
+
+	SGMatrix<float64_t> data(dim, num_vec);
+	for (auto i=0; i<dim*num_vec; ++i)
+		data.matrix[i]=sg_rand->random(0.0, 1.0);
+	auto feats=some<CDenseFeatures<float64_t> >(data);
+
+	auto kernel=some<CGaussianKernel>(width);
+	kernel->init(feats, feats);
+	auto expected=kernel->get_kernel_matrix<float32_t>();
+	kernel->remove_lhs_and_rhs();
+
+	ASSERT_TRUE(GaussianBlockKernel::is_supported(kernel, feats));
+	GaussianBlockKernel gaussian(width);
+	auto kernel_matrix=gaussian(feats);
+
+	ASSERT_EQ(kernel_matrix.num_rows, num_vec);
+	ASSERT_EQ(kernel_matrix.num_cols, num_vec);
+	for (auto i=0; i<num_vec*num_vec; ++i)
+		EXPECT_NEAR(kernel_matrix.matrix[i], expected.matrix[i], 1E-6);
+}
+
+TEST(GaussianBlockKernel, kernel_matrix_subset)
+{
+	const index_t dim=2;
+	const index_t num_vec=10;
+	const float64_t width=2.0;
+
+	SGMatrix<float64_t> data(dim, num_vec);
+	for (auto i=0; i<dim*num_vec; ++i)
+		data.matrix[i]=sg_rand->random(0.0, 1.0);
+	auto feats=some<CDenseFeatures<float64_t> >(data);
+
+	SGVector<index_t> inds(4);
+	inds[0]=7;
+	inds[1]=2;
+	inds[2]=9;
+	inds[3]=0;
+	feats->add_subset(inds);
+
+	auto kernel=some<CGaussianKernel>(width);
+	kernel->init(feats, feats);
+	auto expected=kernel->get_kernel_matrix<float32_t>();
+	kernel->remove_lhs_and_rhs();
+
+	GaussianBlockKernel gaussian(width);
+	auto kernel_matrix=gaussian(feats);
+
+	ASSERT_EQ(kernel_matrix.num_rows, inds.vlen);
+	for (auto i=0; i<kernel_matrix.num_rows*kernel_matrix.num_cols; ++i)
+		EXPECT_NEAR(kernel_matrix.matrix[i], expected.matrix[i], 1E-6);
+}
+
+TEST(GaussianBlockKernel, is_supported)
+{
+	SGMatrix<float64_t> data(2, 5);
+	data.set_const(1.0);
+	auto feats=some<CDenseFeatures<float64_t> >(data);
+
+	auto gaussian=some<CGaussianKernel>(1.0);
+	EXPECT_TRUE(GaussianBlockKernel::is_supported(gaussian, feats));
+
+	auto linear=some<CLinearKernel>();
+	EXPECT_FALSE(GaussianBlockKernel::is_supported(linear, feats));
+
+	auto normalized=some<CGaussianKernel>(1.0);
+	normalized->set_normalizer(new CSqrtDiagKernelNormalizer());
+	EXPECT_FALSE(GaussianBlockKernel::is_supported(normalized, feats));
+
+	auto short_real=some<CGaussianShortRealKernel>(10, 1.0);
+	EXPECT_FALSE(GaussianBlockKernel::is_supported(short_real, feats));
+}
@@ -0,0 +1,269 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/init.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/structure/DynProg.h>
+#include <shogun/structure/PlifMatrix.h>
+
+#include <vector>
+
+using namespace shogun;
+
+namespace
+{
+
+const int32_t num_states=4;
+const int32_t seq_len=40;
+const int32_t num_plifs=3;
+const int32_t max_segment_len=6;
+
+/** segmental model with random transition, start, end and observation
+ * scores, where every transition is scored by two length PLiFs
+ */
+struct DynProgProblem
+{
+	DynProgProblem()
+	{
+		CMath::init_random(17);
+
+		p=SGVector<float64_t>(num_states);
+		q=SGVector<float64_t>(num_states);
+		for (int32_t i=0; i<num_states; i++)
+		{
+			p[i]=CMath::random(-1.0, 1.0);
+			q[i]=CMath::random(-1.0, 1.0);
+		}
+
+		// transitions sorted by target state
+		a_trans=SGMatrix<float64_t>(num_states*num_states, 3);
+		for (int32_t to=0; to<num_states; to++)
+		{
+			for (int32_t from=0; from<num_states; from++)
+			{
+				int32_t row=from+to*num_states;
+				a_trans(row, 0)=from;
+				a_trans(row, 1)=to;
+				a_trans(row, 2)=CMath::random(-1.0, 1.0);
+			}
+		}
+
+		SGVector<index_t> dims(3);
+		dims[0]=num_states;
+		dims[1]=seq_len;
+		dims[2]=1;
+		observations=SGNDArray<float64_t>(dims);
+		for (int32_t i=0; i<num_states*seq_len; i++)
+			observations.array[i]=CMath::random(-1.0, 1.0);
+
+		plifs=new CPlifMatrix();
+		SG_REF(plifs);
+		plifs->create_plifs(num_plifs, 3);
+		SGVector<int32_t> ids(num_plifs);
+		SGVector<float64_t> min_values(num_plifs);
+		SGVector<float64_t> max_values(num_plifs);
+		SGMatrix<float64_t> limits(num_plifs, 3);
+		SGMatrix<float64_t> penalties(num_plifs, 3);
+		for (int32_t i=0; i<num_plifs; i++)
+		{
+			ids[i]=i;
+			min_values[i]=1;
+			max_values[i]=max_segment_len;
+			for (int32_t k=0; k<3; k++)
+			{
+				// row major, as the plif matrix reads them
+				limits.matrix[i*3+k]=1+k*(max_segment_len-1)/2.0;
+				penalties.matrix[i*3+k]=CMath::random(-1.0, 1.0);
+			}
+		}
+		plifs->set_plif_ids(ids);
+		plifs->set_plif_min_values(min_values);
+		plifs->set_plif_max_values(max_values);
+		plifs->set_plif_limits(limits);
+		plifs->set_plif_penalties(penalties);
+
+		// two plifs per transition, so that every entry is a plif array
+		SGVector<index_t> plif_dims(3);
+		plif_dims[0]=num_states;
+		plif_dims[1]=num_states;
+		plif_dims[2]=2;
+		SGNDArray<float64_t> transition_plifs(plif_dims);
+		for (int32_t to=0; to<num_states; to++)
+		{
+			for (int32_t from=0; from<num_states; from++)
+			{
+				int32_t idx=to+from*num_states;
+				transition_plifs.array[idx]=1+(to+from)%num_plifs;
+				transition_plifs.array[idx+num_states*num_states]=1+(to+2*from+1)%num_plifs;
+			}
+		}
+		plifs->compute_plif_matrix(transition_plifs);
+		SGMatrix<int32_t> state_signals(num_states, 1);
+		state_signals.zero();
+		plifs->compute_signal_plifs(state_signals);
+	}
+
+	~DynProgProblem()
+	{
+		SG_UNREF(plifs);
+	}
+
+	/** decode with the given beam score gap */
+	void decode(float64_t gap, SGVector<float64_t>& scores,
+			SGMatrix<int32_t>& states, SGMatrix<int32_t>& positions)
+	{
+		CDynProg* dp=new CDynProg();
+		SG_REF(dp);
+		dp->set_num_states(num_states);
+
+		SGVector<int32_t> pos(seq_len);
+		SGVector<char> genestr(seq_len);
+		for (int32_t i=0; i<seq_len; i++)
+		{
+			pos[i]=i;
+			genestr[i]="acgt"[i%4];
+		}
+		dp->set_pos(pos);
+		dp->set_gene_string(genestr);
+		dp->init_content_svm_value_array(dp->get_num_svms());
+
+		SGMatrix<int32_t> orf_info(num_states, 2);
+		orf_info.set_const(-1);
+		dp->set_orf_info(orf_info);
+		dp->set_p_vector(p);
+		dp->set_q_vector(q);
+		dp->set_a_trans_matrix(a_trans);
+		dp->check_svm_arrays();
+		dp->set_observation_matrix(observations);
+		dp->set_plif_matrices(plifs);
+		dp->long_transition_settings(false, 1000, 1000);
+		dp->set_beam_score_gap(gap);
+
+		dp->compute_nbest_paths(1, false, 1, false, false);
+
+		scores=dp->get_scores();
+		states=dp->get_states();
+		positions=dp->get_positions();
+		SG_UNREF(dp);
+	}
+
+	SGVector<float64_t> p;
+	SGVector<float64_t> q;
+	SGMatrix<float64_t> a_trans;
+	SGNDArray<float64_t> observations;
+	CPlifMatrix* plifs;
+};
+
+}
+
+TEST(DynProg, parallel_states_match_serial)
+{
+	DynProgProblem problem;
+	int32_t num_threads=get_global_parallel()->get_num_threads();
+
+	const float64_t gaps[]={CMath::INFTY, 1.0};
+	for (int32_t g=0; g<2; g++)
+	{
+		SGVector<float64_t> scores[2];
+		SGMatrix<int32_t> states[2];
+		SGMatrix<int32_t> positions[2];
+		for (int32_t p=0; p<2; p++)
+		{
+			get_global_parallel()->set_num_threads(p==0 ? 1 : 4);
+			problem.decode(gaps[g], scores[p], states[p], positions[p]);
+		}
+
+		EXPECT_EQ(scores[0][0], scores[1][0]);
+		ASSERT_EQ(states[0].num_cols, states[1].num_cols);
+		for (int32_t i=0; i<states[0].num_cols; i++)
+		{
+			EXPECT_EQ(states[0][i], states[1][i]);
+			EXPECT_EQ(positions[0][i], positions[1][i]);
+		}
+	}
+
+	get_global_parallel()->set_num_threads(num_threads);
+}
+
+TEST(DynProg, infinite_beam_gap_is_exact)
+{
+	DynProgProblem problem;
+
+	SGVector<float64_t> scores;
+	SGMatrix<int32_t> states;
+	SGMatrix<int32_t> positions;
+	problem.decode(CMath::INFTY, scores, states, positions);
+
+	// plain segmental Viterbi with the same scores and tie breaking
+	CPlifBase** plif_matrix=problem.plifs->get_plif_matrix();
+	float64_t* svm_values=SG_CALLOC(float64_t, 8);
+	std::vector<float64_t> delta(seq_len*num_states);
+	std::vector<int32_t> from_state(seq_len*num_states);
+	std::vector<int32_t> from_pos(seq_len*num_states);
+	for (int32_t j=0; j<num_states; j++)
+		delta[j]=problem.p[j]+problem.observations.array[j];
+
+	for (int32_t t=1; t<seq_len; t++)
+	{
+		for (int32_t j=0; j<num_states; j++)
+		{
+			float64_t best=-CMath::INFTY;
+			for (int32_t ii=0; ii<num_states; ii++)
+			{
+				float64_t a=problem.a_trans(ii+j*num_states, 2);
+				CPlifBase* penalty=plif_matrix[j+ii*num_states];
+				for (int32_t ts=t-1; ts>=0 && t-ts<=max_segment_len; ts--)
+				{
+					float64_t val=a+penalty->lookup_penalty(t-ts, svm_values);
+					float64_t score=val+delta[ii+ts*num_states];
+					if (score>best)
+					{
+						best=score;
+						from_state[j+t*num_states]=ii;
+						from_pos[j+t*num_states]=ts;
+					}
+				}
+			}
+			delta[j+t*num_states]=best+problem.observations.array[j+t*num_states];
+		}
+	}
+	SG_FREE(svm_values);
+
+	float64_t best=-CMath::INFTY;
+	int32_t state=0;
+	for (int32_t j=0; j<num_states; j++)
+	{
+		float64_t score=delta[j+(seq_len-1)*num_states]+problem.q[j];
+		if (score>best)
+		{
+			best=score;
+			state=j;
+		}
+	}
+	EXPECT_DOUBLE_EQ(scores[0], best);
+
+	std::vector<int32_t> path_states(1, state);
+	std::vector<int32_t> path_pos(1, seq_len-1);
+	while (path_pos.back()>0)
+	{
+		int32_t idx=path_states.back()+path_pos.back()*num_states;
+		path_states.push_back(from_state[idx]);
+		path_pos.push_back(from_pos[idx]);
+	}
+
+	int32_t len=path_states.size();
+	ASSERT_LE(len, states.num_cols);
+	for (int32_t i=0; i<len; i++)
+	{
+		EXPECT_EQ(states[i], path_states[len-1-i]);
+		EXPECT_EQ(positions[i], path_pos[len-1-i]);
+	}
+	if (len<states.num_cols)
+	{
+		EXPECT_EQ(states[len], -1);
+		EXPECT_EQ(positions[len], -1);
+	}
+}